@@ -12,6 +12,8 @@
 #include "pragma/clientdefinitions.h"
 #include <pragma/networkstate/networkstate.h>
 #include <pragma/networking/portinfo.h>
+#include <pragma/networking/enums.hpp>
+#include <pragma/networking/net_message_registry.hpp>
 #include "pragma/rendering/game_world_shader_settings.hpp"
 #include "pragma/game/c_game.h"
 #include "pragma/audio/c_alsound.h"
@@ -38,11 +40,12 @@ struct DLLCLIENT ServerInfo {
 };
 
 struct DLLCLIENT ResourceDownload {
-	ResourceDownload(VFilePtrReal file, std::string name, unsigned int size)
+	ResourceDownload(VFilePtrReal file, std::string name, uint64_t size, uint64_t offset = 0)
 	{
 		this->file = file;
 		this->name = name;
 		this->size = size;
+		this->offset = offset;
 	}
 	~ResourceDownload()
 	{
@@ -51,7 +54,8 @@ struct DLLCLIENT ResourceDownload {
 	}
 	VFilePtrReal file;
 	std::string name;
-	unsigned int size;
+	uint64_t size;
+	uint64_t offset; // Number of bytes that have been written so far
 };
 
 class CLNetMessage;
@@ -85,9 +89,15 @@ class DLLCLIENT ClientState : public NetworkState {
   private:
 	std::unique_ptr<pragma::networking::IClient> m_client;
 	std::unique_ptr<ServerInfo> m_svInfo;
-	std::unique_ptr<ResourceDownload> m_resDownload; // Current resource file being downloaded
+	std::unordered_map<uint32_t, std::unique_ptr<ResourceDownload>> m_resDownloads; // Resource files currently being downloaded, by transfer id
 
 	unsigned int GetServerMessageID(std::string identifier);
+	template<pragma::networking::NetMessageName TName>
+	unsigned int GetServerMessageID();
+	// Sent messages are indexed by server message ID, received messages by client message ID
+	pragma::networking::NetMessageStatsTable m_sentMessageStats;
+	pragma::networking::NetMessageStatsTable m_receivedMessageStats;
+	void SendPacket(uint32_t messageId, const char *name, NetPacket &packet, pragma::networking::Protocol protocol);
 	unsigned int GetServerConVarID(std::string scmd);
 	bool GetServerConVarIdentifier(uint32_t id, std::string &cvar);
 
@@ -200,6 +210,8 @@ class DLLCLIENT ClientState : public NetworkState {
 	// Handles
 	void LoadLuaCache(std::string cache, unsigned int cacheSize);
 	void HandlePacket(NetPacket &packet);
+	// Unpacks small unreliable messages that the server has aggregated into a single datagram
+	void HandleMessageBundle(NetPacket &packet);
 	void HandleConnect();
 	void HandleReceiveGameInfo(NetPacket &packet);
 	void SetGameReady();
@@ -215,6 +227,17 @@ class DLLCLIENT ClientState : public NetworkState {
 	void SendPacket(const std::string &name, NetPacket &packet, pragma::networking::Protocol protocol);
 	void SendPacket(const std::string &name, NetPacket &packet);
 	void SendPacket(const std::string &name, pragma::networking::Protocol protocol);
+	// Preferred over the overloads above, since the message ID is only looked up once
+	template<pragma::networking::NetMessageName TName>
+	void SendPacket(NetPacket &packet, pragma::networking::Protocol protocol);
+	template<pragma::networking::NetMessageName TName>
+	void SendPacket(NetPacket &packet);
+	template<pragma::networking::NetMessageName TName>
+	void SendPacket(pragma::networking::Protocol protocol);
+
+	const pragma::networking::NetMessageStatsTable &GetSentMessageStats() const;
+	const pragma::networking::NetMessageStatsTable &GetReceivedMessageStats() const;
+	void ResetMessageStats();
 
 	void Disconnect();
 	// Game
@@ -250,4 +273,31 @@ class DLLCLIENT ClientState : public NetworkState {
 };
 #pragma warning(pop)
 
+template<pragma::networking::NetMessageName TName>
+unsigned int ClientState::GetServerMessageID()
+{
+	// Net messages are registered during static initialization, so the ID won't change once it has been found
+	static unsigned int id = 0;
+	if(id == 0)
+		id = GetServerMessageID(std::string {TName.value});
+	return id;
+}
+
+template<pragma::networking::NetMessageName TName>
+void ClientState::SendPacket(NetPacket &packet, pragma::networking::Protocol protocol)
+{
+	SendPacket(GetServerMessageID<TName>(), TName.value, packet, protocol);
+}
+template<pragma::networking::NetMessageName TName>
+void ClientState::SendPacket(NetPacket &packet)
+{
+	SendPacket<TName>(packet, pragma::networking::Protocol::FastUnreliable);
+}
+template<pragma::networking::NetMessageName TName>
+void ClientState::SendPacket(pragma::networking::Protocol protocol)
+{
+	NetPacket packet {};
+	SendPacket<TName>(packet, protocol);
+}
+
 #endif
@@ -15,6 +15,8 @@
 REGISTER_CONVAR_CL(playername, udm::Type::String, "player", ConVarFlags::Archive | ConVarFlags::Userinfo, "Local player name.");
 REGISTER_CONVAR_CL(password, udm::Type::String, "", ConVarFlags::Password, "Password which will be used for the next connection attempt.");
 REGISTER_CONVAR_CL(cl_updaterate, udm::Type::UInt32, "20", ConVarFlags::Archive, "The amount of times per second user input is being transmitted to the server.");
+REGISTER_CONVAR_CL(cl_interp, udm::Type::Float, "0.1", ConVarFlags::Archive, "Delay (in seconds) at which entity states received through snapshots are played back, to allow interpolating between them. 0 = Disables interpolation.");
+REGISTER_CONVAR_CL(cl_interp_max_extrapolation, udm::Type::Float, "0.25", ConVarFlags::Archive, "Maximum amount of time (in seconds) an entity state may be extrapolated if no newer snapshot has arrived in time. Past that, the buffered states are no longer applied.");
 REGISTER_CONVAR_CL(net_graph, udm::Type::Boolean, "0", ConVarFlags::None, "Displays a graph about current network transmissions.");
 
 DLLCLIENT void CMD_cl_send(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv);
@@ -32,11 +34,18 @@ REGISTER_CONCOMMAND_CL(connect, CMD_connect, ConVarFlags::None, "Attempts to con
 DLLCLIENT void CMD_disconnect(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv);
 REGISTER_CONCOMMAND_CL(disconnect, CMD_disconnect, ConVarFlags::None, "Disconnects from the server (if a connection is active), or closes the game if in single player mode.");
 
+DLLCLIENT void CMD_cl_interp_stats(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv);
+REGISTER_CONCOMMAND_CL(cl_interp_stats, CMD_cl_interp_stats, ConVarFlags::None, "Prints statistics about the snapshot interpolation buffer. Usage: cl_interp_stats <reset>");
+
 DLLCLIENT void CMD_cl_debug_netmessages(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv);
 REGISTER_CONCOMMAND_CL(cl_debug_netmessages, CMD_cl_debug_netmessages, ConVarFlags::None, "Prints out debug information about recent net-messages.");
 
+DLLCLIENT void CMD_cl_net_message_stats(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv);
+REGISTER_CONCOMMAND_CL(cl_net_message_stats, CMD_cl_net_message_stats, ConVarFlags::None, "Prints the number of packets and bytes that have been sent and received per net-message. Usage: cl_net_message_stats <reset>");
+
 REGISTER_CONVAR_CL(cl_port_tcp, udm::Type::String, sci::DEFAULT_PORT_TCP, ConVarFlags::Archive | ConVarFlags::Userinfo, "Port used for TCP transmissions.");
 REGISTER_CONVAR_CL(cl_port_udp, udm::Type::String, sci::DEFAULT_PORT_UDP, ConVarFlags::Archive | ConVarFlags::Userinfo, "Port used for UDP transmissions.");
+REGISTER_CONVAR_CL(cl_rate, udm::Type::UInt32, "131072", ConVarFlags::Archive | ConVarFlags::Userinfo, "Maximum number of bytes per second the server should send to this client. The server may clamp this to sv_minrate and sv_maxrate.");
 
 REGISTER_CONVAR_CL(cl_max_fps, udm::Type::Int32, "-1", ConVarFlags::Archive, "FPS will be clamped at this value. A value of < 0 deactivates the limit.");
 #endif
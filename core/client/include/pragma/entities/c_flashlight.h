@@ -18,6 +18,7 @@ namespace pragma {
 		CFlashlightComponent(BaseEntity &ent) : BaseFlashlightComponent(ent) {}
 		virtual void Initialize() override;
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 		virtual void InitializeLuaObject(lua_State *l) override;
 	};
 };
@@ -23,6 +23,8 @@ namespace pragma {
 		virtual void ReceiveSnapshotData(NetPacket &packet) override;
 		virtual bool ShouldTransmitNetData() const override;
 		virtual bool ShouldTransmitSnapshotData() const override;
+		// Reads a bitmask of changed networked members, followed by their values (see SLuaBaseEntityComponent::WritePendingMemberUpdates)
+		void ReceiveMemberUpdates(NetPacket &packet);
 	  protected:
 		virtual void InvokeNetEventHandle(const std::string &methodName, NetPacket &packet, pragma::BasePlayerComponent *pl) override;
 	};
@@ -40,6 +40,7 @@ namespace pragma {
 		virtual void OnUnCrouch() override;
 		virtual void SetLocalPlayer(bool b) override;
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 		bool IsInFirstPersonMode() const;
 
 		virtual void ApplyViewRotationOffset(const EulerAngles &ang, float dur = 0.5f) override;
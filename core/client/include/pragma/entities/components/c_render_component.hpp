@@ -58,6 +58,7 @@ namespace pragma {
 			Hidden = ShouldDrawShadow << 1u,
 			AncestorHidden = Hidden << 1u,
 			IgnoreAncestorVisibility = AncestorHidden << 1u,
+			Dormant = IgnoreAncestorVisibility << 1u,
 		};
 		static constexpr auto USE_HOST_MEMORY_FOR_RENDER_DATA = true;
 
@@ -201,6 +202,9 @@ namespace pragma {
 		void SetHidden(bool hidden);
 		bool IsHidden() const;
 		bool IsVisible() const;
+		// Dormant entities are hidden, since the server doesn't send updates for them while they're not relevant to the local player
+		void SetDormant(bool dormant);
+		bool IsDormant() const;
 		void SetIgnoreAncestorVisibility(bool ignoreVisibility);
 		bool ShouldIgnoreAncestorVisibility() const;
 
@@ -221,6 +225,7 @@ namespace pragma {
 		bool RenderCallback(RenderObject *o, pragma::CCameraComponent *cam, pragma::ShaderGameWorldLightingPass *shader, Material *mat);
 		void UpdateRenderMeshes();
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 
 		void InitializeRenderBuffers();
 		void UpdateBoneBuffer();
@@ -23,6 +23,7 @@ namespace pragma {
 		virtual void ReceiveData(NetPacket &packet) override;
 		virtual void OnTick(double dt) override;
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 
 		void SetOrientationType(CParticleSystemComponent::OrientationType orientationType);
 		virtual void StartParticle();
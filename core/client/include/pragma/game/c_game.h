@@ -24,6 +24,8 @@
 #include <pragma/input/inkeys.h>
 #include <mathutil/color.h>
 #include <pragma/util/bulletinfo.h>
+#include <pragma/networking/snapshot_codec.hpp>
+#include "pragma/networking/c_snapshot_interpolation.hpp"
 #include <queue>
 #include <wgui/wihandle.h>
 #include <sharedutils/property/util_property.hpp>
@@ -321,6 +323,7 @@ class DLLCLIENT CGame : public Game {
 	uint16_t GetLatency() const;
 	// Returns the number of lost snapshot packets within the last second
 	uint32_t GetLostPacketCount();
+	pragma::networking::SnapshotInterpolationBuffer &GetSnapshotInterpolationBuffer();
 
 	pragma::CCameraComponent *CreateCamera(uint32_t width, uint32_t height, float fov, float nearZ, float farZ);
 	pragma::CCameraComponent *CreateCamera(float aspectRatio, float fov, float nearZ, float farZ);
@@ -468,6 +471,12 @@ class DLLCLIENT CGame : public Game {
 	};
 	MessagePacketTracker m_snapshotTracker;
 	MessagePacketTracker m_userInputTracker;
+	// Entity states of the most recent compressed snapshots, required to decode delta-encoded snapshots
+	pragma::networking::SnapshotHistory m_snapshotHistory;
+	// Snapshot that is acknowledged to the server with the next user input
+	std::optional<uint8_t> m_lastReceivedSnapshotId {};
+	pragma::networking::SnapshotInterpolationBuffer m_snapshotInterpolation {};
+	void UpdateSnapshotInterpolation();
 	std::vector<double> m_lostPackets;
 	void UpdateLostPackets();
 
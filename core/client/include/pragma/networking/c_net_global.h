@@ -43,6 +43,8 @@ DECLARE_NETMESSAGE_CL(ent_setparentmode);
 DECLARE_NETMESSAGE_CL(ent_phys_init);
 DECLARE_NETMESSAGE_CL(ent_phys_destroy);
 DECLARE_NETMESSAGE_CL(ent_event);
+DECLARE_NETMESSAGE_CL(ent_member_updates);
+DECLARE_NETMESSAGE_CL(ent_dormant);
 DECLARE_NETMESSAGE_CL(ent_toggle);
 DECLARE_NETMESSAGE_CL(ent_setcollisionfilter);
 DECLARE_NETMESSAGE_CL(ent_anim_gesture_play);
@@ -58,6 +60,7 @@ DECLARE_NETMESSAGE_CL(gameinfo);
 DECLARE_NETMESSAGE_CL(game_ready);
 
 DECLARE_NETMESSAGE_CL(snapshot);
+DECLARE_NETMESSAGE_CL(msg_bundle);
 
 DECLARE_NETMESSAGE_CL(cvar_set);
 DECLARE_NETMESSAGE_CL(luacmd_reg);
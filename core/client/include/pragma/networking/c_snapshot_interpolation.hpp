@@ -0,0 +1,69 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan
+ */
+
+#ifndef __C_SNAPSHOT_INTERPOLATION_HPP__
+#define __C_SNAPSHOT_INTERPOLATION_HPP__
+
+#include "pragma/clientdefinitions.h"
+#include <mathutil/uvec.h>
+#include <mathutil/uquat.h>
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+class CGame;
+namespace pragma::networking {
+	// Buffers the entity transforms received through snapshots and plays them back with a fixed delay,
+	// so that entities can be interpolated between two known states instead of snapping to each new snapshot.
+	class DLLCLIENT SnapshotInterpolationBuffer {
+	  public:
+		static constexpr uint32_t BUFFER_SIZE = 32;
+		struct DLLCLIENT State {
+			double time = 0.0; // Server time
+			Vector3 position {};
+			Quat rotation = uquat::identity();
+			Vector3 velocity {};
+			Vector3 angularVelocity {};
+		};
+		struct DLLCLIENT Stats {
+			uint64_t numSamples = 0;
+			uint64_t numOutOfOrderSamples = 0;
+			uint64_t numInterpolated = 0;
+			// Render time was ahead of the newest sample, but within the extrapolation limit
+			uint64_t numExtrapolated = 0;
+			// Render time was ahead of the newest sample by more than the extrapolation limit, the buffered states weren't applied
+			uint64_t numUnderruns = 0;
+		};
+
+		void AddState(uint32_t entIdx, const State &state);
+		// Applies the interpolated states for the specified render time (in server time) to all buffered entities
+		void Update(CGame &game, double renderTime, double maxExtrapolation);
+		void RemoveEntity(uint32_t entIdx);
+		// Removes the buffers of all entities that are not in the specified list (i.e. entities that have left the snapshot).
+		// The list will be sorted.
+		void RemoveMissingEntities(std::vector<uint32_t> &entIndices);
+		void Clear();
+
+		const Stats &GetStats() const;
+		void ResetStats();
+		uint32_t GetEntityCount() const;
+	  private:
+		struct EntityBuffer {
+			std::array<State, BUFFER_SIZE> states {};
+			uint32_t head = 0; // Index of the oldest state
+			uint32_t count = 0;
+			const State &Get(uint32_t i) const { return states[(head + i) % states.size()]; }
+			const State &GetNewest() const { return Get(count - 1); }
+			State &GetNewest() { return states[(head + count - 1) % states.size()]; }
+		};
+		bool ComputeState(const EntityBuffer &buf, double renderTime, double maxExtrapolation, State &outState);
+		std::unordered_map<uint32_t, EntityBuffer> m_buffers;
+		Stats m_stats {};
+	};
+};
+
+#endif
@@ -92,7 +92,6 @@ void pragma::nav::CMesh::ShowNavMeshes(bool b)
 		return;
 	m_bShowNavMeshes = b;
 
-	auto &polyMesh = navMesh->GetPolyMesh();
 	std::vector<Vector3> triangleVerts;
 	{
 		const auto fDrawMeshTile = [&triangleVerts](const dtNavMesh &mesh, const dtMeshTile &tile) {
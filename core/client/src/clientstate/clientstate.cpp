@@ -72,7 +72,7 @@ DLLCLIENT ClientState *client = NULL;
 extern CGame *c_game;
 
 std::vector<std::string> &get_required_game_textures();
-ClientState::ClientState() : NetworkState(), m_client(nullptr), m_svInfo(nullptr), m_resDownload(nullptr), m_volMaster(1.f), m_hMainMenu(), m_luaGUI(NULL)
+ClientState::ClientState() : NetworkState(), m_client(nullptr), m_svInfo(nullptr), m_volMaster(1.f), m_hMainMenu(), m_luaGUI(NULL)
 {
 	client = this;
 	m_soundScriptManager = std::make_unique<CSoundScriptManager>();
@@ -437,7 +437,7 @@ bool ClientState::RunConsoleCommand(std::string scmd, std::vector<std::string> &
 	p->Write<unsigned char>(CUChar(argv.size()));
 	for(unsigned char i = 0; i < argv.size(); i++)
 		p->WriteString(argv[i]);
-	SendPacket("cmd_call", p, pragma::networking::Protocol::SlowReliable);
+	SendPacket<"cmd_call">(p, pragma::networking::Protocol::SlowReliable);
 	return true;
 }
 
@@ -451,7 +451,7 @@ ConVar *ClientState::SetConVar(std::string scmd, std::string value, bool bApplyI
 		NetPacket p;
 		p->WriteString(scmd);
 		p->WriteString(cvar->GetString());
-		SendPacket("cvar_set", p, pragma::networking::Protocol::SlowReliable);
+		SendPacket<"cvar_set">(p, pragma::networking::Protocol::SlowReliable);
 	}
 	return cvar;
 }
@@ -637,7 +637,7 @@ void ClientState::SendUserInfo()
 		}
 	}
 	packet->Write<unsigned int>(numUserInfo, &sz);
-	client->SendPacket("clientinfo", packet, pragma::networking::Protocol::SlowReliable);
+	client->SendPacket<"clientinfo">(packet, pragma::networking::Protocol::SlowReliable);
 }
 
 std::string ClientState::GetMessagePrefix() const { return std::string {Con::PREFIX_CLIENT}; }
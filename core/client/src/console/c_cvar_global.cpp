@@ -118,7 +118,7 @@ DLLCLIENT void CMD_setpos(NetworkState *state, pragma::BasePlayerComponent *, st
 	Vector3 pos(atof(argv[0].c_str()), atof(argv[1].c_str()), atof(argv[2].c_str()));
 	NetPacket p;
 	nwm::write_vector(p, pos);
-	cstate->SendPacket("cmd_setpos", p, pragma::networking::Protocol::SlowReliable);
+	cstate->SendPacket<"cmd_setpos">(p, pragma::networking::Protocol::SlowReliable);
 }
 
 DLLCLIENT void CMD_getpos(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &)
@@ -550,7 +550,7 @@ void CMD_debug_ai_schedule_print(NetworkState *state, pragma::BasePlayerComponen
 	Con::cout << "Querying schedule data for NPC " << *npc << "..." << Con::endl;
 	NetPacket p;
 	nwm::write_entity(p, npc);
-	client->SendPacket("debug_ai_schedule_print", p, pragma::networking::Protocol::SlowReliable);
+	client->SendPacket<"debug_ai_schedule_print">(p, pragma::networking::Protocol::SlowReliable);
 }
 
 DLLCLIENT void CMD_reloadmaterial(NetworkState *state, pragma::BasePlayerComponent *, std::vector<std::string> &argv)
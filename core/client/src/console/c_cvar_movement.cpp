@@ -242,28 +242,28 @@ void Console::commands::noclip(NetworkState *state, pragma::BasePlayerComponent
 {
 	CHECK_CHEATS("noclip", state, );
 	ClientState *client = static_cast<ClientState *>(state);
-	client->SendPacket("noclip", pragma::networking::Protocol::SlowReliable);
+	client->SendPacket<"noclip">(pragma::networking::Protocol::SlowReliable);
 }
 
 void Console::commands::notarget(NetworkState *state, pragma::BasePlayerComponent *, std::vector<std::string> &)
 {
 	CHECK_CHEATS("notarget", state, );
 	ClientState *client = static_cast<ClientState *>(state);
-	client->SendPacket("notarget", pragma::networking::Protocol::SlowReliable);
+	client->SendPacket<"notarget">(pragma::networking::Protocol::SlowReliable);
 }
 
 void Console::commands::godmode(NetworkState *state, pragma::BasePlayerComponent *, std::vector<std::string> &)
 {
 	CHECK_CHEATS("godmode", state, );
 	auto *client = static_cast<ClientState *>(state);
-	client->SendPacket("godmode", pragma::networking::Protocol::SlowReliable);
+	client->SendPacket<"godmode">(pragma::networking::Protocol::SlowReliable);
 }
 
 void Console::commands::suicide(NetworkState *state, pragma::BasePlayerComponent *, std::vector<std::string> &)
 {
 	CHECK_CHEATS("suicide", state, );
 	auto *client = static_cast<ClientState *>(state);
-	client->SendPacket("suicide", pragma::networking::Protocol::SlowReliable);
+	client->SendPacket<"suicide">(pragma::networking::Protocol::SlowReliable);
 }
 
 void Console::commands::hurtme(NetworkState *state, pragma::BasePlayerComponent *, std::vector<std::string> &args)
@@ -273,7 +273,7 @@ void Console::commands::hurtme(NetworkState *state, pragma::BasePlayerComponent
 	NetPacket p;
 	p->Write<uint16_t>(static_cast<uint16_t>(dmg));
 	auto *client = static_cast<ClientState *>(state);
-	client->SendPacket("hurtme", p, pragma::networking::Protocol::SlowReliable);
+	client->SendPacket<"hurtme">(p, pragma::networking::Protocol::SlowReliable);
 }
 
 void Console::commands::give_weapon(NetworkState *state, pragma::BasePlayerComponent *, std::vector<std::string> &argv)
@@ -283,7 +283,7 @@ void Console::commands::give_weapon(NetworkState *state, pragma::BasePlayerCompo
 	CHECK_CHEATS("give_weapon", state, );
 	NetPacket p;
 	p->WriteString(argv.front());
-	client->SendPacket("give_weapon", p, pragma::networking::Protocol::SlowReliable);
+	client->SendPacket<"give_weapon">(p, pragma::networking::Protocol::SlowReliable);
 }
 
 void Console::commands::strip_weapons(NetworkState *state, pragma::BasePlayerComponent *, std::vector<std::string> &argv)
@@ -292,19 +292,19 @@ void Console::commands::strip_weapons(NetworkState *state, pragma::BasePlayerCom
 		return;
 	CHECK_CHEATS("strip_weapons", state, );
 	NetPacket p;
-	client->SendPacket("strip_weapons", p, pragma::networking::Protocol::SlowReliable);
+	client->SendPacket<"strip_weapons">(p, pragma::networking::Protocol::SlowReliable);
 }
 
 void Console::commands::next_weapon(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &args)
 {
 	auto *client = static_cast<ClientState *>(state);
-	client->SendPacket("weapon_next", pragma::networking::Protocol::FastUnreliable);
+	client->SendPacket<"weapon_next">(pragma::networking::Protocol::FastUnreliable);
 }
 
 void Console::commands::previous_weapon(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &args)
 {
 	auto *client = static_cast<ClientState *>(state);
-	client->SendPacket("weapon_previous", pragma::networking::Protocol::FastUnreliable);
+	client->SendPacket<"weapon_previous">(pragma::networking::Protocol::FastUnreliable);
 }
 
 void Console::commands::give_ammo(NetworkState *state, pragma::BasePlayerComponent *, std::vector<std::string> &argv)
@@ -316,7 +316,7 @@ void Console::commands::give_ammo(NetworkState *state, pragma::BasePlayerCompone
 	NetPacket p;
 	p->WriteString(argv.front());
 	p->Write<uint32_t>(amount);
-	client->SendPacket("give_ammo", p, pragma::networking::Protocol::SlowReliable);
+	client->SendPacket<"give_ammo">(p, pragma::networking::Protocol::SlowReliable);
 }
 
 const float defaultTurnSpeed = 3.f;
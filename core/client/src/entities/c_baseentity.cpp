@@ -309,7 +309,7 @@ void CBaseEntity::SendNetEventTCP(UInt32 eventId, NetPacket &data) const
 	}
 	nwm::write_entity(data, this);
 	data->Write<UInt32>(eventId);
-	client->SendPacket("ent_event", data, pragma::networking::Protocol::SlowReliable);
+	client->SendPacket<"ent_event">(data, pragma::networking::Protocol::SlowReliable);
 }
 void CBaseEntity::SendNetEventUDP(UInt32 eventId) const
 {
@@ -330,7 +330,7 @@ void CBaseEntity::SendNetEventUDP(UInt32 eventId, NetPacket &data) const
 	}
 	nwm::write_entity(data, this);
 	data->Write<UInt32>(eventId);
-	client->SendPacket("ent_event", data, pragma::networking::Protocol::FastUnreliable);
+	client->SendPacket<"ent_event">(data, pragma::networking::Protocol::FastUnreliable);
 }
 pragma::ComponentHandle<pragma::BaseAnimatedComponent> CBaseEntity::GetAnimatedComponent() const
 {
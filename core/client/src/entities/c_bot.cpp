@@ -46,6 +46,11 @@ util::EventReply CBotComponent::HandleEvent(ComponentEventId eventId, ComponentE
 		OnFootStep(static_cast<CEOnFootStep &>(evData).footType);
 	return util::EventReply::Unhandled;
 }
+void CBotComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseBotComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseCharacterComponent::EVENT_ON_FOOT_STEP);
+}
 void CBotComponent::OnFootStep(BaseCharacterComponent::FootType footType)
 {
 	auto &ent = GetEntity();
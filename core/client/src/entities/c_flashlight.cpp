@@ -62,6 +62,12 @@ util::EventReply CFlashlightComponent::HandleEvent(ComponentEventId eventId, Com
 	}
 	return util::EventReply::Unhandled;
 }
+void CFlashlightComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseFlashlightComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_ON);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_OFF);
+}
 void CFlashlightComponent::InitializeLuaObject(lua_State *l) { return BaseEntityComponent::InitializeLuaObject<std::remove_reference_t<decltype(*this)>>(l); }
 
 void CFlashlight::Initialize()
@@ -27,6 +27,23 @@ void CLuaBaseEntityComponent::ReceiveData(NetPacket &packet)
 	}
 	CallLuaMethod<void, NetPacket>("ReceiveData", packet);
 }
+void CLuaBaseEntityComponent::ReceiveMemberUpdates(NetPacket &packet)
+{
+	if(m_networkedMemberInfo == nullptr)
+		return;
+	auto &members = GetMembers();
+	auto numMembers = m_networkedMemberInfo->networkedMembers.size();
+	std::vector<uint8_t> mask((numMembers + 7) / 8, 0);
+	packet->Read(mask.data(), mask.size());
+	for(auto i = decltype(numMembers) {0u}; i < numMembers; ++i) {
+		if((mask[i / 8] & (1 << (i % 8))) == 0)
+			continue;
+		auto &member = members.at(m_networkedMemberInfo->networkedMembers[i]);
+		std::any value;
+		Lua::ReadAny(packet, detail::member_type_to_util_type(member.type), value);
+		SetMemberValue(member, value);
+	}
+}
 Bool CLuaBaseEntityComponent::ReceiveNetEvent(pragma::NetEventId eventId, NetPacket &packet)
 {
 	if(m_networkedMemberInfo != nullptr && eventId == m_networkedMemberInfo->netEvSetMember) {
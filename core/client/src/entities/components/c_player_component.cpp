@@ -160,6 +160,13 @@ util::EventReply CPlayerComponent::HandleEvent(ComponentEventId eventId, Compone
 		OnSetCharacterOrientation(static_cast<const CEOnSetCharacterOrientation &>(evData).up);
 	return util::EventReply::Unhandled;
 }
+void CPlayerComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BasePlayerComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseCharacterComponent::EVENT_ON_DEPLOY_WEAPON);
+	outEventIds.push_back(BaseCharacterComponent::EVENT_ON_SET_ACTIVE_WEAPON);
+	outEventIds.push_back(BaseCharacterComponent::EVENT_ON_CHARACTER_ORIENTATION_CHANGED);
+}
 
 void CPlayerComponent::OnSetUpDirection(const Vector3 &direction)
 {
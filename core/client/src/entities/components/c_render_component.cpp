@@ -155,6 +155,11 @@ util::EventReply CRenderComponent::HandleEvent(ComponentEventId eventId, Compone
 	}
 	return BaseRenderComponent::HandleEvent(eventId, evData);
 }
+void CRenderComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseRenderComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseChildComponent::EVENT_ON_PARENT_CHANGED);
+}
 void CRenderComponent::SetDepthPassEnabled(bool enabled) { umath::set_flag(m_stateFlags, StateFlags::EnableDepthPass, enabled); }
 bool CRenderComponent::IsDepthPassEnabled() const { return umath::is_flag_set(m_stateFlags, StateFlags::EnableDepthPass); }
 void CRenderComponent::SetRenderClipPlane(const Vector4 &plane)
@@ -730,7 +735,7 @@ const util::PEnumProperty<pragma::rendering::SceneRenderPass> &CRenderComponent:
 pragma::rendering::SceneRenderPass CRenderComponent::GetSceneRenderPass() const { return *m_renderPass; }
 void CRenderComponent::SetHidden(bool hidden)
 {
-	if(hidden == IsHidden())
+	if(hidden == umath::is_flag_set(m_stateFlags, StateFlags::Hidden))
 		return;
 	umath::set_flag(m_stateFlags, StateFlags::Hidden, hidden);
 	PropagateHiddenState();
@@ -739,9 +744,18 @@ void CRenderComponent::SetHidden(bool hidden)
 bool CRenderComponent::IsHidden() const
 {
 	if(ShouldIgnoreAncestorVisibility())
-		return umath::is_flag_set(m_stateFlags, StateFlags::Hidden);
-	return umath::is_flag_set(m_stateFlags, StateFlags::Hidden | StateFlags::AncestorHidden);
+		return umath::is_flag_set(m_stateFlags, StateFlags::Hidden | StateFlags::Dormant);
+	return umath::is_flag_set(m_stateFlags, StateFlags::Hidden | StateFlags::AncestorHidden | StateFlags::Dormant);
+}
+void CRenderComponent::SetDormant(bool dormant)
+{
+	if(dormant == IsDormant())
+		return;
+	umath::set_flag(m_stateFlags, StateFlags::Dormant, dormant);
+	PropagateHiddenState();
+	UpdateVisibility();
 }
+bool CRenderComponent::IsDormant() const { return umath::is_flag_set(m_stateFlags, StateFlags::Dormant); }
 bool CRenderComponent::IsVisible() const { return !IsHidden() && *m_renderPass != pragma::rendering::SceneRenderPass::None; }
 void CRenderComponent::SetIgnoreAncestorVisibility(bool ignoreVisibility)
 {
@@ -106,6 +106,11 @@ util::EventReply CBaseSoundDspComponent::HandleEvent(ComponentEventId eventId, C
 		DetachAllSoundSources();
 	return util::EventReply::Unhandled;
 }
+void CBaseSoundDspComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEnvSoundDspComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_OFF);
+}
 ALSoundType CBaseSoundDspComponent::GetTargetSoundTypes() const
 {
 	auto types = ALSoundType::Generic;
@@ -94,6 +94,12 @@ util::EventReply CCameraComponent::HandleEvent(ComponentEventId eventId, Compone
 		UpdateState();
 	return util::EventReply::Unhandled;
 }
+void CCameraComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEnvCameraComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_ON);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_OFF);
+}
 void CCameraComponent::InitializeLuaObject(lua_State *l) { return BaseEntityComponent::InitializeLuaObject<std::remove_reference_t<decltype(*this)>>(l); }
 
 /////////
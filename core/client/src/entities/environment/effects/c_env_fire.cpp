@@ -36,6 +36,12 @@ util::EventReply CFireComponent::HandleEvent(ComponentEventId eventId, Component
 		DestroyParticle();
 	return util::EventReply::Unhandled;
 }
+void CFireComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEnvFireComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_ON);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_OFF);
+}
 void CFireComponent::InitializeParticle()
 {
 	auto &ent = GetEntity();
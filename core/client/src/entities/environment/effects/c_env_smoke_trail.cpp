@@ -52,6 +52,12 @@ util::EventReply CSmokeTrailComponent::HandleEvent(ComponentEventId eventId, Com
 		DestroyParticle();
 	return util::EventReply::Unhandled;
 }
+void CSmokeTrailComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEnvSmokeTrailComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_ON);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_OFF);
+}
 
 void CSmokeTrailComponent::InitializeParticle()
 {
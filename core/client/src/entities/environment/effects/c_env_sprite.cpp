@@ -67,6 +67,12 @@ util::EventReply CSpriteComponent::HandleEvent(ComponentEventId eventId, Compone
 		StopParticle();
 	return util::EventReply::Unhandled;
 }
+void CSpriteComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEnvSpriteComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_ON);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_OFF);
+}
 
 void CSpriteComponent::StopParticle()
 {
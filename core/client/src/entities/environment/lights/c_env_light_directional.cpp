@@ -195,6 +195,11 @@ util::EventReply CLightDirectionalComponent::HandleEvent(ComponentEventId eventI
 		UpdateAmbientColor();
 	return util::EventReply::Unhandled;
 }
+void CLightDirectionalComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEnvLightDirectionalComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_ON);
+}
 
 void CLightDirectionalComponent::SetAmbientColor(const Color &color)
 {
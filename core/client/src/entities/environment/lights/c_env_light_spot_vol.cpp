@@ -201,6 +201,12 @@ util::EventReply CLightSpotVolComponent::HandleEvent(ComponentEventId eventId, C
 	}
 	return util::EventReply::Unhandled;
 }
+void CLightSpotVolComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEnvLightSpotVolComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_ON);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_OFF);
+}
 
 #include "pragma/lua/classes/c_lmaterial.h"
 void CLightSpotVolComponent::InitializeVolumetricLight()
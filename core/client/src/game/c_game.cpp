@@ -715,7 +715,7 @@ void CGame::RequestResource(const std::string &fileName)
 	m_requestedResources.push_back(fName);
 	NetPacket p;
 	p->WriteString(fName);
-	client->SendPacket("query_resource", p, pragma::networking::Protocol::SlowReliable);
+	client->SendPacket<"query_resource">(p, pragma::networking::Protocol::SlowReliable);
 	Con::ccl << "[CGame] Request sent!" << Con::endl;
 }
 
@@ -997,6 +997,7 @@ void CGame::Think()
 
 	double tDelta = m_stateNetwork->DeltaTime();
 	m_tServer += DeltaTime();
+	UpdateSnapshotInterpolation();
 	if(m_gameComponent.valid())
 		m_gameComponent->UpdateFrame(cam);
 	CallCallbacks<void>("Think");
@@ -1373,7 +1374,10 @@ void CGame::SendUserInput()
 			p->Write<float>(magnitude);
 		}
 	}
-	client->SendPacket("userinput", p, pragma::networking::Protocol::FastUnreliable);
+	p->Write<bool>(m_lastReceivedSnapshotId.has_value());
+	if(m_lastReceivedSnapshotId.has_value())
+		p->Write<uint8_t>(*m_lastReceivedSnapshotId);
+	client->SendPacket<"userinput">(p, pragma::networking::Protocol::FastUnreliable);
 }
 
 double &CGame::ServerTime() { return m_tServer; }
@@ -1394,7 +1398,28 @@ uint32_t CGame::GetLostPacketCount()
 	return static_cast<uint32_t>(m_lostPackets.size());
 }
 
+pragma::networking::SnapshotInterpolationBuffer &CGame::GetSnapshotInterpolationBuffer() { return m_snapshotInterpolation; }
+
+static CVar cvInterp = GetClientConVar("cl_interp");
+static CVar cvInterpMaxExtrapolation = GetClientConVar("cl_interp_max_extrapolation");
+void CGame::UpdateSnapshotInterpolation()
+{
+	auto interpDelay = cvInterp->GetFloat();
+	if(interpDelay <= 0.f) {
+		m_snapshotInterpolation.Clear();
+		return;
+	}
+	m_snapshotInterpolation.Update(*this, m_tServer - interpDelay, umath::max(cvInterpMaxExtrapolation->GetFloat(), 0.f));
+}
+
 #include <pragma/physics/controller.hpp>
+static bool is_physically_simulated(CBaseEntity &ent)
+{
+	// Entities with dynamic physics objects are corrected through the physics data of the snapshot instead
+	auto *pPhysComponent = ent.GetPhysicsComponent();
+	auto *physObj = pPhysComponent ? pPhysComponent->GetPhysicsObject() : nullptr;
+	return physObj != nullptr && physObj->IsStatic() == false;
+}
 void CGame::ReceiveSnapshot(NetPacket &packet)
 {
 	//Con::ccl<<"Received snapshot.."<<Con::endl;
@@ -1413,17 +1438,89 @@ void CGame::ReceiveSnapshot(NetPacket &packet)
 		return; // Old snapshot; Just skip it (We're already received a newer snapshot, this one's out of order)
 	m_snapshotTracker.CheckMessages(snapshotId, m_lostPackets, t);
 
+	auto encoding = packet->Read<pragma::networking::SnapshotEncoding>();
+	pragma::networking::SnapshotQuantizationSettings quantizationSettings {};
+	const pragma::networking::SnapshotStateTable *baselineStates = nullptr;
+	std::shared_ptr<pragma::networking::SnapshotStateTable> receivedStates = nullptr;
+	auto decodedAllStates = true;
+	if(encoding == pragma::networking::SnapshotEncoding::Quantized) {
+		quantizationSettings.Read(packet);
+		if(packet->Read<bool>()) {
+			auto baselineId = packet->Read<uint8_t>();
+			baselineStates = m_snapshotHistory.Find(baselineId, quantizationSettings);
+		}
+		receivedStates = std::make_shared<pragma::networking::SnapshotStateTable>();
+	}
+	auto readPhysObjState = [encoding, &quantizationSettings, &packet](Vector3 &pos, Quat &rot, Vector3 &vel, Vector3 &angVel) {
+		if(encoding == pragma::networking::SnapshotEncoding::Raw) {
+			pos = packet->Read<Vector3>();
+			rot = packet->Read<Quat>();
+			vel = packet->Read<Vector3>();
+			angVel = packet->Read<Vector3>();
+			return;
+		}
+		pos = pragma::networking::snapshot::read_quantized_vector(packet, quantizationSettings.positionPrecision);
+		rot = pragma::networking::snapshot::read_quantized_rotation(packet, quantizationSettings.rotationBits);
+		vel = pragma::networking::snapshot::read_quantized_vector(packet, quantizationSettings.velocityPrecision);
+		angVel = pragma::networking::snapshot::read_quantized_vector(packet, quantizationSettings.angularVelocityPrecision);
+	};
+
 	//std::cout<<"Received snapshot with "<<(m_tServer -tOld)<<" time difference to last snapshot"<<std::endl;
 	const auto maxCorrectionDistance = umath::pow2(10.f);
+	auto useInterpolation = (cvInterp->GetFloat() > 0.f);
+	auto *plLocal = GetLocalPlayer();
+	auto *entLocal = plLocal ? &plLocal->GetEntity() : nullptr;
 	unsigned int numEnts = packet->Read<unsigned int>();
+	// Entities whose states are buffered for interpolation; Buffers of all other entities are outdated
+	std::vector<uint32_t> interpolatedEntities;
+	if(useInterpolation)
+		interpolatedEntities.reserve(numEnts);
 	for(unsigned int i = 0; i < numEnts; i++) {
-		CBaseEntity *ent = static_cast<CBaseEntity *>(nwm::read_entity(packet));
-		Vector3 pos = nwm::read_vector(packet);
-		Vector3 vel = nwm::read_vector(packet);
-		Vector3 angVel = nwm::read_vector(packet);
-		auto orientation = nwm::read_quat(packet);
+		CBaseEntity *ent = nullptr;
+		Vector3 pos {};
+		Vector3 vel {};
+		Vector3 angVel {};
+		auto orientation = uquat::identity();
+		auto hasTransform = true;
+		if(encoding == pragma::networking::SnapshotEncoding::Raw) {
+			ent = static_cast<CBaseEntity *>(nwm::read_entity(packet));
+			pos = nwm::read_vector(packet);
+			vel = nwm::read_vector(packet);
+			angVel = nwm::read_vector(packet);
+			orientation = nwm::read_quat(packet);
+		}
+		else {
+			auto entIdx = static_cast<uint32_t>(pragma::networking::snapshot::read_varint(packet));
+			ent = static_cast<CBaseEntity *>(GetEntity(entIdx));
+			const pragma::networking::QuantizedEntityState *baseline = nullptr;
+			if(baselineStates) {
+				auto itBaseline = baselineStates->find(entIdx);
+				if(itBaseline != baselineStates->end())
+					baseline = &itBaseline->second;
+			}
+			auto state = pragma::networking::snapshot::read_entity_state(packet, baseline, quantizationSettings);
+			if(state.has_value()) {
+				receivedStates->insert(std::make_pair(entIdx, *state));
+				pos = state->GetPosition(quantizationSettings);
+				vel = state->GetVelocity(quantizationSettings);
+				angVel = state->GetAngularVelocity(quantizationSettings);
+				orientation = state->GetRotation(quantizationSettings);
+			}
+			else {
+				// Delta-encoded against a snapshot we don't know about; We'll have to wait for a new baseline
+				hasTransform = false;
+				decodedAllStates = false;
+			}
+		}
 		auto entDataSize = packet->Read<UInt8>();
-		if(ent != NULL) {
+		if(ent != NULL && hasTransform && useInterpolation && ent != entLocal && is_physically_simulated(*ent) == false) {
+			// Transform will be applied with a delay by the interpolation buffer
+			m_snapshotInterpolation.AddState(ent->GetIndex(), {m_tServer, pos, orientation, vel, angVel});
+			interpolatedEntities.push_back(ent->GetIndex());
+		}
+		else if(ent != NULL && !hasTransform && useInterpolation)
+			interpolatedEntities.push_back(ent->GetIndex()); // Keep the buffered states until we've received a new baseline
+		else if(ent != NULL && hasTransform) {
 			pos += vel * tDelta;
 			if(uvec::length_sqr(angVel) > 0.0)
 				orientation = uquat::create(EulerAngles(umath::rad_to_deg(angVel.x), umath::rad_to_deg(angVel.y), umath::rad_to_deg(angVel.z)) * tDelta) * orientation; // TODO: Check if this is correct
@@ -1458,65 +1555,61 @@ void CGame::ReceiveSnapshot(NetPacket &packet)
 			}
 			if(pTrComponent != nullptr)
 				pTrComponent->SetRotation(orientation);
-			ent->ReceiveSnapshotData(packet);
 		}
+		if(ent != NULL)
+			ent->ReceiveSnapshotData(packet);
 		else
 			packet->SetOffset(packet->GetOffset() + entDataSize);
 
 		auto flags = packet->Read<pragma::SnapshotFlags>();
 		if((flags & pragma::SnapshotFlags::PhysicsData) != pragma::SnapshotFlags::None) {
 			auto numObjs = packet->Read<uint8_t>();
-			if(ent != NULL) {
-				auto pPhysComponent = ent->GetPhysicsComponent();
-				PhysObj *physObj = pPhysComponent != nullptr ? pPhysComponent->GetPhysicsObject() : nullptr;
-				if(physObj != NULL && !physObj->IsStatic()) {
-					auto colObjs = physObj->GetCollisionObjects();
-					auto numActualObjs = colObjs.size();
-					for(auto i = decltype(numObjs) {0}; i < numObjs; ++i) {
-						auto pos = packet->Read<Vector3>();
-						auto rot = packet->Read<Quat>();
-						auto vel = packet->Read<Vector3>();
-						auto angVel = packet->Read<Vector3>();
-						if(physObj->IsController()) {
-							auto *physController = static_cast<ControllerPhysObj *>(physObj);
-							//physController->SetPosition(pos);
-							physController->SetOrientation(rot);
-							physController->SetLinearVelocity(vel);
-							physController->SetAngularVelocity(angVel);
-						}
-						else if(i < numActualObjs) {
-							auto &hObj = colObjs[i];
-							if(hObj.IsValid()) {
-								pos += vel * tDelta;
-								auto l = uvec::length_sqr(angVel);
-								if(l > 0.0)
-									rot = uquat::create(EulerAngles(umath::rad_to_deg(angVel.x), umath::rad_to_deg(angVel.y), umath::rad_to_deg(angVel.z)) * tDelta) * rot; // TODO: Check if this is correct
-								auto *o = hObj.Get();
-								o->SetRotation(rot);
-								if(o->IsRigid()) {
-									auto *rigid = o->GetRigidBody();
-
-									//auto correctionVel = pos -rigid->GetPos();
-									//auto l = uvec::length_sqr(correctionVel);
-									//if(l > maxCorrectionDistance)
-									rigid->SetPos(pos); // Too far away, just snap into position
-									//else
-									//	rigid->SetLinearCorrectionVelocity(pos -ent->GetPosition());
-
-									rigid->SetLinearVelocity(vel);
-									rigid->SetAngularVelocity(angVel);
-								}
-								else
-									o->SetPos(pos);
-							}
+			auto pPhysComponent = (ent != NULL) ? ent->GetPhysicsComponent() : nullptr;
+			PhysObj *physObj = pPhysComponent != nullptr ? pPhysComponent->GetPhysicsObject() : nullptr;
+			if(physObj != NULL && physObj->IsStatic())
+				physObj = nullptr;
+			auto *colObjs = (physObj != NULL) ? &physObj->GetCollisionObjects() : nullptr;
+			for(auto i = decltype(numObjs) {0}; i < numObjs; ++i) {
+				// Always read the state, since compressed physics data has a variable size and can't be skipped
+				Vector3 pos, vel, angVel;
+				Quat rot;
+				readPhysObjState(pos, rot, vel, angVel);
+				if(physObj == NULL)
+					continue;
+				if(physObj->IsController()) {
+					auto *physController = static_cast<ControllerPhysObj *>(physObj);
+					//physController->SetPosition(pos);
+					physController->SetOrientation(rot);
+					physController->SetLinearVelocity(vel);
+					physController->SetAngularVelocity(angVel);
+				}
+				else if(i < colObjs->size()) {
+					auto &hObj = (*colObjs)[i];
+					if(hObj.IsValid()) {
+						pos += vel * tDelta;
+						auto l = uvec::length_sqr(angVel);
+						if(l > 0.0)
+							rot = uquat::create(EulerAngles(umath::rad_to_deg(angVel.x), umath::rad_to_deg(angVel.y), umath::rad_to_deg(angVel.z)) * tDelta) * rot; // TODO: Check if this is correct
+						auto *o = hObj.Get();
+						o->SetRotation(rot);
+						if(o->IsRigid()) {
+							auto *rigid = o->GetRigidBody();
+
+							//auto correctionVel = pos -rigid->GetPos();
+							//auto l = uvec::length_sqr(correctionVel);
+							//if(l > maxCorrectionDistance)
+							rigid->SetPos(pos); // Too far away, just snap into position
+							//else
+							//	rigid->SetLinearCorrectionVelocity(pos -ent->GetPosition());
+
+							rigid->SetLinearVelocity(vel);
+							rigid->SetAngularVelocity(angVel);
 						}
+						else
+							o->SetPos(pos);
 					}
 				}
-				else
-					packet->SetOffset(packet->GetOffset() + numObjs * (sizeof(Vector3) * 3 + sizeof(Quat)));
 			}
-			else
-				packet->SetOffset(packet->GetOffset() + numObjs * (sizeof(Vector3) * 3 + sizeof(Quat)));
 		}
 
 		if((flags & pragma::SnapshotFlags::ComponentData) != pragma::SnapshotFlags::None) {
@@ -1545,6 +1638,9 @@ void CGame::ReceiveSnapshot(NetPacket &packet)
 		}
 	}
 
+	if(useInterpolation)
+		m_snapshotInterpolation.RemoveMissingEntities(interpolatedEntities);
+
 	unsigned char numPlayers = packet->Read<unsigned char>();
 	for(int i = 0; i < numPlayers; i++) {
 		auto *plComponent = nwm::read_player(packet);
@@ -1572,6 +1668,12 @@ void CGame::ReceiveSnapshot(NetPacket &packet)
 			charComponent->SetViewOrientation(orientation);
 		}
 	}
+
+	if(encoding == pragma::networking::SnapshotEncoding::Quantized)
+		m_snapshotHistory.Store(snapshotId, quantizationSettings, receivedStates);
+	// If we couldn't decode all entity states, we don't acknowledge the snapshot, which forces the server to eventually send a full update
+	if(decodedAllStates)
+		m_lastReceivedSnapshotId = snapshotId;
 }
 
 static void set_action_input(Action action, bool b, bool bKeepMagnitude, const float *inMagnitude = nullptr)
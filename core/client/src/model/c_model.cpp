@@ -25,7 +25,7 @@ void CModel::OnMaterialMissing(const std::string &matName)
 	NetPacket p {};
 	p->WriteString(GetName());
 	p->WriteString(matName);
-	client->SendPacket("query_model_texture", p, pragma::networking::Protocol::FastUnreliable);
+	client->SendPacket<"query_model_texture">(p, pragma::networking::Protocol::FastUnreliable);
 }
 
 void CModel::PrecacheTexture(uint32_t texId, bool bReload) { Model::PrecacheTexture(texId, bReload); }
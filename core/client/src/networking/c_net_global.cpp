@@ -20,6 +20,7 @@
 #include "pragma/entities/components/c_generic_component.hpp"
 #include "pragma/entities/components/c_transform_component.hpp"
 #include "pragma/entities/components/c_io_component.hpp"
+#include "pragma/entities/components/c_lua_component.hpp"
 #include "pragma/entities/environment/c_env_camera.h"
 #include "pragma/entities/environment/lights/c_env_light.h"
 #include "pragma/entities/environment/lights/c_env_light_spot.h"
@@ -464,6 +465,48 @@ void NET_cl_ent_event(NetPacket packet)
 	ent->ReceiveNetEvent(localId, packet);
 }
 
+void NET_cl_ent_member_updates(NetPacket packet)
+{
+	if(!client->IsGameActive())
+		return;
+	auto *ent = static_cast<CBaseEntity *>(nwm::read_entity(packet));
+	if(ent == nullptr)
+		return;
+	auto &componentManager = static_cast<pragma::CEntityComponentManager &>(c_game->GetEntityComponentManager());
+	auto &svComponentToClComponentTable = componentManager.GetServerComponentIdToClientComponentIdTable();
+	auto numComponents = packet->Read<uint8_t>();
+	for(auto i = decltype(numComponents) {0}; i < numComponents; ++i) {
+		auto svId = packet->Read<pragma::ComponentId>();
+		auto componentSize = packet->Read<uint32_t>();
+		auto componentEndOffset = packet->GetOffset() + componentSize;
+		if(svId < svComponentToClComponentTable.size() && svComponentToClComponentTable.at(svId) != pragma::CEntityComponentManager::INVALID_COMPONENT) {
+			auto pComponent = ent->FindComponent(svComponentToClComponentTable.at(svId));
+			auto *pLuaComponent = pComponent.valid() ? dynamic_cast<pragma::CLuaBaseEntityComponent *>(pComponent.get()) : nullptr;
+			if(pLuaComponent != nullptr)
+				pLuaComponent->ReceiveMemberUpdates(packet);
+		}
+		packet->SetOffset(componentEndOffset);
+	}
+}
+
+void NET_cl_ent_dormant(NetPacket packet)
+{
+	if(!client->IsGameActive())
+		return;
+	auto numEntities = packet->Read<uint32_t>();
+	for(auto i = decltype(numEntities) {0}; i < numEntities; ++i) {
+		auto *ent = static_cast<CBaseEntity *>(nwm::read_entity(packet));
+		auto dormant = packet->Read<bool>();
+		if(ent == nullptr)
+			continue;
+		// Buffered states are outdated either way
+		c_game->GetSnapshotInterpolationBuffer().RemoveEntity(ent->GetIndex());
+		auto *pRenderComponent = ent->GetRenderComponent();
+		if(pRenderComponent)
+			pRenderComponent->SetDormant(dormant);
+	}
+}
+
 DLLCLIENT void NET_cl_ent_movetype(NetPacket packet)
 {
 	if(!client->IsGameActive())
@@ -596,6 +639,8 @@ DLLCLIENT void NET_cl_snapshot(NetPacket packet)
 	game->ReceiveSnapshot(packet);
 }
 
+DLLCLIENT void NET_cl_msg_bundle(NetPacket packet) { client->HandleMessageBundle(packet); }
+
 DLLCLIENT void NET_cl_cvar_set(NetPacket packet)
 {
 	std::string cvar = packet->ReadString();
@@ -1175,7 +1220,7 @@ void CMD_debug_ai_schedule(NetworkState *state, pragma::BasePlayerComponent *pl,
 	Con::cout << "Querying schedule data for NPC " << *npc << "..." << Con::endl;
 	NetPacket p;
 	nwm::write_entity(p, npc);
-	client->SendPacket("debug_ai_schedule_tree", p, pragma::networking::Protocol::SlowReliable);
+	client->SendPacket<"debug_ai_schedule_tree">(p, pragma::networking::Protocol::SlowReliable);
 }
 
 void CMD_debug_draw_line(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv)
@@ -1614,5 +1659,5 @@ REGISTER_CONVAR_CALLBACK_CL(debug_ai_navigation, [](NetworkState *state, const C
 		s_aiNavDebugObjects.clear();
 	NetPacket p {};
 	p->Write<bool>(val);
-	client->SendPacket("debug_ai_navigation", p, pragma::networking::Protocol::SlowReliable);
+	client->SendPacket<"debug_ai_navigation">(p, pragma::networking::Protocol::SlowReliable);
 });
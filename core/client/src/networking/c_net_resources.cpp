@@ -19,6 +19,8 @@
 #include <sharedutils/scope_guard.h>
 #include <sharedutils/util_library.hpp>
 #include <pragma/game/game_resources.h>
+#include <pragma/networking/resource_transfer.hpp>
+#include <udm.hpp>
 
 #define RESOURCE_TRANSFER_VERBOSE 0
 
@@ -30,16 +32,20 @@ void ClientState::StartResourceTransfer()
 		m_client->SetTimeoutDuration(0.0); // Disable timeout until resource transfer has been completed
 	NetPacket resourceReq;
 	resourceReq->Write<bool>(GetConVarBool("cl_allowdownload"));
-	SendPacket("resource_begin", resourceReq, pragma::networking::Protocol::SlowReliable);
+	SendPacket<"resource_begin">(resourceReq, pragma::networking::Protocol::SlowReliable);
 }
 
 void ClientState::HandleClientResource(NetPacket &packet)
 {
+	auto transferId = packet->Read<uint32_t>();
 	std::string file = packet->ReadString();
+	auto size = packet->Read<UInt64>();
+	auto hash = packet->ReadString();
+	NetPacket response;
+	response->Write<uint32_t>(transferId);
 	if(!IsValidResource(file)) {
-		NetPacket response;
 		response->Write<bool>(false);
-		SendPacket("resourceinfo_response", response, pragma::networking::Protocol::SlowReliable);
+		SendPacket<"resourceinfo_response">(response, pragma::networking::Protocol::SlowReliable);
 		return;
 	}
 	auto bDefaultPath = true;
@@ -55,64 +61,89 @@ void ClientState::HandleClientResource(NetPacket &packet)
 		fileDst = "downloads\\" + fileDst; // Files are placed into 'downloads' directory by default (Which is automatically mounted)
 
 	FileManager::CreatePath(fileDst.substr(0, fileDst.find_last_of('\\')).c_str());
-	auto size = packet->Read<UInt64>();
-	Con::ccl << "Downloading file '" << file << "' (" << util::get_pretty_bytes(size) << ")..." << Con::endl;
 	auto f = FileManager::OpenFile(file.c_str(), "rb"); //,fsys::SearchFlags::Local);
-	NetPacket response;
-	bool bSkip = false;
-	if(f != NULL) {
-		if(f->GetSize() == size) {
-			bSkip = true;
-			Con::ccl << "File '" << file << "' doesn't differ from server's. Skipping..." << Con::endl;
-			f.reset();
-			response->Write<bool>(false);
-		}
-		else
-			f = nullptr;
+	if(f != NULL && f->GetSize() == size && pragma::networking::resource_transfer::compute_file_hash(*f) == hash) {
+		Con::ccl << "File '" << file << "' doesn't differ from server's. Skipping..." << Con::endl;
+		response->Write<bool>(false);
+		SendPacket<"resourceinfo_response">(response, pragma::networking::Protocol::SlowReliable);
+		return;
 	}
-	if(bSkip == false)
-		f = FileManager::OpenFile((fileDst + ".part").c_str(), "wb");
-	if(!bSkip) {
-		if(f == NULL) {
-			response->Write<bool>(false);
-			Con::cwar << Con::PREFIX_CLIENT << "[ResourceManager] Unable to write file '" << fileDst << "'. Skipping..." << Con::endl;
-		}
-		else {
-			response->Write<bool>(true);
-			m_resDownload = std::make_unique<ResourceDownload>(std::static_pointer_cast<VFilePtrInternalReal>(f), fileDst, CUInt32(size));
-		}
+	f = nullptr;
+
+	// If a previous download of the same file was interrupted, we can continue where it left off, as long as the
+	// file on the server hasn't changed in the meantime
+	auto partFileName = fileDst + ".part";
+	auto hashFileName = partFileName + pragma::networking::resource_transfer::PARTIAL_HASH_FILE_EXTENSION;
+	uint64_t resumeOffset = 0;
+	auto fHash = FileManager::OpenFile(hashFileName.c_str(), "r");
+	if(fHash != nullptr) {
+		auto partHash = fHash->ReadString();
+		fHash = nullptr;
+		auto partSize = FileManager::GetFileSize(partFileName);
+		if(partHash == hash && partSize <= size)
+			resumeOffset = partSize;
+	}
+	if(resumeOffset > 0) {
+		Con::ccl << "Resuming download of file '" << file << "' (" << util::get_pretty_bytes(resumeOffset) << " / " << util::get_pretty_bytes(size) << ")..." << Con::endl;
+		f = FileManager::OpenFile<VFilePtrReal>(partFileName.c_str(), "ab");
+	}
+	else {
+		Con::ccl << "Downloading file '" << file << "' (" << util::get_pretty_bytes(size) << ")..." << Con::endl;
+		auto fHashOut = FileManager::OpenFile<VFilePtrReal>(hashFileName.c_str(), "w");
+		if(fHashOut != nullptr)
+			fHashOut->WriteString(hash);
+		f = FileManager::OpenFile<VFilePtrReal>(partFileName.c_str(), "wb");
+	}
+	if(f == NULL) {
+		response->Write<bool>(false);
+		Con::cwar << Con::PREFIX_CLIENT << "[ResourceManager] Unable to write file '" << fileDst << "'. Skipping..." << Con::endl;
 	}
-	SendPacket("resourceinfo_response", response, pragma::networking::Protocol::SlowReliable);
+	else {
+		response->Write<bool>(true);
+		response->Write<uint64_t>(resumeOffset);
+		m_resDownloads[transferId] = std::make_unique<ResourceDownload>(std::static_pointer_cast<VFilePtrInternalReal>(f), fileDst, size, resumeOffset);
+	}
+	SendPacket<"resourceinfo_response">(response, pragma::networking::Protocol::SlowReliable);
 }
 
 void ClientState::HandleClientResourceFragment(NetPacket &packet)
 {
-	if(m_resDownload == NULL)
+	auto transferId = packet->Read<uint32_t>();
+	auto offset = packet->Read<uint64_t>();
+	auto it = m_resDownloads.find(transferId);
+	if(it == m_resDownloads.end())
 		return;
-	std::array<uint8_t, RESOURCE_TRANSFER_FRAGMENT_SIZE> buf;
-	unsigned int read = packet->Read<unsigned int>();
-	packet->Read(buf.data(), read);
-	auto &res = m_resDownload;
-	auto f = res->file;
-	f->Write(buf.data(), read);
-	NetPacket resourceReq;
+	auto &res = it->second;
+	std::vector<uint8_t> data;
+	if(pragma::networking::resource_transfer::read_chunk(packet, data) == false || offset != res->offset) {
+		Con::cwar << Con::PREFIX_CLIENT << "[ResourceManager] Received invalid chunk for file '" << res->name << "'! Aborting download..." << Con::endl;
+		m_resDownloads.erase(it);
+		// The server will retry the transfer, which resumes from the data that has been written to the partial file so far
+		NetPacket resourceAbort;
+		resourceAbort->Write<uint32_t>(transferId);
+		SendPacket<"resource_abort">(resourceAbort, pragma::networking::Protocol::SlowReliable);
+		return;
+	}
+	res->file->Write(data.data(), data.size());
+	res->offset += data.size();
+
+	// Acknowledge the chunk, so the server can send the next one
+	NetPacket resourceAck;
+	resourceAck->Write<uint32_t>(transferId);
+	SendPacket<"resource_request">(resourceAck, pragma::networking::Protocol::SlowReliable);
 #if RESOURCE_TRANSFER_VERBOSE == 1
-	Con::ccl << "[ResourceManager] " << ((f->Tell() / float(res->size)) * 100) << "%" << Con::endl;
+	Con::ccl << "[ResourceManager] " << res->name << ": " << ((res->offset / static_cast<double>(res->size)) * 100) << "%" << Con::endl;
 #endif
-	if(read < RESOURCE_TRANSFER_FRAGMENT_SIZE) {
-		auto resName = res->name;
-		res = nullptr;
-		f = nullptr;
-		resourceReq->Write<bool>(true);
-
-		if((FileManager::Exists(resName.c_str()) == true && FileManager::RemoveFile(resName.c_str()) == false) || FileManager::RenameFile((resName + ".part").c_str(), resName.c_str()) == false)
-			Con::ccl << "File '" << (resName + ".part") << "' successfully received, but unable to rename to '" << resName << "'... Requesting next..." << Con::endl;
-		else
-			Con::ccl << "File '" << resName << "' successfully received... Requesting next..." << Con::endl;
-	}
+	if(res->offset < res->size && data.empty() == false)
+		return;
+	auto resName = res->name;
+	m_resDownloads.erase(it);
+	auto partFileName = resName + ".part";
+	FileManager::RemoveFile((partFileName + pragma::networking::resource_transfer::PARTIAL_HASH_FILE_EXTENSION).c_str());
+	if((FileManager::Exists(resName.c_str()) == true && FileManager::RemoveFile(resName.c_str()) == false) || FileManager::RenameFile(partFileName.c_str(), resName.c_str()) == false)
+		Con::ccl << "File '" << partFileName << "' successfully received, but unable to rename to '" << resName << "'..." << Con::endl;
 	else
-		resourceReq->Write<bool>(false);
-	SendPacket("resource_request", resourceReq, pragma::networking::Protocol::SlowReliable);
+		Con::ccl << "File '" << resName << "' successfully received..." << Con::endl;
 }
 
 ////////////////////
@@ -323,7 +354,25 @@ void ModelLoadManager::Update()
 		static auto *ptrBuildMesh = dllHandle->FindSymbolAddress<void (*)(const std::vector<Vector3> &, std::vector<Vector3> &, std::vector<uint32_t> &)>("pcl_build_convex_mesh");
 
 		auto &mdl = query->model;
-		auto &packet = query->packet;
+		// The mesh data is LZ4-compressed by the server
+		auto uncompressedSize = query->packet->Read<uint64_t>();
+		auto compressedSize = query->packet->Read<uint64_t>();
+		// The uncompressed size determines the size of the allocation, so it can't be trusted blindly
+		if(compressedSize > query->packet->GetDataSize() - query->packet->GetOffset() || uncompressedSize == 0 || uncompressedSize > pragma::networking::resource_transfer::MAX_ROUGH_MODEL_SIZE
+		  || uncompressedSize > compressedSize * pragma::networking::resource_transfer::MAX_LZ4_COMPRESSION_RATIO) {
+			Con::cwar << "Received invalid rough model data for model '" << query->fileName << "'!" << Con::endl;
+			continue;
+		}
+		std::vector<uint8_t> compressedData(compressedSize);
+		query->packet->Read(compressedData.data(), compressedSize);
+		auto blob = ::udm::decompress_lz4_blob(compressedData.data(), compressedData.size(), uncompressedSize);
+		if(blob.data.size() != uncompressedSize) {
+			Con::cwar << "Unable to decompress rough model data for model '" << query->fileName << "'!" << Con::endl;
+			continue;
+		}
+		NetPacket packet;
+		packet->Write(blob.data.data(), blob.data.size());
+		packet->SetOffset(0);
 
 		auto group = mdl->AddMeshGroup("reference");
 		auto mesh = std::make_shared<CModelMesh>();
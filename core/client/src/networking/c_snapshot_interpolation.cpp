@@ -0,0 +1,144 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan
+ */
+
+#include "stdafx_client.h"
+#include "pragma/networking/c_snapshot_interpolation.hpp"
+#include "pragma/game/c_game.h"
+#include "pragma/entities/c_baseentity.h"
+#include <pragma/entities/components/base_transform_component.hpp>
+#include <pragma/entities/components/velocity_component.hpp>
+#include <pragma/entities/entity_component_system_t.hpp>
+#include <algorithm>
+
+void pragma::networking::SnapshotInterpolationBuffer::AddState(uint32_t entIdx, const State &state)
+{
+	auto &buf = m_buffers[entIdx];
+	++m_stats.numSamples;
+	if(buf.count > 0) {
+		auto &newest = buf.GetNewest();
+		if(state.time < newest.time) {
+			++m_stats.numOutOfOrderSamples;
+			return;
+		}
+		if(state.time == newest.time) {
+			// Same snapshot time, just update the newest sample
+			newest = state;
+			return;
+		}
+	}
+	if(buf.count == buf.states.size()) {
+		// Buffer is full, drop the oldest state
+		buf.head = (buf.head + 1) % buf.states.size();
+		--buf.count;
+	}
+	buf.states[(buf.head + buf.count) % buf.states.size()] = state;
+	++buf.count;
+}
+
+bool pragma::networking::SnapshotInterpolationBuffer::ComputeState(const EntityBuffer &buf, double renderTime, double maxExtrapolation, State &outState)
+{
+	if(buf.count == 0)
+		return false;
+	auto &oldest = buf.Get(0);
+	if(renderTime <= oldest.time) {
+		outState = oldest;
+		return true;
+	}
+	auto &newest = buf.GetNewest();
+	if(renderTime > newest.time) {
+		// No newer sample available yet; Extrapolate from the newest one, but only up to a limit
+		auto dt = renderTime - newest.time;
+		if(dt > maxExtrapolation) {
+			// The buffered states are outdated, don't override the entity's transform (e.g. teleports or local simulation) with them
+			++m_stats.numUnderruns;
+			return false;
+		}
+		++m_stats.numExtrapolated;
+		auto t = static_cast<float>(dt);
+		outState = newest;
+		outState.position += newest.velocity * t;
+		if(uvec::length_sqr(newest.angularVelocity) > 0.f)
+			outState.rotation = uquat::create(EulerAngles(umath::rad_to_deg(newest.angularVelocity.x), umath::rad_to_deg(newest.angularVelocity.y), umath::rad_to_deg(newest.angularVelocity.z)) * t) * newest.rotation;
+		return true;
+	}
+	for(auto i = decltype(buf.count) {1u}; i < buf.count; ++i) {
+		auto &b = buf.Get(i);
+		if(b.time < renderTime)
+			continue;
+		auto &a = buf.Get(i - 1);
+		auto f = static_cast<float>((renderTime - a.time) / (b.time - a.time));
+		outState.time = renderTime;
+		outState.position = uvec::lerp(a.position, b.position, f);
+		outState.rotation = uquat::slerp(a.rotation, b.rotation, f);
+		outState.velocity = uvec::lerp(a.velocity, b.velocity, f);
+		outState.angularVelocity = uvec::lerp(a.angularVelocity, b.angularVelocity, f);
+		++m_stats.numInterpolated;
+		return true;
+	}
+	return false;
+}
+
+void pragma::networking::SnapshotInterpolationBuffer::Update(CGame &game, double renderTime, double maxExtrapolation)
+{
+	for(auto it = m_buffers.begin(); it != m_buffers.end();) {
+		auto *ent = game.GetEntity(it->first);
+		if(ent == nullptr) {
+			it = m_buffers.erase(it);
+			continue;
+		}
+		State state;
+		if(ComputeState(it->second, renderTime, maxExtrapolation, state)) {
+			auto *trC = ent->GetTransformComponent();
+			if(trC) {
+				trC->SetPosition(state.position);
+				trC->SetRotation(state.rotation);
+			}
+			auto velC = ent->GetComponent<pragma::VelocityComponent>();
+			if(velC.valid()) {
+				velC->SetVelocity(state.velocity);
+				velC->SetAngularVelocity(state.angularVelocity);
+			}
+		}
+		++it;
+	}
+}
+
+void pragma::networking::SnapshotInterpolationBuffer::RemoveEntity(uint32_t entIdx) { m_buffers.erase(entIdx); }
+void pragma::networking::SnapshotInterpolationBuffer::RemoveMissingEntities(std::vector<uint32_t> &entIndices)
+{
+	std::sort(entIndices.begin(), entIndices.end());
+	for(auto it = m_buffers.begin(); it != m_buffers.end();) {
+		if(std::binary_search(entIndices.begin(), entIndices.end(), it->first) == false)
+			it = m_buffers.erase(it);
+		else
+			++it;
+	}
+}
+void pragma::networking::SnapshotInterpolationBuffer::Clear() { m_buffers.clear(); }
+const pragma::networking::SnapshotInterpolationBuffer::Stats &pragma::networking::SnapshotInterpolationBuffer::GetStats() const { return m_stats; }
+void pragma::networking::SnapshotInterpolationBuffer::ResetStats() { m_stats = {}; }
+uint32_t pragma::networking::SnapshotInterpolationBuffer::GetEntityCount() const { return m_buffers.size(); }
+
+extern DLLCLIENT CGame *c_game;
+void CMD_cl_interp_stats(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv)
+{
+	if(c_game == nullptr) {
+		Con::cwar << "No game is active!" << Con::endl;
+		return;
+	}
+	auto &interpBuffer = c_game->GetSnapshotInterpolationBuffer();
+	if(!argv.empty() && argv.front() == "reset") {
+		interpBuffer.ResetStats();
+		return;
+	}
+	auto &stats = interpBuffer.GetStats();
+	Con::cout << "Buffered entities: " << interpBuffer.GetEntityCount() << Con::endl;
+	Con::cout << "Samples received: " << stats.numSamples << " (" << stats.numOutOfOrderSamples << " out of order)" << Con::endl;
+	Con::cout << "Interpolated: " << stats.numInterpolated << Con::endl;
+	Con::cout << "Extrapolated: " << stats.numExtrapolated << Con::endl;
+	Con::cout << "Underruns: " << stats.numUnderruns << Con::endl;
+}
@@ -74,7 +74,7 @@ DLLCLIENT void CMD_cl_rcon(NetworkState *, pragma::BasePlayerComponent *, std::v
 	NetPacket p;
 	p->WriteString(pass);
 	p->WriteString(argv[0]);
-	client->SendPacket("rcon", p, pragma::networking::Protocol::SlowReliable);
+	client->SendPacket<"rcon">(p, pragma::networking::Protocol::SlowReliable);
 }
 
 DLLCLIENT void CMD_connect(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv)
@@ -154,7 +154,7 @@ DLLCLIENT void CMD_cl_send(NetworkState *, pragma::BasePlayerComponent *, std::v
 		return;
 	NetPacket packet;
 	packet->WriteString(argv[0]);
-	client->SendPacket("cl_send", packet, pragma::networking::Protocol::SlowReliable);
+	client->SendPacket<"cl_send">(packet, pragma::networking::Protocol::SlowReliable);
 }
 
 DLLCLIENT void CMD_cl_send_udp(NetworkState *, pragma::BasePlayerComponent *, std::vector<std::string> &argv)
@@ -163,7 +163,7 @@ DLLCLIENT void CMD_cl_send_udp(NetworkState *, pragma::BasePlayerComponent *, st
 		return;
 	NetPacket packet;
 	packet->WriteString(argv[0]);
-	client->SendPacket("cl_send", packet, pragma::networking::Protocol::FastUnreliable);
+	client->SendPacket<"cl_send">(packet, pragma::networking::Protocol::FastUnreliable);
 }
 
 void CMD_cl_debug_netmessages(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv)
@@ -190,3 +190,21 @@ void CMD_cl_debug_netmessages(NetworkState *state, pragma::BasePlayerComponent *
 	cl->DebugPrint(*clMsgs, *svMsgs);
 	cl->DebugDump("cl_netmessages.dump", *clMsgs, *svMsgs);
 }
+
+void CMD_cl_net_message_stats(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv)
+{
+	if(argv.empty() == false && argv.front() == "reset") {
+		client->ResetMessageStats();
+		Con::cout << "Net-message statistics have been reset." << Con::endl;
+		return;
+	}
+	std::unordered_map<std::string, uint32_t> *svMsgs;
+	GetServerMessageMap()->GetNetMessages(&svMsgs);
+	std::unordered_map<std::string, uint32_t> *clMsgs;
+	GetClientMessageMap()->GetNetMessages(&clMsgs);
+
+	Con::cout << "Sent net-messages:" << Con::endl;
+	client->GetSentMessageStats().Print(*svMsgs);
+	Con::cout << Con::endl << "Received net-messages:" << Con::endl;
+	client->GetReceivedMessageStats().Print(*clMsgs);
+}
@@ -37,10 +37,30 @@ void ClientState::HandlePacket(NetPacket &packet)
 		Con::cwar << "(CLIENT) Unhandled net message: " << ID << Con::endl;
 		return;
 	}
+	m_receivedMessageStats.Add(ID, packet->GetSize());
 	// packet->SetClient(true); // WVTODO
 	msg->handler(packet);
 }
 
+void ClientState::HandleMessageBundle(NetPacket &packet)
+{
+	constexpr auto entryHeaderSize = sizeof(uint32_t) + sizeof(uint16_t);
+	while(packet->GetDataSize() - packet->GetOffset() >= entryHeaderSize) {
+		auto messageId = packet->Read<uint32_t>();
+		auto size = packet->Read<uint16_t>();
+		if(size > packet->GetDataSize() - packet->GetOffset()) {
+			Con::cwar << "(CLIENT) Received malformed message bundle!" << Con::endl;
+			return;
+		}
+		NetPacket msg {};
+		msg->Write(packet->GetData() + packet->GetOffset(), size);
+		msg->SetOffset(0);
+		msg.SetMessageID(messageId);
+		packet->SetOffset(packet->GetOffset() + size);
+		HandlePacket(msg);
+	}
+}
+
 void ClientState::HandleConnect() { RequestServerInfo(); }
 
 void ClientState::RequestServerInfo()
@@ -48,7 +68,7 @@ void ClientState::RequestServerInfo()
 	Con::ccl << "Sending serverinfo request..." << Con::endl;
 	NetPacket packet;
 	packet->WriteString(GetConVarString("password"));
-	SendPacket("serverinfo_request", packet, pragma::networking::Protocol::SlowReliable);
+	SendPacket<"serverinfo_request">(packet, pragma::networking::Protocol::SlowReliable);
 }
 
 void ClientState::HandleClientReceiveServerInfo(NetPacket &packet)
@@ -95,7 +115,7 @@ void ClientState::HandleClientReceiveServerInfo(NetPacket &packet)
 		outAuthPacket->Write<uint16_t>(token.size());
 		outAuthPacket->Write(reinterpret_cast<uint8_t *>(token.data()), token.size() * sizeof(token.front()));
 	}
-	SendPacket("authenticate", outAuthPacket, pragma::networking::Protocol::SlowReliable);
+	SendPacket<"authenticate">(outAuthPacket, pragma::networking::Protocol::SlowReliable);
 }
 
 void ClientState::HandleClientStartResourceTransfer(NetPacket &packet)
@@ -319,6 +339,6 @@ void ClientState::SetGameReady()
 {
 	if(!m_game)
 		return;
-	SendPacket("game_ready", pragma::networking::Protocol::SlowReliable);
+	SendPacket<"game_ready">(pragma::networking::Protocol::SlowReliable);
 	m_game->OnGameReady();
 }
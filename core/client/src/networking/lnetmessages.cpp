@@ -50,10 +50,10 @@ void Lua::net::client::send(nwm::Protocol protocol, const std::string &identifie
 	}
 	switch(protocol) {
 	case nwm::Protocol::TCP:
-		::client->SendPacket("luanet", packetNew, pragma::networking::Protocol::SlowReliable);
+		::client->SendPacket<"luanet">(packetNew, pragma::networking::Protocol::SlowReliable);
 		break;
 	case nwm::Protocol::UDP:
-		::client->SendPacket("luanet", packetNew, pragma::networking::Protocol::FastUnreliable);
+		::client->SendPacket<"luanet">(packetNew, pragma::networking::Protocol::FastUnreliable);
 		break;
 	}
 }
@@ -14,19 +14,30 @@
 #include <pragma/networking/nwm_util.h>
 
 extern DLLNETWORK Engine *engine;
-void ClientState::SendPacket(const std::string &name, NetPacket &packet, pragma::networking::Protocol protocol)
+void ClientState::SendPacket(uint32_t messageId, const char *name, NetPacket &packet, pragma::networking::Protocol protocol)
 {
-	auto ID = GetServerMessageID(name);
-	if(ID == 0 || m_client == nullptr)
+	if(messageId == 0 || m_client == nullptr)
 		return;
-	packet.SetMessageID(ID);
+	packet.SetMessageID(messageId);
 	pragma::networking::Error err;
-	if(m_client->SendPacket(protocol, packet, err) == false)
+	if(m_client->SendPacket(protocol, packet, err) == false) {
 		Con::cwar << "Unable to send packet '" << name << "': " << err.GetMessage() << Con::endl;
+		return;
+	}
+	m_sentMessageStats.Add(messageId, packet->GetSize());
 }
+void ClientState::SendPacket(const std::string &name, NetPacket &packet, pragma::networking::Protocol protocol) { SendPacket(GetServerMessageID(name), name.c_str(), packet, protocol); }
 void ClientState::SendPacket(const std::string &name, NetPacket &packet) { SendPacket(name, packet, pragma::networking::Protocol::FastUnreliable); }
 void ClientState::SendPacket(const std::string &name, pragma::networking::Protocol protocol)
 {
 	NetPacket packet {};
 	SendPacket(name, packet, protocol);
 }
+
+const pragma::networking::NetMessageStatsTable &ClientState::GetSentMessageStats() const { return m_sentMessageStats; }
+const pragma::networking::NetMessageStatsTable &ClientState::GetReceivedMessageStats() const { return m_receivedMessageStats; }
+void ClientState::ResetMessageStats()
+{
+	m_sentMessageStats.Reset();
+	m_receivedMessageStats.Reset();
+}
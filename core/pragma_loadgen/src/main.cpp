@@ -0,0 +1,53 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan
+ */
+
+#include "pragma/pragma_executable.hpp"
+#include <cstring>
+
+// Launches a dedicated server and connects headless in-process clients to it once the map has been loaded (see sv_loadgen).
+// Usage: pragma_loadgen +map <map> -clients <numClients> [-join_interval <seconds>] [-input_rate <messagesPerSecond>]
+int main(int argc, char *argv[])
+try {
+	std::string numClients = "8";
+	std::string joinInterval = "0.1";
+	std::string inputRate = "30";
+	std::vector<char *> engineArgv;
+	engineArgv.reserve(argc);
+	for(auto i = decltype(argc) {0}; i < argc; ++i) {
+		auto *arg = argv[i];
+		if(i + 1 < argc) {
+			if(strcmp(arg, "-clients") == 0) {
+				numClients = argv[++i];
+				continue;
+			}
+			if(strcmp(arg, "-join_interval") == 0) {
+				joinInterval = argv[++i];
+				continue;
+			}
+			if(strcmp(arg, "-input_rate") == 0) {
+				inputRate = argv[++i];
+				continue;
+			}
+		}
+		engineArgv.push_back(arg);
+	}
+
+	// Launch commands are executed in order, so the load generator is started after the map from the command line
+	std::vector<std::string> extraArgs {"-log_file", "log_loadgen.txt", "-console_subsystem", "+sv_loadgen " + numClients + " " + joinInterval + " " + inputRate};
+	auto cargs = pragma::merge_arguments(engineArgv.size(), engineArgv.data(), extraArgs);
+	auto hModule = pragma::launch_pragma(cargs.size(), cargs.data(), true);
+	return hModule ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+catch(...) {
+	// Note: Calling std::current_exception in a std::set_terminate handler will return NULL due to a bug in the VS libraries.
+	// Catching all unhandled exceptions here and then calling the handler works around that issue.
+	std::get_terminate()();
+}
+
+#ifdef _WIN32
+int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) { return main(__argc, __argv); }
+#endif
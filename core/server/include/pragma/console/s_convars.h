@@ -40,8 +40,39 @@ REGISTER_SHARED_CONVAR(sv_tickrate, udm::Type::Float, STRING(ENGINE_DEFAULT_TICK
   "Specifies the tickrate. A higher tickrate means smoother and more reliable physics, but also more data to transmit to clients. Higher values can result in more lag for clients.");
 REGISTER_SHARED_CONVAR(sv_acceleration, udm::Type::Float, "33", ConVarFlags::Archive | ConVarFlags::Replicated, "Player acceleration. If this is too low, the player will be unable to reach full movement speed due to friction forces.");
 REGISTER_SHARED_CONVAR(sv_acceleration_ramp_up_time, udm::Type::Float, "0", ConVarFlags::Archive | ConVarFlags::Replicated, "The time it takes to reach full acceleration.");
+REGISTER_SHARED_CONVAR(sv_nav_query_worker_count, udm::Type::UInt32, "2", ConVarFlags::Archive, "Number of worker threads used for navigation path queries. Changes are applied when the navigation mesh is reloaded.");
+REGISTER_SHARED_CONVAR(sv_nav_query_extents, udm::Type::Vector3, "256 256 256", ConVarFlags::Archive, "Search extents for the nearest navigation mesh polygons to the start and goal positions of a path query.");
+REGISTER_SHARED_CONVAR(sv_nav_query_max_path_length, udm::Type::UInt32, "128", ConVarFlags::Archive, "Maximum number of navigation mesh polygons in a path.");
+REGISTER_SHARED_CONVAR(sv_nav_query_max_nodes, udm::Type::UInt32, "2048", ConVarFlags::Archive, "Maximum number of search nodes per navigation path query.");
 
 REGISTER_CONVAR_SV(sv_allowdownload, udm::Type::Boolean, "1", ConVarFlags::Archive, "Specifies whether clients are allowed to download resources from the server.");
 REGISTER_CONVAR_SV(sv_allowupload, udm::Type::Boolean, "1", ConVarFlags::Archive, "Specifies whether clients are allowed to upload resources to the server (e.g. spraylogos).");
+REGISTER_CONVAR_SV(sv_resource_transfer_chunk_size, udm::Type::UInt32, "16384", ConVarFlags::Archive, "Size of a single chunk of a file that is being sent to a client (1 KiB - 256 KiB).");
+REGISTER_CONVAR_SV(sv_resource_transfer_window, udm::Type::UInt32, "32", ConVarFlags::Archive, "Maximum number of file chunks per client that can be in flight before the client has to acknowledge them.");
+REGISTER_CONVAR_SV(sv_resource_transfer_max_files, udm::Type::UInt32, "4", ConVarFlags::Archive, "Maximum number of files that are transferred to a client at the same time.");
+REGISTER_CONVAR_SV(sv_resource_transfer_compression, udm::Type::Boolean, "1", ConVarFlags::Archive, "If enabled, file chunks will be LZ4-compressed before they're sent to the client.");
+REGISTER_CONVAR_SV(sv_snapshot_compression, udm::Type::Boolean, "1", ConVarFlags::Archive, "If enabled, entity transforms in snapshots will be quantized and delta-encoded against the last snapshot acknowledged by the client.");
+REGISTER_CONVAR_SV(sv_snapshot_position_precision, udm::Type::Float, "0.015625", ConVarFlags::Archive, "Quantization step for entity positions in compressed snapshots.");
+REGISTER_CONVAR_SV(sv_snapshot_velocity_precision, udm::Type::Float, "0.0625", ConVarFlags::Archive, "Quantization step for entity velocities in compressed snapshots.");
+REGISTER_CONVAR_SV(sv_snapshot_angular_velocity_precision, udm::Type::Float, "0.001953125", ConVarFlags::Archive, "Quantization step for entity angular velocities in compressed snapshots.");
+REGISTER_CONVAR_SV(sv_snapshot_rotation_bits, udm::Type::UInt8, "12", ConVarFlags::Archive, "Number of bits per quaternion component in compressed snapshots (4-20).");
+REGISTER_CONVAR_SV(sv_coalesce_member_updates, udm::Type::Boolean, "1", ConVarFlags::Archive,
+  "If enabled, changes to networked entity component members will be collected during the tick and transmitted in a single packet per entity at the end of the tick. Members with a high transmit priority are always transmitted immediately.");
+REGISTER_CONVAR_SV(sv_hibernate, udm::Type::UInt8, "1", ConVarFlags::Archive,
+  "Specifies what a dedicated server does while no clients are connected. 0 = Nothing; 1 = Reduce the tick rate to sv_hibernate_tickrate; 2 = Reduce the tick rate and suspend the simulation. Only persistent timers will keep running.");
+REGISTER_CONVAR_SV(sv_hibernate_tickrate, udm::Type::UInt32, "5", ConVarFlags::Archive, "The tick rate of a hibernating server.");
+REGISTER_CONVAR_SV(sv_hibernate_delay, udm::Type::Float, "30", ConVarFlags::Archive, "Amount of time (in seconds) after the last client has disconnected until the server starts hibernating.");
+REGISTER_CONVAR_SV(sv_interest_management, udm::Type::Boolean, "1", ConVarFlags::Archive,
+  "If enabled, entities are only included in a player's snapshots while they're relevant to that player (i.e. close enough and potentially visible). Entities that aren't relevant become dormant on the client.");
+REGISTER_CONVAR_SV(sv_interest_radius, udm::Type::Float, "8192", ConVarFlags::Archive, "Default distance from a player beyond which entities are no longer relevant to that player.");
+REGISTER_CONVAR_SV(sv_interest_pvs, udm::Type::Boolean, "1", ConVarFlags::Archive, "If enabled, entities that are in a BSP cluster that is not visible from the player's cluster are not relevant to that player. Only has an effect on maps with a BSP tree.");
+REGISTER_CONVAR_SV(sv_interest_max_update_interval, udm::Type::Float, "0.25", ConVarFlags::Archive,
+  "Maximum amount of time (in seconds) between snapshot updates for distant relevant entities. Entities with a high transmit priority are always updated every snapshot.");
+REGISTER_CONVAR_SV(sv_member_update_low_priority_delay, udm::Type::Float, "0.25", ConVarFlags::Archive, "Maximum amount of time (in seconds) by which changes to low-priority networked members may be delayed.");
+REGISTER_CONVAR_SV(sv_net_scheduler, udm::Type::Boolean, "1", ConVarFlags::Archive,
+  "If enabled, unreliable messages are queued per client and sent in order of their priority within the client's bandwidth budget (cl_rate). Small messages are aggregated into a single datagram.");
+REGISTER_CONVAR_SV(sv_minrate, udm::Type::UInt32, "16384", ConVarFlags::Archive, "Minimum bandwidth budget (in bytes per second) per client, regardless of the client's cl_rate.");
+REGISTER_CONVAR_SV(sv_maxrate, udm::Type::UInt32, "0", ConVarFlags::Archive, "Maximum bandwidth budget (in bytes per second) per client. 0 = Unlimited.");
+REGISTER_CONVAR_SV(sv_net_scheduler_max_delay, udm::Type::Float, "0.2", ConVarFlags::Archive, "Maximum amount of time (in seconds) an unreliable message may be deferred due to the bandwidth budget before it is dropped.");
 #endif
 #endif
@@ -46,6 +46,24 @@ REGISTER_CONCOMMAND_SV(heartbeat, CMD_heartbeat, ConVarFlags::None, "Instantly s
 DLLSERVER void CMD_sv_debug_netmessages(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv);
 REGISTER_CONCOMMAND_SV(sv_debug_netmessages, CMD_sv_debug_netmessages, ConVarFlags::None, "Prints out debug information about recent net-messages.");
 
+DLLSERVER void CMD_sv_net_message_stats(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv);
+REGISTER_CONCOMMAND_SV(sv_net_message_stats, CMD_sv_net_message_stats, ConVarFlags::None, "Prints the number of packets and bytes that have been sent and received per net-message. Usage: sv_net_message_stats <reset>");
+
+DLLSERVER void CMD_sv_record_traffic(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv);
+REGISTER_CONCOMMAND_SV(sv_record_traffic, CMD_sv_record_traffic, ConVarFlags::None, "Records all packets that are sent to and received from clients to a file. Stops the current recording if no file is specified. Usage: sv_record_traffic <fileName>");
+
+DLLSERVER void CMD_sv_replay_traffic(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv);
+REGISTER_CONCOMMAND_SV(sv_replay_traffic, CMD_sv_replay_traffic, ConVarFlags::None,
+  "Replays a traffic recording with fake clients and prints a report about the throughput and timing once complete. A time scale of 0 replays all packets at once. Stops the current replay if no file is specified. Usage: sv_replay_traffic <fileName> <timeScale>");
+
+DLLSERVER void CMD_sv_loadgen(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv);
+REGISTER_CONCOMMAND_SV(sv_loadgen, CMD_sv_loadgen, ConVarFlags::None,
+  "Connects the specified number of headless in-process clients to the server, which send randomized input once they have joined. Stops the load generator and prints a report about the server tick time, join latency and bandwidth per client if no arguments are specified. Usage: sv_loadgen <numClients> <joinInterval> <inputRate>");
+
+DLLSERVER void CMD_sv_net_scheduler_stats(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv);
+REGISTER_CONCOMMAND_SV(sv_net_scheduler_stats, CMD_sv_net_scheduler_stats, ConVarFlags::None,
+  "Prints the bandwidth budget, queue depth and the number of sent, deferred and dropped unreliable messages per client. Usage: sv_net_scheduler_stats <reset>");
+
 REGISTER_CONVAR_SV(sv_port_tcp, udm::Type::String, "29150", ConVarFlags::Archive, "TCP port which will be used when starting a server.");
 REGISTER_CONVAR_SV(sv_port_udp, udm::Type::String, "29150", ConVarFlags::Archive, "UDP port which will be used when starting a server.");
 REGISTER_CONVAR_SV(sv_use_p2p_if_available, udm::Type::Boolean, "1", ConVarFlags::Archive, "Use a peer-to-peer connection if the selected networking layer supports it.");
@@ -34,6 +34,7 @@ enum class DISPOSITION : uint32_t;
 enum class NPCSTATE : int;
 class AISquad;
 struct DebugBehaviorTreeNode;
+class TraceData;
 namespace pragma {
 	class SCharacterComponent;
 	class BaseActorComponent;
@@ -130,6 +131,7 @@ namespace pragma {
 		SAIComponent(BaseEntity &ent);
 		virtual ~SAIComponent() override;
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 		const ai::Memory::Fragment *GetPrimaryTarget() const;
 		float GetMaxViewDistance() const;
 		void SetMaxViewDistance(float dist);
@@ -170,6 +172,8 @@ namespace pragma {
 		// Returns the number of occupied memory fragments
 		uint32_t GetMemoryFragmentCount() const;
 		bool IsInViewCone(BaseEntity *ent, float *dist = nullptr);
+		// Batched variant of IsInViewCone; The line of sight checks for all entities are issued as a single ray cast batch
+		void IsInViewCone(const std::vector<BaseEntity *> &ents, std::vector<bool> &outVisible, std::vector<float> &outDistances);
 		float GetMemoryDuration();
 		void SetMemoryDuration(float dur);
 		bool CanSee() const;
@@ -296,6 +300,8 @@ namespace pragma {
 		void UpdateMemory();
 		void SelectEnemies();
 		void Listen(std::vector<TargetInfo> &targets);
+		// Returns false if the entity is outside of the view cone or view distance, otherwise outData is set up for the line of sight check
+		bool GetViewConeTraceData(BaseEntity &ent, TraceData &outData, float &outDist) const;
 		void SelectPrimaryTarget();
 		void OnPrePhysicsSimulate();
 		virtual void InitializeLuaObject(lua_State *l) override;
@@ -25,6 +25,8 @@ namespace pragma {
 	  public:
 		virtual void SendSnapshotData(NetPacket &packet, pragma::BasePlayerComponent &pl) = 0;
 		virtual bool ShouldTransmitSnapshotData() const = 0;
+		// If false, the snapshot data is serialized once per snapshot and shared between all players
+		virtual bool IsSnapshotDataPlayerSpecific() const { return false; }
 	};
 
 	/////////////////////////////
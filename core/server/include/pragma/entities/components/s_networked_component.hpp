@@ -12,14 +12,45 @@
 #include <pragma/entities/components/base_networked_component.hpp>
 
 namespace pragma {
+	class SPlayerComponent;
+	struct DLLSERVER CECheckRelevance : public ComponentEvent {
+		CECheckRelevance(pragma::SPlayerComponent &player, bool relevant);
+		virtual void PushArguments(lua_State *l) override;
+		virtual uint32_t GetReturnCount() override;
+		virtual void HandleReturnValues(lua_State *l) override;
+		pragma::SPlayerComponent &player;
+		bool relevant;
+	};
 	class DLLSERVER SNetworkedComponent final : public BaseNetworkedComponent, public SBaseNetComponent {
 	  public:
+		// Determines whether the entity is included in the interest set of a player (see networking::InterestManager)
+		enum class Relevance : uint8_t {
+			Default = 0, // Relevant if the entity is within the relevance radius and potentially visible to the player
+			Always,
+			Never
+		};
+		// Relevant entities with a lower priority receive snapshot updates less frequently the further away they are from the player
+		enum class TransmitPriority : uint8_t { Low = 0, Normal, High };
+		static ComponentEventId EVENT_CHECK_RELEVANCE;
+		static void RegisterEvents(pragma::EntityComponentManager &componentManager, TRegisterComponentEvent registerEvent);
+
 		SNetworkedComponent(BaseEntity &ent) : BaseNetworkedComponent(ent) {}
 		virtual void SendData(NetPacket &packet, networking::ClientRecipientFilter &rp) override;
 		virtual void SetNetworkFlags(NetworkFlags flags) override;
 		virtual bool ShouldTransmitNetData() const override { return true; }
 		virtual void InitializeLuaObject(lua_State *l) override;
+
+		void SetRelevance(Relevance relevance);
+		Relevance GetRelevance() const;
+		// A negative radius means sv_interest_radius is used
+		void SetRelevanceRadius(float radius);
+		float GetRelevanceRadius() const;
+		void SetTransmitPriority(TransmitPriority priority);
+		TransmitPriority GetTransmitPriority() const;
 	  protected:
+		Relevance m_relevance = Relevance::Default;
+		float m_relevanceRadius = -1.f;
+		TransmitPriority m_transmitPriority = TransmitPriority::Normal;
 #if NETWORKED_VARS_ENABLED != 0
 		template<class TProperty>
 		void add_networked_variable_callback(NetworkedVariable::Id id, util::BaseProperty &prop);
@@ -25,6 +25,7 @@ namespace pragma {
 		static unsigned int GetPlayerCount();
 		static const std::vector<SPlayerComponent *> &GetAll();
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 		// Same as SetViewOrientation, but doesn't transmit anything to the client
 		void UpdateViewOrientation(const Quat &rot);
 		void Kick(const std::string &reason);
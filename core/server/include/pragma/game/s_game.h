@@ -15,6 +15,7 @@
 #include <optional>
 #include <mathutil/color.h>
 #include <sharedutils/datastream.h>
+#include <pragma/networking/snapshot_codec.hpp>
 #ifdef __linux__
 #include "pragma/cacheinfo.h"
 #endif
@@ -23,12 +24,14 @@ struct CacheInfo;
 class SBaseEntity;
 namespace pragma {
 	class SPlayerComponent;
+	class SLuaBaseEntityComponent;
 	namespace ai {
 		class TaskManager;
 	};
 	namespace networking {
 		class IServerClient;
 		class ClientRecipientFilter;
+		class InterestManager;
 	};
 };
 namespace udm {
@@ -52,6 +55,29 @@ class DLLSERVER SGame : public Game {
 	std::unordered_map<std::string, udm::PProperty> m_preTransitionWorldState {};
 	// Delta landmark offset between this level and the previous level (in case there was a level change)
 	Vector3 m_deltaTransitionLandmarkOffset {};
+	// Quantized entity states of the current snapshot (shared between all players); Only used if snapshot compression is enabled.
+	// States are created on demand, since the players' snapshots may include entities that haven't changed this tick.
+	std::unique_ptr<pragma::networking::SnapshotStateTable> m_snapshotStates = nullptr;
+	pragma::networking::SnapshotQuantizationSettings m_snapshotQuantizationSettings {};
+	void InitializeSnapshotStates();
+	const pragma::networking::QuantizedEntityState &GetSnapshotState(SBaseEntity &ent);
+	std::unique_ptr<pragma::networking::InterestManager> m_interestManager;
+	// Entities that are included in the snapshot that is currently being written
+	std::vector<SBaseEntity *> m_snapshotEntities;
+	// Snapshot data (physics state and component data) of each entity is only written once per snapshot and then copied into the
+	// snapshot packets of all players that require it. Entities with player-specific snapshot data have an empty entry and are written per player.
+	struct SnapshotDataBlock {
+		size_t offset = 0;
+		size_t size = 0;
+	};
+	NetPacket m_snapshotDataBuffer {};
+	std::unordered_map<uint32_t, std::optional<SnapshotDataBlock>> m_snapshotDataBlocks;
+	void WriteEntitySnapshotData(NetPacket &packet, SBaseEntity &ent, pragma::SPlayerComponent &pl, pragma::networking::SnapshotEncoding encoding);
+	const SnapshotDataBlock *GetSnapshotDataBlock(SBaseEntity &ent, pragma::SPlayerComponent &pl, pragma::networking::SnapshotEncoding encoding);
+	// Lua components with networked member changes that haven't been transmitted yet, grouped by entity index
+	std::unordered_map<uint32_t, std::vector<pragma::ComponentHandle<pragma::SLuaBaseEntityComponent>>> m_pendingMemberUpdates;
+	void FlushNetworkedMemberUpdates();
+	void SendNetworkedMemberUpdates(SBaseEntity &ent, std::span<const pragma::ComponentHandle<pragma::SLuaBaseEntityComponent>> components, bool includeLowPriority);
   protected:
 	template<class T>
 	void GetPlayers(std::vector<T *> *ents);
@@ -72,6 +98,7 @@ class DLLSERVER SGame : public Game {
 	virtual void RegisterLuaEntityComponents(luabind::module_ &gameMod) override;
 	virtual void RegisterLuaEntityComponent(luabind::class_<pragma::BaseEntityComponent> &classDef) override;
 	virtual bool InitializeGameMode() override;
+	virtual void InitializeWorldData(pragma::asset::WorldData &worldData) override;
 
 	const pragma::NetEventManager &GetEntityNetEventManager() const;
 	pragma::NetEventManager &GetEntityNetEventManager();
@@ -104,6 +131,10 @@ class DLLSERVER SGame : public Game {
 	virtual void RegisterLuaClasses() override;
 	void SendSnapshot();
 	void SendSnapshot(pragma::SPlayerComponent *pl);
+	void QueueNetworkedMemberUpdate(pragma::SLuaBaseEntityComponent &component);
+	// Sends the pending member updates of the entity right away, so they arrive before the net events the entity is about to send.
+	// Members that are rate-limited by their transmit interval remain pending.
+	void FlushNetworkedMemberUpdates(SBaseEntity &ent);
 	virtual std::shared_ptr<ModelMesh> CreateModelMesh() const override;
 	virtual std::shared_ptr<ModelSubMesh> CreateModelSubMesh() const override;
 	virtual void GetRegisteredEntities(std::vector<std::string> &classes, std::vector<std::string> &luaClasses) const override;
@@ -172,6 +203,7 @@ class DLLSERVER SGame : public Game {
 	virtual Float GetRestitutionScale() const override;
 
 	pragma::ai::TaskManager &GetAITaskManager() const;
+	pragma::networking::InterestManager &GetInterestManager();
 
 	virtual bool IsPhysicsSimulationEnabled() const override;
 
@@ -21,6 +21,8 @@ namespace Lua {
 			DLLSERVER int load_map(lua_State *l);
 			DLLSERVER void change_level(const std::string &mapName, const std::string &landmarkName);
 			DLLSERVER void change_level(const std::string &mapName);
+			DLLSERVER bool is_hibernating();
+			DLLSERVER void set_hibernation_inhibited(const std::string &identifier, bool inhibited);
 		};
 	};
 };
@@ -22,10 +22,33 @@ namespace pragma {
 		virtual void SendSnapshotData(NetPacket &packet, pragma::BasePlayerComponent &pl) override;
 		virtual bool ShouldTransmitNetData() const override;
 		virtual bool ShouldTransmitSnapshotData() const override;
+		// True if the Lua class implements SendSnapshotData, since the data may depend on the player it's sent to
+		virtual bool IsSnapshotDataPlayerSpecific() const override;
 
 		virtual void OnMemberValueChanged(uint32_t memberIdx) override;
+
+		// Coalesced member updates (see SGame::FlushNetworkedMemberUpdates)
+		bool HasPendingMemberUpdates() const;
+		// Returns true if there is at least one changed member with normal priority that is not being rate-limited
+		bool HasDueMemberUpdates(double t) const;
+		// Writes a bitmask of the transmitted members, followed by their values. Members that are still being rate-limited
+		// (or low-priority members, unless includeLowPriority is set) remain pending. Returns false if nothing was written.
+		bool WritePendingMemberUpdates(NetPacket &packet, double t, bool includeLowPriority);
+		void ClearPendingMemberUpdates();
 	  protected:
 		virtual void InvokeNetEventHandle(const std::string &methodName, NetPacket &packet, pragma::BasePlayerComponent *pl) override;
+	  private:
+		struct NetworkedMemberState {
+			double dirtySince = 0.0;
+			double lastTransmitTime = std::numeric_limits<double>::lowest();
+			bool dirty = false;
+		};
+		void SendMemberValue(const MemberInfo &member, size_t nwIndex);
+		bool IsMemberUpdateDue(const MemberInfo &member, const NetworkedMemberState &state, double t) const;
+		std::vector<NetworkedMemberState> m_networkedMemberStates;
+		uint32_t m_pendingMemberUpdateCount = 0;
+		bool m_queuedForMemberUpdate = false;
+		mutable std::optional<bool> m_snapshotDataPlayerSpecific {};
 	};
 };
 
@@ -0,0 +1,83 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#ifndef __INTEREST_MANAGER_HPP__
+#define __INTEREST_MANAGER_HPP__
+
+#include "pragma/serverdefinitions.h"
+#include "pragma/networking/interest_set.hpp"
+#include "pragma/entities/components/s_networked_component.hpp"
+#include <mathutil/uvec.h>
+#include <cinttypes>
+#include <optional>
+#include <memory>
+#include <vector>
+
+class SGame;
+class SBaseEntity;
+namespace util {
+	class BSPTree;
+};
+namespace pragma {
+	class SPlayerComponent;
+};
+namespace pragma::networking {
+	class IServerClient;
+	// Determines which entities are relevant to a player, based on their distance to the player, BSP cluster visibility (if the map has a BSP tree)
+	// and the overrides of the entity's networked component. Snapshots only include the relevant entities of a player, and distant entities
+	// are updated less frequently, depending on their transmit priority.
+	// Only the entities within the interest radius of a player (found through the entity spatial index), the entities that were relevant to the
+	// player in the previous snapshot, and entities whose relevance doesn't depend on their position are evaluated for each player.
+	class DLLSERVER InterestManager {
+	  public:
+		InterestManager(SGame &game);
+		InterestManager(const InterestManager &) = delete;
+		InterestManager &operator=(const InterestManager &) = delete;
+
+		void SetBSPTree(const std::shared_ptr<util::BSPTree> &bspTree);
+		// Has to be called once per snapshot, before any of the players are updated
+		void BeginSnapshot();
+		// Collects the entities that have to be included in the next snapshot of the player, and notifies the client
+		// about entities that have become dormant or relevant since the last update.
+		void Update(pragma::SPlayerComponent &pl, IServerClient &session, std::vector<SBaseEntity *> &outEntities);
+		void OnEntityRemoved(uint32_t entIdx);
+	  private:
+		struct Viewer {
+			const BaseEntity *entity = nullptr;
+			Vector3 position {};
+			std::optional<uint16_t> cluster {};
+		};
+		bool IsRelevant(pragma::SPlayerComponent &pl, const Viewer &viewer, SBaseEntity &ent, float &outDistance, float &outRadius, SNetworkedComponent::TransmitPriority &outPriority) const;
+		bool IsPotentiallyVisible(const Viewer &viewer, SBaseEntity &ent) const;
+		// Returns true if the relevance of the entity can't be determined from its position alone
+		bool RequiresEvaluation(SBaseEntity &ent) const;
+		// Collects the entities that have to be evaluated for the player
+		void CollectCandidates(const Viewer &viewer, InterestSet &interestSet, std::vector<SBaseEntity *> &outEntities);
+		double GetUpdateInterval(SNetworkedComponent::TransmitPriority priority, float distance, float radius) const;
+		uint32_t GetGeneration(uint32_t entIdx) const;
+
+		SGame &m_game;
+		std::shared_ptr<util::BSPTree> m_bspTree = nullptr;
+		// Incremented whenever an entity is removed, so stale entries of reused entity indices can be detected
+		std::vector<uint32_t> m_entityGenerations;
+
+		// Settings of the current snapshot
+		bool m_enabled = true;
+		bool m_usePvs = true;
+		float m_radius = 0.f;
+		float m_maxUpdateInterval = 0.f;
+		uint64_t m_snapshotIndex = 0;
+		// Entities that are evaluated for every player, regardless of their distance
+		std::vector<SBaseEntity *> m_unconditionalEntities;
+		// Entities that have become networked since the previous snapshot
+		std::vector<SBaseEntity *> m_newEntities;
+		// Generation + 1 of the entity that was last seen at the index, or 0
+		std::vector<uint32_t> m_knownGenerations;
+		std::vector<SBaseEntity *> m_candidates;
+		std::vector<BaseEntity *> m_spatialCandidates;
+};
+
+#endif
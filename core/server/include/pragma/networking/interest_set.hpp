@@ -0,0 +1,46 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#ifndef __INTEREST_SET_HPP__
+#define __INTEREST_SET_HPP__
+
+#include "pragma/serverdefinitions.h"
+#include <cinttypes>
+#include <vector>
+
+namespace pragma::networking {
+	// Per-client record of which entities are relevant to the client's player
+	class DLLSERVER InterestSet {
+	  public:
+		enum class State : uint8_t {
+			Unknown = 0, // Relevance hasn't been evaluated yet, the client still has the state the entity was created with
+			Relevant,
+			Dormant // The entity still exists on the client, but is hidden and doesn't receive any snapshot updates
+		};
+		struct DLLSERVER Entry {
+			State state = State::Unknown;
+			// Set if the entity has changed since it was last transmitted to the client
+			bool pendingUpdate = false;
+			uint32_t generation = 0;
+			double nextUpdateTime = 0.0;
+		};
+		// The entry is reset if it belonged to a previous entity with the same index
+		Entry &GetEntry(uint32_t entIdx, uint32_t generation);
+		void Clear();
+
+		// Indices of the entities that were relevant as of the last update
+		std::vector<uint32_t> &GetRelevantEntities() { return m_relevantEntities; }
+		// Index of the snapshot in which the set was last updated (see InterestManager), or 0 if it has never been updated
+		uint64_t GetLastSnapshotIndex() const { return m_lastSnapshotIndex; }
+		void SetLastSnapshotIndex(uint64_t index) { m_lastSnapshotIndex = index; }
+	  private:
+		std::vector<Entry> m_entries;
+		std::vector<uint32_t> m_relevantEntities;
+		uint64_t m_lastSnapshotIndex = 0;
+	};
+};
+
+#endif
@@ -10,6 +10,7 @@
 #include "pragma/serverdefinitions.h"
 #include <pragma/networking/enums.hpp>
 #include <pragma/networking/nwm_message_tracker.hpp>
+#include "pragma/networking/outgoing_message_queue.hpp"
 #include <cinttypes>
 #include <optional>
 #include <functional>
@@ -23,11 +24,14 @@ namespace pragma::networking {
 		std::function<void(IServerClient &)> onClientConnected = nullptr;
 		std::function<void(IServerClient &, pragma::networking::DropReason)> onClientDropped = nullptr;
 		std::function<void(IServerClient &, NetPacket &)> handlePacket = nullptr;
+		// Called for every queued message once it has actually been sent (see OutgoingMessageQueue)
+		std::function<void(IServerClient &, NetPacket &)> onQueuedMessageSent = nullptr;
 	};
 
 	class Error;
 	class IServerClient;
 	class ClientRecipientFilter;
+	class TrafficRecorder;
 	class DLLSERVER IServer : public pragma::networking::MessageTracker {
 	  public:
 		template<class TServer, typename... TARGS>
@@ -44,7 +48,9 @@ namespace pragma::networking {
 		// Note: The identifier HAS to match the directory name of the networking module!
 		virtual std::string GetNetworkLayerIdentifier() const = 0;
 		bool Shutdown(Error &outErr);
-		bool SendPacket(Protocol protocol, NetPacket &packet, const ClientRecipientFilter &rf, Error &outErr);
+		// outNumRecipients receives the number of clients the packet has been sent to right away. Packets that have been queued for
+		// a client are reported through ServerEventInterface::onQueuedMessageSent once they've been sent.
+		bool SendPacket(Protocol protocol, NetPacket &packet, const ClientRecipientFilter &rf, Error &outErr, uint32_t *outNumRecipients = nullptr);
 		void AddClient(const std::shared_ptr<IServerClient> &client);
 		template<class TServerClient, typename... TARGS>
 		std::shared_ptr<TServerClient> AddClient(TARGS &&...args);
@@ -55,12 +61,27 @@ namespace pragma::networking {
 		bool IsRunning() const;
 		const std::vector<std::shared_ptr<IServerClient>> &GetClients() const;
 
+		// All packets that are sent or received while a recorder is set will be written to the recorder's file
+		void SetTrafficRecorder(const std::shared_ptr<TrafficRecorder> &recorder);
+		TrafficRecorder *GetTrafficRecorder();
+
+		// Unreliable messages are queued per client and sent by UpdateOutgoingQueues, in order of their priority and within
+		// the client's bandwidth budget (see OutgoingMessageQueue). If disabled, all messages are sent immediately.
+		void SetOutgoingSchedulerEnabled(bool enabled);
+		bool IsOutgoingSchedulerEnabled() const;
+		void SetOutgoingSchedulerSettings(const OutgoingMessageQueue::Settings &settings);
+		const OutgoingMessageQueue::Settings &GetOutgoingSchedulerSettings() const;
+		// Indexed by client message ID
+		void SetMessagePriority(uint32_t messageId, MessagePriority priority, bool supersede = false);
+		const MessagePriorityInfo &GetMessagePriority(uint32_t messageId) const;
+		void UpdateOutgoingQueues();
+
 		// These have to be called by the implementation of IServer
 		void HandlePacket(IServerClient &client, NetPacket &packet);
 		void OnClientConnected(IServerClient &client);
 		void OnClientDropped(IServerClient &client, DropReason reason);
 	  protected:
-		IServer() = default;
+		IServer();
 		virtual bool DoStart(Error &outErr, uint16_t port, bool useP2PIfAvailable = false) = 0;
 		const ServerEventInterface &GetEventInterface() const;
 		virtual bool DoShutdown(Error &outErr) = 0;
@@ -68,6 +89,11 @@ namespace pragma::networking {
 		bool m_bRunning = true;
 		std::vector<std::shared_ptr<IServerClient>> m_clients = {};
 		ServerEventInterface m_eventInterface = {};
+		std::shared_ptr<TrafficRecorder> m_trafficRecorder = nullptr;
+		bool m_outgoingSchedulerEnabled = true;
+		OutgoingMessageQueue::Settings m_outgoingSchedulerSettings {};
+		std::vector<MessagePriorityInfo> m_messagePriorities;
+		uint32_t m_bundleMessageId = 0;
 	};
 };
 
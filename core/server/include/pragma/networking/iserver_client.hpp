@@ -10,6 +10,9 @@
 #include "pragma/serverdefinitions.h"
 #include "pragma/networking/enums.hpp"
 #include "pragma/networking/ip_address.hpp"
+#include "pragma/networking/interest_set.hpp"
+#include "pragma/networking/outgoing_message_queue.hpp"
+#include <pragma/networking/snapshot_codec.hpp>
 #include <cinttypes>
 
 struct Resource;
@@ -42,6 +45,9 @@ namespace pragma::networking {
 		const std::vector<std::shared_ptr<Resource>> &GetResourceTransfer() const;
 		bool AddResource(const std::string &fileName, bool stream = true);
 		void RemoveResource(uint32_t i);
+		void RemoveResource(const Resource &res);
+		Resource *FindResourceByTransferId(uint32_t transferId);
+		uint32_t AssignResourceTransferId();
 		void ClearResourceTransfer();
 		bool IsInitialResourceTransferComplete() const;
 		void SetInitialResourceTransferState(TransferState state);
@@ -50,6 +56,12 @@ namespace pragma::networking {
 		bool IsTransferring() const;
 
 		uint8_t SwapSnapshotId();
+		uint8_t GetNextSnapshotId() const;
+		void SetLastAcknowledgedSnapshotId(uint8_t id);
+		const std::optional<uint8_t> &GetLastAcknowledgedSnapshotId() const;
+		pragma::networking::SnapshotHistory &GetSnapshotHistory();
+		pragma::networking::InterestSet &GetInterestSet();
+		pragma::networking::OutgoingMessageQueue &GetOutgoingQueue();
 		void Reset();
 		void ScheduleResource(const std::string &fileName);
 		std::vector<std::string> &GetScheduledResources();
@@ -63,9 +75,14 @@ namespace pragma::networking {
 		mutable pragma::ComponentHandle<pragma::SPlayerComponent> m_player = {};
 		bool m_bTransferring = false;
 		std::vector<std::shared_ptr<Resource>> m_resourceTransfer;
+		uint32_t m_nextResourceTransferId = 0;
 		TransferState m_initialResourceTransferState = TransferState::Initial;
 
 		uint8_t m_snapshotId = 0;
+		std::optional<uint8_t> m_lastAcknowledgedSnapshotId {};
+		pragma::networking::SnapshotHistory m_snapshotHistory {};
+		pragma::networking::InterestSet m_interestSet {};
+		pragma::networking::OutgoingMessageQueue m_outgoingQueue {};
 		std::vector<std::string> m_scheduledResources; // Scheduled resource files for download
 
 		// TODO: Move this somewhere else?
@@ -0,0 +1,119 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#ifndef __PRAGMA_LOAD_GENERATOR_HPP__
+#define __PRAGMA_LOAD_GENERATOR_HPP__
+
+#include "pragma/serverdefinitions.h"
+#include "pragma/networking/iserver_client.hpp"
+#include <pragma/networking/net_message_registry.hpp>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace pragma::networking {
+	class IServer;
+	class LoadGenerator;
+	// Headless client that lives inside the server process. It runs through the same connect and resource handshake as a
+	// regular client, but never loads the game; The messages it receives are only inspected as far as the handshake requires.
+	class DLLSERVER LoadGeneratorClient : public IServerClient {
+	  public:
+		enum class State : uint8_t { Connecting = 0, Authenticating, TransferringResources, Joining, Ready, Dropped };
+
+		virtual uint16_t GetLatency() const override;
+		virtual std::string GetIdentifier() const override;
+		virtual std::optional<std::string> GetIP() const override;
+		virtual std::optional<Port> GetPort() const override;
+		virtual bool IsListenServerHost() const override;
+		virtual bool SendPacket(pragma::networking::Protocol protocol, NetPacket &packet, pragma::networking::Error &outErr) override;
+		virtual bool Drop(DropReason reason, pragma::networking::Error &outErr) override;
+
+		State GetState() const;
+		// Time between the connection request and the server's 'game_ready' message
+		std::optional<std::chrono::steady_clock::duration> GetJoinLatency() const;
+		// Indexed by client message ID
+		const NetMessageStatsTable &GetReceivedMessageStats() const;
+		// Indexed by server message ID
+		const NetMessageStatsTable &GetSentMessageStats() const;
+	  private:
+		friend IServerClient;
+		friend LoadGenerator;
+		LoadGeneratorClient(LoadGenerator &loadGenerator, uint16_t index);
+		void ReceiveMessage(uint32_t messageId, const uint8_t *data, size_t size);
+		LoadGenerator &m_loadGenerator;
+		uint16_t m_index = 0;
+		State m_state = State::Connecting;
+		// Replies are deferred to the next update, so the server's message handlers are never re-entered
+		std::vector<NetPacket> m_pendingMessages;
+		std::chrono::steady_clock::time_point m_tConnect;
+		std::optional<std::chrono::steady_clock::time_point> m_tReady {};
+		std::chrono::steady_clock::time_point m_tNextInput;
+		std::optional<uint8_t> m_lastSnapshotId {};
+		uint8_t m_nextUserInputId = 0;
+		NetMessageStatsTable m_receivedMessageStats;
+		NetMessageStatsTable m_sentMessageStats;
+	};
+
+	// Connects a number of LoadGeneratorClients to the server, which send randomized user input once they've joined the game.
+	// Used to measure how the server tick time and the bandwidth per client scale with the number of players.
+	class DLLSERVER LoadGenerator {
+	  public:
+		struct DLLSERVER Settings {
+			uint32_t numClients = 1;
+			// Delay between two clients connecting to the server
+			float joinInterval = 0.1f;
+			// User input messages per second and client
+			float inputRate = 30.f;
+		};
+		static std::unique_ptr<LoadGenerator> Create(IServer &server, const Settings &settings);
+		LoadGenerator(const LoadGenerator &) = delete;
+		LoadGenerator &operator=(const LoadGenerator &) = delete;
+		~LoadGenerator();
+
+		// Connects clients that are due, advances their handshakes and sends user input
+		void Update();
+		void OnServerTick(std::chrono::steady_clock::duration tickDuration);
+		uint32_t GetReadyClientCount() const;
+		void PrintReport() const;
+	  private:
+		friend LoadGeneratorClient;
+		LoadGenerator(IServer &server, const Settings &settings);
+		void ProcessMessage(LoadGeneratorClient &client, NetPacket &packet);
+		void SendUserInput(LoadGeneratorClient &client);
+		void Send(LoadGeneratorClient &client, uint32_t messageId, NetPacket &packet);
+
+		IServer &m_server;
+		Settings m_settings;
+		std::vector<std::shared_ptr<LoadGeneratorClient>> m_clients;
+		std::chrono::steady_clock::time_point m_tStart;
+
+		struct MessageIds {
+			// Client messages (Received from the server)
+			uint32_t serverInfo = 0;
+			uint32_t startResourceTransfer = 0;
+			uint32_t resourceInfo = 0;
+			uint32_t resourceComplete = 0;
+			uint32_t gameReady = 0;
+			uint32_t snapshot = 0;
+			uint32_t messageBundle = 0;
+			// Server messages (Sent to the server)
+			uint32_t serverInfoRequest = 0;
+			uint32_t authenticate = 0;
+			uint32_t resourceBegin = 0;
+			uint32_t resourceInfoResponse = 0;
+			uint32_t clientInfo = 0;
+			uint32_t gameReadyResponse = 0;
+			uint32_t userInput = 0;
+		} m_messageIds;
+
+		uint64_t m_tickCount = 0;
+		std::chrono::steady_clock::duration m_totalTickTime {0};
+		std::chrono::steady_clock::duration m_maxTickTime {0};
+	};
+};
+
+#endif
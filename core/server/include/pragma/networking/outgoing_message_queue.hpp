@@ -0,0 +1,93 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#ifndef __PRAGMA_OUTGOING_MESSAGE_QUEUE_HPP__
+#define __PRAGMA_OUTGOING_MESSAGE_QUEUE_HPP__
+
+#include "pragma/serverdefinitions.h"
+#include <sharedutils/netpacket.hpp>
+#include <mathutil/umath.h>
+#include <functional>
+#include <optional>
+#include <chrono>
+#include <array>
+#include <deque>
+
+namespace pragma::networking {
+	class IServerClient;
+	enum class MessagePriority : uint8_t {
+		Critical = 0, // State the client can't do without (e.g. snapshots)
+		High,
+		Normal,
+		Low, // Cosmetic messages (e.g. debug drawing, giblets), which are the first to be deferred if the bandwidth is limited
+
+		Count
+	};
+	struct DLLSERVER MessagePriorityInfo {
+		MessagePriority priority = MessagePriority::Normal;
+		// If set, a queued message is dropped when a newer message of the same type is queued
+		bool supersede = false;
+	};
+
+	// Unreliable messages to a client are queued and sent at the end of a frame in order of their priority, as long as the
+	// client's bandwidth budget allows it. The budget is a token bucket, which is refilled at the client's rate.
+	// Small messages are aggregated into 'msg_bundle' datagrams, which the client unpacks again.
+	// Reliable messages aren't queued (their order has to be preserved), but their size is deducted from the budget.
+	class DLLSERVER OutgoingMessageQueue {
+	  public:
+		static constexpr uint32_t DEFAULT_RATE = 131'072;
+		static constexpr uint32_t MAX_DATAGRAM_SIZE = 1'200;
+		static constexpr uint32_t BUNDLE_ENTRY_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint16_t);
+		struct DLLSERVER Settings {
+			uint32_t minRate = 0;
+			uint32_t maxRate = 0; // 0 = Unlimited
+			// Queued messages that couldn't be sent within this time (in seconds) are dropped
+			float maxDelay = 0.2f;
+		};
+		struct DLLSERVER Stats {
+			uint64_t queuedMessageCount = 0;
+			uint64_t sentMessageCount = 0;
+			uint64_t sentByteCount = 0;
+			uint64_t sentDatagramCount = 0;
+			uint64_t bundledMessageCount = 0;
+			// Messages that had to wait for at least one more flush due to the bandwidth budget
+			uint64_t deferredMessageCount = 0;
+			// Messages that were superseded or too old
+			uint64_t droppedMessageCount = 0;
+			uint32_t maxQueueDepth = 0;
+		};
+
+		void SetRate(uint32_t bytesPerSecond);
+		uint32_t GetRate() const;
+		void Enqueue(NetPacket &packet, const MessagePriorityInfo &priorityInfo);
+		void ConsumeBandwidth(size_t numBytes, const Settings &settings);
+		// Sends all queued messages that fit into the budget. 'onDatagramSent' is called for every datagram that has been sent,
+		// 'onMessageSent' for every queued message that has been sent (individually or as part of a bundle).
+		void Flush(IServerClient &client, uint32_t bundleMessageId, const Settings &settings, const std::function<void(NetPacket &)> &onDatagramSent = nullptr, const std::function<void(NetPacket &)> &onMessageSent = nullptr);
+		void Clear();
+
+		uint32_t GetQueueDepth() const;
+		const Stats &GetStats() const;
+		void ResetStats();
+	  private:
+		struct Message {
+			NetPacket packet;
+			std::chrono::steady_clock::time_point tQueued;
+			bool deferred = false;
+		};
+		uint32_t GetEffectiveRate(const Settings &settings) const;
+		void Refill(const Settings &settings);
+		bool Send(IServerClient &client, NetPacket &packet, const std::function<void(NetPacket &)> &onDatagramSent);
+
+		std::array<std::deque<Message>, umath::to_integral(MessagePriority::Count)> m_queues;
+		uint32_t m_rate = DEFAULT_RATE;
+		double m_tokens = 0.0;
+		std::optional<std::chrono::steady_clock::time_point> m_tLastRefill {};
+		Stats m_stats {};
+	};
+};
+
+#endif
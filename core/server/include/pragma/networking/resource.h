@@ -10,19 +10,38 @@
 #include "pragma/serverdefinitions.h"
 #include <string>
 #include <memory>
+#include <cinttypes>
 
 class VFilePtrInternal;
 #pragma warning(push)
 #pragma warning(disable : 4251)
 struct DLLSERVER Resource
 {
+	enum class State : uint8_t
+	{
+		Queued = 0,
+		Announced, // Resource info has been sent to the client, waiting for response
+		Transferring
+	};
+	// Number of times a transfer is restarted after the client has aborted it, before the resource is skipped
+	static constexpr uint32_t MAX_TRANSFER_ATTEMPTS = 3;
 	Resource(std::string name,bool bStream=true);
 	~Resource();
 	bool Construct();
+	// The file is only kept open while the resource is being transferred
+	bool Open();
+	void Close();
 	std::string name;
-	unsigned int offset;
+	uint64_t offset;
+	uint64_t size = 0;
 	std::shared_ptr<VFilePtrInternal> file;
 	bool stream;
+
+	State state = State::Queued;
+	uint32_t transferId = 0;
+	uint32_t chunksInFlight = 0;
+	bool eofSent = false;
+	uint32_t transferAttempts = 0;
 };
 #pragma warning(pop)
 
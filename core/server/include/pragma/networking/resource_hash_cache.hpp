@@ -0,0 +1,44 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#ifndef __RESOURCE_HASH_CACHE_HPP__
+#define __RESOURCE_HASH_CACHE_HPP__
+
+#include "pragma/serverdefinitions.h"
+#include <pragma/util/util_thread_pool.hpp>
+#include <unordered_map>
+#include <filesystem>
+#include <optional>
+#include <memory>
+#include <string>
+
+namespace pragma::networking {
+	// Content hashes of the resource files that are sent to clients. The hashes are shared between all clients, so they
+	// only have to be computed once per file. Hashing is done on a worker thread, since resource files can be large.
+	// An entry is invalidated if the size or last write time of the file has changed.
+	class DLLSERVER ResourceHashCache {
+	  public:
+		ResourceHashCache();
+		// Returns nullptr if the hash is not available yet, in which case it is computed in the background
+		const std::string *Find(const std::string &name, uint64_t size);
+		// Applies the hashes that have been computed since the last call; Returns true if there were any
+		bool Poll();
+		void Clear();
+	  private:
+		using FileTime = std::optional<std::filesystem::file_time_type>;
+		struct Entry {
+			uint64_t size = 0;
+			FileTime lastWriteTime {};
+			std::string hash;
+		};
+		std::unordered_map<std::string, Entry> m_entries;
+		// Files that are currently being hashed, by task id
+		std::unordered_map<std::string, uint32_t> m_pending;
+		std::unique_ptr<pragma::ThreadPool> m_threadPool;
+	};
+};
+
+#endif
@@ -0,0 +1,50 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#ifndef __ROUGH_MODEL_CACHE_HPP__
+#define __ROUGH_MODEL_CACHE_HPP__
+
+#include "pragma/serverdefinitions.h"
+#include <unordered_map>
+#include <memory>
+#include <vector>
+#include <string>
+
+class Model;
+namespace pragma::networking {
+	// Caches the LZ4-compressed rough-model payload (collision or render mesh vertices) of every model that has been
+	// requested by a client, so it only has to be generated once, regardless of how many clients request it.
+	// An entry is invalidated if the model has been reloaded or updated since the payload was generated.
+	// Payloads are also written to "cache/rough_models/", keyed by the content hash of the model file, so they
+	// survive server restarts.
+	class DLLSERVER RoughModelCache {
+	  public:
+		static constexpr uint32_t FORMAT_VERSION = 1;
+		struct DLLSERVER Payload {
+			std::vector<uint8_t> compressedData;
+			uint64_t uncompressedSize = 0;
+		};
+
+		// Returns nullptr if no payload could be generated for the model
+		std::shared_ptr<const Payload> Get(const std::string &mdlName, const std::shared_ptr<Model> &mdl);
+		void Clear();
+	  private:
+		struct Entry {
+			std::weak_ptr<Model> model;
+			uint32_t updateIndex = 0;
+			std::shared_ptr<const Payload> payload;
+		};
+		static bool Serialize(const std::string &mdlName, Model &mdl, std::vector<uint8_t> &outData);
+		static std::string GetModelFileHash(const std::string &mdlName);
+		static std::string GetDiskCachePath(const std::string &hash);
+		static std::shared_ptr<const Payload> LoadFromDisk(const std::string &hash, uint32_t updateIndex);
+		static void SaveToDisk(const std::string &hash, uint32_t updateIndex, const Payload &payload);
+
+		std::unordered_map<std::string, Entry> m_entries;
+	};
+};
+
+#endif
@@ -11,11 +11,13 @@
 #include "pragma/networking/netmessages.h"
 DLLSERVER void NET_sv_resourceinfo_response(pragma::networking::IServerClient &session, NetPacket packet);
 DLLSERVER void NET_sv_resource_request(pragma::networking::IServerClient &session, NetPacket packet);
+DLLSERVER void NET_sv_resource_abort(pragma::networking::IServerClient &session, NetPacket packet);
 DLLSERVER void NET_sv_resource_begin(pragma::networking::IServerClient &session, NetPacket packet);
 DLLSERVER void NET_sv_query_resource(pragma::networking::IServerClient &session, NetPacket packet);
 DLLSERVER void NET_sv_query_model_texture(pragma::networking::IServerClient &session, NetPacket packet);
 REGISTER_NETMESSAGE_SV(resourceinfo_response, NET_sv_resourceinfo_response);
 REGISTER_NETMESSAGE_SV(resource_request, NET_sv_resource_request);
+REGISTER_NETMESSAGE_SV(resource_abort, NET_sv_resource_abort);
 REGISTER_NETMESSAGE_SV(resource_begin, NET_sv_resource_begin);
 REGISTER_NETMESSAGE_SV(query_resource, NET_sv_query_resource);
 REGISTER_NETMESSAGE_SV(query_model_texture, NET_sv_query_model_texture);
@@ -0,0 +1,80 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#ifndef __PRAGMA_TRAFFIC_RECORDER_HPP__
+#define __PRAGMA_TRAFFIC_RECORDER_HPP__
+
+#include "pragma/serverdefinitions.h"
+#include <sharedutils/netpacket.hpp>
+#include <fsys/filesystem.h>
+#include <unordered_map>
+#include <cinttypes>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pragma::networking {
+	class IServerClient;
+	// Recorded traffic file layout:
+	// Header: "PTRF", version (u32), the names and IDs of the server messages (incoming) and client messages (outgoing) at the time of the recording
+	// Records: Time since the start of the recording in microseconds (u64), client index (u16), direction (u8), message id (u32), size (u32), packet data
+	enum class TrafficDirection : uint8_t { Incoming = 0, Outgoing };
+
+	// Writes the packets a server sends and receives to a file, so they can be replayed later (see TrafficReplay)
+	class DLLSERVER TrafficRecorder {
+	  public:
+		static constexpr uint32_t FORMAT_VERSION = 1;
+		static std::unique_ptr<TrafficRecorder> Create(const std::string &fileName);
+		TrafficRecorder(const TrafficRecorder &) = delete;
+		TrafficRecorder &operator=(const TrafficRecorder &) = delete;
+		void Record(const IServerClient &client, TrafficDirection direction, NetPacket &packet);
+		// Clients that connect afterwards may be at the same address, so they have to be assigned a new index
+		void OnClientDropped(const IServerClient &client);
+
+		const std::string &GetFileName() const;
+		uint64_t GetPacketCount() const;
+		uint64_t GetByteCount() const;
+		std::chrono::steady_clock::duration GetDuration() const;
+	  private:
+		TrafficRecorder(VFilePtrReal f, const std::string &fileName);
+		uint16_t GetClientIndex(const IServerClient &client);
+
+		VFilePtrReal m_file = nullptr;
+		std::string m_fileName;
+		std::chrono::steady_clock::time_point m_tStart;
+		std::unordered_map<const IServerClient *, uint16_t> m_clientIndices;
+		uint16_t m_nextClientIndex = 0;
+		uint64_t m_packetCount = 0;
+		uint64_t m_byteCount = 0;
+	};
+
+	struct DLLSERVER TrafficRecord {
+		uint64_t timestampUs = 0;
+		uint16_t clientIndex = 0;
+		TrafficDirection direction = TrafficDirection::Incoming;
+		uint32_t messageId = 0;
+		std::vector<uint8_t> data;
+	};
+
+	class DLLSERVER TrafficRecording {
+	  public:
+		static std::unique_ptr<TrafficRecording> Load(const std::string &fileName, std::string &outErr);
+		const std::vector<TrafficRecord> &GetRecords() const;
+		// Returns the name the message had at the time of the recording, or nullptr if the ID is unknown
+		const std::string *FindMessageName(TrafficDirection direction, uint32_t messageId) const;
+		uint16_t GetClientCount() const;
+		uint64_t GetDurationUs() const;
+	  private:
+		TrafficRecording() = default;
+		std::vector<TrafficRecord> m_records;
+		std::unordered_map<uint32_t, std::string> m_incomingMessageNames;
+		std::unordered_map<uint32_t, std::string> m_outgoingMessageNames;
+		uint16_t m_clientCount = 0;
+	};
+};
+
+#endif
@@ -0,0 +1,79 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#ifndef __PRAGMA_TRAFFIC_REPLAY_HPP__
+#define __PRAGMA_TRAFFIC_REPLAY_HPP__
+
+#include "pragma/serverdefinitions.h"
+#include "pragma/networking/iserver_client.hpp"
+#include "pragma/networking/traffic_recorder.hpp"
+#include <pragma/networking/net_message_registry.hpp>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace pragma::networking {
+	class IServer;
+	// Stands in for a recorded client during a replay. Packets that are sent to it are only counted.
+	class DLLSERVER ReplayServerClient : public IServerClient {
+	  public:
+		virtual uint16_t GetLatency() const override;
+		virtual std::string GetIdentifier() const override;
+		virtual std::optional<std::string> GetIP() const override;
+		virtual std::optional<Port> GetPort() const override;
+		virtual bool IsListenServerHost() const override;
+		virtual bool SendPacket(pragma::networking::Protocol protocol, NetPacket &packet, pragma::networking::Error &outErr) override;
+		virtual bool Drop(DropReason reason, pragma::networking::Error &outErr) override;
+
+		// Indexed by client message ID
+		const NetMessageStatsTable &GetReceivedMessageStats() const;
+	  private:
+		friend IServerClient;
+		ReplayServerClient(uint16_t index);
+		uint16_t m_index = 0;
+		NetMessageStatsTable m_receivedMessageStats;
+	};
+
+	// Feeds the incoming packets of a recording back into the server, with fake clients standing in for the recorded clients.
+	// The traffic the server sends to the fake clients is compared against the recorded outgoing traffic, which makes it
+	// possible to measure the effects of changes to the network protocol (e.g. the snapshot format) with a reproducible workload.
+	class DLLSERVER TrafficReplay {
+	  public:
+		// A time scale of 0 dispatches all packets at once, without waiting for the recorded timestamps
+		static std::unique_ptr<TrafficReplay> Create(IServer &server, std::unique_ptr<TrafficRecording> recording, float timeScale = 1.f);
+		TrafficReplay(const TrafficReplay &) = delete;
+		TrafficReplay &operator=(const TrafficReplay &) = delete;
+		~TrafficReplay();
+
+		// Dispatches all incoming packets that are due. Returns false once the replay is complete.
+		bool Update();
+		bool IsComplete() const;
+		void PrintReport() const;
+	  private:
+		TrafficReplay(IServer &server, std::unique_ptr<TrafficRecording> recording, float timeScale);
+		void Dispatch(const TrafficRecord &record);
+
+		IServer &m_server;
+		std::unique_ptr<TrafficRecording> m_recording;
+		float m_timeScale = 1.f;
+		std::vector<std::shared_ptr<ReplayServerClient>> m_clients;
+		// Translates the recorded server message IDs to the current ones (0 if the message doesn't exist anymore)
+		std::vector<uint32_t> m_incomingMessageIds;
+		size_t m_nextRecord = 0;
+		std::chrono::steady_clock::time_point m_tStart;
+		std::chrono::steady_clock::time_point m_tEnd;
+
+		uint64_t m_dispatchedPacketCount = 0;
+		uint64_t m_dispatchedByteCount = 0;
+		uint64_t m_skippedPacketCount = 0;
+		std::chrono::nanoseconds m_totalHandlerTime {0};
+		std::chrono::nanoseconds m_maxHandlerTime {0};
+		// Indexed by recorded client message ID
+		NetMessageStatsTable m_recordedOutgoingStats;
+	};
+};
+
+#endif
@@ -11,8 +11,12 @@
 #include "pragma/game/s_game.h"
 #include <pragma/input/inkeys.h>
 #include <pragma/networking/enums.hpp>
+#include <pragma/networking/net_message_registry.hpp>
 #include <sharedutils/chronoutil.h>
 #include "wmserverdata.h"
+#include <unordered_set>
+#include <optional>
+#include <chrono>
 
 #define FSYS_SEARCH_CACHE 8'192
 
@@ -25,6 +29,10 @@ namespace pragma {
 		class IServerClient;
 		class ClientRecipientFilter;
 		class MasterServerRegistration;
+		class RoughModelCache;
+		class ResourceHashCache;
+		class TrafficReplay;
+		class LoadGenerator;
 		enum class Protocol : uint8_t;
 	};
 };
@@ -44,13 +52,23 @@ class DLLSERVER ServerState : public NetworkState {
 	unsigned int m_conCommandID;
 	std::unique_ptr<pragma::networking::IServer> m_server;
 	std::shared_ptr<pragma::networking::IServerClient> m_localClient = {};
+	std::unique_ptr<pragma::networking::TrafficReplay> m_trafficReplay;
+	std::unique_ptr<pragma::networking::LoadGenerator> m_loadGenerator;
 
 	// Handles the connection to the master server
 	std::unique_ptr<pragma::networking::MasterServerRegistration> m_serverReg;
+	std::unique_ptr<pragma::networking::RoughModelCache> m_roughModelCache;
+	std::unique_ptr<pragma::networking::ResourceHashCache> m_resourceHashCache;
+	void UpdateResourceHashes();
 
 	ChronoTimePoint m_tNextWMSConnect;
 	unsigned int m_alsoundID;
 
+	bool m_hibernating = false;
+	std::optional<std::chrono::steady_clock::time_point> m_tEmptySince {};
+	std::unordered_set<std::string> m_hibernationInhibitors;
+	void UpdateHibernation();
+
 	std::deque<unsigned int> m_alsoundIndex;
 	// We need to keep shared pointer references to all serverside sounds (Network state only keeps references)
 	std::vector<std::shared_ptr<ALSound>> m_serverSounds;
@@ -105,13 +123,26 @@ class DLLSERVER ServerState : public NetworkState {
 	void CloseServer();
 	pragma::networking::IServerClient *GetLocalClient();
 	void InitResourceTransfer(pragma::networking::IServerClient &session);
-	void HandleServerNextResource(pragma::networking::IServerClient &session);
+	// Announces queued resources and sends chunks until the configured limits are reached
+	void UpdateResourceTransfer(pragma::networking::IServerClient &session);
+	void SendResourceChunk(pragma::networking::IServerClient &session, Resource &res);
 	void HandleServerResourceStart(pragma::networking::IServerClient &session, NetPacket &packet);
-	void HandleServerResourceFragment(pragma::networking::IServerClient &session);
+	void HandleServerResourceAck(pragma::networking::IServerClient &session, NetPacket &packet);
+	// The client has discarded the download, e.g. because it has received an invalid chunk
+	void HandleServerResourceAbort(pragma::networking::IServerClient &session, NetPacket &packet);
 	void HandleLuaNetPacket(pragma::networking::IServerClient &session, NetPacket &packet);
 	bool HandlePacket(pragma::networking::IServerClient &session, NetPacket &packet);
 	void ReceiveUserInput(pragma::networking::IServerClient &session, NetPacket &packet);
 	bool ConnectLocalHostPlayerClient();
+	void UpdateTrafficReplay();
+	void UpdateLoadGenerator();
+	void UpdateOutgoingQueues();
+
+	// Sent messages are indexed by client message ID, received messages by server message ID
+	pragma::networking::NetMessageStatsTable m_sentMessageStats;
+	pragma::networking::NetMessageStatsTable m_receivedMessageStats;
+	void SendPacket(uint32_t messageId, const char *name, NetPacket &packet, pragma::networking::Protocol protocol, const pragma::networking::ClientRecipientFilter &rf);
+	void SendPacket(uint32_t messageId, const char *name, NetPacket &packet, pragma::networking::Protocol protocol);
   public:
 	ServerState();
 	virtual ~ServerState() override;
@@ -123,6 +154,8 @@ class DLLSERVER ServerState : public NetworkState {
 	ServerMessageMap *GetNetMessageMap();
 	SVNetMessage *GetNetMessage(unsigned int ID);
 	unsigned int GetClientMessageID(std::string identifier);
+	template<pragma::networking::NetMessageName TName>
+	unsigned int GetClientMessageID();
 	virtual ConCommand *CreateConCommand(const std::string &scmd, LuaFunction fc, ConVarFlags flags = ConVarFlags::None, const std::string &help = "") override;
 	void GetLuaConCommands(std::unordered_map<std::string, ConCommand *> **cmds);
 
@@ -141,11 +174,79 @@ class DLLSERVER ServerState : public NetworkState {
 	void SendPacket(const std::string &name, NetPacket &packet, pragma::networking::Protocol protocol);
 	void SendPacket(const std::string &name, NetPacket &packet);
 	void SendPacket(const std::string &name, pragma::networking::Protocol protocol);
+	// Preferred over the overloads above, since the message ID is only looked up once
+	template<pragma::networking::NetMessageName TName>
+	void SendPacket(NetPacket &packet, pragma::networking::Protocol protocol, const pragma::networking::ClientRecipientFilter &rf);
+	template<pragma::networking::NetMessageName TName>
+	void SendPacket(NetPacket &packet, pragma::networking::Protocol protocol);
+	template<pragma::networking::NetMessageName TName>
+	void SendPacket(NetPacket &packet);
+	template<pragma::networking::NetMessageName TName>
+	void SendPacket(pragma::networking::Protocol protocol);
+
+	const pragma::networking::NetMessageStatsTable &GetSentMessageStats() const;
+	const pragma::networking::NetMessageStatsTable &GetReceivedMessageStats() const;
+	void ResetMessageStats();
 
 	pragma::networking::IServer *GetServer();
 	pragma::networking::MasterServerRegistration *GetMasterServerRegistration();
 	bool IsServerRunning() const;
+
+	// Records all packets that are sent to and received from clients to a file
+	bool StartTrafficRecording(const std::string &fileName);
+	void StopTrafficRecording();
+	bool IsRecordingTraffic() const;
+	// Replays the incoming packets of a traffic recording with fake clients and prints a report once the replay is complete
+	bool StartTrafficReplay(const std::string &fileName, float timeScale = 1.f);
+	void StopTrafficReplay();
+	bool IsReplayingTraffic() const;
+	// Connects headless in-process clients to the server and prints a report with the server tick time, the join latency
+	// and the bandwidth per client once it is stopped
+	bool StartLoadGenerator(uint32_t numClients, float joinInterval = 0.1f, float inputRate = 30.f);
+	void StopLoadGenerator();
+	pragma::networking::LoadGenerator *GetLoadGenerator();
+
+	// A dedicated server without any connected clients hibernates after a while, i.e. it reduces its tick rate
+	// (and suspends the simulation, depending on sv_hibernate). Systems that need to keep running at the full
+	// tick rate can inhibit hibernation with an arbitrary identifier.
+	enum class HibernationMode : uint8_t { Disabled = 0, ReducedTickRate, SuspendSimulation };
+	bool IsHibernating() const;
+	HibernationMode GetHibernationMode() const;
+	void SetHibernating(bool hibernating);
+	void SetHibernationInhibited(const std::string &identifier, bool inhibited);
 	void DropClient(pragma::networking::IServerClient &session, pragma::networking::DropReason reason = pragma::networking::DropReason::Disconnected);
 };
 #pragma warning(pop)
+
+template<pragma::networking::NetMessageName TName>
+unsigned int ServerState::GetClientMessageID()
+{
+	// Net messages are registered during static initialization, so the ID won't change once it has been found
+	static unsigned int id = 0;
+	if(id == 0)
+		id = GetClientMessageID(std::string {TName.value});
+	return id;
+}
+
+template<pragma::networking::NetMessageName TName>
+void ServerState::SendPacket(NetPacket &packet, pragma::networking::Protocol protocol, const pragma::networking::ClientRecipientFilter &rf)
+{
+	SendPacket(GetClientMessageID<TName>(), TName.value, packet, protocol, rf);
+}
+template<pragma::networking::NetMessageName TName>
+void ServerState::SendPacket(NetPacket &packet, pragma::networking::Protocol protocol)
+{
+	SendPacket(GetClientMessageID<TName>(), TName.value, packet, protocol);
+}
+template<pragma::networking::NetMessageName TName>
+void ServerState::SendPacket(NetPacket &packet)
+{
+	SendPacket<TName>(packet, pragma::networking::Protocol::FastUnreliable);
+}
+template<pragma::networking::NetMessageName TName>
+void ServerState::SendPacket(pragma::networking::Protocol protocol)
+{
+	NetPacket packet {};
+	SendPacket<TName>(packet, protocol);
+}
 #endif
@@ -54,9 +54,9 @@ void SALSound::SendEvent(NetEvent evId, const std::function<void(NetPacket &)> &
 	if(write != nullptr)
 		write(p);
 	if(bUDP == true)
-		server->SendPacket("snd_ev", p, pragma::networking::Protocol::FastUnreliable);
+		server->SendPacket<"snd_ev">(p, pragma::networking::Protocol::FastUnreliable);
 	else
-		server->SendPacket("snd_ev", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"snd_ev">(p, pragma::networking::Protocol::SlowReliable);
 }
 
 void SALSound::SetState(ALState state)
@@ -14,6 +14,7 @@
 #include <pragma/networking/nwm_util.h>
 #include <pragma/networking/enums.hpp>
 #include <pragma/networking/iserver.hpp>
+#include <pragma/networking/iserver_client.hpp>
 #include <pragma/game/game_limits.h>
 #include "pragma/entities/components/s_name_component.hpp"
 #include "pragma/entities/components/s_io_component.hpp"
@@ -24,6 +25,7 @@
 #include <pragma/entities/entity_component_system_t.hpp>
 #include <pragma/console/sh_cmd.h>
 #include <pragma/networking/netmessages.h>
+#include <sharedutils/util.h>
 
 extern DLLNETWORK Engine *engine;
 extern ServerState *server;
@@ -35,7 +37,7 @@ DLLSERVER void CMD_sv_send(NetworkState *, pragma::BasePlayerComponent *, std::v
 	NetPacket packet;
 	packet->WriteString(argv[(argv.size() == 1) ? 0 : 1]);
 	if(argv.size() == 1)
-		server->SendPacket("sv_send", packet, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"sv_send">(packet, pragma::networking::Protocol::SlowReliable);
 	else {
 		/*server->
 		ClientSession *cs = GetSessionByPlayerID(atoi(argv[0]));
@@ -55,7 +57,7 @@ DLLSERVER void CMD_sv_send_udp(NetworkState *, pragma::BasePlayerComponent *, st
 	NetPacket packet;
 	packet->WriteString(argv[(argv.size() == 1) ? 0 : 1]);
 	if(argv.size() == 1)
-		server->SendPacket("sv_send", packet, pragma::networking::Protocol::FastUnreliable);
+		server->SendPacket<"sv_send">(packet, pragma::networking::Protocol::FastUnreliable);
 	else {
 		/*ClientSession *cs = GetSessionByPlayerID(atoi(argv[0]));
 		if(!cs)
@@ -272,3 +274,98 @@ void CMD_sv_debug_netmessages(NetworkState *state, pragma::BasePlayerComponent *
 	sv->DebugPrint(*svMsgs, *clMsgs);
 	sv->DebugDump("sv_netmessages.dump", *svMsgs, *clMsgs);
 }
+
+void CMD_sv_net_message_stats(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv)
+{
+	if(argv.empty() == false && argv.front() == "reset") {
+		server->ResetMessageStats();
+		Con::cout << "Net-message statistics have been reset." << Con::endl;
+		return;
+	}
+	std::unordered_map<std::string, uint32_t> *clMsgs;
+	GetClientMessageMap()->GetNetMessages(&clMsgs);
+	std::unordered_map<std::string, uint32_t> *svMsgs;
+	GetServerMessageMap()->GetNetMessages(&svMsgs);
+
+	Con::cout << "Sent net-messages:" << Con::endl;
+	server->GetSentMessageStats().Print(*clMsgs);
+	Con::cout << Con::endl << "Received net-messages:" << Con::endl;
+	server->GetReceivedMessageStats().Print(*svMsgs);
+}
+
+void CMD_sv_record_traffic(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv)
+{
+	if(argv.empty()) {
+		server->StopTrafficRecording();
+		return;
+	}
+	if(server->GetServer() == nullptr) {
+		Con::cwar << "No server is active!" << Con::endl;
+		return;
+	}
+	if(server->StartTrafficRecording(argv.front()) == false) {
+		Con::cwar << "Unable to start recording to '" << argv.front() << "'!" << Con::endl;
+		return;
+	}
+	Con::cout << "Recording network traffic to '" << argv.front() << "'..." << Con::endl;
+}
+
+void CMD_sv_replay_traffic(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv)
+{
+	if(argv.empty()) {
+		server->StopTrafficReplay();
+		return;
+	}
+	if(server->GetServer() == nullptr) {
+		Con::cwar << "No server is active!" << Con::endl;
+		return;
+	}
+	auto timeScale = (argv.size() > 1) ? util::to_float(argv[1]) : 1.f;
+	if(server->StartTrafficReplay(argv.front(), timeScale))
+		Con::cout << "Replaying network traffic from '" << argv.front() << "'..." << Con::endl;
+}
+
+void CMD_sv_loadgen(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv)
+{
+	if(argv.empty()) {
+		server->StopLoadGenerator();
+		return;
+	}
+	if(server->GetServer() == nullptr) {
+		Con::cwar << "No server is active!" << Con::endl;
+		return;
+	}
+	auto numClients = util::to_int(argv.front());
+	if(numClients <= 0) {
+		Con::cwar << "Invalid number of clients!" << Con::endl;
+		return;
+	}
+	auto joinInterval = (argv.size() > 1) ? util::to_float(argv[1]) : 0.1f;
+	auto inputRate = (argv.size() > 2) ? util::to_float(argv[2]) : 30.f;
+	if(server->StartLoadGenerator(numClients, joinInterval, inputRate))
+		Con::cout << "Connecting " << numClients << " load generator clients..." << Con::endl;
+}
+
+void CMD_sv_net_scheduler_stats(NetworkState *state, pragma::BasePlayerComponent *pl, std::vector<std::string> &argv)
+{
+	auto *sv = server->GetServer();
+	if(sv == nullptr) {
+		Con::cwar << "No server is active!" << Con::endl;
+		return;
+	}
+	auto &clients = sv->GetClients();
+	if(argv.empty() == false && argv.front() == "reset") {
+		for(auto &cl : clients)
+			cl->GetOutgoingQueue().ResetStats();
+		Con::cout << "Outgoing scheduler statistics have been reset." << Con::endl;
+		return;
+	}
+	if(sv->IsOutgoingSchedulerEnabled() == false)
+		Con::cout << "Outgoing scheduler is disabled (sv_net_scheduler)." << Con::endl;
+	for(auto &cl : clients) {
+		auto &queue = cl->GetOutgoingQueue();
+		auto &stats = queue.GetStats();
+		Con::cout << cl->GetIdentifier() << ": Rate " << util::get_pretty_bytes(queue.GetRate()) << "/s, queue depth " << queue.GetQueueDepth() << " (max " << stats.maxQueueDepth << "), " << stats.sentMessageCount << " of " << stats.queuedMessageCount << " messages sent in "
+		          << stats.sentDatagramCount << " datagrams (" << util::get_pretty_bytes(stats.sentByteCount) << ", " << stats.bundledMessageCount << " bundled), " << stats.deferredMessageCount << " deferred, " << stats.droppedMessageCount << " dropped" << Con::endl;
+	}
+}
@@ -477,6 +477,9 @@ void SAIComponent::SelectEnemies()
 	auto numPrevTargets = GetMemoryFragmentCount();
 	std::vector<TargetInfo> newTargets;
 	Listen(newTargets);
+
+	// Collect all potential targets first, so the line of sight checks can be done in a single batch
+	std::vector<BaseEntity *> candidates;
 	for(unsigned int i = 0; i < s_npcs.size(); i++) {
 		SAIComponent *npc = s_npcs[i];
 		auto &ent = npc->GetEntity();
@@ -484,11 +487,8 @@ void SAIComponent::SelectEnemies()
 			auto *charComponent = static_cast<pragma::SCharacterComponent *>(ent.GetCharacterComponent().get());
 			if(charComponent == nullptr || (charComponent->IsAlive() == true && charComponent->GetNoTarget() == false)) {
 				auto disp = GetDisposition(&ent);
-				float dist;
-				if(disp == DISPOSITION::HATE && !IsInMemory(&ent) && IsInViewCone(&ent, &dist)) {
-					if(Memorize(&ent, ai::Memory::MemoryType::Visual) != nullptr)
-						newTargets.push_back({&ent, dist});
-				}
+				if(disp == DISPOSITION::HATE && !IsInMemory(&ent))
+					candidates.push_back(&ent);
 			}
 		}
 	}
@@ -499,10 +499,19 @@ void SAIComponent::SelectEnemies()
 		if(charComponent != nullptr && charComponent->IsAlive() == false)
 			continue;
 		auto disp = GetDisposition(&ent);
-		float dist;
-		if(disp == DISPOSITION::HATE && charComponent->GetNoTarget() == false && !IsInMemory(&ent) && IsInViewCone(&ent, &dist)) {
-			if(Memorize(&ent, ai::Memory::MemoryType::Visual) != nullptr)
-				newTargets.push_back({&ent, dist});
+		if(disp == DISPOSITION::HATE && charComponent->GetNoTarget() == false && !IsInMemory(&ent))
+			candidates.push_back(&ent);
+	}
+	if(candidates.empty() == false) {
+		std::vector<bool> visible;
+		std::vector<float> distances;
+		IsInViewCone(candidates, visible, distances);
+		for(auto i = decltype(candidates.size()) {0u}; i < candidates.size(); ++i) {
+			if(visible[i] == false)
+				continue;
+			auto *ent = candidates[i];
+			if(Memorize(ent, ai::Memory::MemoryType::Visual) != nullptr)
+				newTargets.push_back({ent, distances[i]});
 		}
 	}
 	SelectPrimaryTarget();
@@ -536,6 +545,11 @@ util::EventReply SAIComponent::HandleEvent(ComponentEventId eventId, ComponentEv
 		OnKilled(static_cast<const CEOnCharacterKilled &>(evData).damageInfo);
 	return util::EventReply::Unhandled;
 }
+void SAIComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseAIComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseCharacterComponent::EVENT_ON_KILLED);
+}
 
 bool SAIComponent::HasCharacterNoTargetEnabled(const BaseEntity &ent) const
 {
@@ -44,7 +44,7 @@ void SAIComponent::_debugSendNavInfo(pragma::SPlayerComponent &pl)
 	}
 	auto *session = pl.GetClientSession();
 	if(session)
-		server->SendPacket("debug_ai_navigation", p, pragma::networking::Protocol::SlowReliable, *session);
+		server->SendPacket<"debug_ai_navigation">(p, pragma::networking::Protocol::SlowReliable, *session);
 }
 
 void SAIComponent::_debugSendScheduleInfo(pragma::SPlayerComponent &pl, std::shared_ptr<DebugBehaviorTreeNode> &dbgTree, std::shared_ptr<::ai::Schedule> &aiSchedule, float &tLastSchedUpdate)
@@ -59,7 +59,7 @@ void SAIComponent::_debugSendScheduleInfo(pragma::SPlayerComponent &pl, std::sha
 				p->Write<uint8_t>(static_cast<uint8_t>(0));
 				auto *session = pl.GetClientSession();
 				if(session)
-					server->SendPacket("debug_ai_schedule_tree", p, pragma::networking::Protocol::SlowReliable, *session);
+					server->SendPacket<"debug_ai_schedule_tree">(p, pragma::networking::Protocol::SlowReliable, *session);
 				aiSchedule = nullptr;
 			}
 		}
@@ -175,7 +175,7 @@ void SAIComponent::_debugSendScheduleInfo(pragma::SPlayerComponent &pl, std::sha
 	}
 	auto *session = pl.GetClientSession();
 	if(session)
-		server->SendPacket("debug_ai_schedule_tree", p, pragma::networking::Protocol::SlowReliable, *session);
+		server->SendPacket<"debug_ai_schedule_tree">(p, pragma::networking::Protocol::SlowReliable, *session);
 }
 
 void NET_sv_debug_ai_navigation(pragma::networking::IServerClient &session, NetPacket packet)
@@ -18,29 +18,40 @@ extern DLLSERVER SGame *s_game;
 void SAIComponent::UpdateMemory()
 {
 	double t = s_game->CurTime();
+	std::vector<ai::Memory::Fragment *> fragmentsToCheck;
+	std::vector<BaseEntity *> entsToCheck;
 	for(auto &fragment : m_memory.fragments) {
 		if(fragment.occupied == true) {
-			float dist;
 			if(!fragment.hEntity.valid() || (fragment.hEntity->IsCharacter() && fragment.hEntity->GetCharacterComponent()->IsAlive() == false) || (!fragment.visible && t - fragment.GetLastTimeSensed() >= m_memoryDuration) || HasCharacterNoTargetEnabled(*fragment.hEntity.get()) == true)
 				m_memory.Clear(fragment);
 			else if(t - fragment.lastSeen >= (fragment.visible ? AI_MEMORY_NEXT_CHECK_IF_HIDDEN : AI_MEMORY_NEXT_CHECK_IF_VISIBLE)) {
-				if(!IsInViewCone(fragment.hEntity.get(), &dist)) {
-					auto bVisible = fragment.visible;
-					fragment.visible = false;
-					if(bVisible == true)
-						OnTargetVisibilityLost(fragment);
-				}
-				else {
-					auto bVisible = fragment.visible;
-					fragment.visible = true;
-					fragment.UpdateVisibility(dist);
-					if(bVisible == false)
-						OnTargetVisibilityReacquired(fragment);
-				}
-				fragment.lastCheck = CFloat(t);
+				fragmentsToCheck.push_back(&fragment);
+				entsToCheck.push_back(fragment.hEntity.get());
 			}
 		}
 	}
+	if(fragmentsToCheck.empty())
+		return;
+	std::vector<bool> visible;
+	std::vector<float> distances;
+	IsInViewCone(entsToCheck, visible, distances);
+	for(auto i = decltype(fragmentsToCheck.size()) {0u}; i < fragmentsToCheck.size(); ++i) {
+		auto &fragment = *fragmentsToCheck[i];
+		if(!visible[i]) {
+			auto bVisible = fragment.visible;
+			fragment.visible = false;
+			if(bVisible == true)
+				OnTargetVisibilityLost(fragment);
+		}
+		else {
+			auto bVisible = fragment.visible;
+			fragment.visible = true;
+			fragment.UpdateVisibility(distances[i]);
+			if(bVisible == false)
+				OnTargetVisibilityReacquired(fragment);
+		}
+		fragment.lastCheck = CFloat(t);
+	}
 }
 
 void SAIComponent::OnTargetVisibilityLost(const ai::Memory::Fragment &fragment)
@@ -15,11 +15,11 @@ using namespace pragma;
 extern DLLSERVER ServerState *server;
 extern DLLSERVER SGame *s_game;
 
-bool SAIComponent::IsInViewCone(BaseEntity *ent, float *dist)
+bool SAIComponent::GetViewConeTraceData(BaseEntity &ent, TraceData &outData, float &outDist) const
 {
 	auto &entThis = GetEntity();
 	auto charComponent = entThis.GetCharacterComponent();
-	auto pTrComponent = ent->GetTransformComponent();
+	auto pTrComponent = ent.GetTransformComponent();
 	if(charComponent.expired() || pTrComponent == nullptr)
 		return false;
 	auto dir = charComponent->GetViewForward();
@@ -30,19 +30,57 @@ bool SAIComponent::IsInViewCone(BaseEntity *ent, float *dist)
 	auto dirEnt = posEnt - pos;
 	uvec::normalize(&dirEnt);
 	auto dot = uvec::dot(dir, dirEnt);
-	if(dot >= m_maxViewDot) {
-		auto d = glm::distance(pos, posEnt);
-		if(dist != nullptr)
-			*dist = d;
-		if(d <= m_maxViewDist) {
-			auto data = charComponent->GetAimTraceData();
-			data.SetTarget(posEnt);
-			auto res = s_game->RayCast(data);
-			if(res.hitType == RayCastHitType::None || res.entity.get() == ent)
-				return true;
-		}
+	if(dot < m_maxViewDot)
+		return false;
+	outDist = glm::distance(pos, posEnt);
+	if(outDist > m_maxViewDist)
+		return false;
+	outData = charComponent->GetAimTraceData();
+	outData.SetTarget(posEnt);
+	return true;
+}
+
+bool SAIComponent::IsInViewCone(BaseEntity *ent, float *dist)
+{
+	TraceData data;
+	auto d = std::numeric_limits<float>::max();
+	auto inViewCone = GetViewConeTraceData(*ent, data, d);
+	if(dist != nullptr && d != std::numeric_limits<float>::max())
+		*dist = d;
+	if(inViewCone == false)
+		return false;
+	auto res = s_game->RayCast(data);
+	return res.hitType == RayCastHitType::None || res.entity.get() == ent;
+}
+
+void SAIComponent::IsInViewCone(const std::vector<BaseEntity *> &ents, std::vector<bool> &outVisible, std::vector<float> &outDistances)
+{
+	outVisible.clear();
+	outVisible.resize(ents.size(), false);
+	outDistances.clear();
+	outDistances.resize(ents.size(), std::numeric_limits<float>::max());
+
+	std::vector<TraceData> traces;
+	std::vector<size_t> traceEntIndices;
+	traces.reserve(ents.size());
+	traceEntIndices.reserve(ents.size());
+	for(auto i = decltype(ents.size()) {0u}; i < ents.size(); ++i) {
+		TraceData data;
+		if(GetViewConeTraceData(*ents[i], data, outDistances[i]) == false)
+			continue;
+		traces.push_back(std::move(data));
+		traceEntIndices.push_back(i);
+	}
+	if(traces.empty())
+		return;
+	std::vector<TraceResult> results(traces.size());
+	// The queries are only run in parallel if the physics module supports concurrent queries
+	s_game->RayCastBatch(traces, results, pragma::physics::IEnvironment::BatchQueryFlags::Parallel);
+	for(auto i = decltype(results.size()) {0u}; i < results.size(); ++i) {
+		auto entIdx = traceEntIndices[i];
+		auto &res = results[i];
+		outVisible[entIdx] = (res.hitType == RayCastHitType::None || res.entity.get() == ents[entIdx]);
 	}
-	return false;
 }
 
 bool SAIComponent::CanSee() const { return (GetMaxViewDistance() > 0 && GetMaxViewAngle() > 0) ? true : false; }
@@ -32,7 +32,7 @@ AttachmentData *SAttachmentComponent::SetupAttachment(BaseEntity *ent, const Att
 		p->Write<FAttachmentMode>(attInfo.flags);
 		p->Write<Vector3>(attData->offset);
 		p->Write<Quat>(attData->rotation);
-		server->SendPacket("ent_setparent", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"ent_setparent">(p, pragma::networking::Protocol::SlowReliable);
 	}
 	return attData;
 }
@@ -45,7 +45,7 @@ void SAttachmentComponent::SetAttachmentFlags(FAttachmentMode flags)
 		NetPacket p;
 		nwm::write_entity(p, &entThis);
 		p->Write<FAttachmentMode>(flags);
-		server->SendPacket("ent_setparentmode", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"ent_setparentmode">(p, pragma::networking::Protocol::SlowReliable);
 	}
 }
 
@@ -20,5 +20,5 @@ void SEntityComponentManager::OnComponentTypeRegistered(const ComponentInfo &com
 	NetPacket p {};
 	p->Write<ComponentId>(componentInfo.id);
 	p->WriteString(*componentInfo.name);
-	server->SendPacket("register_entity_component", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"register_entity_component">(p, pragma::networking::Protocol::SlowReliable);
 }
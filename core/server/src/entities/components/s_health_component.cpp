@@ -26,6 +26,6 @@ void SHealthComponent::SetHealth(unsigned short health)
 	NetPacket p;
 	nwm::write_entity(p, &ent);
 	p->Write<unsigned short>(health);
-	server->SendPacket("ent_sethealth", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"ent_sethealth">(p, pragma::networking::Protocol::SlowReliable);
 }
 void SHealthComponent::InitializeLuaObject(lua_State *l) { return BaseEntityComponent::InitializeLuaObject<std::remove_reference_t<decltype(*this)>>(l); }
@@ -26,6 +26,6 @@ void SNameComponent::SetName(std::string name)
 	NetPacket p;
 	nwm::write_entity(p, &ent);
 	p->WriteString(name);
-	server->SendPacket("ent_setname", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"ent_setname">(p, pragma::networking::Protocol::SlowReliable);
 }
 void SNameComponent::InitializeLuaObject(lua_State *l) { return BaseEntityComponent::InitializeLuaObject<std::remove_reference_t<decltype(*this)>>(l); }
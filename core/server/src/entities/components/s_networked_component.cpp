@@ -6,6 +6,7 @@
 
 #include "stdafx_server.h"
 #include "pragma/entities/components/s_networked_component.hpp"
+#include "pragma/entities/components/s_player_component.hpp"
 #include "pragma/lua/s_lentity_handles.hpp"
 #include <pragma/lua/converters/game_type_converters_t.hpp>
 #include <sharedutils/property/util_property_euler_angles.hpp>
@@ -13,6 +14,13 @@
 
 using namespace pragma;
 
+ComponentEventId SNetworkedComponent::EVENT_CHECK_RELEVANCE = INVALID_COMPONENT_ID;
+void SNetworkedComponent::RegisterEvents(pragma::EntityComponentManager &componentManager, TRegisterComponentEvent registerEvent)
+{
+	BaseNetworkedComponent::RegisterEvents(componentManager, registerEvent);
+	EVENT_CHECK_RELEVANCE = registerEvent("CHECK_RELEVANCE", ComponentEventInfo::Type::Broadcast);
+}
+
 void SNetworkedComponent::SendData(NetPacket &packet, networking::ClientRecipientFilter &rp)
 {
 #if NETWORKED_VARS_ENABLED != 0
@@ -25,6 +33,28 @@ void SNetworkedComponent::SendData(NetPacket &packet, networking::ClientRecipien
 
 void SNetworkedComponent::InitializeLuaObject(lua_State *l) { return BaseEntityComponent::InitializeLuaObject<std::remove_reference_t<decltype(*this)>>(l); }
 
+void SNetworkedComponent::SetRelevance(Relevance relevance) { m_relevance = relevance; }
+SNetworkedComponent::Relevance SNetworkedComponent::GetRelevance() const { return m_relevance; }
+void SNetworkedComponent::SetRelevanceRadius(float radius) { m_relevanceRadius = radius; }
+float SNetworkedComponent::GetRelevanceRadius() const { return m_relevanceRadius; }
+void SNetworkedComponent::SetTransmitPriority(TransmitPriority priority) { m_transmitPriority = priority; }
+SNetworkedComponent::TransmitPriority SNetworkedComponent::GetTransmitPriority() const { return m_transmitPriority; }
+
+//////////////////
+
+CECheckRelevance::CECheckRelevance(pragma::SPlayerComponent &player, bool relevant) : player {player}, relevant {relevant} {}
+void CECheckRelevance::PushArguments(lua_State *l)
+{
+	player.PushLuaObject(l);
+	Lua::PushBool(l, relevant);
+}
+uint32_t CECheckRelevance::GetReturnCount() { return 1u; }
+void CECheckRelevance::HandleReturnValues(lua_State *l)
+{
+	if(Lua::IsBool(l, -1))
+		relevant = Lua::CheckBool(l, -1);
+}
+
 #if NETWORKED_VARS_ENABLED != 0
 template<typename T>
 SNetworkedComponent::NetworkedVariable::Type SNetworkedComponent::get_networked_variable_type()
@@ -39,7 +39,7 @@ void SPhysicsComponent::SetKinematic(bool b)
 		NetPacket p;
 		nwm::write_entity(p, &ent);
 		p->Write<bool>(b);
-		server->SendPacket("ent_setkinematic", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"ent_setkinematic">(p, pragma::networking::Protocol::SlowReliable);
 	}
 }
 
@@ -52,7 +52,7 @@ void SPhysicsComponent::SetMoveType(MOVETYPE movetype)
 	NetPacket p;
 	nwm::write_entity(p, &ent);
 	p->Write<unsigned char>(static_cast<unsigned char>(movetype));
-	server->SendPacket("ent_movetype", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"ent_movetype">(p, pragma::networking::Protocol::SlowReliable);
 }
 void SPhysicsComponent::OnPhysicsInitialized()
 {
@@ -62,7 +62,7 @@ void SPhysicsComponent::OnPhysicsInitialized()
 		NetPacket p;
 		nwm::write_entity(p, &ent);
 		p->Write<unsigned int>(static_cast<unsigned int>(m_physicsType));
-		server->SendPacket("ent_phys_init", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"ent_phys_init">(p, pragma::networking::Protocol::SlowReliable);
 	}
 }
 void SPhysicsComponent::OnPhysicsDestroyed()
@@ -72,7 +72,7 @@ void SPhysicsComponent::OnPhysicsDestroyed()
 	if(ent.IsShared()) {
 		NetPacket p;
 		nwm::write_entity(p, &ent);
-		server->SendPacket("ent_phys_destroy", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"ent_phys_destroy">(p, pragma::networking::Protocol::SlowReliable);
 	}
 }
 void SPhysicsComponent::GetBaseTypeIndex(std::type_index &outTypeIndex) const { outTypeIndex = std::type_index(typeid(BasePhysicsComponent)); }
@@ -105,7 +105,7 @@ void SPhysicsComponent::SetCollisionType(COLLISIONTYPE collisiontype)
 	NetPacket p;
 	nwm::write_entity(p, &ent);
 	p->Write<unsigned char>(static_cast<unsigned char>(collisiontype));
-	server->SendPacket("ent_collisiontype", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"ent_collisiontype">(p, pragma::networking::Protocol::SlowReliable);
 }
 
 void SPhysicsComponent::SetCollisionFilter(CollisionMask filterGroup, CollisionMask filterMask)
@@ -117,7 +117,7 @@ void SPhysicsComponent::SetCollisionFilter(CollisionMask filterGroup, CollisionM
 		nwm::write_entity(p, &ent);
 		p->Write<unsigned int>(static_cast<unsigned int>(filterGroup));
 		p->Write<unsigned int>(static_cast<unsigned int>(filterMask));
-		server->SendPacket("ent_setcollisionfilter", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"ent_setcollisionfilter">(p, pragma::networking::Protocol::SlowReliable);
 	}
 }
 
@@ -147,6 +147,11 @@ util::EventReply SPlayerComponent::HandleEvent(ComponentEventId eventId, Compone
 		OnRespawn();
 	return util::EventReply::Unhandled;
 }
+void SPlayerComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BasePlayerComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseCharacterComponent::EVENT_ON_RESPAWN);
+}
 
 void SPlayerComponent::OnRespawn()
 {
@@ -282,7 +287,7 @@ void SPlayerComponent::OnSetSlopeLimit(float limit)
 		NetPacket p;
 		nwm::write_entity(p, &ent);
 		p->Write<float>(limit);
-		server->SendPacket("pl_slopelimit", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"pl_slopelimit">(p, pragma::networking::Protocol::SlowReliable);
 	}
 }
 void SPlayerComponent::OnSetStepOffset(float offset)
@@ -292,7 +297,7 @@ void SPlayerComponent::OnSetStepOffset(float offset)
 		NetPacket p;
 		nwm::write_entity(p, &ent);
 		p->Write<float>(offset);
-		server->SendPacket("pl_stepoffset", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"pl_stepoffset">(p, pragma::networking::Protocol::SlowReliable);
 	}
 }
 
@@ -341,7 +346,7 @@ void SPlayerComponent::SetWalkSpeed(float speed)
 		NetPacket p;
 		nwm::write_entity(p, &ent);
 		p->Write<float>(speed);
-		server->SendPacket("pl_speed_walk", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"pl_speed_walk">(p, pragma::networking::Protocol::SlowReliable);
 	}
 }
 
@@ -353,7 +358,7 @@ void SPlayerComponent::SetRunSpeed(float speed)
 		NetPacket p;
 		nwm::write_entity(p, &ent);
 		p->Write<float>(speed);
-		server->SendPacket("pl_speed_run", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"pl_speed_run">(p, pragma::networking::Protocol::SlowReliable);
 	}
 }
 
@@ -365,7 +370,7 @@ void SPlayerComponent::SetCrouchedWalkSpeed(float speed)
 		NetPacket p;
 		nwm::write_entity(p, &ent);
 		p->Write<float>(speed);
-		server->SendPacket("pl_speed_crouch_walk", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"pl_speed_crouch_walk">(p, pragma::networking::Protocol::SlowReliable);
 	}
 }
 
@@ -377,7 +382,7 @@ void SPlayerComponent::SetStandHeight(float height)
 		NetPacket p;
 		nwm::write_entity(p, &ent);
 		p->Write<float>(height);
-		server->SendPacket("pl_height_stand", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"pl_height_stand">(p, pragma::networking::Protocol::SlowReliable);
 	}
 }
 void SPlayerComponent::SetCrouchHeight(float height)
@@ -388,7 +393,7 @@ void SPlayerComponent::SetCrouchHeight(float height)
 		NetPacket p;
 		nwm::write_entity(p, &ent);
 		p->Write<float>(height);
-		server->SendPacket("pl_height_crouch", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"pl_height_crouch">(p, pragma::networking::Protocol::SlowReliable);
 	}
 }
 void SPlayerComponent::SetStandEyeLevel(float eyelevel)
@@ -399,7 +404,7 @@ void SPlayerComponent::SetStandEyeLevel(float eyelevel)
 		NetPacket p;
 		nwm::write_entity(p, &ent);
 		p->Write<float>(eyelevel);
-		server->SendPacket("pl_eyelevel_stand", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"pl_eyelevel_stand">(p, pragma::networking::Protocol::SlowReliable);
 	}
 }
 void SPlayerComponent::SetCrouchEyeLevel(float eyelevel)
@@ -410,7 +415,7 @@ void SPlayerComponent::SetCrouchEyeLevel(float eyelevel)
 		NetPacket p;
 		nwm::write_entity(p, &ent);
 		p->Write<float>(eyelevel);
-		server->SendPacket("pl_eyelevel_crouch", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"pl_eyelevel_crouch">(p, pragma::networking::Protocol::SlowReliable);
 	}
 }
 
@@ -429,7 +434,7 @@ void SPlayerComponent::SetSprintSpeed(float speed)
 		NetPacket p;
 		nwm::write_entity(p, &ent);
 		p->Write<float>(speed);
-		server->SendPacket("pl_speed_sprint", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"pl_speed_sprint">(p, pragma::networking::Protocol::SlowReliable);
 	}
 }
 void SPlayerComponent::GetBaseTypeIndex(std::type_index &outTypeIndex) const { outTypeIndex = std::type_index(typeid(BasePlayerComponent)); }
@@ -26,7 +26,7 @@ void SRenderComponent::SetUnlit(bool b)
 	NetPacket p;
 	nwm::write_entity(p, &ent);
 	p->Write<bool>(b);
-	server->SendPacket("ent_setunlit", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"ent_setunlit">(p, pragma::networking::Protocol::SlowReliable);
 }
 void SRenderComponent::SetCastShadows(bool b)
 {
@@ -37,5 +37,5 @@ void SRenderComponent::SetCastShadows(bool b)
 	NetPacket p;
 	nwm::write_entity(p, &ent);
 	p->Write<bool>(b);
-	server->SendPacket("ent_setcastshadows", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"ent_setcastshadows">(p, pragma::networking::Protocol::SlowReliable);
 }
@@ -66,7 +66,7 @@ std::shared_ptr<ALSound> SSoundEmitterComponent::CreateSound(std::string sndname
 		NetPacket p;
 		nwm::write_entity(p, &ent);
 		p->Write<unsigned int>(snd->GetIndex());
-		server->SendPacket("ent_sound", p, pragma::networking::Protocol::FastUnreliable);
+		server->SendPacket<"ent_sound">(p, pragma::networking::Protocol::FastUnreliable);
 	}
 	return ptrSnd;
 }
@@ -47,5 +47,5 @@ void STransformComponent::SetEyeOffset(const Vector3 &offset)
 	NetPacket p;
 	nwm::write_entity(p, &ent);
 	nwm::write_vector(p, offset);
-	server->SendPacket("ent_eyeoffset", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"ent_eyeoffset">(p, pragma::networking::Protocol::SlowReliable);
 }
@@ -159,7 +159,7 @@ void SWeaponComponent::Deploy()
 	if(ent.IsShared()) {
 		NetPacket p;
 		nwm::write_entity(p, &ent);
-		server->SendPacket("wep_deploy", p, pragma::networking::Protocol::FastUnreliable);
+		server->SendPacket<"wep_deploy">(p, pragma::networking::Protocol::FastUnreliable);
 	}
 }
 
@@ -170,7 +170,7 @@ void SWeaponComponent::Holster()
 	if(ent.IsShared()) {
 		NetPacket p;
 		nwm::write_entity(p, &ent);
-		server->SendPacket("wep_holster", p, pragma::networking::Protocol::FastUnreliable);
+		server->SendPacket<"wep_holster">(p, pragma::networking::Protocol::FastUnreliable);
 	}
 }
 
@@ -188,7 +188,7 @@ void SWeaponComponent::PrimaryAttack()
 		nwm::write_entity(p, &ent);
 		networking::ClientRecipientFilter rpFilter;
 		GetTargetRecipients(rpFilter);
-		server->SendPacket("wep_primaryattack", p, pragma::networking::Protocol::FastUnreliable, rpFilter);
+		server->SendPacket<"wep_primaryattack">(p, pragma::networking::Protocol::FastUnreliable, rpFilter);
 	}
 }
 void SWeaponComponent::SecondaryAttack()
@@ -202,7 +202,7 @@ void SWeaponComponent::SecondaryAttack()
 		nwm::write_entity(p, &ent);
 		networking::ClientRecipientFilter rpFilter;
 		GetTargetRecipients(rpFilter);
-		server->SendPacket("wep_secondaryattack", p, pragma::networking::Protocol::FastUnreliable, rpFilter);
+		server->SendPacket<"wep_secondaryattack">(p, pragma::networking::Protocol::FastUnreliable, rpFilter);
 	}
 }
 void SWeaponComponent::TertiaryAttack()
@@ -214,7 +214,7 @@ void SWeaponComponent::TertiaryAttack()
 		nwm::write_entity(p, &ent);
 		networking::ClientRecipientFilter rpFilter;
 		GetTargetRecipients(rpFilter);
-		server->SendPacket("wep_attack3", p, pragma::networking::Protocol::FastUnreliable, rpFilter);
+		server->SendPacket<"wep_attack3">(p, pragma::networking::Protocol::FastUnreliable, rpFilter);
 	}
 }
 void SWeaponComponent::Attack4()
@@ -226,7 +226,7 @@ void SWeaponComponent::Attack4()
 		nwm::write_entity(p, &ent);
 		networking::ClientRecipientFilter rpFilter;
 		GetTargetRecipients(rpFilter);
-		server->SendPacket("wep_attack4", p, pragma::networking::Protocol::FastUnreliable, rpFilter);
+		server->SendPacket<"wep_attack4">(p, pragma::networking::Protocol::FastUnreliable, rpFilter);
 	}
 }
 void SWeaponComponent::Reload()
@@ -238,7 +238,7 @@ void SWeaponComponent::Reload()
 		nwm::write_entity(p, &ent);
 		networking::ClientRecipientFilter rpFilter;
 		GetTargetRecipients(rpFilter);
-		server->SendPacket("wep_reload", p, pragma::networking::Protocol::FastUnreliable, rpFilter);
+		server->SendPacket<"wep_reload">(p, pragma::networking::Protocol::FastUnreliable, rpFilter);
 	}
 }
 void SWeaponComponent::SetPrimaryClipSize(UInt16 size)
@@ -251,7 +251,7 @@ void SWeaponComponent::SetPrimaryClipSize(UInt16 size)
 		p->Write<UInt16>(*m_clipPrimary);
 		networking::ClientRecipientFilter rpFilter;
 		GetTargetRecipients(rpFilter);
-		server->SendPacket("wep_prim_clip_size", p, pragma::networking::Protocol::FastUnreliable);
+		server->SendPacket<"wep_prim_clip_size">(p, pragma::networking::Protocol::FastUnreliable);
 	}
 }
 void SWeaponComponent::SetSecondaryClipSize(UInt16 size)
@@ -264,7 +264,7 @@ void SWeaponComponent::SetSecondaryClipSize(UInt16 size)
 		p->Write<UInt16>(*m_clipSecondary);
 		networking::ClientRecipientFilter rpFilter;
 		GetTargetRecipients(rpFilter);
-		server->SendPacket("wep_sec_clip_size", p, pragma::networking::Protocol::FastUnreliable);
+		server->SendPacket<"wep_sec_clip_size">(p, pragma::networking::Protocol::FastUnreliable);
 	}
 }
 void SWeaponComponent::SetMaxPrimaryClipSize(UInt16 size)
@@ -277,7 +277,7 @@ void SWeaponComponent::SetMaxPrimaryClipSize(UInt16 size)
 		p->Write<UInt16>(*m_maxPrimaryClipSize);
 		networking::ClientRecipientFilter rpFilter;
 		GetTargetRecipients(rpFilter);
-		server->SendPacket("wep_prim_max_clip_size", p, pragma::networking::Protocol::FastUnreliable);
+		server->SendPacket<"wep_prim_max_clip_size">(p, pragma::networking::Protocol::FastUnreliable);
 	}
 }
 void SWeaponComponent::SetMaxSecondaryClipSize(UInt16 size)
@@ -290,7 +290,7 @@ void SWeaponComponent::SetMaxSecondaryClipSize(UInt16 size)
 		p->Write<UInt16>(*m_maxSecondaryClipSize);
 		networking::ClientRecipientFilter rpFilter;
 		GetTargetRecipients(rpFilter);
-		server->SendPacket("wep_sec_max_clip_size", p, pragma::networking::Protocol::FastUnreliable);
+		server->SendPacket<"wep_sec_max_clip_size">(p, pragma::networking::Protocol::FastUnreliable);
 	}
 }
 void SWeaponComponent::SetPrimaryAmmoType(UInt32 type)
@@ -303,7 +303,7 @@ void SWeaponComponent::SetPrimaryAmmoType(UInt32 type)
 		p->Write<UInt32>(type);
 		networking::ClientRecipientFilter rpFilter;
 		GetTargetRecipients(rpFilter);
-		server->SendPacket("wep_prim_ammo_type", p, pragma::networking::Protocol::FastUnreliable);
+		server->SendPacket<"wep_prim_ammo_type">(p, pragma::networking::Protocol::FastUnreliable);
 	}
 }
 void SWeaponComponent::SetSecondaryAmmoType(UInt32 type)
@@ -316,7 +316,7 @@ void SWeaponComponent::SetSecondaryAmmoType(UInt32 type)
 		p->Write<UInt32>(type);
 		networking::ClientRecipientFilter rpFilter;
 		GetTargetRecipients(rpFilter);
-		server->SendPacket("wep_sec_ammo_type", p, pragma::networking::Protocol::FastUnreliable);
+		server->SendPacket<"wep_sec_ammo_type">(p, pragma::networking::Protocol::FastUnreliable);
 	}
 }
 void SWeaponComponent::AddPrimaryClip(UInt16 num) { SetPrimaryClipSize(umath::limit<UInt16>(CUInt32(GetPrimaryClipSize()) + CUInt32(num))); }
@@ -27,7 +27,7 @@ void SExplosionComponent::Explode()
 	if(ent.IsShared()) {
 		NetPacket p;
 		nwm::write_entity(p, &ent);
-		server->SendPacket("envexplosion_explode", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"envexplosion_explode">(p, pragma::networking::Protocol::SlowReliable);
 	}
 	BaseEnvExplosionComponent::Explode();
 }
@@ -31,7 +31,7 @@ void SParticleSystemComponent::SetContinuous(bool b)
 	NetPacket p;
 	nwm::write_entity(p, &GetEntity());
 	p->Write<bool>(b);
-	server->SendPacket("env_prtsys_setcontinuous", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"env_prtsys_setcontinuous">(p, pragma::networking::Protocol::SlowReliable);
 }
 
 void SParticleSystemComponent::InitializeLuaObject(lua_State *l) { return BaseEntityComponent::InitializeLuaObject<std::remove_reference_t<decltype(*this)>>(l); }
@@ -43,7 +43,7 @@ void SLightSpotComponent::SetOuterConeAngle(float ang)
 	NetPacket p;
 	nwm::write_entity(p, &ent);
 	p->Write<float>(ang);
-	server->SendPacket("env_light_spot_outercutoff_angle", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"env_light_spot_outercutoff_angle">(p, pragma::networking::Protocol::SlowReliable);
 }
 
 void SLightSpotComponent::SetBlendFraction(float ang)
@@ -55,7 +55,7 @@ void SLightSpotComponent::SetBlendFraction(float ang)
 	NetPacket p;
 	nwm::write_entity(p, &ent);
 	p->Write<float>(ang);
-	server->SendPacket("env_light_spot_innercutoff_angle", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"env_light_spot_innercutoff_angle">(p, pragma::networking::Protocol::SlowReliable);
 }
 
 void SLightSpotComponent::InitializeLuaObject(lua_State *l) { return BaseEntityComponent::InitializeLuaObject<std::remove_reference_t<decltype(*this)>>(l); }
@@ -26,7 +26,7 @@ void SFogControllerComponent::SetFogStart(float start)
 	NetPacket p;
 	nwm::write_entity(p, &GetEntity());
 	p->Write<float>(m_kvFogStart);
-	server->SendPacket("env_fogcon_setstartdist", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"env_fogcon_setstartdist">(p, pragma::networking::Protocol::SlowReliable);
 }
 void SFogControllerComponent::SetFogEnd(float end)
 {
@@ -34,7 +34,7 @@ void SFogControllerComponent::SetFogEnd(float end)
 	NetPacket p;
 	nwm::write_entity(p, &GetEntity());
 	p->Write<float>(m_kvFogEnd);
-	server->SendPacket("env_fogcon_setenddist", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"env_fogcon_setenddist">(p, pragma::networking::Protocol::SlowReliable);
 }
 void SFogControllerComponent::SetMaxDensity(float density)
 {
@@ -42,7 +42,7 @@ void SFogControllerComponent::SetMaxDensity(float density)
 	NetPacket p;
 	nwm::write_entity(p, &GetEntity());
 	p->Write<float>(m_kvMaxDensity);
-	server->SendPacket("env_fogcon_setmaxdensity", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"env_fogcon_setmaxdensity">(p, pragma::networking::Protocol::SlowReliable);
 }
 void SFogControllerComponent::SetFogType(util::FogType type) { BaseEnvFogControllerComponent::SetFogType(type); }
 void SFogControllerComponent::SendData(NetPacket &packet, networking::ClientRecipientFilter &rp)
@@ -189,9 +189,11 @@ void SBaseEntity::SendNetEvent(pragma::NetEventId eventId, NetPacket &packet, pr
 {
 	if(!IsShared() || !IsSpawned())
 		return;
+	// Member changes made before the event have to arrive before it
+	static_cast<SGame *>(GetNetworkState()->GetGameState())->FlushNetworkedMemberUpdates(*this);
 	nwm::write_entity(packet, this);
 	packet->Write<UInt32>(eventId);
-	server->SendPacket("ent_event", packet, protocol, rf);
+	server->SendPacket<"ent_event">(packet, protocol, rf);
 }
 void SBaseEntity::SendNetEvent(pragma::NetEventId eventId, NetPacket &packet, pragma::networking::Protocol protocol)
 {
@@ -283,6 +285,6 @@ pragma::ComponentHandle<pragma::BaseEntityComponent> SBaseEntity::AddNetworkedCo
 	NetPacket packet {};
 	nwm::write_entity(packet, this);
 	packet->Write<pragma::ComponentId>(componentId);
-	static_cast<ServerState *>(GetNetworkState())->SendPacket("add_shared_component", packet, pragma::networking::Protocol::SlowReliable);
+	static_cast<ServerState *>(GetNetworkState())->SendPacket<"add_shared_component">(packet, pragma::networking::Protocol::SlowReliable);
 	return c;
 }
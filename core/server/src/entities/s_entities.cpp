@@ -11,6 +11,7 @@
 #include "pragma/entities/player.h"
 #include "pragma/lua/classes/s_lua_entity.h"
 #include "pragma/game/s_game.h"
+#include "pragma/networking/interest_manager.hpp"
 #include "luasystem.h"
 #include "pragma/game/s_game_entities.h"
 #include <sharedutils/util_string.h>
@@ -75,12 +76,14 @@ void SGame::RemoveEntity(BaseEntity *ent)
 		if(ID != 0) {
 			NetPacket p;
 			nwm::write_entity(p, ent);
-			server->SendPacket("ent_remove", p, pragma::networking::Protocol::SlowReliable);
+			server->SendPacket<"ent_remove">(p, pragma::networking::Protocol::SlowReliable);
 		}
 	}
 	if(ent->IsPlayer())
 		m_numPlayers--;
 	unsigned int idx = ent->GetIndex();
+	if(m_interestManager)
+		m_interestManager->OnEntityRemoved(idx);
 #ifdef PRAGMA_ENABLE_VTUNE_PROFILING
 	debug::get_domain().BeginTask("remove_entity");
 #endif
@@ -117,7 +120,7 @@ void SGame::SpawnEntity(BaseEntity *ent) // Don't call directly
 		p->Write<unsigned int>(ent->GetIndex());
 		p->Write<unsigned int>(pMapComponent.valid() ? pMapComponent->GetMapIndex() : 0u);
 		sent->SendData(p, rp);
-		server->SendPacket("ent_create", p, pragma::networking::Protocol::SlowReliable, rp);
+		server->SendPacket<"ent_create">(p, pragma::networking::Protocol::SlowReliable, rp);
 	}
 	auto hEnt = ent->GetHandle();
 	CallCallbacks<void, BaseEntity *>("OnEntitySpawned", ent); // TODO: Call this after transmission for lua-entities has finished (Entity:OnPostSpawn)
@@ -49,6 +49,7 @@
 #include "pragma/model/s_modelmanager.h"
 #include "pragma/networking/iserver.hpp"
 #include "pragma/networking/iserver_client.hpp"
+#include "pragma/networking/interest_manager.hpp"
 #include <pragma/lua/luafunction_call.h>
 #include "pragma/entities/components/s_entity_component.hpp"
 #include "pragma/entities/components/s_vehicle_component.hpp"
@@ -74,6 +75,8 @@
 #include <pragma/entities/components/map_component.hpp>
 #include <pragma/entities/components/velocity_component.hpp>
 #include <pragma/entities/entity_component_system_t.hpp>
+#include <pragma/asset_types/world.hpp>
+#include <pragma/util/util_bsp_tree.hpp>
 #include <udm.hpp>
 
 extern DLLNETWORK Engine *engine;
@@ -86,6 +89,7 @@ DLLSERVER pragma::physics::IEnvironment *s_physEnv = nullptr;
 SGame::SGame(NetworkState *state) : Game(state)
 {
 	RegisterCallback<void, SGame *>("OnGameEnd");
+	RegisterCallback<void, bool>("OnHibernationStateChanged");
 
 	auto &staticCallbacks = get_static_server_callbacks();
 	for(auto it = staticCallbacks.begin(); it != staticCallbacks.end(); ++it) {
@@ -98,6 +102,8 @@ SGame::SGame(NetworkState *state) : Game(state)
 	m_ents.push_back(NULL); // Slot 0 is reserved
 	m_baseEnts.push_back(NULL);
 
+	m_interestManager = std::make_unique<pragma::networking::InterestManager>(*this);
+
 	m_taskManager = std::make_unique<pragma::ai::TaskManager>();
 	m_taskManager->RegisterTask(typeid(pragma::ai::TaskMoveToTarget), []() { return std::make_shared<pragma::ai::TaskMoveToTarget>(); });
 	m_taskManager->RegisterTask(typeid(pragma::ai::TaskPlayAnimation), []() { return std::make_shared<pragma::ai::TaskPlayAnimation>(); });
@@ -169,7 +175,7 @@ void SGame::SetTimeScale(float t)
 	Game::SetTimeScale(t);
 	NetPacket p;
 	p->Write<float>(t);
-	server->SendPacket("game_timescale", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"game_timescale">(p, pragma::networking::Protocol::SlowReliable);
 }
 
 static void CVAR_CALLBACK_host_timescale(NetworkState *, const ConVar &, float, float val) { s_game->SetTimeScale(val); }
@@ -217,7 +223,7 @@ bool SGame::LoadMap(const std::string &map, const Vector3 &origin, std::vector<E
 	bool b = Game::LoadMap(map, origin, entities);
 	if(b == false)
 		return false;
-	server->SendPacket("map_ready", pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"map_ready">(pragma::networking::Protocol::SlowReliable);
 	LoadNavMesh();
 
 	m_flags |= GameFlags::MapLoaded;
@@ -235,6 +241,14 @@ bool SGame::IsPhysicsSimulationEnabled() const { return cvSimEnabled->GetBool();
 std::shared_ptr<pragma::EntityComponentManager> SGame::InitializeEntityComponentManager() { return std::make_shared<pragma::SEntityComponentManager>(); }
 
 pragma::ai::TaskManager &SGame::GetAITaskManager() const { return *m_taskManager; }
+pragma::networking::InterestManager &SGame::GetInterestManager() { return *m_interestManager; }
+
+void SGame::InitializeWorldData(pragma::asset::WorldData &worldData)
+{
+	Game::InitializeWorldData(worldData);
+	auto *bspTree = worldData.GetBSPTree();
+	m_interestManager->SetBSPTree(bspTree ? bspTree->shared_from_this() : nullptr);
+}
 
 void SGame::Think()
 {
@@ -252,15 +266,29 @@ bool SGame::StopProfilingStage() { return m_profilingStageManager && m_profiling
 
 void SGame::Tick()
 {
-	Game::Tick();
+	if(server->GetHibernationMode() == ServerState::HibernationMode::SuspendSimulation) {
+		// No clients are connected, so there's nothing to simulate or transmit. Only persistent timers are kept running.
+		m_tDeltaTick = (1.f / engine->GetTickRate()) * GetTimeScale();
+		StartProfilingStage("Timers");
+		UpdateTimers(true);
+		StopProfilingStage();
+		PostTick();
+	}
+	else {
+		Game::Tick();
+
+		StartProfilingStage("NetworkedMemberUpdates");
+		FlushNetworkedMemberUpdates();
+		StopProfilingStage();
 
-	StartProfilingStage("Snapshot");
-	SendSnapshot();
-	StopProfilingStage();
+		StartProfilingStage("Snapshot");
+		SendSnapshot();
+		StopProfilingStage();
 
-	CallCallbacks<void>("Tick");
-	CallLuaCallbacks("Tick");
-	PostTick();
+		CallCallbacks<void>("Tick");
+		CallLuaCallbacks("Tick");
+		PostTick();
+	}
 
 	if(m_changeLevelInfo.has_value()) {
 		// Write entity state of all entities that have a global name component
@@ -333,7 +361,7 @@ bool SGame::RegisterNetMessage(std::string name)
 		return false;
 	NetPacket packet;
 	packet->WriteString(name);
-	server->SendPacket("luanet_reg", packet, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"luanet_reg">(packet, pragma::networking::Protocol::SlowReliable);
 	return true;
 }
 
@@ -365,7 +393,7 @@ void SGame::CreateGiblet(const GibletCreateInfo &info)
 {
 	NetPacket packet {};
 	packet->Write<GibletCreateInfo>(info);
-	server->SendPacket("create_giblet", packet, pragma::networking::Protocol::FastUnreliable);
+	server->SendPacket<"create_giblet">(packet, pragma::networking::Protocol::FastUnreliable);
 }
 
 bool SGame::IsValidGameResource(const std::string &fileName)
@@ -448,7 +476,7 @@ void SGame::CreateExplosion(const Vector3 &origin, Float radius, DamageInfo &dmg
 	NetPacket p;
 	p->Write<Vector3>(origin);
 	p->Write<float>(radius);
-	server->SendPacket("create_explosion", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"create_explosion">(p, pragma::networking::Protocol::SlowReliable);
 }
 void SGame::CreateExplosion(const Vector3 &origin, Float radius, UInt32 damage, Float force, BaseEntity *attacker, BaseEntity *inflictor, const std::function<bool(BaseEntity *, DamageInfo &)> &callback)
 {
@@ -473,7 +501,7 @@ void SGame::OnClientDropped(pragma::networking::IServerClient &client, pragma::n
 	NetPacket p;
 	nwm::write_player(p, pl);
 	p->Write<int32_t>(umath::to_integral(reason));
-	server->SendPacket("client_dropped", p, pragma::networking::Protocol::SlowReliable, {client, pragma::networking::ClientRecipientFilter::FilterType::Exclude});
+	server->SendPacket<"client_dropped">(p, pragma::networking::Protocol::SlowReliable, {client, pragma::networking::ClientRecipientFilter::FilterType::Exclude});
 	OnPlayerDropped(*pl, reason);
 	ent.RemoveSafely();
 }
@@ -486,7 +514,7 @@ void SGame::ReceiveGameReady(pragma::networking::IServerClient &session, NetPack
 	pl->SetGameReady(true);
 	NetPacket p;
 	nwm::write_player(p, pl);
-	server->SendPacket("client_ready", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"client_ready">(p, pragma::networking::Protocol::SlowReliable);
 	OnPlayerReady(*pl);
 }
 
@@ -665,14 +693,14 @@ void SGame::ReceiveUserInfo(pragma::networking::IServerClient &session, NetPacke
 
 	auto *ptrWorld = GetWorld();
 	nwm::write_entity(packetInf, (ptrWorld != nullptr) ? &ptrWorld->GetEntity() : nullptr);
-	server->SendPacket("gameinfo", packetInf, pragma::networking::Protocol::SlowReliable, rp);
-	server->SendPacket("pl_local", p, pragma::networking::Protocol::SlowReliable, session);
+	server->SendPacket<"gameinfo">(packetInf, pragma::networking::Protocol::SlowReliable, rp);
+	server->SendPacket<"pl_local">(p, pragma::networking::Protocol::SlowReliable, session);
 	NetPacket tmp {};
-	server->SendPacket("game_ready", tmp, pragma::networking::Protocol::SlowReliable, rp);
+	server->SendPacket<"game_ready">(tmp, pragma::networking::Protocol::SlowReliable, rp);
 
 	NetPacket pJoinedInfo;
 	nwm::write_player(pJoinedInfo, pl);
-	server->SendPacket("client_joined", pJoinedInfo, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"client_joined">(pJoinedInfo, pragma::networking::Protocol::SlowReliable);
 
 	if(IsMapInitialized() == true)
 		SpawnPlayer(*pl);
@@ -694,7 +722,7 @@ pragma::NetEventId SGame::RegisterNetEvent(const std::string &name)
 	NetPacket packet;
 	packet->WriteString(name);
 	packet->Write<pragma::NetEventId>(id);
-	server->SendPacket("register_net_event", packet, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"register_net_event">(packet, pragma::networking::Protocol::SlowReliable);
 	return id;
 }
 
@@ -722,7 +750,12 @@ void SGame::OnClientConVarChanged(pragma::BasePlayerComponent &pl, std::string c
 		NetPacket p;
 		nwm::write_player(p, &pl);
 		p->WriteString(value);
-		server->SendPacket("pl_changedname", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"pl_changedname">(p, pragma::networking::Protocol::SlowReliable);
+	}
+	else if(cvar == "cl_rate") {
+		auto *session = static_cast<pragma::SPlayerComponent &>(pl).GetClientSession();
+		if(session)
+			session->GetOutgoingQueue().SetRate(util::to_int(value));
 	}
 }
 
@@ -9,6 +9,8 @@
 #include "pragma/entities/components/s_player_component.hpp"
 #include "pragma/networking/iserver_client.hpp"
 #include "pragma/networking/recipient_filter.hpp"
+#include "pragma/networking/interest_manager.hpp"
+#include "pragma/console/s_cvar.h"
 #include "pragma/entities/player.h"
 #include <pragma/entities/baseplayer.hpp>
 #include <pragma/networking/snapshot_flags.hpp>
@@ -19,28 +21,205 @@
 #include <pragma/entities/entity_component_system_t.hpp>
 #include <pragma/networking/nwm_util.h>
 #include <pragma/networking/enums.hpp>
+#include <pragma/networking/snapshot_codec.hpp>
+#include "pragma/lua/s_lua_component.hpp"
 
 extern DLLSERVER ServerState *server;
 
+static CVar cvSnapshotCompression = GetServerConVar("sv_snapshot_compression");
+static CVar cvSnapshotPositionPrecision = GetServerConVar("sv_snapshot_position_precision");
+static CVar cvSnapshotVelocityPrecision = GetServerConVar("sv_snapshot_velocity_precision");
+static CVar cvSnapshotAngularVelocityPrecision = GetServerConVar("sv_snapshot_angular_velocity_precision");
+static CVar cvSnapshotRotationBits = GetServerConVar("sv_snapshot_rotation_bits");
+
+void SGame::InitializeSnapshotStates()
+{
+	constexpr auto minPrecision = 0.0001f;
+	auto &settings = m_snapshotQuantizationSettings;
+	settings.positionPrecision = umath::max(cvSnapshotPositionPrecision->GetFloat(), minPrecision);
+	settings.velocityPrecision = umath::max(cvSnapshotVelocityPrecision->GetFloat(), minPrecision);
+	settings.angularVelocityPrecision = umath::max(cvSnapshotAngularVelocityPrecision->GetFloat(), minPrecision);
+	settings.rotationBits = static_cast<uint8_t>(umath::clamp(cvSnapshotRotationBits->GetInt(), 4, 20));
+	m_snapshotStates = std::make_unique<pragma::networking::SnapshotStateTable>();
+}
+
+const pragma::networking::QuantizedEntityState &SGame::GetSnapshotState(SBaseEntity &ent)
+{
+	auto it = m_snapshotStates->find(ent.GetIndex());
+	if(it != m_snapshotStates->end())
+		return it->second;
+	auto pTrComponent = ent.GetTransformComponent();
+	auto pVelComponent = ent.GetComponent<pragma::VelocityComponent>();
+	auto state = pragma::networking::QuantizedEntityState::Create(m_snapshotQuantizationSettings, pTrComponent != nullptr ? pTrComponent->GetPosition() : Vector3 {}, pVelComponent.valid() ? pVelComponent->GetVelocity() : Vector3 {},
+	  pVelComponent.valid() ? pVelComponent->GetAngularVelocity() : Vector3 {}, pTrComponent != nullptr ? pTrComponent->GetRotation() : uquat::identity());
+	return m_snapshotStates->insert(std::make_pair(ent.GetIndex(), state)).first->second;
+}
+
+void SGame::WriteEntitySnapshotData(NetPacket &packet, SBaseEntity &ent, pragma::SPlayerComponent &pl, pragma::networking::SnapshotEncoding encoding)
+{
+	auto offsetEntData = packet->GetSize();
+	packet->Write<UInt8>(UInt8(0));
+	auto offset = packet->GetSize();
+	ent.SendSnapshotData(packet, pl);
+	auto entDataSize = packet->GetSize() - offset;
+#ifdef _DEBUG
+	assert(entDataSize <= std::numeric_limits<UInt8>::max());
+#endif
+	packet->Write<UInt8>(CUInt8(entDataSize), &offsetEntData);
+
+	auto flags = pragma::SnapshotFlags::None;
+	auto offsetSnapshotFlags = packet->GetOffset();
+	packet->Write<decltype(flags)>(flags);
+
+	auto pPhysComponent = ent.GetPhysicsComponent();
+	PhysObj *physObj = pPhysComponent != nullptr ? pPhysComponent->GetPhysicsObject() : nullptr;
+	if(physObj != NULL && !physObj->IsStatic()) {
+		flags |= pragma::SnapshotFlags::PhysicsData;
+		auto writePhysObjState = [this, encoding, &packet](const Vector3 &pos, const Quat &rot, const Vector3 &vel, const Vector3 &angVel) {
+			if(encoding == pragma::networking::SnapshotEncoding::Raw) {
+				packet->Write<Vector3>(pos);
+				packet->Write<Quat>(rot);
+				packet->Write<Vector3>(vel);
+				packet->Write<Vector3>(angVel);
+				return;
+			}
+			auto &settings = m_snapshotQuantizationSettings;
+			pragma::networking::snapshot::write_quantized_vector(packet, pos, settings.positionPrecision);
+			pragma::networking::snapshot::write_quantized_rotation(packet, rot, settings.rotationBits);
+			pragma::networking::snapshot::write_quantized_vector(packet, vel, settings.velocityPrecision);
+			pragma::networking::snapshot::write_quantized_vector(packet, angVel, settings.angularVelocityPrecision);
+		};
+		if(physObj->IsController()) {
+			packet->Write<uint8_t>(1u);
+			auto *physController = static_cast<ControllerPhysObj *>(physObj);
+			writePhysObjState(physController->GetPosition(), physController->GetOrientation(), physController->GetLinearVelocity(), physController->GetAngularVelocity());
+		}
+		else {
+			auto colObjs = physObj->GetCollisionObjects();
+			packet->Write<uint8_t>(static_cast<uint8_t>(colObjs.size()));
+			//auto i = 0;
+			for(auto &hObj : colObjs) {
+				Vector3 pos {0.f, 0.f, 0.f};
+				auto rot = uquat::identity();
+				Vector3 vel {0.f, 0.f, 0.f};
+				Vector3 angVel {0.f, 0.f, 0.f};
+				if(hObj.IsValid()) {
+					auto *o = hObj.Get();
+					pos = o->GetPos();
+					rot = o->GetRotation();
+					if(o->IsRigid()) {
+						auto *rigid = o->GetRigidBody();
+						vel = rigid->GetLinearVelocity();
+						angVel = rigid->GetAngularVelocity();
+					}
+				}
+				writePhysObjState(pos, rot, vel, angVel);
+			}
+		}
+	}
+
+	auto offsetNumComponents = 0u;
+	auto numComponents = 0u;
+	auto bFirst = true;
+	for(auto &pComponent : ent.GetComponents()) {
+		if(pComponent.expired() || pComponent->ShouldTransmitSnapshotData() == false)
+			continue;
+		auto *pSnapshotComponent = dynamic_cast<pragma::SBaseSnapshotComponent *>(pComponent.get());
+		if(pSnapshotComponent == nullptr)
+			throw std::logic_error("Component must be derived from SBaseSnapshotComponent if snapshot data is enabled!");
+		if(bFirst) {
+			bFirst = false;
+			flags |= pragma::SnapshotFlags::ComponentData;
+			offsetNumComponents = packet->GetOffset();
+			packet->Write<uint8_t>(static_cast<uint8_t>(0u));
+		}
+		packet->Write<pragma::ComponentId>(pComponent->GetComponentId());
+		auto offsetComponentSize = packet->GetOffset();
+		packet->Write<uint8_t>(static_cast<uint8_t>(0u));
+
+		auto offsetComponentDataStart = packet->GetOffset();
+		pSnapshotComponent->SendSnapshotData(packet, pl);
+		auto szComponent = packet->GetOffset() - offsetComponentDataStart;
+		if(szComponent > std::numeric_limits<uint8_t>::max())
+			throw std::runtime_error("Component size mustn't exceed " + std::to_string(std::numeric_limits<uint8_t>::max()) + " bytes!");
+		packet->Write<uint8_t>(szComponent, &offsetComponentSize);
+
+		if(++numComponents == std::numeric_limits<uint8_t>::max()) {
+			Con::cwar << Con::PREFIX_SERVER << "Attempted to send data for more than " << std::numeric_limits<uint8_t>::max() << " components for a single entity! This is not allowed!" << Con::endl;
+			break;
+		}
+	}
+	packet->Write<decltype(flags)>(flags, &offsetSnapshotFlags);
+	if((flags & pragma::SnapshotFlags::ComponentData) != pragma::SnapshotFlags::None)
+		packet->Write<uint8_t>(numComponents, &offsetNumComponents);
+}
+
+const SGame::SnapshotDataBlock *SGame::GetSnapshotDataBlock(SBaseEntity &ent, pragma::SPlayerComponent &pl, pragma::networking::SnapshotEncoding encoding)
+{
+	auto it = m_snapshotDataBlocks.find(ent.GetIndex());
+	if(it != m_snapshotDataBlocks.end())
+		return it->second.has_value() ? &*it->second : nullptr;
+	auto playerSpecific = false;
+	for(auto &pComponent : ent.GetComponents()) {
+		if(pComponent.expired() || pComponent->ShouldTransmitSnapshotData() == false)
+			continue;
+		auto *pSnapshotComponent = dynamic_cast<pragma::SBaseSnapshotComponent *>(pComponent.get());
+		if(pSnapshotComponent && pSnapshotComponent->IsSnapshotDataPlayerSpecific()) {
+			playerSpecific = true;
+			break;
+		}
+	}
+	if(playerSpecific) {
+		m_snapshotDataBlocks.insert(std::make_pair(ent.GetIndex(), std::optional<SnapshotDataBlock> {}));
+		return nullptr;
+	}
+	SnapshotDataBlock block {};
+	block.offset = m_snapshotDataBuffer->GetSize();
+	WriteEntitySnapshotData(m_snapshotDataBuffer, ent, pl, encoding);
+	block.size = m_snapshotDataBuffer->GetSize() - block.offset;
+	return &*m_snapshotDataBlocks.insert(std::make_pair(ent.GetIndex(), block)).first->second;
+}
+
 void SGame::SendSnapshot(pragma::SPlayerComponent *pl)
 {
 	auto *session = pl ? pl->GetClientSession() : nullptr;
 	if(session == nullptr)
 		return;
 	NetPacket packet;
-	packet->Write<uint8_t>(session->SwapSnapshotId());
+	auto snapshotId = session->SwapSnapshotId();
+	packet->Write<uint8_t>(snapshotId);
 	packet->Write<double>(CurTime());
 
-	std::vector<SBaseEntity *> *entities;
-	GetEntities(&entities);
-	auto numEntities = entities->size();
+	auto encoding = (m_snapshotStates != nullptr) ? pragma::networking::SnapshotEncoding::Quantized : pragma::networking::SnapshotEncoding::Raw;
+	packet->Write<pragma::networking::SnapshotEncoding>(encoding);
+	const pragma::networking::SnapshotStateTable *baselineStates = nullptr;
+	if(encoding == pragma::networking::SnapshotEncoding::Quantized) {
+		m_snapshotQuantizationSettings.Write(packet);
+		// The baseline has to be recent enough to still be in the history of both the server and the client
+		auto &ackId = session->GetLastAcknowledgedSnapshotId();
+		if(ackId.has_value()) {
+			auto age = static_cast<uint8_t>(snapshotId - *ackId);
+			if(age > 0 && age < pragma::networking::SnapshotHistory::MAX_BASELINE_AGE)
+				baselineStates = session->GetSnapshotHistory().Find(*ackId, m_snapshotQuantizationSettings);
+		}
+		packet->Write<bool>(baselineStates != nullptr);
+		if(baselineStates)
+			packet->Write<uint8_t>(*ackId);
+	}
+
+	m_interestManager->Update(*pl, *session, m_snapshotEntities);
+	// Only the states that were actually sent to this client can be used as delta baselines later on
+	std::shared_ptr<pragma::networking::SnapshotStateTable> sentStates = nullptr;
+	if(encoding == pragma::networking::SnapshotEncoding::Quantized) {
+		sentStates = std::make_shared<pragma::networking::SnapshotStateTable>();
+		sentStates->reserve(m_snapshotEntities.size());
+	}
 	auto posNumEnts = packet->GetSize();
 	packet->Write<unsigned int>((unsigned int)(0));
 	size_t numEntitiesValid = 0;
-	for(size_t i = 0; i < numEntities; i++) {
-		SBaseEntity *ent = (*entities)[i];
-		if(ent != NULL && ent->IsShared() && ent->IsSynchronized() && ent->IsMarkedForSnapshot()) {
-			numEntitiesValid++;
+	for(auto *ent : m_snapshotEntities) {
+		numEntitiesValid++;
+		if(encoding == pragma::networking::SnapshotEncoding::Raw) {
 			auto pTrComponent = ent->GetTransformComponent();
 			auto pVelComponent = ent->GetComponent<pragma::VelocityComponent>();
 			nwm::write_entity(packet, ent);
@@ -48,95 +227,28 @@ void SGame::SendSnapshot(pragma::SPlayerComponent *pl)
 			nwm::write_vector(packet, pVelComponent.valid() ? pVelComponent->GetVelocity() : Vector3 {});
 			nwm::write_vector(packet, pVelComponent.valid() ? pVelComponent->GetAngularVelocity() : Vector3 {});
 			nwm::write_quat(packet, pTrComponent != nullptr ? pTrComponent->GetRotation() : uquat::identity());
-
-			auto offsetEntData = packet->GetSize();
-			packet->Write<UInt8>(UInt8(0));
-			auto offset = packet->GetSize();
-			ent->SendSnapshotData(packet, *pl);
-			auto entDataSize = packet->GetSize() - offset;
-#ifdef _DEBUG
-			assert(entDataSize <= std::numeric_limits<UInt8>::max());
-#endif
-			packet->Write<UInt8>(CUInt8(entDataSize), &offsetEntData);
-
-			auto flags = pragma::SnapshotFlags::None;
-			auto offsetSnapshotFlags = packet->GetOffset();
-			packet->Write<decltype(flags)>(flags);
-
-			auto pPhysComponent = ent->GetPhysicsComponent();
-			PhysObj *physObj = pPhysComponent != nullptr ? pPhysComponent->GetPhysicsObject() : nullptr;
-			if(physObj != NULL && !physObj->IsStatic()) {
-				flags |= pragma::SnapshotFlags::PhysicsData;
-				if(physObj->IsController()) {
-					packet->Write<uint8_t>(1u);
-					auto *physController = static_cast<ControllerPhysObj *>(physObj);
-					packet->Write<Vector3>(physController->GetPosition());
-					packet->Write<Quat>(physController->GetOrientation());
-					packet->Write<Vector3>(physController->GetLinearVelocity());
-					packet->Write<Vector3>(physController->GetAngularVelocity());
-				}
-				else {
-					auto colObjs = physObj->GetCollisionObjects();
-					packet->Write<uint8_t>(static_cast<uint8_t>(colObjs.size()));
-					//auto i = 0;
-					for(auto &hObj : colObjs) {
-						Vector3 pos {0.f, 0.f, 0.f};
-						auto rot = uquat::identity();
-						Vector3 vel {0.f, 0.f, 0.f};
-						Vector3 angVel {0.f, 0.f, 0.f};
-						if(hObj.IsValid()) {
-							auto *o = hObj.Get();
-							pos = o->GetPos();
-							rot = o->GetRotation();
-							if(o->IsRigid()) {
-								auto *rigid = o->GetRigidBody();
-								vel = rigid->GetLinearVelocity();
-								angVel = rigid->GetAngularVelocity();
-							}
-						}
-						packet->Write<Vector3>(pos);
-						packet->Write<Quat>(rot);
-						packet->Write<Vector3>(vel);
-						packet->Write<Vector3>(angVel);
-					}
-				}
+		}
+		else {
+			auto entIdx = ent->GetIndex();
+			pragma::networking::snapshot::write_varint(packet, entIdx);
+			const pragma::networking::QuantizedEntityState *baseline = nullptr;
+			if(baselineStates) {
+				auto itBaseline = baselineStates->find(entIdx);
+				if(itBaseline != baselineStates->end())
+					baseline = &itBaseline->second;
 			}
+			auto &state = GetSnapshotState(*ent);
+			pragma::networking::snapshot::write_entity_state(packet, state, baseline, m_snapshotQuantizationSettings);
+			sentStates->insert(std::make_pair(entIdx, state));
+		}
 
-			auto offsetNumComponents = 0u;
-			auto numComponents = 0u;
-			auto bFirst = true;
-			for(auto &pComponent : ent->GetComponents()) {
-				if(pComponent.expired() || pComponent->ShouldTransmitSnapshotData() == false)
-					continue;
-				auto *pSnapshotComponent = dynamic_cast<pragma::SBaseSnapshotComponent *>(pComponent.get());
-				if(pSnapshotComponent == nullptr)
-					throw std::logic_error("Component must be derived from SBaseSnapshotComponent if snapshot data is enabled!");
-				if(bFirst) {
-					bFirst = false;
-					flags |= pragma::SnapshotFlags::ComponentData;
-					offsetNumComponents = packet->GetOffset();
-					packet->Write<uint8_t>(static_cast<uint8_t>(0u));
-				}
-				packet->Write<pragma::ComponentId>(pComponent->GetComponentId());
-				auto offsetComponentSize = packet->GetOffset();
-				packet->Write<uint8_t>(static_cast<uint8_t>(0u));
-
-				auto offsetComponentDataStart = packet->GetOffset();
-				pSnapshotComponent->SendSnapshotData(packet, *pl);
-				auto szComponent = packet->GetOffset() - offsetComponentDataStart;
-				if(szComponent > std::numeric_limits<uint8_t>::max())
-					throw std::runtime_error("Component size mustn't exceed " + std::to_string(std::numeric_limits<uint8_t>::max()) + " bytes!");
-				packet->Write<uint8_t>(szComponent, &offsetComponentSize);
-
-				if(++numComponents == std::numeric_limits<uint8_t>::max()) {
-					Con::cwar << Con::PREFIX_SERVER << "Attempted to send data for more than " << std::numeric_limits<uint8_t>::max() << " components for a single entity! This is not allowed!" << Con::endl;
-					break;
-				}
-			}
-			packet->Write<decltype(flags)>(flags, &offsetSnapshotFlags);
-			if((flags & pragma::SnapshotFlags::ComponentData) != pragma::SnapshotFlags::None)
-				packet->Write<uint8_t>(numComponents, &offsetNumComponents);
+		auto *dataBlock = GetSnapshotDataBlock(*ent, *pl, encoding);
+		if(dataBlock) {
+			auto *data = reinterpret_cast<const uint8_t *>(m_snapshotDataBuffer->GetData());
+			packet->Write(data + dataBlock->offset, dataBlock->size);
 		}
+		else
+			WriteEntitySnapshotData(packet, *ent, *pl, encoding);
 	}
 	packet->Write<UInt32>(CUInt32(numEntitiesValid), &posNumEnts);
 
@@ -166,18 +278,28 @@ void SGame::SendSnapshot(pragma::SPlayerComponent *pl)
 		}
 	}
 	packet->Write<unsigned char>(numPlayersValid, &posNumPls);
-	server->SendPacket("snapshot", packet, pragma::networking::Protocol::FastUnreliable, *session);
+	if(encoding == pragma::networking::SnapshotEncoding::Quantized)
+		session->GetSnapshotHistory().Store(snapshotId, m_snapshotQuantizationSettings, sentStates);
+	server->SendPacket<"snapshot">(packet, pragma::networking::Protocol::FastUnreliable, *session);
 }
 
 void SGame::SendSnapshot()
 {
 	//Con::csv<<"Sending snapshot.."<<Con::endl;
+	if(cvSnapshotCompression->GetBool())
+		InitializeSnapshotStates();
+	m_interestManager->BeginSnapshot();
+	m_snapshotDataBuffer = {};
+	m_snapshotDataBlocks.clear();
 	auto &players = pragma::SPlayerComponent::GetAll();
 	//unsigned char numPlayersValid = 0;
 	for(auto *plComponent : players) {
 		if(plComponent != nullptr && plComponent->IsGameReady())
 			SendSnapshot(plComponent);
 	}
+	m_snapshotStates = nullptr;
+	m_snapshotDataBuffer = {};
+	m_snapshotDataBlocks.clear();
 	std::vector<SBaseEntity *> *entities;
 	GetEntities(&entities);
 	for(unsigned int i = 0; i < entities->size(); i++) {
@@ -190,3 +312,85 @@ void SGame::SendSnapshot()
 			plComponent->ClearKeyStack();
 	}
 }
+
+void SGame::QueueNetworkedMemberUpdate(pragma::SLuaBaseEntityComponent &component) { m_pendingMemberUpdates[component.GetEntity().GetIndex()].push_back(component.GetHandle<pragma::SLuaBaseEntityComponent>()); }
+
+static void remove_expired_components(std::vector<pragma::ComponentHandle<pragma::SLuaBaseEntityComponent>> &components)
+{
+	// The entity index may have been re-used by a new entity, in which case the components of the old entity have expired
+	components.erase(std::remove_if(components.begin(), components.end(), [](const pragma::ComponentHandle<pragma::SLuaBaseEntityComponent> &hComponent) { return hComponent.expired(); }), components.end());
+}
+
+void SGame::FlushNetworkedMemberUpdates()
+{
+	if(m_pendingMemberUpdates.empty())
+		return;
+	// Components may be re-queued while the updates are being sent
+	auto pendingUpdates = std::move(m_pendingMemberUpdates);
+	m_pendingMemberUpdates.clear();
+
+	auto t = CurTime();
+	for(auto &[entIdx, components] : pendingUpdates) {
+		remove_expired_components(components);
+		if(components.empty())
+			continue;
+		auto &ent = static_cast<SBaseEntity &>(components.front()->GetEntity());
+		// Low-priority changes are only sent early if there's something else to transmit for this entity anyway
+		auto includeLowPriority = std::find_if(components.begin(), components.end(), [t](const pragma::ComponentHandle<pragma::SLuaBaseEntityComponent> &hComponent) { return hComponent->HasDueMemberUpdates(t); }) != components.end();
+		SendNetworkedMemberUpdates(ent, components, includeLowPriority);
+	}
+}
+
+void SGame::FlushNetworkedMemberUpdates(SBaseEntity &ent)
+{
+	auto it = m_pendingMemberUpdates.find(ent.GetIndex());
+	if(it == m_pendingMemberUpdates.end())
+		return;
+	auto components = std::move(it->second);
+	m_pendingMemberUpdates.erase(it);
+	remove_expired_components(components);
+	if(components.empty())
+		return;
+	SendNetworkedMemberUpdates(ent, components, true);
+}
+
+void SGame::SendNetworkedMemberUpdates(SBaseEntity &ent, std::span<const pragma::ComponentHandle<pragma::SLuaBaseEntityComponent>> components, bool includeLowPriority)
+{
+	if(!ent.IsShared() || !ent.IsSpawned()) {
+		// Clients will receive the current values when the entity is created on their end
+		for(auto &hComponent : components)
+			hComponent->ClearPendingMemberUpdates();
+		return;
+	}
+	auto t = CurTime();
+	NetPacket packet {};
+	nwm::write_entity(packet, &ent);
+	auto offsetNumComponents = packet->GetOffset();
+	packet->Write<uint8_t>(static_cast<uint8_t>(0u));
+	auto numComponents = 0u;
+	for(auto &hComponent : components) {
+		auto &component = *hComponent;
+		if(numComponents == std::numeric_limits<uint8_t>::max()) {
+			// Remaining components will be transmitted next tick
+			if(component.HasPendingMemberUpdates())
+				QueueNetworkedMemberUpdate(component);
+			continue;
+		}
+		auto offsetComponent = packet->GetOffset();
+		packet->Write<pragma::ComponentId>(component.GetComponentId());
+		auto offsetSize = packet->GetOffset();
+		packet->Write<uint32_t>(static_cast<uint32_t>(0u));
+		if(component.WritePendingMemberUpdates(packet, t, includeLowPriority) == false) {
+			packet->SetOffset(offsetComponent);
+			continue;
+		}
+		// Member values such as strings have no upper size limit, so the size has to be stored with 32 bits
+		auto size = packet->GetOffset() - offsetSize - sizeof(uint32_t);
+		packet->Write<uint32_t>(static_cast<uint32_t>(size), &offsetSize);
+		++numComponents;
+	}
+	if(numComponents == 0)
+		return;
+	packet->Write<uint8_t>(static_cast<uint8_t>(numComponents), &offsetNumComponents);
+	server->SendPacket<"ent_member_updates">(packet, pragma::networking::Protocol::SlowReliable);
+}
@@ -8,12 +8,18 @@
 #include "pragma/lua/s_lua_component.hpp"
 #include "pragma/networking/recipient_filter.hpp"
 #include "pragma/lua/base_lua_handle_method.hpp"
+#include "pragma/game/s_game.h"
 #include <servermanager/interface/sv_nwm_manager.hpp>
 #include <pragma/entities/components/base_player_component.hpp>
 #include <pragma/networking/enums.hpp>
 
 using namespace pragma;
 
+extern DLLSERVER SGame *s_game;
+
+static CVar cvCoalesceMemberUpdates = GetServerConVar("sv_coalesce_member_updates");
+static CVar cvLowPriorityDelay = GetServerConVar("sv_member_update_low_priority_delay");
+
 SLuaBaseEntityComponent::SLuaBaseEntityComponent(BaseEntity &ent) : BaseLuaBaseEntityComponent(ent), SBaseSnapshotComponent() {}
 void SLuaBaseEntityComponent::OnMemberValueChanged(uint32_t memberIdx)
 {
@@ -36,18 +42,112 @@ void SLuaBaseEntityComponent::OnMemberValueChanged(uint32_t memberIdx)
 		return;
 	}
 	auto nwIndex = itNwIndex->second;
-	const auto maxNwVars = std::numeric_limits<uint8_t>::max();
-	if(nwIndex > maxNwVars) {
-		Con::cwar << "Networked member index of '" << member.functionName << "' exceeds maximum allowed number of networked variables (" << maxNwVars << ")!" << Con::endl;
+	if(member.transmitPriority == TransmitPriority::High || cvCoalesceMemberUpdates->GetBool() == false) {
+		const auto maxNwVars = std::numeric_limits<uint8_t>::max();
+		if(nwIndex > maxNwVars) {
+			Con::cwar << "Networked member index of '" << member.functionName << "' exceeds maximum allowed number of networked variables (" << maxNwVars << ")!" << Con::endl;
+			return;
+		}
+		SendMemberValue(member, nwIndex);
 		return;
 	}
 
+	// Coalesce the change with all other changes of this entity during this tick
+	if(m_networkedMemberStates.size() != m_networkedMemberInfo->networkedMembers.size())
+		m_networkedMemberStates.resize(m_networkedMemberInfo->networkedMembers.size());
+	auto &state = m_networkedMemberStates[nwIndex];
+	if(state.dirty)
+		return;
+	state.dirty = true;
+	state.dirtySince = s_game->CurTime();
+	++m_pendingMemberUpdateCount;
+	if(m_queuedForMemberUpdate)
+		return;
+	m_queuedForMemberUpdate = true;
+	s_game->QueueNetworkedMemberUpdate(*this);
+}
+void SLuaBaseEntityComponent::SendMemberValue(const MemberInfo &member, size_t nwIndex)
+{
+	if(nwIndex < m_networkedMemberStates.size()) {
+		auto &state = m_networkedMemberStates[nwIndex];
+		if(state.dirty) {
+			state.dirty = false;
+			--m_pendingMemberUpdateCount;
+		}
+		state.lastTransmitTime = s_game->CurTime();
+	}
 	auto value = GetMemberValue(member);
 	NetPacket p {};
 	p->Write<uint8_t>(nwIndex);
 	Lua::WriteAny(p, detail::member_type_to_util_type(member.type), value);
 	static_cast<SBaseEntity &>(GetEntity()).SendNetEvent(m_networkedMemberInfo->netEvSetMember, p, pragma::networking::Protocol::SlowReliable);
 }
+void SLuaBaseEntityComponent::ClearPendingMemberUpdates()
+{
+	for(auto &state : m_networkedMemberStates)
+		state.dirty = false;
+	m_pendingMemberUpdateCount = 0;
+	m_queuedForMemberUpdate = false;
+}
+bool SLuaBaseEntityComponent::HasPendingMemberUpdates() const { return m_pendingMemberUpdateCount > 0; }
+bool SLuaBaseEntityComponent::IsMemberUpdateDue(const MemberInfo &member, const NetworkedMemberState &state, double t) const { return state.dirty && (t - state.lastTransmitTime) >= member.transmitInterval; }
+bool SLuaBaseEntityComponent::HasDueMemberUpdates(double t) const
+{
+	if(m_pendingMemberUpdateCount == 0)
+		return false;
+	auto &members = GetMembers();
+	for(auto i = decltype(m_networkedMemberStates.size()) {0u}; i < m_networkedMemberStates.size(); ++i) {
+		auto &member = members[m_networkedMemberInfo->networkedMembers[i]];
+		if(member.transmitPriority != TransmitPriority::Low && IsMemberUpdateDue(member, m_networkedMemberStates[i], t))
+			return true;
+	}
+	return false;
+}
+bool SLuaBaseEntityComponent::WritePendingMemberUpdates(NetPacket &packet, double t, bool includeLowPriority)
+{
+	m_queuedForMemberUpdate = false;
+	if(m_pendingMemberUpdateCount == 0)
+		return false;
+	auto &members = GetMembers();
+	auto lowPriorityDelay = cvLowPriorityDelay->GetFloat();
+	auto numMembers = m_networkedMemberStates.size();
+	std::vector<uint8_t> mask((numMembers + 7) / 8, 0);
+	auto hasUpdates = false;
+	for(auto i = decltype(numMembers) {0u}; i < numMembers; ++i) {
+		auto &member = members[m_networkedMemberInfo->networkedMembers[i]];
+		auto &state = m_networkedMemberStates[i];
+		if(IsMemberUpdateDue(member, state, t) == false)
+			continue;
+		if(member.transmitPriority == TransmitPriority::Low && includeLowPriority == false && (t - state.dirtySince) < lowPriorityDelay)
+			continue;
+		mask[i / 8] |= 1 << (i % 8);
+		hasUpdates = true;
+	}
+	// Members that were held back have to be re-queued for the next tick
+	auto requeue = [this]() {
+		if(m_pendingMemberUpdateCount == 0 || m_queuedForMemberUpdate)
+			return;
+		m_queuedForMemberUpdate = true;
+		s_game->QueueNetworkedMemberUpdate(*this);
+	};
+	if(hasUpdates == false) {
+		requeue();
+		return false;
+	}
+	packet->Write(mask.data(), mask.size());
+	for(auto i = decltype(numMembers) {0u}; i < numMembers; ++i) {
+		if((mask[i / 8] & (1 << (i % 8))) == 0)
+			continue;
+		auto &member = members[m_networkedMemberInfo->networkedMembers[i]];
+		auto &state = m_networkedMemberStates[i];
+		state.dirty = false;
+		state.lastTransmitTime = t;
+		--m_pendingMemberUpdateCount;
+		Lua::WriteAny(packet, detail::member_type_to_util_type(member.type), GetMemberValue(member));
+	}
+	requeue();
+	return true;
+}
 void SLuaBaseEntityComponent::SendData(NetPacket &packet, networking::ClientRecipientFilter &rp)
 {
 	if(m_networkedMemberInfo != nullptr) {
@@ -87,4 +187,18 @@ void SLuaBaseEntityComponent::SendSnapshotData(NetPacket &packet, pragma::BasePl
 }
 bool SLuaBaseEntityComponent::ShouldTransmitNetData() const { return IsNetworked(); }
 bool SLuaBaseEntityComponent::ShouldTransmitSnapshotData() const { return BaseLuaBaseEntityComponent::ShouldTransmitSnapshotData(); }
+bool SLuaBaseEntityComponent::IsSnapshotDataPlayerSpecific() const
+{
+	if(m_snapshotDataPlayerSpecific.has_value() == false) {
+		// If the method wasn't overridden, it resolves to the (empty) base implementation
+		auto &o = GetLuaObject();
+		if(o.is_valid() == false)
+			return true;
+		auto *l = o.interpreter();
+		luabind::object fBase = luabind::globals(l)["ents"]["BaseEntityComponent"]["SendSnapshotData"];
+		luabind::object f = o["SendSnapshotData"];
+		m_snapshotDataPlayerSpecific = (f != fBase);
+	}
+	return *m_snapshotDataPlayerSpecific;
+}
 void SLuaBaseEntityComponent::InvokeNetEventHandle(const std::string &methodName, NetPacket &packet, pragma::BasePlayerComponent *pl) { CallLuaMethod<void, luabind::object, NetPacket>(methodName, pl->GetLuaObject(), packet); }
@@ -43,7 +43,7 @@ void SLuaEntity::DoSpawn()
 		auto pMapComponent = GetComponent<pragma::MapComponent>();
 		p->Write<unsigned int>(pMapComponent.valid() ? pMapComponent->GetMapIndex() : 0u);
 		SendData(p, rf);
-		server->SendPacket("ent_create_lua", p, pragma::networking::Protocol::SlowReliable, rf);
+		server->SendPacket<"ent_create_lua">(p, pragma::networking::Protocol::SlowReliable, rf);
 	}
 }
 void SLuaEntity::Remove()
@@ -52,7 +52,7 @@ void SLuaEntity::Remove()
 		// TODO: Do we need this? (If so, why?)
 		NetPacket p;
 		nwm::write_entity(p, this);
-		server->SendPacket("ent_remove", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"ent_remove">(p, pragma::networking::Protocol::SlowReliable);
 	}
 	SBaseEntity::Remove();
 }
@@ -27,7 +27,7 @@ void SModelComponent::OnModelChanged(const std::shared_ptr<Model> &model)
 		NetPacket p;
 		nwm::write_entity(p, &ent);
 		p->WriteString(GetModelName());
-		server->SendPacket("ent_model", p, pragma::networking::Protocol::SlowReliable);
+		server->SendPacket<"ent_model">(p, pragma::networking::Protocol::SlowReliable);
 	}
 }
 
@@ -59,7 +59,7 @@ void SModelComponent::SetSkin(unsigned int skin)
 	NetPacket p;
 	nwm::write_entity(p, &ent);
 	p->Write<unsigned int>(skin);
-	server->SendPacket("ent_skin", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"ent_skin">(p, pragma::networking::Protocol::SlowReliable);
 }
 
 void SModelComponent::SetMaxDrawDistance(float maxDist)
@@ -92,9 +92,11 @@ int Lua::game::Server::load_map(lua_State *l)
 	s_game->WriteEntityData(packet, ptrEnts.data(), ptrEnts.size(), filter);
 	packet->Write<bool>((entWorld != nullptr) ? true : false);
 
-	server->SendPacket("map_load", packet, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"map_load">(packet, pragma::networking::Protocol::SlowReliable);
 	return pair.second;
 }
 
 void Lua::game::Server::change_level(const std::string &mapName, const std::string &landmarkName) { s_game->ChangeLevel(mapName, landmarkName); }
 void Lua::game::Server::change_level(const std::string &mapName) { change_level(mapName, ""); }
+bool Lua::game::Server::is_hibernating() { return server->IsHibernating(); }
+void Lua::game::Server::set_hibernation_inhibited(const std::string &identifier, bool inhibited) { server->SetHibernationInhibited(identifier, inhibited); }
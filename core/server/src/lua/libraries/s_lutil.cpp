@@ -87,7 +87,7 @@ luabind::object Lua::util::Server::fire_bullets(lua_State *l, const BulletInfo &
 		packet->Write<Vector3>(n);
 		packet->Write<int32_t>(surfaceMaterial);
 	}
-	server->SendPacket("fire_bullet", packet, pragma::networking::Protocol::FastUnreliable);
+	server->SendPacket<"fire_bullet">(packet, pragma::networking::Protocol::FastUnreliable);
 	return r;
 }
 
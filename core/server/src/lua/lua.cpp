@@ -76,7 +76,8 @@ void SGame::RegisterLua()
 	  luabind::def("set_gravity", Lua::game::Server::set_gravity), luabind::def("get_gravity", Lua::game::Server::get_gravity), luabind::def("load_model", Lua::game::Server::load_model),
 	  luabind::def("load_sound_scripts", static_cast<void (*)(lua_State *, const std::string &, bool)>(Lua::engine::LoadSoundScripts)), luabind::def("load_sound_scripts", static_cast<void (*)(lua_State *, const std::string &)>(Lua::engine::LoadSoundScripts)),
 	  luabind::def("precache_model", Lua::engine::PrecacheModel_sv), luabind::def("get_model", Lua::engine::get_model), luabind::def("load_material", static_cast<Material *(*)(const std::string &, bool)>(Lua::engine::server::LoadMaterial)),
-	  luabind::def("load_material", static_cast<Material *(*)(const std::string &)>(Lua::engine::server::LoadMaterial)), luabind::def("set_time_scale", &Lua::game::set_time_scale)];
+	  luabind::def("load_material", static_cast<Material *(*)(const std::string &)>(Lua::engine::server::LoadMaterial)), luabind::def("set_time_scale", &Lua::game::set_time_scale),
+	  luabind::def("is_hibernating", Lua::game::Server::is_hibernating), luabind::def("set_hibernation_inhibited", Lua::game::Server::set_hibernation_inhibited)];
 
 	Lua::ents::register_library(GetLuaState());
 	auto entsMod = luabind::module(GetLuaState(), "ents");
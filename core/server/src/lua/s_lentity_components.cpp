@@ -146,6 +146,19 @@ void SGame::RegisterLuaEntityComponents(luabind::module_ &entsMod)
 	entsMod[defSName];
 
 	auto defSNetworked = pragma::lua::create_entity_component_class<pragma::SNetworkedComponent, pragma::BaseNetworkedComponent>("NetworkedComponent");
+	defSNetworked.add_static_constant("EVENT_CHECK_RELEVANCE", pragma::SNetworkedComponent::EVENT_CHECK_RELEVANCE);
+	defSNetworked.add_static_constant("RELEVANCE_DEFAULT", umath::to_integral(pragma::SNetworkedComponent::Relevance::Default));
+	defSNetworked.add_static_constant("RELEVANCE_ALWAYS", umath::to_integral(pragma::SNetworkedComponent::Relevance::Always));
+	defSNetworked.add_static_constant("RELEVANCE_NEVER", umath::to_integral(pragma::SNetworkedComponent::Relevance::Never));
+	defSNetworked.add_static_constant("TRANSMIT_PRIORITY_LOW", umath::to_integral(pragma::SNetworkedComponent::TransmitPriority::Low));
+	defSNetworked.add_static_constant("TRANSMIT_PRIORITY_NORMAL", umath::to_integral(pragma::SNetworkedComponent::TransmitPriority::Normal));
+	defSNetworked.add_static_constant("TRANSMIT_PRIORITY_HIGH", umath::to_integral(pragma::SNetworkedComponent::TransmitPriority::High));
+	defSNetworked.def("SetRelevance", &pragma::SNetworkedComponent::SetRelevance);
+	defSNetworked.def("GetRelevance", &pragma::SNetworkedComponent::GetRelevance);
+	defSNetworked.def("SetRelevanceRadius", &pragma::SNetworkedComponent::SetRelevanceRadius);
+	defSNetworked.def("GetRelevanceRadius", &pragma::SNetworkedComponent::GetRelevanceRadius);
+	defSNetworked.def("SetTransmitPriority", &pragma::SNetworkedComponent::SetTransmitPriority);
+	defSNetworked.def("GetTransmitPriority", &pragma::SNetworkedComponent::GetTransmitPriority);
 	entsMod[defSNetworked];
 
 	auto defSObservable = pragma::lua::create_entity_component_class<pragma::SObservableComponent, pragma::BaseObservableComponent>("ObservableComponent");
@@ -17,6 +17,7 @@ bool ServerState::HandlePacket(pragma::networking::IServerClient &session, NetPa
 	SVNetMessage *msg = GetNetMessage(ID);
 	if(msg == nullptr)
 		return false;
+	m_receivedMessageStats.Add(ID, packet->GetSize());
 	msg->handler(session, packet);
 	return true;
 }
@@ -0,0 +1,271 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#include "stdafx_server.h"
+#include "pragma/networking/interest_manager.hpp"
+#include "pragma/networking/iserver_client.hpp"
+#include "pragma/networking/recipient_filter.hpp"
+#include "pragma/entities/components/s_player_component.hpp"
+#include "pragma/game/s_game.h"
+#include "pragma/console/s_cvar.h"
+#include <pragma/entities/components/base_transform_component.hpp>
+#include <pragma/entities/components/base_physics_component.hpp>
+#include <pragma/networking/nwm_util.h>
+#include <pragma/networking/enums.hpp>
+#include <pragma/entities/entity_spatial_index.hpp>
+#include <pragma/util/util_bsp_tree.hpp>
+#include <algorithm>
+
+using namespace pragma::networking;
+
+extern DLLSERVER ServerState *server;
+
+static CVar cvInterestManagement = GetServerConVar("sv_interest_management");
+static CVar cvInterestRadius = GetServerConVar("sv_interest_radius");
+static CVar cvInterestPvs = GetServerConVar("sv_interest_pvs");
+static CVar cvInterestMaxUpdateInterval = GetServerConVar("sv_interest_max_update_interval");
+
+InterestManager::InterestManager(SGame &game) : m_game {game} {}
+
+// Only entities with components that handle EVENT_CHECK_RELEVANCE, or have callbacks bound to it, can override their relevance
+static bool has_relevance_listeners(SBaseEntity &ent, pragma::SNetworkedComponent &nwComponent)
+{
+	return ent.HasEventHandlers(pragma::SNetworkedComponent::EVENT_CHECK_RELEVANCE) || nwComponent.HasEventCallbacks(pragma::SNetworkedComponent::EVENT_CHECK_RELEVANCE);
+}
+
+void InterestManager::SetBSPTree(const std::shared_ptr<util::BSPTree> &bspTree) { m_bspTree = (bspTree && bspTree->IsValid()) ? bspTree : nullptr; }
+
+void InterestManager::BeginSnapshot()
+{
+	m_enabled = cvInterestManagement->GetBool();
+	m_usePvs = cvInterestPvs->GetBool();
+	m_radius = umath::max(cvInterestRadius->GetFloat(), 0.f);
+	m_maxUpdateInterval = umath::max(cvInterestMaxUpdateInterval->GetFloat(), 0.f);
+
+	++m_snapshotIndex;
+	m_unconditionalEntities.clear();
+	m_newEntities.clear();
+	if(m_enabled == false)
+		return;
+	std::vector<SBaseEntity *> *entities;
+	m_game.GetEntities(&entities);
+	for(auto *ent : *entities) {
+		if(ent == nullptr || ent->IsShared() == false || ent->IsSynchronized() == false)
+			continue;
+		auto entIdx = ent->GetIndex();
+		if(entIdx >= m_knownGenerations.size())
+			m_knownGenerations.resize(entIdx + 1, 0);
+		auto generation = GetGeneration(entIdx) + 1;
+		if(m_knownGenerations[entIdx] != generation) {
+			m_knownGenerations[entIdx] = generation;
+			m_newEntities.push_back(ent);
+		}
+		if(RequiresEvaluation(*ent))
+			m_unconditionalEntities.push_back(ent);
+	}
+}
+
+bool InterestManager::RequiresEvaluation(SBaseEntity &ent) const
+{
+	if(ent.IsWorld() || !ent.GetTransformComponent())
+		return true;
+	// Players and everything attached to them; The player may be the viewer, in which case the entity is always relevant
+	auto *root = static_cast<const BaseEntity *>(&ent);
+	while(root->GetParent() != nullptr)
+		root = root->GetParent();
+	if(root->IsPlayer())
+		return true;
+	auto nwComponent = ent.GetComponent<pragma::SNetworkedComponent>();
+	if(nwComponent.valid() == false)
+		return false;
+	return nwComponent->GetRelevance() != SNetworkedComponent::Relevance::Default || nwComponent->GetRelevanceRadius() > m_radius || has_relevance_listeners(ent, *nwComponent);
+}
+
+void InterestManager::CollectCandidates(const Viewer &viewer, InterestSet &interestSet, std::vector<SBaseEntity *> &outEntities)
+{
+	outEntities.clear();
+	auto lastSnapshotIndex = interestSet.GetLastSnapshotIndex();
+	interestSet.SetLastSnapshotIndex(m_snapshotIndex);
+	if(m_enabled == false || lastSnapshotIndex == 0 || lastSnapshotIndex + 1 != m_snapshotIndex) {
+		// If the set wasn't updated in the previous snapshot, it may have missed new entities, so all of them have to be evaluated
+		std::vector<SBaseEntity *> *entities;
+		m_game.GetEntities(&entities);
+		outEntities.reserve(entities->size());
+		for(auto *ent : *entities) {
+			if(ent != nullptr)
+				outEntities.push_back(ent);
+		}
+		return;
+	}
+	Vector3 extents {m_radius, m_radius, m_radius};
+	m_spatialCandidates.clear();
+	m_game.GetEntitySpatialIndex().FindCandidates(viewer.position - extents, viewer.position + extents, m_spatialCandidates);
+
+	auto &relevantEntities = interestSet.GetRelevantEntities();
+	outEntities.reserve(m_spatialCandidates.size() + m_unconditionalEntities.size() + m_newEntities.size() + relevantEntities.size());
+	for(auto *ent : m_spatialCandidates)
+		outEntities.push_back(static_cast<SBaseEntity *>(ent));
+	outEntities.insert(outEntities.end(), m_unconditionalEntities.begin(), m_unconditionalEntities.end());
+	outEntities.insert(outEntities.end(), m_newEntities.begin(), m_newEntities.end());
+	// Previously relevant entities that are now out of range have to become dormant
+	for(auto entIdx : relevantEntities) {
+		auto *ent = m_game.GetEntity(entIdx);
+		if(ent != nullptr)
+			outEntities.push_back(ent);
+	}
+	// Same order as a full update
+	std::sort(outEntities.begin(), outEntities.end(), [](const SBaseEntity *a, const SBaseEntity *b) { return a->GetIndex() < b->GetIndex(); });
+	outEntities.erase(std::unique(outEntities.begin(), outEntities.end()), outEntities.end());
+}
+
+void InterestManager::OnEntityRemoved(uint32_t entIdx)
+{
+	if(entIdx >= m_entityGenerations.size())
+		m_entityGenerations.resize(entIdx + 1, 0);
+	++m_entityGenerations[entIdx];
+}
+
+uint32_t InterestManager::GetGeneration(uint32_t entIdx) const { return (entIdx < m_entityGenerations.size()) ? m_entityGenerations[entIdx] : 0; }
+
+bool InterestManager::IsPotentiallyVisible(const Viewer &viewer, SBaseEntity &ent) const
+{
+	if(m_bspTree == nullptr || viewer.cluster.has_value() == false)
+		return true;
+	auto pTrComponent = ent.GetTransformComponent();
+	if(!pTrComponent)
+		return true;
+	auto &pos = pTrComponent->GetPosition();
+	Vector3 center {};
+	auto radius = 0.f;
+	auto pPhysComponent = ent.GetPhysicsComponent();
+	if(pPhysComponent)
+		radius = pPhysComponent->GetCollisionRadius(&center);
+	center += pos;
+	Vector3 extents {radius, radius, radius};
+	return m_bspTree->IsAabbVisibleInCluster(center - extents, center + extents, *viewer.cluster);
+}
+
+bool InterestManager::IsRelevant(pragma::SPlayerComponent &pl, const Viewer &viewer, SBaseEntity &ent, float &outDistance, float &outRadius, SNetworkedComponent::TransmitPriority &outPriority) const
+{
+	auto nwComponent = ent.GetComponent<pragma::SNetworkedComponent>();
+	outDistance = 0.f;
+	outRadius = m_radius;
+	outPriority = SNetworkedComponent::TransmitPriority::Normal;
+	if(nwComponent.valid()) {
+		outPriority = nwComponent->GetTransmitPriority();
+		if(nwComponent->GetRelevanceRadius() >= 0.f)
+			outRadius = nwComponent->GetRelevanceRadius();
+	}
+	auto pTrComponent = ent.GetTransformComponent();
+	if(pTrComponent)
+		outDistance = uvec::distance(viewer.position, pTrComponent->GetPosition());
+
+	// The player's own entity, everything attached to it and the world are always relevant
+	if(ent.IsWorld())
+		return true;
+	for(auto *entParent = static_cast<const BaseEntity *>(&ent); entParent != nullptr; entParent = entParent->GetParent()) {
+		if(entParent == viewer.entity)
+			return true;
+	}
+	if(m_enabled == false)
+		return true;
+
+	auto relevance = nwComponent.valid() ? nwComponent->GetRelevance() : SNetworkedComponent::Relevance::Default;
+	auto relevant = false;
+	switch(relevance) {
+	case SNetworkedComponent::Relevance::Always:
+		relevant = true;
+		break;
+	case SNetworkedComponent::Relevance::Never:
+		relevant = false;
+		break;
+	default:
+		relevant = (pTrComponent == nullptr) || (outDistance <= outRadius && IsPotentiallyVisible(viewer, ent));
+		break;
+	}
+	if(nwComponent.valid() && has_relevance_listeners(ent, *nwComponent)) {
+		pragma::CECheckRelevance evData {pl, relevant};
+		nwComponent->BroadcastEvent(SNetworkedComponent::EVENT_CHECK_RELEVANCE, evData);
+		relevant = evData.relevant;
+	}
+	return relevant;
+}
+
+double InterestManager::GetUpdateInterval(SNetworkedComponent::TransmitPriority priority, float distance, float radius) const
+{
+	if(priority == SNetworkedComponent::TransmitPriority::High || m_enabled == false || m_maxUpdateInterval == 0.f || radius <= 0.f)
+		return 0.0;
+	// Entities close to the player are updated with every snapshot, beyond that the update interval
+	// grows linearly with the distance. Low-priority entities are never updated at full rate.
+	auto d = umath::clamp(distance / radius, 0.f, 1.f);
+	auto factor = (priority == SNetworkedComponent::TransmitPriority::Low) ? (0.5f + 0.5f * d) : umath::max((d - 0.25f) / 0.75f, 0.f);
+	return m_maxUpdateInterval * factor;
+}
+
+void InterestManager::Update(pragma::SPlayerComponent &pl, IServerClient &session, std::vector<SBaseEntity *> &outEntities)
+{
+	outEntities.clear();
+	auto &interestSet = session.GetInterestSet();
+	auto t = m_game.CurTime();
+
+	Viewer viewer {};
+	viewer.entity = &pl.GetEntity();
+	viewer.position = pl.GetViewPos();
+	if(m_enabled && m_usePvs && m_bspTree) {
+		auto *leaf = m_bspTree->FindLeafNode(viewer.position);
+		if(leaf && leaf->cluster != std::numeric_limits<util::BSPTree::ClusterIndex>::max())
+			viewer.cluster = leaf->cluster;
+	}
+
+	NetPacket packetDormancy {};
+	auto offsetNumDormancyChanges = packetDormancy->GetSize();
+	packetDormancy->Write<uint32_t>(static_cast<uint32_t>(0u));
+	uint32_t numDormancyChanges = 0;
+
+	CollectCandidates(viewer, interestSet, m_candidates);
+	auto &relevantEntities = interestSet.GetRelevantEntities();
+	relevantEntities.clear();
+	for(auto *ent : m_candidates) {
+		if(ent->IsShared() == false || ent->IsSynchronized() == false)
+			continue;
+		auto entIdx = ent->GetIndex();
+		auto &entry = interestSet.GetEntry(entIdx, GetGeneration(entIdx));
+		auto distance = 0.f;
+		auto radius = 0.f;
+		auto priority = SNetworkedComponent::TransmitPriority::Normal;
+		auto relevant = IsRelevant(pl, viewer, *ent, distance, radius, priority);
+
+		auto prevState = entry.state;
+		entry.state = relevant ? InterestSet::State::Relevant : InterestSet::State::Dormant;
+		if(entry.state != prevState && (prevState != InterestSet::State::Unknown || relevant == false)) {
+			nwm::write_entity(packetDormancy, ent);
+			packetDormancy->Write<bool>(!relevant);
+			++numDormancyChanges;
+		}
+		if(relevant == false) {
+			// The client will receive the current state once the entity becomes relevant again
+			entry.pendingUpdate = false;
+			continue;
+		}
+		relevantEntities.push_back(entIdx);
+		if(prevState == InterestSet::State::Dormant) {
+			entry.pendingUpdate = true;
+			entry.nextUpdateTime = 0.0;
+		}
+		else if(ent->IsMarkedForSnapshot())
+			entry.pendingUpdate = true;
+		if(entry.pendingUpdate == false || t < entry.nextUpdateTime)
+			continue;
+		entry.pendingUpdate = false;
+		entry.nextUpdateTime = t + GetUpdateInterval(priority, distance, radius);
+		outEntities.push_back(ent);
+	}
+
+	if(numDormancyChanges == 0)
+		return;
+	packetDormancy->Write<uint32_t>(numDormancyChanges, &offsetNumDormancyChanges);
+	server->SendPacket<"ent_dormant">(packetDormancy, pragma::networking::Protocol::SlowReliable, session);
+}
@@ -0,0 +1,28 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#include "stdafx_server.h"
+#include "pragma/networking/interest_set.hpp"
+
+using namespace pragma::networking;
+
+InterestSet::Entry &InterestSet::GetEntry(uint32_t entIdx, uint32_t generation)
+{
+	if(entIdx >= m_entries.size())
+		m_entries.resize(entIdx + 1);
+	auto &entry = m_entries[entIdx];
+	if(entry.generation != generation) {
+		entry = {};
+		entry.generation = generation;
+	}
+	return entry;
+}
+void InterestSet::Clear()
+{
+	m_entries.clear();
+	m_relevantEntities.clear();
+	m_lastSnapshotIndex = 0;
+}
@@ -8,8 +8,28 @@
 #include "pragma/networking/iserver.hpp"
 #include "pragma/networking/iserver_client.hpp"
 #include "pragma/networking/recipient_filter.hpp"
+#include "pragma/networking/traffic_recorder.hpp"
+#include "pragma/networking/netmessages.h"
 #include <pragma/networking/error.hpp>
 
+pragma::networking::IServer::IServer()
+{
+	auto *clMap = GetClientMessageMap();
+	m_bundleMessageId = clMap->GetNetMessageID("msg_bundle");
+
+	// Snapshots are only relevant until the next one has been generated
+	SetMessagePriority(clMap->GetNetMessageID("snapshot"), MessagePriority::Critical, true);
+	SetMessagePriority(clMap->GetNetMessageID("playerinput"), MessagePriority::High);
+	for(auto *name : {"create_giblet", "resource_mdl_rough"})
+		SetMessagePriority(clMap->GetNetMessageID(name), MessagePriority::Low);
+	std::unordered_map<std::string, uint32_t> *clMsgs;
+	clMap->GetNetMessages(&clMsgs);
+	for(auto &pair : *clMsgs) {
+		if(ustring::compare(pair.first.c_str(), "debug_", true, 6))
+			SetMessagePriority(pair.second, MessagePriority::Low);
+	}
+}
+
 bool pragma::networking::IServer::Shutdown(Error &outErr)
 {
 	for(auto &cl : m_clients)
@@ -18,15 +38,36 @@ bool pragma::networking::IServer::Shutdown(Error &outErr)
 	m_bRunning = false;
 	return result;
 }
-bool pragma::networking::IServer::SendPacket(Protocol protocol, NetPacket &packet, const ClientRecipientFilter &rf, Error &outErr)
+bool pragma::networking::IServer::SendPacket(Protocol protocol, NetPacket &packet, const ClientRecipientFilter &rf, Error &outErr, uint32_t *outNumRecipients)
 {
 	auto success = true;
+	uint32_t numRecipients = 0;
+	std::optional<NetPacket> queuedPacket {};
 	for(auto &cl : m_clients) {
 		if(rf(*cl) == false)
 			continue;
-		if(cl->SendPacket(protocol, packet, outErr) == false)
+		// The listen server host is in the same process and not subject to any bandwidth restrictions
+		if(m_outgoingSchedulerEnabled && protocol == Protocol::FastUnreliable && cl->IsListenServerHost() == false) {
+			if(queuedPacket.has_value() == false) {
+				// The caller may re-use the packet after this call, so queued messages need their own copy (which is shared between all recipients)
+				queuedPacket = NetPacket {};
+				(*queuedPacket)->Write(packet->GetData(), packet->GetSize());
+				queuedPacket->SetMessageID(packet.GetMessageID());
+			}
+			cl->GetOutgoingQueue().Enqueue(*queuedPacket, GetMessagePriority(packet.GetMessageID()));
+			continue;
+		}
+		if(cl->SendPacket(protocol, packet, outErr) == false) {
 			success = false;
+			continue;
+		}
+		cl->GetOutgoingQueue().ConsumeBandwidth(packet->GetSize(), m_outgoingSchedulerSettings);
+		++numRecipients;
+		if(m_trafficRecorder)
+			m_trafficRecorder->Record(*cl, TrafficDirection::Outgoing, packet);
 	}
+	if(outNumRecipients)
+		*outNumRecipients = numRecipients;
 	return success;
 }
 void pragma::networking::IServer::AddClient(const std::shared_ptr<IServerClient> &client)
@@ -51,6 +92,8 @@ bool pragma::networking::IServer::DropClient(const IServerClient &client, pragma
 		m_eventInterface.onClientDropped(**it, reason);
 	auto cl = *it;
 	m_clients.erase(it);
+	if(m_trafficRecorder)
+		m_trafficRecorder->OnClientDropped(*cl);
 	return cl->Drop(reason, outErr);
 }
 
@@ -59,8 +102,48 @@ void pragma::networking::IServer::SetEventInterface(const ServerEventInterface &
 bool pragma::networking::IServer::IsRunning() const { return m_bRunning; }
 const std::vector<std::shared_ptr<pragma::networking::IServerClient>> &pragma::networking::IServer::GetClients() const { return m_clients; }
 const pragma::networking::ServerEventInterface &pragma::networking::IServer::GetEventInterface() const { return m_eventInterface; }
+void pragma::networking::IServer::SetTrafficRecorder(const std::shared_ptr<TrafficRecorder> &recorder) { m_trafficRecorder = recorder; }
+pragma::networking::TrafficRecorder *pragma::networking::IServer::GetTrafficRecorder() { return m_trafficRecorder.get(); }
+void pragma::networking::IServer::SetOutgoingSchedulerEnabled(bool enabled)
+{
+	if(enabled == m_outgoingSchedulerEnabled)
+		return;
+	if(enabled == false)
+		UpdateOutgoingQueues();
+	m_outgoingSchedulerEnabled = enabled;
+}
+bool pragma::networking::IServer::IsOutgoingSchedulerEnabled() const { return m_outgoingSchedulerEnabled; }
+void pragma::networking::IServer::SetOutgoingSchedulerSettings(const OutgoingMessageQueue::Settings &settings) { m_outgoingSchedulerSettings = settings; }
+const pragma::networking::OutgoingMessageQueue::Settings &pragma::networking::IServer::GetOutgoingSchedulerSettings() const { return m_outgoingSchedulerSettings; }
+void pragma::networking::IServer::SetMessagePriority(uint32_t messageId, MessagePriority priority, bool supersede)
+{
+	if(messageId == 0)
+		return;
+	if(messageId >= m_messagePriorities.size())
+		m_messagePriorities.resize(messageId + 1);
+	m_messagePriorities[messageId] = {priority, supersede};
+}
+const pragma::networking::MessagePriorityInfo &pragma::networking::IServer::GetMessagePriority(uint32_t messageId) const
+{
+	static MessagePriorityInfo defaultPriority {};
+	return (messageId < m_messagePriorities.size()) ? m_messagePriorities[messageId] : defaultPriority;
+}
+void pragma::networking::IServer::UpdateOutgoingQueues()
+{
+	for(auto &cl : m_clients) {
+		std::function<void(NetPacket &)> onDatagramSent = nullptr;
+		if(m_trafficRecorder)
+			onDatagramSent = [this, &cl](NetPacket &packet) { m_trafficRecorder->Record(*cl, TrafficDirection::Outgoing, packet); };
+		std::function<void(NetPacket &)> onMessageSent = nullptr;
+		if(m_eventInterface.onQueuedMessageSent)
+			onMessageSent = [this, &cl](NetPacket &packet) { m_eventInterface.onQueuedMessageSent(*cl, packet); };
+		cl->GetOutgoingQueue().Flush(*cl, m_bundleMessageId, m_outgoingSchedulerSettings, onDatagramSent, onMessageSent);
+	}
+}
 void pragma::networking::IServer::HandlePacket(IServerClient &client, NetPacket &packet)
 {
+	if(m_trafficRecorder)
+		m_trafficRecorder->Record(client, TrafficDirection::Incoming, packet);
 	if(m_eventInterface.handlePacket)
 		m_eventInterface.handlePacket(client, packet);
 }
@@ -71,6 +154,8 @@ void pragma::networking::IServer::OnClientConnected(IServerClient &client)
 }
 void pragma::networking::IServer::OnClientDropped(IServerClient &client, DropReason reason)
 {
+	if(m_trafficRecorder)
+		m_trafficRecorder->OnClientDropped(client);
 	if(m_eventInterface.onClientDropped)
 		m_eventInterface.onClientDropped(client, reason);
 }
@@ -25,7 +25,11 @@ bool pragma::networking::IServerClient::IsTransferring() const { return m_bTrans
 bool pragma::networking::IServerClient::IsInitialResourceTransferComplete() const { return (m_initialResourceTransferState == TransferState::Complete) ? true : false; }
 void pragma::networking::IServerClient::SetInitialResourceTransferState(TransferState state) { m_initialResourceTransferState = state; }
 pragma::networking::IServerClient::TransferState pragma::networking::IServerClient::GetInitialResourceTransferState() { return m_initialResourceTransferState; }
-void pragma::networking::IServerClient::SetPlayer(pragma::SPlayerComponent &pl) { m_player = pl.GetHandle<pragma::SPlayerComponent>(); }
+void pragma::networking::IServerClient::SetPlayer(pragma::SPlayerComponent &pl)
+{
+	m_player = pl.GetHandle<pragma::SPlayerComponent>();
+	m_interestSet.Clear();
+}
 const std::vector<std::shared_ptr<Resource>> &pragma::networking::IServerClient::GetResourceTransfer() const { return m_resourceTransfer; }
 bool pragma::networking::IServerClient::AddResource(const std::string &fileName, bool stream)
 {
@@ -55,12 +59,36 @@ bool pragma::networking::IServerClient::AddResource(const std::string &fileName,
 	return true;
 }
 void pragma::networking::IServerClient::RemoveResource(uint32_t i) { m_resourceTransfer.erase(m_resourceTransfer.begin() + i); }
+void pragma::networking::IServerClient::RemoveResource(const Resource &res)
+{
+	auto it = std::find_if(m_resourceTransfer.begin(), m_resourceTransfer.end(), [&res](const std::shared_ptr<Resource> &other) { return other.get() == &res; });
+	if(it != m_resourceTransfer.end())
+		m_resourceTransfer.erase(it);
+}
+Resource *pragma::networking::IServerClient::FindResourceByTransferId(uint32_t transferId)
+{
+	auto it = std::find_if(m_resourceTransfer.begin(), m_resourceTransfer.end(), [transferId](const std::shared_ptr<Resource> &res) { return res->state != Resource::State::Queued && res->transferId == transferId; });
+	return (it != m_resourceTransfer.end()) ? it->get() : nullptr;
+}
+uint32_t pragma::networking::IServerClient::AssignResourceTransferId() { return m_nextResourceTransferId++; }
 void pragma::networking::IServerClient::ClearResourceTransfer() { m_resourceTransfer.clear(); }
 
 uint8_t pragma::networking::IServerClient::SwapSnapshotId()
 {
 	return m_snapshotId++; // Overflow doesn't matter
 }
+uint8_t pragma::networking::IServerClient::GetNextSnapshotId() const { return m_snapshotId; }
+void pragma::networking::IServerClient::SetLastAcknowledgedSnapshotId(uint8_t id)
+{
+	// Acknowledgements arrive unreliably and may be out of order, so we only accept newer ones
+	if(m_lastAcknowledgedSnapshotId.has_value() && static_cast<uint8_t>(id - *m_lastAcknowledgedSnapshotId) >= std::numeric_limits<uint8_t>::max() / 2)
+		return;
+	m_lastAcknowledgedSnapshotId = id;
+}
+const std::optional<uint8_t> &pragma::networking::IServerClient::GetLastAcknowledgedSnapshotId() const { return m_lastAcknowledgedSnapshotId; }
+pragma::networking::SnapshotHistory &pragma::networking::IServerClient::GetSnapshotHistory() { return m_snapshotHistory; }
+pragma::networking::InterestSet &pragma::networking::IServerClient::GetInterestSet() { return m_interestSet; }
+pragma::networking::OutgoingMessageQueue &pragma::networking::IServerClient::GetOutgoingQueue() { return m_outgoingQueue; }
 
 void pragma::networking::IServerClient::ScheduleResource(const std::string &fileName)
 {
@@ -81,7 +81,7 @@ void Lua::net::server::broadcast(pragma::networking::Protocol protocol, const st
 		Con::cwar << Con::PREFIX_SERVER << "Attempted to send unindexed lua net message: " << identifier << Con::endl;
 		return;
 	}
-	::server->SendPacket("luanet", packetNew, protocol);
+	::server->SendPacket<"luanet">(packetNew, protocol);
 }
 
 static void send(lua_State *l, pragma::networking::Protocol protocol, const std::string &identifier, NetPacket &packet, const pragma::networking::TargetRecipientFilter &rp)
@@ -91,7 +91,7 @@ static void send(lua_State *l, pragma::networking::Protocol protocol, const std:
 		Con::cwar << Con::PREFIX_SERVER << "Attempted to send unindexed lua net message: " << identifier << Con::endl;
 		return;
 	}
-	::server->SendPacket("luanet", packetNew, protocol, rp);
+	::server->SendPacket<"luanet">(packetNew, protocol, rp);
 }
 
 void Lua::net::server::send(lua_State *l, pragma::networking::Protocol protocol, const std::string &identifier, NetPacket &packet, const luabind::tableT<pragma::SPlayerComponent> &recipients)
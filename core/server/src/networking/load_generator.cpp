@@ -0,0 +1,306 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#include "stdafx_server.h"
+#include "pragma/networking/load_generator.hpp"
+#include "pragma/networking/iserver.hpp"
+#include "pragma/networking/netmessages.h"
+#include <pragma/networking/nwm_util.h>
+#include <pragma/networking/error.hpp>
+#include <pragma/input/inkeys.h>
+#include <pragma/engine_version.h>
+#include <sharedutils/util.h>
+#include <algorithm>
+#include <cstring>
+
+using namespace pragma::networking;
+
+LoadGeneratorClient::LoadGeneratorClient(LoadGenerator &loadGenerator, uint16_t index) : m_loadGenerator {loadGenerator}, m_index {index} {}
+uint16_t LoadGeneratorClient::GetLatency() const { return 0; }
+std::string LoadGeneratorClient::GetIdentifier() const { return "loadgen_" + std::to_string(m_index); }
+std::optional<std::string> LoadGeneratorClient::GetIP() const { return {}; }
+std::optional<Port> LoadGeneratorClient::GetPort() const { return {}; }
+bool LoadGeneratorClient::IsListenServerHost() const { return false; }
+bool LoadGeneratorClient::SendPacket(pragma::networking::Protocol protocol, NetPacket &packet, pragma::networking::Error &outErr)
+{
+	auto messageId = packet.GetMessageID();
+	auto size = packet->GetSize();
+	m_receivedMessageStats.Add(messageId, size);
+	auto *data = static_cast<const uint8_t *>(packet->GetData());
+	if(messageId != m_loadGenerator.m_messageIds.messageBundle) {
+		ReceiveMessage(messageId, data, size);
+		return true;
+	}
+	// See OutgoingMessageQueue
+	constexpr auto entryHeaderSize = sizeof(uint32_t) + sizeof(uint16_t);
+	size_t offset = 0;
+	while(size - offset >= entryHeaderSize) {
+		uint32_t entryMessageId;
+		uint16_t entrySize;
+		memcpy(&entryMessageId, data + offset, sizeof(entryMessageId));
+		memcpy(&entrySize, data + offset + sizeof(entryMessageId), sizeof(entrySize));
+		offset += entryHeaderSize;
+		if(entrySize > size - offset)
+			break;
+		ReceiveMessage(entryMessageId, data + offset, entrySize);
+		offset += entrySize;
+	}
+	return true;
+}
+void LoadGeneratorClient::ReceiveMessage(uint32_t messageId, const uint8_t *data, size_t size)
+{
+	auto &ids = m_loadGenerator.m_messageIds;
+	if(messageId == ids.snapshot) {
+		// Snapshots aren't decoded, but they still have to be acknowledged so the server can delta-compress the next ones
+		if(size > 0)
+			m_lastSnapshotId = data[0];
+		return;
+	}
+	if(messageId != ids.serverInfo && messageId != ids.startResourceTransfer && messageId != ids.resourceInfo && messageId != ids.resourceComplete && messageId != ids.gameReady)
+		return;
+	NetPacket copy {};
+	copy->Write(data, size);
+	copy->SetOffset(0);
+	copy.SetMessageID(messageId);
+	m_pendingMessages.push_back(copy);
+}
+bool LoadGeneratorClient::Drop(DropReason reason, pragma::networking::Error &outErr)
+{
+	m_state = State::Dropped;
+	m_pendingMessages.clear();
+	return true;
+}
+LoadGeneratorClient::State LoadGeneratorClient::GetState() const { return m_state; }
+std::optional<std::chrono::steady_clock::duration> LoadGeneratorClient::GetJoinLatency() const
+{
+	if(m_tReady.has_value() == false)
+		return {};
+	return *m_tReady - m_tConnect;
+}
+const NetMessageStatsTable &LoadGeneratorClient::GetReceivedMessageStats() const { return m_receivedMessageStats; }
+const NetMessageStatsTable &LoadGeneratorClient::GetSentMessageStats() const { return m_sentMessageStats; }
+
+///////////////////
+
+std::unique_ptr<LoadGenerator> LoadGenerator::Create(IServer &server, const Settings &settings)
+{
+	if(settings.numClients == 0)
+		return nullptr;
+	return std::unique_ptr<LoadGenerator> {new LoadGenerator {server, settings}};
+}
+
+LoadGenerator::LoadGenerator(IServer &server, const Settings &settings) : m_server {server}, m_settings {settings}, m_tStart {std::chrono::steady_clock::now()}
+{
+	m_settings.numClients = umath::min(m_settings.numClients, static_cast<uint32_t>(std::numeric_limits<uint16_t>::max()));
+	m_settings.joinInterval = umath::max(m_settings.joinInterval, 0.f);
+	m_settings.inputRate = umath::max(m_settings.inputRate, 1.f);
+
+	auto *clMap = GetClientMessageMap();
+	m_messageIds.serverInfo = clMap->GetNetMessageID("serverinfo");
+	m_messageIds.startResourceTransfer = clMap->GetNetMessageID("start_resource_transfer");
+	m_messageIds.resourceInfo = clMap->GetNetMessageID("resourceinfo");
+	m_messageIds.resourceComplete = clMap->GetNetMessageID("resourcecomplete");
+	m_messageIds.gameReady = clMap->GetNetMessageID("game_ready");
+	m_messageIds.snapshot = clMap->GetNetMessageID("snapshot");
+	m_messageIds.messageBundle = clMap->GetNetMessageID("msg_bundle");
+
+	auto *svMap = GetServerMessageMap();
+	m_messageIds.serverInfoRequest = svMap->GetNetMessageID("serverinfo_request");
+	m_messageIds.authenticate = svMap->GetNetMessageID("authenticate");
+	m_messageIds.resourceBegin = svMap->GetNetMessageID("resource_begin");
+	m_messageIds.resourceInfoResponse = svMap->GetNetMessageID("resourceinfo_response");
+	m_messageIds.clientInfo = svMap->GetNetMessageID("clientinfo");
+	m_messageIds.gameReadyResponse = svMap->GetNetMessageID("game_ready");
+	m_messageIds.userInput = svMap->GetNetMessageID("userinput");
+
+	m_clients.reserve(m_settings.numClients);
+}
+
+LoadGenerator::~LoadGenerator()
+{
+	for(auto &cl : m_clients) {
+		if(cl->GetState() == LoadGeneratorClient::State::Dropped)
+			continue;
+		Error err;
+		m_server.DropClient(*cl, DropReason::Disconnected, err);
+	}
+}
+
+void LoadGenerator::Send(LoadGeneratorClient &client, uint32_t messageId, NetPacket &packet)
+{
+	if(messageId == 0 || client.GetState() == LoadGeneratorClient::State::Dropped)
+		return;
+	packet->SetOffset(0);
+	packet.SetMessageID(messageId);
+	client.m_sentMessageStats.Add(messageId, packet->GetSize());
+	m_server.HandlePacket(client, packet);
+}
+
+void LoadGenerator::ProcessMessage(LoadGeneratorClient &client, NetPacket &packet)
+{
+	auto messageId = packet.GetMessageID();
+	if(messageId == m_messageIds.serverInfo) {
+		client.m_state = LoadGeneratorClient::State::Authenticating;
+		NetPacket p {};
+		p->Write<bool>(false);
+		Send(client, m_messageIds.authenticate, p);
+	}
+	else if(messageId == m_messageIds.startResourceTransfer) {
+		// Downloads are declined, the load generator only needs the handshake
+		client.m_state = LoadGeneratorClient::State::TransferringResources;
+		NetPacket p {};
+		p->Write<bool>(false);
+		Send(client, m_messageIds.resourceBegin, p);
+	}
+	else if(messageId == m_messageIds.resourceInfo) {
+		NetPacket p {};
+		p->Write<uint32_t>(packet->Read<uint32_t>());
+		p->Write<bool>(false);
+		Send(client, m_messageIds.resourceInfoResponse, p);
+	}
+	else if(messageId == m_messageIds.resourceComplete) {
+		if(client.m_state != LoadGeneratorClient::State::TransferringResources)
+			return;
+		client.m_state = LoadGeneratorClient::State::Joining;
+		NetPacket p {};
+		p->Write<util::Version>(get_engine_version());
+		p->Write<unsigned char>(static_cast<unsigned char>(0));
+		p->WriteString(client.GetIdentifier());
+		p->Write<unsigned int>(static_cast<unsigned int>(0));
+		Send(client, m_messageIds.clientInfo, p);
+	}
+	else if(messageId == m_messageIds.gameReady) {
+		if(client.m_state != LoadGeneratorClient::State::Joining)
+			return;
+		NetPacket p {};
+		Send(client, m_messageIds.gameReadyResponse, p);
+		client.m_state = LoadGeneratorClient::State::Ready;
+		client.m_tReady = std::chrono::steady_clock::now();
+		client.m_tNextInput = *client.m_tReady;
+	}
+}
+
+void LoadGenerator::SendUserInput(LoadGeneratorClient &client)
+{
+	NetPacket p {};
+	p->Write<uint8_t>(client.m_nextUserInputId++);
+	nwm::write_quat(p, uquat::create(EulerAngles(umath::random(-89.f, 89.f), umath::random(-180.f, 180.f), 0.f)));
+	p->Write<Vector3>(Vector3 {});
+
+	// Random walk, with the occasional jump or attack
+	auto actions = Action::None;
+	if(umath::random(0.f, 1.f) < 0.7f)
+		actions |= (umath::random(0.f, 1.f) < 0.5f) ? Action::MoveForward : Action::MoveBackward;
+	if(umath::random(0.f, 1.f) < 0.3f)
+		actions |= (umath::random(0.f, 1.f) < 0.5f) ? Action::MoveLeft : Action::MoveRight;
+	if(umath::random(0.f, 1.f) < 0.05f)
+		actions |= Action::Jump;
+	if(umath::random(0.f, 1.f) < 0.1f)
+		actions |= Action::Attack;
+	p->Write<Action>(actions);
+	p->Write<bool>(false);
+
+	p->Write<bool>(client.m_lastSnapshotId.has_value());
+	if(client.m_lastSnapshotId.has_value())
+		p->Write<uint8_t>(*client.m_lastSnapshotId);
+	Send(client, m_messageIds.userInput, p);
+}
+
+void LoadGenerator::Update()
+{
+	auto t = std::chrono::steady_clock::now();
+	auto tElapsed = std::chrono::duration<float>(t - m_tStart).count();
+	while(m_clients.size() < m_settings.numClients && tElapsed >= m_clients.size() * m_settings.joinInterval) {
+		auto cl = IServerClient::Create<LoadGeneratorClient>(*this, static_cast<uint16_t>(m_clients.size()));
+		m_clients.push_back(cl);
+		cl->m_tConnect = t;
+		m_server.AddClient(cl);
+		NetPacket p {};
+		p->WriteString("");
+		Send(*cl, m_messageIds.serverInfoRequest, p);
+	}
+
+	auto inputInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(1.f / m_settings.inputRate));
+	for(auto &cl : m_clients) {
+		// Processing a message may cause the server to send new ones, which will be processed with the next update
+		auto messages = std::move(cl->m_pendingMessages);
+		cl->m_pendingMessages.clear();
+		for(auto &packet : messages)
+			ProcessMessage(*cl, packet);
+
+		if(cl->GetState() != LoadGeneratorClient::State::Ready || t < cl->m_tNextInput)
+			continue;
+		SendUserInput(*cl);
+		cl->m_tNextInput += inputInterval;
+		if(cl->m_tNextInput < t)
+			cl->m_tNextInput = t + inputInterval; // Don't try to catch up after a stall
+	}
+}
+
+void LoadGenerator::OnServerTick(std::chrono::steady_clock::duration tickDuration)
+{
+	++m_tickCount;
+	m_totalTickTime += tickDuration;
+	m_maxTickTime = std::max(m_maxTickTime, tickDuration);
+}
+
+uint32_t LoadGenerator::GetReadyClientCount() const
+{
+	return std::count_if(m_clients.begin(), m_clients.end(), [](const std::shared_ptr<LoadGeneratorClient> &cl) { return cl->GetState() == LoadGeneratorClient::State::Ready; });
+}
+
+void LoadGenerator::PrintReport() const
+{
+	auto t = std::chrono::steady_clock::now();
+	auto numDropped = std::count_if(m_clients.begin(), m_clients.end(), [](const std::shared_ptr<LoadGeneratorClient> &cl) { return cl->GetState() == LoadGeneratorClient::State::Dropped; });
+	Con::cout << "Load generator: " << GetReadyClientCount() << " of " << m_settings.numClients << " clients have joined, " << numDropped << " have been dropped (" << std::chrono::duration<double>(t - m_tStart).count() << "s)" << Con::endl;
+
+	if(m_tickCount > 0) {
+		auto avgTickTime = std::chrono::duration<double, std::milli>(m_totalTickTime).count() / m_tickCount;
+		Con::cout << "Server tick time: " << avgTickTime << "ms average, " << std::chrono::duration<double, std::milli>(m_maxTickTime).count() << "ms max (" << m_tickCount << " ticks)" << Con::endl;
+	}
+
+	std::vector<double> joinLatencies;
+	joinLatencies.reserve(m_clients.size());
+	for(auto &cl : m_clients) {
+		auto latency = cl->GetJoinLatency();
+		if(latency.has_value())
+			joinLatencies.push_back(std::chrono::duration<double, std::milli>(*latency).count());
+	}
+	if(joinLatencies.empty() == false) {
+		std::sort(joinLatencies.begin(), joinLatencies.end());
+		auto sum = 0.0;
+		for(auto v : joinLatencies)
+			sum += v;
+		Con::cout << "Join latency: " << (sum / joinLatencies.size()) << "ms average, " << joinLatencies.front() << "ms min, " << joinLatencies[joinLatencies.size() / 2] << "ms median, " << joinLatencies.back() << "ms max" << Con::endl;
+	}
+
+	// Bandwidth is averaged over the time each client has been connected
+	NetMessageStats totalReceived {};
+	NetMessageStats totalSent {};
+	auto bytesPerSecondReceived = 0.0;
+	auto bytesPerSecondSent = 0.0;
+	auto maxBytesPerSecondReceived = 0.0;
+	for(auto &cl : m_clients) {
+		auto received = cl->GetReceivedMessageStats().GetTotal();
+		auto sent = cl->GetSentMessageStats().GetTotal();
+		totalReceived.packetCount += received.packetCount;
+		totalReceived.byteCount += received.byteCount;
+		totalSent.packetCount += sent.packetCount;
+		totalSent.byteCount += sent.byteCount;
+		auto duration = std::chrono::duration<double>(t - cl->m_tConnect).count();
+		if(duration <= 0.0)
+			continue;
+		bytesPerSecondReceived += received.byteCount / duration;
+		bytesPerSecondSent += sent.byteCount / duration;
+		maxBytesPerSecondReceived = umath::max(maxBytesPerSecondReceived, received.byteCount / duration);
+	}
+	if(m_clients.empty())
+		return;
+	Con::cout << "Server -> clients: " << totalReceived.packetCount << " packets, " << util::get_pretty_bytes(totalReceived.byteCount) << " (" << util::get_pretty_bytes(static_cast<uint64_t>(bytesPerSecondReceived / m_clients.size())) << "/s average, "
+	          << util::get_pretty_bytes(static_cast<uint64_t>(maxBytesPerSecondReceived)) << "/s max per client)" << Con::endl;
+	Con::cout << "Clients -> server: " << totalSent.packetCount << " packets, " << util::get_pretty_bytes(totalSent.byteCount) << " (" << util::get_pretty_bytes(static_cast<uint64_t>(bytesPerSecondSent / m_clients.size())) << "/s average per client)" << Con::endl;
+}
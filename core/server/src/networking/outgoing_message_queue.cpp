@@ -0,0 +1,167 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#include "stdafx_server.h"
+#include "pragma/networking/outgoing_message_queue.hpp"
+#include "pragma/networking/iserver_client.hpp"
+#include <pragma/networking/enums.hpp>
+#include <pragma/networking/error.hpp>
+#include <algorithm>
+#include <vector>
+
+using namespace pragma::networking;
+
+void OutgoingMessageQueue::SetRate(uint32_t bytesPerSecond) { m_rate = bytesPerSecond; }
+uint32_t OutgoingMessageQueue::GetRate() const { return m_rate; }
+uint32_t OutgoingMessageQueue::GetEffectiveRate(const Settings &settings) const
+{
+	auto rate = m_rate;
+	if(settings.maxRate > 0)
+		rate = umath::min(rate, settings.maxRate);
+	return umath::max(rate, settings.minRate);
+}
+
+void OutgoingMessageQueue::Enqueue(NetPacket &packet, const MessagePriorityInfo &priorityInfo)
+{
+	auto &queue = m_queues[umath::to_integral(priorityInfo.priority)];
+	if(priorityInfo.supersede) {
+		auto messageId = packet.GetMessageID();
+		auto numQueued = queue.size();
+		queue.erase(std::remove_if(queue.begin(), queue.end(), [messageId](const Message &msg) { return msg.packet.GetMessageID() == messageId; }), queue.end());
+		m_stats.droppedMessageCount += numQueued - queue.size();
+	}
+	queue.push_back({packet, std::chrono::steady_clock::now()});
+	++m_stats.queuedMessageCount;
+	m_stats.maxQueueDepth = umath::max(m_stats.maxQueueDepth, GetQueueDepth());
+}
+
+void OutgoingMessageQueue::ConsumeBandwidth(size_t numBytes, const Settings &settings)
+{
+	// The debt is limited to one second, so a burst of reliable messages can't stall the queue indefinitely
+	m_tokens = umath::max(m_tokens - static_cast<double>(numBytes), -static_cast<double>(GetEffectiveRate(settings)));
+}
+
+void OutgoingMessageQueue::Refill(const Settings &settings)
+{
+	auto t = std::chrono::steady_clock::now();
+	auto rate = GetEffectiveRate(settings);
+	// Allow bursts of up to 100ms worth of data, but at least one full datagram
+	auto capacity = umath::max(rate / 10.0, static_cast<double>(MAX_DATAGRAM_SIZE));
+	if(m_tLastRefill.has_value() == false)
+		m_tokens = capacity;
+	else
+		m_tokens = umath::min(m_tokens + std::chrono::duration<double>(t - *m_tLastRefill).count() * rate, capacity);
+	m_tLastRefill = t;
+}
+
+bool OutgoingMessageQueue::Send(IServerClient &client, NetPacket &packet, const std::function<void(NetPacket &)> &onDatagramSent)
+{
+	Error err;
+	if(client.SendPacket(Protocol::FastUnreliable, packet, err) == false)
+		return false;
+	++m_stats.sentDatagramCount;
+	m_stats.sentByteCount += packet->GetSize();
+	if(onDatagramSent)
+		onDatagramSent(packet);
+	return true;
+}
+
+void OutgoingMessageQueue::Flush(IServerClient &client, uint32_t bundleMessageId, const Settings &settings, const std::function<void(NetPacket &)> &onDatagramSent, const std::function<void(NetPacket &)> &onMessageSent)
+{
+	Refill(settings);
+	if(GetQueueDepth() == 0)
+		return;
+
+	auto t = std::chrono::steady_clock::now();
+	auto maxDelay = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(settings.maxDelay));
+	for(auto &queue : m_queues) {
+		while(queue.empty() == false && t - queue.front().tQueued > maxDelay) {
+			queue.pop_front();
+			++m_stats.droppedMessageCount;
+		}
+	}
+
+	// Messages that were dropped above, or that couldn't be sent, don't count as sent
+	auto onSent = [this, &onMessageSent](NetPacket &packet) {
+		++m_stats.sentMessageCount;
+		if(onMessageSent)
+			onMessageSent(packet);
+	};
+	std::vector<NetPacket> bundle;
+	uint32_t bundleSize = 0;
+	auto flushBundle = [&]() {
+		if(bundle.empty())
+			return;
+		if(bundle.size() == 1 || bundleMessageId == 0) {
+			for(auto &packet : bundle) {
+				if(Send(client, packet, onDatagramSent))
+					onSent(packet);
+			}
+		}
+		else {
+			NetPacket packetBundle {};
+			for(auto &packet : bundle) {
+				packetBundle->Write<uint32_t>(packet.GetMessageID());
+				packetBundle->Write<uint16_t>(static_cast<uint16_t>(packet->GetSize()));
+				packetBundle->Write(packet->GetData(), packet->GetSize());
+			}
+			packetBundle.SetMessageID(bundleMessageId);
+			if(Send(client, packetBundle, onDatagramSent)) {
+				m_stats.bundledMessageCount += bundle.size();
+				for(auto &packet : bundle)
+					onSent(packet);
+			}
+		}
+		bundle.clear();
+		bundleSize = 0;
+	};
+	for(auto &queue : m_queues) {
+		// Messages may exceed the remaining budget, in which case the bucket goes into debt and subsequent flushes are delayed
+		while(queue.empty() == false && m_tokens > 0.0) {
+			auto &msg = queue.front();
+			auto size = static_cast<uint32_t>(msg.packet->GetSize());
+			if(size + BUNDLE_ENTRY_HEADER_SIZE <= MAX_DATAGRAM_SIZE) {
+				if(bundleSize + size + BUNDLE_ENTRY_HEADER_SIZE > MAX_DATAGRAM_SIZE)
+					flushBundle();
+				bundle.push_back(msg.packet);
+				bundleSize += size + BUNDLE_ENTRY_HEADER_SIZE;
+				m_tokens -= size + BUNDLE_ENTRY_HEADER_SIZE;
+			}
+			else {
+				if(Send(client, msg.packet, onDatagramSent))
+					onSent(msg.packet);
+				m_tokens -= size;
+			}
+			queue.pop_front();
+		}
+	}
+	flushBundle();
+
+	for(auto &queue : m_queues) {
+		for(auto &msg : queue) {
+			if(msg.deferred)
+				continue;
+			msg.deferred = true;
+			++m_stats.deferredMessageCount;
+		}
+	}
+}
+
+void OutgoingMessageQueue::Clear()
+{
+	for(auto &queue : m_queues)
+		queue.clear();
+}
+
+uint32_t OutgoingMessageQueue::GetQueueDepth() const
+{
+	uint32_t depth = 0;
+	for(auto &queue : m_queues)
+		depth += queue.size();
+	return depth;
+}
+const OutgoingMessageQueue::Stats &OutgoingMessageQueue::GetStats() const { return m_stats; }
+void OutgoingMessageQueue::ResetStats() { m_stats = {}; }
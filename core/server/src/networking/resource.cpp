@@ -19,10 +19,15 @@ Resource::~Resource()
 		return;
 	file.reset();
 }
-bool Resource::Construct()
+bool Resource::Construct() { return FileManager::Exists(name); }
+bool Resource::Open()
 {
+	if(file != nullptr)
+		return true;
 	file = FileManager::OpenFile(name.c_str(), "rb");
 	if(file == nullptr)
 		return false;
+	size = file->GetSize();
 	return true;
 }
+void Resource::Close() { file = nullptr; }
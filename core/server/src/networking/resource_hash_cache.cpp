@@ -0,0 +1,57 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#include "stdafx_server.h"
+#include "pragma/networking/resource_hash_cache.hpp"
+#include <pragma/networking/resource_transfer.hpp>
+#include <fsys/filesystem.h>
+
+using namespace pragma::networking;
+
+ResourceHashCache::ResourceHashCache() : m_threadPool {std::make_unique<pragma::ThreadPool>(1, "res_hash")} {}
+
+const std::string *ResourceHashCache::Find(const std::string &name, uint64_t size)
+{
+	FileTime lastWriteTime = filemanager::get_last_write_time(name);
+	auto it = m_entries.find(name);
+	if(it != m_entries.end() && it->second.size == size && it->second.lastWriteTime == lastWriteTime)
+		return &it->second.hash;
+	if(m_pending.find(name) != m_pending.end())
+		return nullptr;
+	auto taskId = m_threadPool->AddTask([this, name, size, lastWriteTime]() -> pragma::ThreadPool::ResultHandler {
+		// The file is opened separately, so the handle of the resource is never accessed from the worker thread
+		auto f = FileManager::OpenFile(name.c_str(), "rb");
+		auto hash = f ? pragma::networking::resource_transfer::compute_file_hash(*f) : std::string {};
+		return [this, name, size, lastWriteTime, hash = std::move(hash)]() {
+			m_pending.erase(name);
+			m_entries[name] = {size, lastWriteTime, hash};
+		};
+	});
+	m_pending[name] = taskId;
+	return nullptr;
+}
+
+bool ResourceHashCache::Poll()
+{
+	if(m_pending.empty())
+		return false;
+	std::vector<uint32_t> completed;
+	for(auto &[name, taskId] : m_pending) {
+		if(m_threadPool->IsComplete(taskId))
+			completed.push_back(taskId);
+	}
+	// The result handlers remove the entries from m_pending, so they can't be invoked while iterating
+	for(auto taskId : completed)
+		m_threadPool->PushResults(taskId);
+	return !completed.empty();
+}
+
+void ResourceHashCache::Clear()
+{
+	m_threadPool->WaitForCompletion();
+	Poll();
+	m_entries.clear();
+}
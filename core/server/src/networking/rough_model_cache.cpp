@@ -0,0 +1,144 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#include "stdafx_server.h"
+#include "pragma/networking/rough_model_cache.hpp"
+#include <pragma/model/model.h>
+#include <pragma/model/modelmesh.h>
+#include <pragma/physics/collisionmesh.h>
+#include <pragma/asset/util_asset.hpp>
+#include <pragma/networking/resource_transfer.hpp>
+#include <fsys/filesystem.h>
+#include <udm.hpp>
+#include <array>
+
+using namespace pragma::networking;
+
+static constexpr std::array<char, 4> ROUGH_MODEL_CACHE_IDENTIFIER = {'P', 'R', 'M', 'C'};
+static constexpr const char *ROUGH_MODEL_CACHE_PATH = "cache/rough_models/";
+
+std::shared_ptr<const RoughModelCache::Payload> RoughModelCache::Get(const std::string &mdlName, const std::shared_ptr<Model> &mdl)
+{
+	auto updateIndex = mdl->GetUpdateIndex();
+	auto it = m_entries.find(mdlName);
+	if(it != m_entries.end() && it->second.model.lock() == mdl && it->second.updateIndex == updateIndex)
+		return it->second.payload;
+
+	// Loading the same model file always results in the same number of updates, so if the update index matches the one
+	// from the cached file, the model has not been modified since it was loaded.
+	auto hash = GetModelFileHash(mdlName);
+	auto payload = hash.empty() ? nullptr : LoadFromDisk(hash, updateIndex);
+	if(payload == nullptr) {
+		std::vector<uint8_t> data;
+		if(Serialize(mdlName, *mdl, data) == false)
+			return nullptr;
+		// Clients reject anything larger
+		if(data.size() > pragma::networking::resource_transfer::MAX_ROUGH_MODEL_SIZE) {
+			Con::cwar << "Rough model data of model '" << mdlName << "' exceeds the maximum size of " << util::get_pretty_bytes(pragma::networking::resource_transfer::MAX_ROUGH_MODEL_SIZE) << "!" << Con::endl;
+			return nullptr;
+		}
+		auto blob = ::udm::compress_lz4_blob(data.data(), data.size());
+		auto newPayload = std::make_shared<Payload>();
+		newPayload->compressedData = std::move(blob.compressedData);
+		newPayload->uncompressedSize = data.size();
+		if(hash.empty() == false)
+			SaveToDisk(hash, updateIndex, *newPayload);
+		payload = newPayload;
+	}
+	m_entries[mdlName] = {mdl, updateIndex, payload};
+	return payload;
+}
+
+void RoughModelCache::Clear() { m_entries.clear(); }
+
+bool RoughModelCache::Serialize(const std::string &mdlName, Model &mdl, std::vector<uint8_t> &outData)
+{
+	NetPacket packet;
+	auto &colMeshes = mdl.GetCollisionMeshes();
+	if(colMeshes.empty() == false) {
+		packet->Write<uint8_t>(static_cast<uint8_t>(0));
+		packet->Write<uint32_t>(static_cast<uint32_t>(colMeshes.size()));
+		for(auto &colMesh : colMeshes) {
+			packet->Write<int32_t>(colMesh->GetBoneParent());
+			packet->Write<Vector3>(colMesh->GetOrigin());
+			auto &verts = colMesh->GetVertices();
+			packet->Write<uint32_t>(static_cast<uint32_t>(verts.size()));
+			packet->Write(reinterpret_cast<const uint8_t *>(verts.data()), verts.size() * sizeof(verts.front()));
+		}
+	}
+	else {
+		packet->Write<uint8_t>(static_cast<uint8_t>(1));
+		auto numMeshes = mdl.GetSubMeshCount();
+		packet->Write<uint32_t>(numMeshes);
+		for(auto &meshGroup : mdl.GetMeshGroups()) {
+			for(auto &mesh : meshGroup->GetMeshes()) {
+				for(auto &subMesh : mesh->GetSubMeshes()) {
+					assert(numMeshes > 0);
+					if(numMeshes-- == 0)
+						goto endLoop;
+					auto numVerts = subMesh->GetVertexCount();
+					packet->Write<uint32_t>(numVerts);
+					for(auto &v : subMesh->GetVertices())
+						packet->Write<Vector3>(v.position);
+				}
+			}
+		}
+	endLoop:;
+		assert(numMeshes == 0);
+		if(numMeshes > 0) {
+			Con::cwar << "Model '" << mdlName << "' has invalid mesh count. Unable to generate rough mesh!" << Con::endl;
+			return false;
+		}
+	}
+	auto *data = static_cast<const uint8_t *>(packet->GetData());
+	outData = std::vector<uint8_t>(data, data + packet->GetDataSize());
+	return true;
+}
+
+std::string RoughModelCache::GetModelFileHash(const std::string &mdlName)
+{
+	auto fileName = pragma::asset::find_file(mdlName, pragma::asset::Type::Model);
+	if(fileName.has_value() == false)
+		return {};
+	auto f = FileManager::OpenFile(("models/" + *fileName).c_str(), "rb");
+	if(f == nullptr)
+		return {};
+	return resource_transfer::compute_file_hash(*f);
+}
+
+std::string RoughModelCache::GetDiskCachePath(const std::string &hash) { return ROUGH_MODEL_CACHE_PATH + hash + ".prm"; }
+
+std::shared_ptr<const RoughModelCache::Payload> RoughModelCache::LoadFromDisk(const std::string &hash, uint32_t updateIndex)
+{
+	auto f = FileManager::OpenFile(GetDiskCachePath(hash).c_str(), "rb");
+	if(f == nullptr)
+		return nullptr;
+	auto header = f->Read<std::array<char, 4>>();
+	if(header != ROUGH_MODEL_CACHE_IDENTIFIER || f->Read<uint32_t>() != FORMAT_VERSION || f->Read<uint32_t>() != updateIndex)
+		return nullptr;
+	auto payload = std::make_shared<Payload>();
+	payload->uncompressedSize = f->Read<uint64_t>();
+	auto compressedSize = f->Read<uint64_t>();
+	if(compressedSize != f->GetSize() - f->Tell())
+		return nullptr; // Truncated file
+	payload->compressedData.resize(compressedSize);
+	f->Read(payload->compressedData.data(), compressedSize);
+	return payload;
+}
+
+void RoughModelCache::SaveToDisk(const std::string &hash, uint32_t updateIndex, const Payload &payload)
+{
+	FileManager::CreatePath(ROUGH_MODEL_CACHE_PATH);
+	auto f = FileManager::OpenFile<VFilePtrReal>(GetDiskCachePath(hash).c_str(), "wb");
+	if(f == nullptr)
+		return;
+	f->Write<std::array<char, 4>>(ROUGH_MODEL_CACHE_IDENTIFIER);
+	f->Write<uint32_t>(FORMAT_VERSION);
+	f->Write<uint32_t>(updateIndex);
+	f->Write<uint64_t>(payload.uncompressedSize);
+	f->Write<uint64_t>(payload.compressedData.size());
+	f->Write(payload.compressedData.data(), payload.compressedData.size());
+}
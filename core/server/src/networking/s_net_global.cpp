@@ -130,7 +130,7 @@ DLLSERVER void NET_sv_cmd_call(pragma::networking::IServerClient &session, NetPa
 			p->WriteString("");
 		}
 	}
-	server->SendPacket("cmd_call_response", p, pragma::networking::Protocol::SlowReliable, session);
+	server->SendPacket<"cmd_call_response">(p, pragma::networking::Protocol::SlowReliable, session);
 }
 
 DLLSERVER void NET_sv_rcon(pragma::networking::IServerClient &session, NetPacket packet)
@@ -159,7 +159,7 @@ DLLSERVER void NET_sv_serverinfo_request(pragma::networking::IServerClient &sess
 	std::string passSv = server->GetConVarString("sv_password").c_str();
 	if(passSv.empty() == false && passSv != password && session.IsListenServerHost() == false) {
 		NetPacket p;
-		server->SendPacket("invalidpassword", p, pragma::networking::Protocol::SlowReliable, session);
+		server->SendPacket<"invalidpassword">(p, pragma::networking::Protocol::SlowReliable, session);
 		server->DropClient(session);
 		return;
 	}
@@ -174,7 +174,7 @@ DLLSERVER void NET_sv_serverinfo_request(pragma::networking::IServerClient &sess
 		p->Write<unsigned char>((unsigned char)(0));
 
 	p->Write<bool>(server->IsClientAuthenticationRequired());
-	server->SendPacket("serverinfo", p, pragma::networking::Protocol::SlowReliable, session);
+	server->SendPacket<"serverinfo">(p, pragma::networking::Protocol::SlowReliable, session);
 }
 
 bool ServerState::IsClientAuthenticationRequired() const { return IsMultiPlayer() && server->GetConVarBool("sv_require_authentication"); }
@@ -257,7 +257,7 @@ DLLSERVER void NET_sv_noclip(pragma::networking::IServerClient &session, NetPack
 	NetPacket p;
 	nwm::write_entity(p, &pl->GetEntity());
 	p->Write<bool>(bNoclip);
-	server->SendPacket("pl_toggle_noclip", p, pragma::networking::Protocol::SlowReliable);
+	server->SendPacket<"pl_toggle_noclip">(p, pragma::networking::Protocol::SlowReliable);
 }
 
 void NET_sv_notarget(pragma::networking::IServerClient &session, NetPacket packet)
@@ -413,7 +413,7 @@ void NET_sv_debug_ai_schedule_print(pragma::networking::IServerClient &session,
 		schedule->DebugPrint(ss);
 		response->WriteString(ss.str());
 	}
-	server->SendPacket("debug_ai_schedule_print", response, pragma::networking::Protocol::SlowReliable, session);
+	server->SendPacket<"debug_ai_schedule_print">(response, pragma::networking::Protocol::SlowReliable, session);
 }
 
 void NET_sv_debug_ai_schedule_tree(pragma::networking::IServerClient &session, NetPacket packet)
@@ -23,18 +23,28 @@
 #include <pragma/entities/components/action_input_controller_component.hpp>
 #include <material_manager2.hpp>
 #include <sharedutils/util_file.h>
+#include <pragma/networking/resource_transfer.hpp>
+#include "pragma/networking/rough_model_cache.hpp"
+#include "pragma/networking/resource_hash_cache.hpp"
 
 #define RESOURCE_TRANSFER_VERBOSE 0
 
 extern DLLSERVER SGame *s_game;
 extern DLLSERVER ServerState *server;
 
+static CVar cvChunkSize = GetServerConVar("sv_resource_transfer_chunk_size");
+static CVar cvWindowSize = GetServerConVar("sv_resource_transfer_window");
+static CVar cvMaxFiles = GetServerConVar("sv_resource_transfer_max_files");
+static CVar cvCompression = GetServerConVar("sv_resource_transfer_compression");
+
+static uint32_t get_chunk_size() { return umath::clamp(cvChunkSize->GetInt(), static_cast<int32_t>(pragma::networking::resource_transfer::MIN_CHUNK_SIZE), static_cast<int32_t>(pragma::networking::resource_transfer::MAX_CHUNK_SIZE)); }
+
 void ServerState::InitResourceTransfer(pragma::networking::IServerClient &session)
 {
 	auto state = session.GetInitialResourceTransferState();
-	if(state == pragma::networking::IServerClient::TransferState::Initial || session.IsTransferring() == true)
+	if(state == pragma::networking::IServerClient::TransferState::Initial)
 		return;
-	HandleServerNextResource(session);
+	UpdateResourceTransfer(session);
 }
 
 void ServerState::SendResourceFile(const std::string &f, const std::vector<pragma::networking::IServerClient *> &clients)
@@ -74,48 +84,17 @@ void ServerState::SendRoughModel(const std::string &f, const std::vector<pragma:
 	if(asset == nullptr)
 		return;
 	auto mdl = pragma::asset::ModelManager::GetAssetObject(*asset);
+	// The payload is only generated once per model and shared between all clients
+	auto payload = m_roughModelCache->Get(mdlName, mdl);
+	if(payload == nullptr)
+		return;
 	NetPacket pOut;
 	pOut->WriteString(mdlName);
-
-	auto &colMeshes = mdl->GetCollisionMeshes();
-	if(colMeshes.empty() == false) {
-		pOut->Write<uint8_t>(static_cast<uint8_t>(0));
-		pOut->Write<uint32_t>(static_cast<uint32_t>(colMeshes.size()));
-		for(auto &colMesh : colMeshes) {
-			pOut->Write<int32_t>(colMesh->GetBoneParent());
-			pOut->Write<Vector3>(colMesh->GetOrigin());
-			auto &verts = colMesh->GetVertices();
-			pOut->Write<uint32_t>(static_cast<uint32_t>(verts.size()));
-			for(auto &v : verts)
-				pOut->Write<Vector3>(v);
-		}
-	}
-	else {
-		pOut->Write<uint8_t>(static_cast<uint8_t>(1));
-		auto numMeshes = mdl->GetSubMeshCount();
-		pOut->Write<uint32_t>(numMeshes);
-		for(auto &meshGroup : mdl->GetMeshGroups()) {
-			for(auto &mesh : meshGroup->GetMeshes()) {
-				for(auto &subMesh : mesh->GetSubMeshes()) {
-					assert(numMeshes > 0);
-					if(numMeshes-- == 0)
-						goto endLoop;
-					auto numVerts = subMesh->GetVertexCount();
-					pOut->Write<uint32_t>(numVerts);
-					for(auto &v : subMesh->GetVertices())
-						pOut->Write<Vector3>(v.position);
-				}
-			}
-		}
-	endLoop:;
-		assert(numMeshes == 0);
-		if(numMeshes > 0) {
-			Con::cwar << "Model '" << mdlName << "' has invalid mesh count. Unable to generate rough mesh!" << Con::endl;
-			return;
-		}
-	}
+	pOut->Write<uint64_t>(payload->uncompressedSize);
+	pOut->Write<uint64_t>(payload->compressedData.size());
+	pOut->Write(payload->compressedData.data(), payload->compressedData.size());
 	for(auto *cl : clients) {
-		server->SendPacket("resource_mdl_rough", pOut, pragma::networking::Protocol::FastUnreliable, *cl);
+		server->SendPacket<"resource_mdl_rough">(pOut, pragma::networking::Protocol::FastUnreliable, *cl);
 		//#if RESOURCE_TRANSFER_VERBOSE == 1
 		Con::csv << "[ResourceManager] Sent rough model to: " << cl->GetIdentifier() << "..." << Con::endl;
 		//#endif
@@ -133,99 +112,197 @@ void ServerState::SendRoughModel(const std::string &f)
 	SendRoughModel(f, clients);
 }
 
-void ServerState::HandleServerNextResource(pragma::networking::IServerClient &session)
+void ServerState::UpdateResourceTransfer(pragma::networking::IServerClient &session)
 {
-	auto bRemoveCurrent = true;
-	if(session.IsTransferring() == false) {
-		bRemoveCurrent = false; // Transfer has just started; Don't remove first resource
-		session.SetTransferComplete(false);
-	}
 	auto &resTransfer = session.GetResourceTransfer();
-	size_t numResources;
 	auto bComplete = session.IsInitialResourceTransferComplete();
-	if(bComplete == false && resTransfer.empty()) {
-		auto &resources = ResourceManager::GetResources();
-		numResources = resources.size();
-		if(numResources > 0) {
-			for(auto &res : resources) {
+	if(session.IsTransferring() == false) {
+		session.SetTransferComplete(false);
+		if(bComplete == false && resTransfer.empty()) {
+			for(auto &res : ResourceManager::GetResources()) {
 				if(session.AddResource(res.fileName, res.stream) == false)
 					Con::cwar << Con::PREFIX_SERVER << "[ResourceManager] Unable to open file '" << res.fileName << "'. Skipping..." << Con::endl;
 			}
 		}
-		numResources = resTransfer.size();
 	}
-	else if(bRemoveCurrent == true) {
-		numResources = resTransfer.size();
-		if(numResources > 0) {
-#if RESOURCE_TRANSFER_VERBOSE == 1
-			auto &r = resTransfer[0];
-			Con::csv << "[ResourceManager] File '" << r->name << "' transferred successfully to " << session->GetIP() << ". " << (numResources - 1) << " resources left!" << Con::endl;
-#endif
-			session.RemoveResource(0);
-			numResources--;
+
+	// Announce queued resources to the client, up to the maximum number of concurrent files
+	auto maxFiles = umath::max(cvMaxFiles->GetInt(), 1);
+	auto numActive = 0;
+	auto hasStaticResources = false;
+	for(auto &r : resTransfer) {
+		if(r->state != Resource::State::Queued)
+			++numActive;
+		if(r->stream == false)
+			hasStaticResources = true;
+	}
+	std::vector<std::shared_ptr<Resource>> invalidResources;
+	for(auto &r : resTransfer) {
+		if(numActive >= maxFiles)
+			break;
+		if(r->state != Resource::State::Queued)
+			continue;
+		// Streamed resources are only sent once all static resources have been received by the client
+		if(r->stream == true && bComplete == false && hasStaticResources)
+			break;
+		if(r->Open() == false) {
+			Con::cwar << Con::PREFIX_SERVER << "[ResourceManager] Unable to open file '" << r->name << "'. Skipping..." << Con::endl;
+			invalidResources.push_back(r);
+			continue;
+		}
+		// The resource is announced once its content hash is available, see UpdateResourceHashes
+		auto *hash = m_resourceHashCache->Find(r->name, r->size);
+		if(hash == nullptr) {
+			r->Close();
+			continue;
 		}
+		r->state = Resource::State::Announced;
+		r->transferId = session.AssignResourceTransferId();
+		NetPacket packetRes;
+		packetRes->Write<uint32_t>(r->transferId);
+		packetRes->WriteString(r->name);
+		packetRes->Write<UInt64>(r->size);
+		packetRes->WriteString(*hash);
+		SendPacket<"resourceinfo">(packetRes, pragma::networking::Protocol::SlowReliable, session);
+		++numActive;
 	}
-	else
-		numResources = resTransfer.size();
-	if(numResources == 0 || (resTransfer.front()->stream == true && bComplete == false) // All static resources are complete; Starting dynamic resources
-	) {
-		if(bComplete == false) {
-			session.SetInitialResourceTransferState(pragma::networking::IServerClient::TransferState::Complete);
-			Con::csv << "All resources have been sent to client '" << session.GetIdentifier() << "'!" << Con::endl;
-			NetPacket p;
-			SendPacket("resourcecomplete", p, pragma::networking::Protocol::SlowReliable, session);
+	for(auto &r : invalidResources)
+		session.RemoveResource(*r);
+
+	// Keep the window of unacknowledged chunks filled. Chunks are distributed round-robin between all active
+	// files, so small files don't have to wait for large ones.
+	auto windowSize = umath::max(cvWindowSize->GetInt(), 1);
+	auto numChunksInFlight = 0;
+	for(auto &r : resTransfer)
+		numChunksInFlight += r->chunksInFlight;
+	auto sentChunk = true;
+	while(sentChunk && numChunksInFlight < windowSize) {
+		sentChunk = false;
+		for(auto &r : resTransfer) {
+			if(numChunksInFlight >= windowSize)
+				break;
+			if(r->state != Resource::State::Transferring || r->eofSent)
+				continue;
+			SendResourceChunk(session, *r);
+			++numChunksInFlight;
+			sentChunk = true;
 		}
-		if(numResources == 0) {
-			session.SetTransferComplete(true);
+	}
+
+	if(bComplete == false && std::find_if(resTransfer.begin(), resTransfer.end(), [](const std::shared_ptr<Resource> &r) { return r->stream == false; }) == resTransfer.end()) {
+		// All static resources are complete
+		session.SetInitialResourceTransferState(pragma::networking::IServerClient::TransferState::Complete);
+		Con::csv << "All resources have been sent to client '" << session.GetIdentifier() << "'!" << Con::endl;
+		NetPacket p;
+		SendPacket<"resourcecomplete">(p, pragma::networking::Protocol::SlowReliable, session);
+		if(resTransfer.empty() == false) {
+			// Start streaming the remaining resources
+			UpdateResourceTransfer(session);
 			return;
 		}
 	}
-	auto &r = resTransfer[0];
-	auto f = r->file;
-	UInt64 size = CUInt64(f->GetSize());
-	NetPacket packetRes;
-	packetRes->WriteString(r->name);
-	packetRes->Write<UInt64>(size);
-	SendPacket("resourceinfo", packetRes, pragma::networking::Protocol::SlowReliable, session);
+	if(resTransfer.empty())
+		session.SetTransferComplete(true);
+}
+
+void ServerState::UpdateResourceHashes()
+{
+	if(m_resourceHashCache->Poll() == false || m_server == nullptr)
+		return;
+	for(auto &hClient : m_server->GetClients()) {
+		if(hClient == nullptr || hClient->GetResourceTransfer().empty())
+			continue;
+		UpdateResourceTransfer(*hClient);
+	}
+}
+
+void ServerState::SendResourceChunk(pragma::networking::IServerClient &session, Resource &res)
+{
+	// Only a single chunk is read into memory at a time, regardless of the file size
+	auto chunkSize = get_chunk_size();
+	auto read = static_cast<uint32_t>(umath::min(res.size - res.offset, static_cast<uint64_t>(chunkSize)));
+	std::vector<uint8_t> buf(read);
+	res.file->Seek(res.offset);
+	if(read > 0)
+		read = static_cast<uint32_t>(res.file->Read(buf.data(), read));
+	NetPacket fragment;
+	fragment->Write<uint32_t>(res.transferId);
+	fragment->Write<uint64_t>(res.offset);
+	pragma::networking::resource_transfer::write_chunk(fragment, buf.data(), read, cvCompression->GetBool());
+	res.offset += read;
+	++res.chunksInFlight;
+	if(res.offset >= res.size || read == 0) {
+		res.eofSent = true;
+		res.Close();
+	}
+	SendPacket<"resource_fragment">(fragment, pragma::networking::Protocol::SlowReliable, session);
 }
 
 void ServerState::HandleServerResourceStart(pragma::networking::IServerClient &session, NetPacket &packet)
 {
-	auto &resTransfer = session.GetResourceTransfer();
-	if(resTransfer.empty()) {
-		Con::cwar << "Attempted to send invalid resource fragment to client " << session.GetIdentifier() << Con::endl;
+	auto transferId = packet->Read<uint32_t>();
+	auto send = packet->Read<bool>();
+	auto *r = session.FindResourceByTransferId(transferId);
+	if(r == nullptr || r->state != Resource::State::Announced) {
+		Con::cwar << "Received invalid resource response from client " << session.GetIdentifier() << Con::endl;
 		return;
 	}
-	bool send = packet->Read<bool>();
 	if(send) {
-		Con::csv << "Sending file '" << resTransfer[0]->name << "' to client '" << session.GetIdentifier() << "'" << Con::endl;
-		HandleServerResourceFragment(session);
+		// The client may already have parts of the file from a previous attempt
+		auto resumeOffset = packet->Read<uint64_t>();
+		r->offset = umath::min(resumeOffset, r->size);
+		r->state = Resource::State::Transferring;
+		if(r->offset > 0)
+			Con::csv << "Resuming transfer of file '" << r->name << "' to client '" << session.GetIdentifier() << "' at " << util::get_pretty_bytes(r->offset) << Con::endl;
+		else
+			Con::csv << "Sending file '" << r->name << "' to client '" << session.GetIdentifier() << "'" << Con::endl;
 	}
 	else
-		HandleServerNextResource(session);
+		session.RemoveResource(*r);
+	UpdateResourceTransfer(session);
 }
 
-void ServerState::HandleServerResourceFragment(pragma::networking::IServerClient &session)
+void ServerState::HandleServerResourceAck(pragma::networking::IServerClient &session, NetPacket &packet)
 {
-	auto &resTransfer = session.GetResourceTransfer();
-	if(resTransfer.empty()) {
-		Con::cwar << "Attempted to send invalid resource fragment to client " << session.GetIdentifier() << Con::endl;
+	auto transferId = packet->Read<uint32_t>();
+	auto *r = session.FindResourceByTransferId(transferId);
+	if(r == nullptr || r->state != Resource::State::Transferring || r->chunksInFlight == 0) {
+		Con::cwar << "Received invalid resource acknowledgement from client " << session.GetIdentifier() << Con::endl;
 		return;
 	}
-	auto &r = resTransfer[0];
-	auto f = r->file;
-	f->Seek(r->offset);
-	NetPacket fragment;
-	std::array<uint8_t, RESOURCE_TRANSFER_FRAGMENT_SIZE> buf;
-	UInt64 size = CUInt64(f->GetSize());
-	auto read = CUInt32(size - r->offset);
-	if(read > RESOURCE_TRANSFER_FRAGMENT_SIZE)
-		read = RESOURCE_TRANSFER_FRAGMENT_SIZE;
-	f->Read(buf.data(), read);
-	fragment->Write<unsigned int>(read);
-	fragment->Write(buf.data(), read);
-	r->offset += read;
-	SendPacket("resource_fragment", fragment, pragma::networking::Protocol::SlowReliable, session);
+	--r->chunksInFlight;
+	if(r->eofSent && r->chunksInFlight == 0) {
+#if RESOURCE_TRANSFER_VERBOSE == 1
+		Con::csv << "[ResourceManager] File '" << r->name << "' transferred successfully to " << session.GetIdentifier() << ". " << (session.GetResourceTransfer().size() - 1) << " resources left!" << Con::endl;
+#endif
+		session.RemoveResource(*r);
+	}
+	UpdateResourceTransfer(session);
+}
+
+void ServerState::HandleServerResourceAbort(pragma::networking::IServerClient &session, NetPacket &packet)
+{
+	auto transferId = packet->Read<uint32_t>();
+	auto *r = session.FindResourceByTransferId(transferId);
+	if(r == nullptr || r->state != Resource::State::Transferring) {
+		Con::cwar << "Received invalid resource abort from client " << session.GetIdentifier() << Con::endl;
+		return;
+	}
+	if(++r->transferAttempts >= Resource::MAX_TRANSFER_ATTEMPTS) {
+		Con::cwar << Con::PREFIX_SERVER << "[ResourceManager] Transfer of file '" << r->name << "' to client '" << session.GetIdentifier() << "' has failed " << r->transferAttempts << " times. Skipping..." << Con::endl;
+		session.RemoveResource(*r);
+	}
+	else {
+		// Queue the resource again; It will be re-announced with a new transfer id, so chunks that are still in flight are
+		// ignored by the client. The client resumes from the data it has already received.
+		Con::cwar << Con::PREFIX_SERVER << "[ResourceManager] Client '" << session.GetIdentifier() << "' has aborted the transfer of file '" << r->name << "'. Retrying..." << Con::endl;
+		r->Close();
+		r->state = Resource::State::Queued;
+		r->offset = 0;
+		r->chunksInFlight = 0;
+		r->eofSent = false;
+	}
+	UpdateResourceTransfer(session);
 }
 
 void ServerState::ReceiveUserInput(pragma::networking::IServerClient &client, NetPacket &packet)
@@ -270,13 +347,17 @@ void ServerState::ReceiveUserInput(pragma::networking::IServerClient &client, Ne
 	}
 	if(actionInputC)
 		actionInputC->SetActionInputs(actions, bController);
+
+	// Most recent snapshot the client has received (Used as baseline for delta-compressed snapshots)
+	if(packet->Read<bool>())
+		client.SetLastAcknowledgedSnapshotId(packet->Read<uint8_t>());
 	//Con::csv<<"Action inputs "<<actions<<" for player "<<pl<<" ("<<pl->GetClientSession()->GetIP()<<")"<<Con::endl;
 
-	SendPacket("playerinput", pOut, pragma::networking::Protocol::FastUnreliable, {client, pragma::networking::ClientRecipientFilter::FilterType::Exclude});
+	SendPacket<"playerinput">(pOut, pragma::networking::Protocol::FastUnreliable, {client, pragma::networking::ClientRecipientFilter::FilterType::Exclude});
 
 	NetPacket plPacket;
 	plPacket->Write<uint8_t>(userInputId);
-	SendPacket("playerinput", plPacket, pragma::networking::Protocol::FastUnreliable, client);
+	SendPacket<"playerinput">(plPacket, pragma::networking::Protocol::FastUnreliable, client);
 }
 
 ////////////////////
@@ -284,17 +365,9 @@ void ServerState::ReceiveUserInput(pragma::networking::IServerClient &client, Ne
 extern ServerState *server;
 void NET_sv_resourceinfo_response(pragma::networking::IServerClient &session, NetPacket packet) { server->HandleServerResourceStart(session, packet); }
 
-void NET_sv_resource_request(pragma::networking::IServerClient &session, NetPacket packet)
-{
-	bool b = packet->Read<bool>();
-#if RESOURCE_TRANSFER_VERBOSE == 1
-	Con::csv << "[ResourceManager] Got resource request from client: " << session->GetIdentifier() << " (" << b << ")" << Con::endl;
-#endif
-	if(b)
-		server->HandleServerNextResource(session);
-	else
-		server->HandleServerResourceFragment(session);
-}
+void NET_sv_resource_request(pragma::networking::IServerClient &session, NetPacket packet) { server->HandleServerResourceAck(session, packet); }
+
+void NET_sv_resource_abort(pragma::networking::IServerClient &session, NetPacket packet) { server->HandleServerResourceAbort(session, packet); }
 
 void NET_sv_resource_begin(pragma::networking::IServerClient &session, NetPacket packet)
 {
@@ -304,14 +377,14 @@ void NET_sv_resource_begin(pragma::networking::IServerClient &session, NetPacket
 #if RESOURCE_TRANSFER_VERBOSE == 1
 		Con::csv << "[ResourceManager] Sending next resource to client: " << session->GetIdentifier() << Con::endl;
 #endif
-		server->HandleServerNextResource(session);
+		server->UpdateResourceTransfer(session);
 	}
 	else {
 #if RESOURCE_TRANSFER_VERBOSE == 1
 		Con::csv << "[ResourceManager] All resources have been sent to: " << session->GetIdentifier() << Con::endl;
 #endif
 		NetPacket p;
-		server->SendPacket("resourcecomplete", p, pragma::networking::Protocol::SlowReliable, session);
+		server->SendPacket<"resourcecomplete">(p, pragma::networking::Protocol::SlowReliable, session);
 	}
 }
 
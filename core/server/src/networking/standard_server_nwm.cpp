@@ -20,6 +20,7 @@
 #include <pragma/networking/error.hpp>
 #include <servermanager/interface/sv_nwm_manager_create.hpp>
 #include <sharedutils/util_clock.hpp>
+#include <pragma/util/frame_pacer.hpp>
 
 #define DEBUG_SERVER_VERBOSE 1
 
@@ -29,6 +30,7 @@
 #define GET_TIMEOUT_DURATION(f) f
 #endif
 
+extern DLLNETWORK Engine *engine;
 extern DLLSERVER ServerState *server;
 
 pragma::networking::NWMActiveServer::NWMActiveServer(const std::shared_ptr<SVNWMUDPConnection> &udp, const std::shared_ptr<SVNWMTCPConnection> &tcp) : nwm::Server(udp, tcp), m_lastHeartBeat() { m_dispatcher = UDPMessageDispatcher::Create(); }
@@ -63,6 +65,8 @@ void pragma::networking::NWMActiveServer::OnPacketReceived(const NWMEndpoint &ep
 	Con::csv << "OnPacketReceived: " << msgName << " (" << id << ")" << Con::endl;
 #endif
 	m_server->MemorizeNetMessage(MessageTracker::MessageType::Incoming, id, ep, packet);
+	// Packets are received on the network thread, make sure the main loop handles them right away instead of waiting for the next tick
+	engine->GetFramePacer().Wake();
 }
 
 bool pragma::networking::NWMActiveServer::HandleAsyncPacket(const NWMEndpoint &ep, NWMSession *session, uint32_t id, NetPacket &packet)
@@ -71,7 +71,7 @@ void ServerState::DropClient(pragma::networking::IServerClient &session, pragma:
 	NetPacket packet;
 	packet->Write<unsigned int>(ent.GetIndex());
 	game->RemoveEntity(&ent);
-	SendPacket("playerdisconnect", packet, pragma::networking::Protocol::SlowReliable);
+	SendPacket<"playerdisconnect">(packet, pragma::networking::Protocol::SlowReliable);
 }
 pragma::networking::IServerClient *ServerState::GetLocalClient() { return m_localClient.get(); }
 
@@ -83,7 +83,7 @@ void ServerState::HandleLuaNetPacket(pragma::networking::IServerClient &session,
 	game->HandleLuaNetPacket(session, packet);
 }
 
-static bool check_message_id(uint32_t id, const std::string &name)
+static bool check_message_id(uint32_t id, const char *name)
 {
 	assert(id != 0);
 	if(id == 0) {
@@ -93,18 +93,22 @@ static bool check_message_id(uint32_t id, const std::string &name)
 	return true;
 }
 
-void ServerState::SendPacket(const std::string &name, NetPacket &packet, pragma::networking::Protocol protocol, const pragma::networking::ClientRecipientFilter &rf)
+void ServerState::SendPacket(uint32_t messageId, const char *name, NetPacket &packet, pragma::networking::Protocol protocol, const pragma::networking::ClientRecipientFilter &rf)
 {
-	auto ID = GetClientMessageID(name);
-	if(check_message_id(ID, name) == false || m_server == nullptr)
+	if(check_message_id(messageId, name) == false || m_server == nullptr)
 		return;
-	packet.SetMessageID(ID);
+	packet.SetMessageID(messageId);
 
 	pragma::networking::Error err;
-	if(m_server->SendPacket(protocol, packet, rf, err) == true)
+	uint32_t numRecipients = 0;
+	auto success = m_server->SendPacket(protocol, packet, rf, err, &numRecipients);
+	m_sentMessageStats.Add(messageId, packet->GetSize(), numRecipients);
+	if(success == true)
 		return;
-	Con::cwar << "Unable to broadcast packet " << ID << ": " << err.GetMessage() << Con::endl;
+	Con::cwar << "Unable to broadcast packet " << messageId << ": " << err.GetMessage() << Con::endl;
 }
+void ServerState::SendPacket(uint32_t messageId, const char *name, NetPacket &packet, pragma::networking::Protocol protocol) { SendPacket(messageId, name, packet, protocol, pragma::networking::ClientRecipientFilter {}); }
+void ServerState::SendPacket(const std::string &name, NetPacket &packet, pragma::networking::Protocol protocol, const pragma::networking::ClientRecipientFilter &rf) { SendPacket(GetClientMessageID(name), name.c_str(), packet, protocol, rf); }
 void ServerState::SendPacket(const std::string &name, NetPacket &packet, pragma::networking::Protocol protocol) { SendPacket(name, packet, protocol, pragma::networking::ClientRecipientFilter {}); }
 void ServerState::SendPacket(const std::string &name, NetPacket &packet) { SendPacket(name, packet, pragma::networking::Protocol::FastUnreliable); }
 void ServerState::SendPacket(const std::string &name, pragma::networking::Protocol protocol)
@@ -112,3 +116,11 @@ void ServerState::SendPacket(const std::string &name, pragma::networking::Protoc
 	NetPacket packet {};
 	SendPacket(name, packet, protocol);
 }
+
+const pragma::networking::NetMessageStatsTable &ServerState::GetSentMessageStats() const { return m_sentMessageStats; }
+const pragma::networking::NetMessageStatsTable &ServerState::GetReceivedMessageStats() const { return m_receivedMessageStats; }
+void ServerState::ResetMessageStats()
+{
+	m_sentMessageStats.Reset();
+	m_receivedMessageStats.Reset();
+}
@@ -12,6 +12,9 @@
 #include "pragma/game/gamemode/gamemodemanager.h"
 #include "pragma/networking/standard_server.hpp"
 #include "pragma/networking/master_server.hpp"
+#include "pragma/networking/traffic_recorder.hpp"
+#include "pragma/networking/traffic_replay.hpp"
+#include "pragma/networking/load_generator.hpp"
 #include <pragma/networking/game_server_data.hpp>
 #include <pragma/networking/enums.hpp>
 #include <wms_shared.h>
@@ -19,6 +22,7 @@
 #include <pragma/networking/error.hpp>
 #include <networkmanager/nwm_error_handle.h>
 #include <pragma/logging.hpp>
+#include <sharedutils/util.h>
 
 extern DLLNETWORK Engine *engine;
 extern DLLSERVER SGame *s_game;
@@ -82,6 +86,8 @@ void ServerState::StartServer(bool singlePlayer)
 
 void ServerState::CloseServer()
 {
+	StopTrafficReplay();
+	StopLoadGenerator();
 	if(m_server == nullptr)
 		return;
 	pragma::networking::Error err;
@@ -90,6 +96,112 @@ void ServerState::CloseServer()
 	spdlog::error("Unable to shut down server: ", err.GetMessage());
 }
 
+bool ServerState::StartTrafficRecording(const std::string &fileName)
+{
+	if(m_server == nullptr)
+		return false;
+	StopTrafficRecording();
+	std::shared_ptr<pragma::networking::TrafficRecorder> recorder = pragma::networking::TrafficRecorder::Create(fileName);
+	if(recorder == nullptr)
+		return false;
+	m_server->SetTrafficRecorder(recorder);
+	return true;
+}
+
+void ServerState::StopTrafficRecording()
+{
+	auto *recorder = m_server ? m_server->GetTrafficRecorder() : nullptr;
+	if(recorder == nullptr)
+		return;
+	Con::csv << "Recorded " << recorder->GetPacketCount() << " packets (" << util::get_pretty_bytes(recorder->GetByteCount()) << ") over " << std::chrono::duration<double>(recorder->GetDuration()).count() << "s to '" << recorder->GetFileName() << "'." << Con::endl;
+	m_server->SetTrafficRecorder(nullptr);
+}
+
+bool ServerState::IsRecordingTraffic() const { return m_server && m_server->GetTrafficRecorder(); }
+
+bool ServerState::StartTrafficReplay(const std::string &fileName, float timeScale)
+{
+	if(m_server == nullptr)
+		return false;
+	StopTrafficReplay();
+	std::string err;
+	auto recording = pragma::networking::TrafficRecording::Load(fileName, err);
+	if(recording == nullptr) {
+		Con::cwar << "Unable to load traffic recording: " << err << Con::endl;
+		return false;
+	}
+	m_trafficReplay = pragma::networking::TrafficReplay::Create(*m_server, std::move(recording), timeScale);
+	return m_trafficReplay != nullptr;
+}
+
+void ServerState::UpdateTrafficReplay()
+{
+	if(m_trafficReplay == nullptr || m_trafficReplay->Update())
+		return;
+	m_trafficReplay->PrintReport();
+	m_trafficReplay = nullptr;
+}
+
+void ServerState::StopTrafficReplay()
+{
+	if(m_trafficReplay == nullptr)
+		return;
+	m_trafficReplay->PrintReport();
+	m_trafficReplay = nullptr;
+}
+
+bool ServerState::IsReplayingTraffic() const { return m_trafficReplay != nullptr; }
+
+bool ServerState::StartLoadGenerator(uint32_t numClients, float joinInterval, float inputRate)
+{
+	if(m_server == nullptr)
+		return false;
+	StopLoadGenerator();
+	pragma::networking::LoadGenerator::Settings settings {};
+	settings.numClients = numClients;
+	settings.joinInterval = joinInterval;
+	settings.inputRate = inputRate;
+	m_loadGenerator = pragma::networking::LoadGenerator::Create(*m_server, settings);
+	return m_loadGenerator != nullptr;
+}
+
+void ServerState::UpdateLoadGenerator()
+{
+	// The clients can only join once a game is running
+	if(m_loadGenerator == nullptr || IsGameActive() == false)
+		return;
+	m_loadGenerator->Update();
+}
+
+void ServerState::StopLoadGenerator()
+{
+	if(m_loadGenerator == nullptr)
+		return;
+	m_loadGenerator->PrintReport();
+	m_loadGenerator = nullptr;
+}
+
+pragma::networking::LoadGenerator *ServerState::GetLoadGenerator() { return m_loadGenerator.get(); }
+
+static auto cvNetScheduler = GetServerConVar("sv_net_scheduler");
+static auto cvMinRate = GetServerConVar("sv_minrate");
+static auto cvMaxRate = GetServerConVar("sv_maxrate");
+static auto cvNetSchedulerMaxDelay = GetServerConVar("sv_net_scheduler_max_delay");
+void ServerState::UpdateOutgoingQueues()
+{
+	if(m_server == nullptr)
+		return;
+	m_server->SetOutgoingSchedulerEnabled(cvNetScheduler->GetBool());
+	if(m_server->IsOutgoingSchedulerEnabled() == false)
+		return;
+	pragma::networking::OutgoingMessageQueue::Settings settings {};
+	settings.minRate = cvMinRate->GetInt();
+	settings.maxRate = cvMaxRate->GetInt();
+	settings.maxDelay = cvNetSchedulerMaxDelay->GetFloat();
+	m_server->SetOutgoingSchedulerSettings(settings);
+	m_server->UpdateOutgoingQueues();
+}
+
 /////////////////////////////////
 
 DLLSERVER void CMD_startserver(NetworkState *, pragma::BasePlayerComponent *, std::vector<std::string> &argv) { engine->StartServer(false); }
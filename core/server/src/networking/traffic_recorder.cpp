@@ -0,0 +1,139 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#include "stdafx_server.h"
+#include "pragma/networking/traffic_recorder.hpp"
+#include "pragma/networking/iserver_client.hpp"
+#include "pragma/networking/netmessages.h"
+#include <sharedutils/util_file.h>
+#include <array>
+
+using namespace pragma::networking;
+
+static constexpr std::array<char, 4> TRAFFIC_RECORDING_IDENTIFIER = {'P', 'T', 'R', 'F'};
+
+static void write_message_names(VFilePtrReal &f, const std::unordered_map<std::string, uint32_t> &messages)
+{
+	f->Write<uint32_t>(messages.size());
+	for(auto &pair : messages) {
+		f->WriteString(pair.first);
+		f->Write<uint32_t>(pair.second);
+	}
+}
+
+std::unique_ptr<TrafficRecorder> TrafficRecorder::Create(const std::string &fileName)
+{
+	auto path = ufile::get_path_from_filename(fileName);
+	if(path.empty() == false)
+		FileManager::CreatePath(path.c_str());
+	auto f = FileManager::OpenFile<VFilePtrReal>(fileName.c_str(), "wb");
+	if(f == nullptr)
+		return nullptr;
+	f->Write<std::array<char, 4>>(TRAFFIC_RECORDING_IDENTIFIER);
+	f->Write<uint32_t>(FORMAT_VERSION);
+
+	std::unordered_map<std::string, uint32_t> *svMsgs;
+	GetServerMessageMap()->GetNetMessages(&svMsgs);
+	write_message_names(f, *svMsgs);
+
+	std::unordered_map<std::string, uint32_t> *clMsgs;
+	GetClientMessageMap()->GetNetMessages(&clMsgs);
+	write_message_names(f, *clMsgs);
+	return std::unique_ptr<TrafficRecorder> {new TrafficRecorder {f, fileName}};
+}
+
+TrafficRecorder::TrafficRecorder(VFilePtrReal f, const std::string &fileName) : m_file {f}, m_fileName {fileName}, m_tStart {std::chrono::steady_clock::now()} {}
+
+uint16_t TrafficRecorder::GetClientIndex(const IServerClient &client)
+{
+	auto it = m_clientIndices.find(&client);
+	if(it == m_clientIndices.end())
+		it = m_clientIndices.insert(std::make_pair(&client, m_nextClientIndex++)).first;
+	return it->second;
+}
+
+void TrafficRecorder::OnClientDropped(const IServerClient &client) { m_clientIndices.erase(&client); }
+
+void TrafficRecorder::Record(const IServerClient &client, TrafficDirection direction, NetPacket &packet)
+{
+	auto size = packet->GetSize();
+	m_file->Write<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_tStart).count());
+	m_file->Write<uint16_t>(GetClientIndex(client));
+	m_file->Write<TrafficDirection>(direction);
+	m_file->Write<uint32_t>(packet.GetMessageID());
+	m_file->Write<uint32_t>(size);
+	m_file->Write(packet->GetData(), size);
+	++m_packetCount;
+	m_byteCount += size;
+}
+
+const std::string &TrafficRecorder::GetFileName() const { return m_fileName; }
+uint64_t TrafficRecorder::GetPacketCount() const { return m_packetCount; }
+uint64_t TrafficRecorder::GetByteCount() const { return m_byteCount; }
+std::chrono::steady_clock::duration TrafficRecorder::GetDuration() const { return std::chrono::steady_clock::now() - m_tStart; }
+
+///////////////////
+
+static void read_message_names(VFilePtr &f, std::unordered_map<uint32_t, std::string> &outMessages)
+{
+	auto numMessages = f->Read<uint32_t>();
+	outMessages.reserve(numMessages);
+	for(auto i = decltype(numMessages) {0u}; i < numMessages; ++i) {
+		auto name = f->ReadString();
+		auto id = f->Read<uint32_t>();
+		outMessages[id] = std::move(name);
+	}
+}
+
+std::unique_ptr<TrafficRecording> TrafficRecording::Load(const std::string &fileName, std::string &outErr)
+{
+	auto f = FileManager::OpenFile(fileName.c_str(), "rb");
+	if(f == nullptr) {
+		outErr = "Unable to open file '" + fileName + "'!";
+		return nullptr;
+	}
+	auto header = f->Read<std::array<char, 4>>();
+	if(header != TRAFFIC_RECORDING_IDENTIFIER) {
+		outErr = "Not a traffic recording!";
+		return nullptr;
+	}
+	auto version = f->Read<uint32_t>();
+	if(version != TrafficRecorder::FORMAT_VERSION) {
+		outErr = "Unsupported traffic recording version " + std::to_string(version) + "!";
+		return nullptr;
+	}
+	auto recording = std::unique_ptr<TrafficRecording> {new TrafficRecording {}};
+	read_message_names(f, recording->m_incomingMessageNames);
+	read_message_names(f, recording->m_outgoingMessageNames);
+
+	constexpr auto recordHeaderSize = sizeof(uint64_t) + sizeof(uint16_t) + sizeof(TrafficDirection) + sizeof(uint32_t) * 2;
+	auto fileSize = f->GetSize();
+	while(fileSize - f->Tell() >= recordHeaderSize) {
+		TrafficRecord record {};
+		record.timestampUs = f->Read<uint64_t>();
+		record.clientIndex = f->Read<uint16_t>();
+		record.direction = f->Read<TrafficDirection>();
+		record.messageId = f->Read<uint32_t>();
+		auto size = f->Read<uint32_t>();
+		if(size > fileSize - f->Tell())
+			break; // The recording was interrupted while the record was written
+		record.data.resize(size);
+		f->Read(record.data.data(), size);
+		recording->m_clientCount = umath::max(recording->m_clientCount, static_cast<uint16_t>(record.clientIndex + 1));
+		recording->m_records.push_back(std::move(record));
+	}
+	return recording;
+}
+
+const std::vector<TrafficRecord> &TrafficRecording::GetRecords() const { return m_records; }
+const std::string *TrafficRecording::FindMessageName(TrafficDirection direction, uint32_t messageId) const
+{
+	auto &names = (direction == TrafficDirection::Incoming) ? m_incomingMessageNames : m_outgoingMessageNames;
+	auto it = names.find(messageId);
+	return (it != names.end()) ? &it->second : nullptr;
+}
+uint16_t TrafficRecording::GetClientCount() const { return m_clientCount; }
+uint64_t TrafficRecording::GetDurationUs() const { return m_records.empty() ? 0 : m_records.back().timestampUs; }
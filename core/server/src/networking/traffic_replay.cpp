@@ -0,0 +1,166 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#include "stdafx_server.h"
+#include "pragma/networking/traffic_replay.hpp"
+#include "pragma/networking/iserver.hpp"
+#include "pragma/networking/netmessages.h"
+#include <pragma/networking/error.hpp>
+#include <sharedutils/util.h>
+#include <map>
+
+using namespace pragma::networking;
+
+ReplayServerClient::ReplayServerClient(uint16_t index) : m_index {index} {}
+uint16_t ReplayServerClient::GetLatency() const { return 0; }
+std::string ReplayServerClient::GetIdentifier() const { return "replay_" + std::to_string(m_index); }
+std::optional<std::string> ReplayServerClient::GetIP() const { return {}; }
+std::optional<Port> ReplayServerClient::GetPort() const { return {}; }
+bool ReplayServerClient::IsListenServerHost() const { return false; }
+bool ReplayServerClient::SendPacket(pragma::networking::Protocol protocol, NetPacket &packet, pragma::networking::Error &outErr)
+{
+	m_receivedMessageStats.Add(packet.GetMessageID(), packet->GetSize());
+	return true;
+}
+bool ReplayServerClient::Drop(DropReason reason, pragma::networking::Error &outErr) { return true; }
+const NetMessageStatsTable &ReplayServerClient::GetReceivedMessageStats() const { return m_receivedMessageStats; }
+
+///////////////////
+
+std::unique_ptr<TrafficReplay> TrafficReplay::Create(IServer &server, std::unique_ptr<TrafficRecording> recording, float timeScale)
+{
+	if(recording == nullptr)
+		return nullptr;
+	return std::unique_ptr<TrafficReplay> {new TrafficReplay {server, std::move(recording), timeScale}};
+}
+
+TrafficReplay::TrafficReplay(IServer &server, std::unique_ptr<TrafficRecording> recording, float timeScale)
+	: m_server {server}, m_recording {std::move(recording)}, m_timeScale {umath::max(timeScale, 0.f)}, m_tStart {std::chrono::steady_clock::now()}
+{
+	auto *svMap = GetServerMessageMap();
+	for(auto &record : m_recording->GetRecords()) {
+		if(record.direction == TrafficDirection::Outgoing) {
+			m_recordedOutgoingStats.Add(record.messageId, record.data.size());
+			continue;
+		}
+		if(record.messageId >= m_incomingMessageIds.size())
+			m_incomingMessageIds.resize(record.messageId + 1, 0);
+		auto *name = m_recording->FindMessageName(TrafficDirection::Incoming, record.messageId);
+		if(name)
+			m_incomingMessageIds[record.messageId] = svMap->GetNetMessageID(*name);
+	}
+
+	auto numClients = m_recording->GetClientCount();
+	m_clients.reserve(numClients);
+	for(auto i = decltype(numClients) {0u}; i < numClients; ++i) {
+		auto cl = IServerClient::Create<ReplayServerClient>(i);
+		m_clients.push_back(cl);
+		m_server.AddClient(cl);
+	}
+}
+
+TrafficReplay::~TrafficReplay()
+{
+	for(auto &cl : m_clients) {
+		Error err;
+		m_server.DropClient(*cl, DropReason::Disconnected, err);
+	}
+}
+
+void TrafficReplay::Dispatch(const TrafficRecord &record)
+{
+	auto messageId = (record.messageId < m_incomingMessageIds.size()) ? m_incomingMessageIds[record.messageId] : 0u;
+	if(messageId == 0) {
+		++m_skippedPacketCount;
+		return;
+	}
+	NetPacket packet {};
+	packet->Write(record.data.data(), record.data.size());
+	packet->SetOffset(0);
+	packet.SetMessageID(messageId);
+
+	auto t = std::chrono::steady_clock::now();
+	m_server.HandlePacket(*m_clients[record.clientIndex], packet);
+	auto dt = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t);
+	m_totalHandlerTime += dt;
+	m_maxHandlerTime = std::max(m_maxHandlerTime, dt);
+	++m_dispatchedPacketCount;
+	m_dispatchedByteCount += record.data.size();
+}
+
+bool TrafficReplay::IsComplete() const { return m_nextRecord >= m_recording->GetRecords().size(); }
+
+bool TrafficReplay::Update()
+{
+	if(IsComplete())
+		return false;
+	auto &records = m_recording->GetRecords();
+	auto tElapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_tStart).count();
+	for(; m_nextRecord < records.size(); ++m_nextRecord) {
+		auto &record = records[m_nextRecord];
+		if(m_timeScale > 0.f && static_cast<double>(record.timestampUs) / m_timeScale > static_cast<double>(tElapsedUs))
+			break;
+		if(record.direction == TrafficDirection::Incoming)
+			Dispatch(record);
+	}
+	if(IsComplete() == false)
+		return true;
+	m_tEnd = std::chrono::steady_clock::now();
+	return false;
+}
+
+void TrafficReplay::PrintReport() const
+{
+	auto tEnd = IsComplete() ? m_tEnd : std::chrono::steady_clock::now();
+	auto duration = std::chrono::duration<double>(tEnd - m_tStart).count();
+	Con::cout << "Replayed " << m_dispatchedPacketCount << " packets (" << util::get_pretty_bytes(m_dispatchedByteCount) << ") from " << m_clients.size() << " clients in " << duration << "s (Recorded duration: " << (m_recording->GetDurationUs() / 1'000'000.0) << "s)"
+	          << Con::endl;
+	if(m_skippedPacketCount > 0)
+		Con::cout << m_skippedPacketCount << " packets of unknown net-messages have been skipped." << Con::endl;
+	if(m_dispatchedPacketCount > 0) {
+		auto handlerTime = std::chrono::duration<double>(m_totalHandlerTime).count();
+		Con::cout << "Packet handling: " << (handlerTime * 1'000.0) << "ms total, " << (handlerTime * 1'000'000.0 / m_dispatchedPacketCount) << "us average, " << (m_maxHandlerTime.count() / 1'000.0) << "us max";
+		if(handlerTime > 0.0)
+			Con::cout << " (" << static_cast<uint64_t>(m_dispatchedPacketCount / handlerTime) << " packets/s)";
+		Con::cout << Con::endl;
+	}
+
+	// Recorded and replayed outgoing traffic by message name, since the message IDs may differ between builds
+	std::map<std::string, std::pair<NetMessageStats, NetMessageStats>> outgoing;
+	auto &recordedStats = m_recordedOutgoingStats.GetStats();
+	for(auto id = decltype(recordedStats.size()) {0u}; id < recordedStats.size(); ++id) {
+		if(recordedStats[id].packetCount == 0)
+			continue;
+		auto *name = m_recording->FindMessageName(TrafficDirection::Outgoing, id);
+		outgoing[name ? *name : ("#" + std::to_string(id))].first = recordedStats[id];
+	}
+	std::unordered_map<std::string, uint32_t> *clMsgs;
+	GetClientMessageMap()->GetNetMessages(&clMsgs);
+	for(auto &pair : *clMsgs) {
+		for(auto &cl : m_clients) {
+			auto *stats = cl->GetReceivedMessageStats().Find(pair.second);
+			if(stats == nullptr || stats->packetCount == 0)
+				continue;
+			auto &replayed = outgoing[pair.first].second;
+			replayed.packetCount += stats->packetCount;
+			replayed.byteCount += stats->byteCount;
+		}
+	}
+	if(outgoing.empty())
+		return;
+	Con::cout << "Outgoing traffic (recorded -> replayed):" << Con::endl;
+	NetMessageStats totalRecorded {};
+	NetMessageStats totalReplayed {};
+	for(auto &[name, stats] : outgoing) {
+		auto &[recorded, replayed] = stats;
+		Con::cout << name << ": " << recorded.packetCount << " packets, " << util::get_pretty_bytes(recorded.byteCount) << " -> " << replayed.packetCount << " packets, " << util::get_pretty_bytes(replayed.byteCount) << Con::endl;
+		totalRecorded.packetCount += recorded.packetCount;
+		totalRecorded.byteCount += recorded.byteCount;
+		totalReplayed.packetCount += replayed.packetCount;
+		totalReplayed.byteCount += replayed.byteCount;
+	}
+	Con::cout << "Total: " << totalRecorded.packetCount << " packets, " << util::get_pretty_bytes(totalRecorded.byteCount) << " -> " << totalReplayed.packetCount << " packets, " << util::get_pretty_bytes(totalReplayed.byteCount) << Con::endl;
+}
@@ -33,6 +33,10 @@
 #include <sharedutils/util_file.h>
 #include <sharedutils/util_library.hpp>
 #include <pragma/logging.hpp>
+#include "pragma/networking/rough_model_cache.hpp"
+#include "pragma/networking/resource_hash_cache.hpp"
+#include "pragma/networking/traffic_replay.hpp"
+#include "pragma/networking/load_generator.hpp"
 
 static std::unordered_map<std::string, std::shared_ptr<PtrConVar>> *conVarPtrs = NULL;
 std::unordered_map<std::string, std::shared_ptr<PtrConVar>> &ServerState::GetConVarPtrs() { return *conVarPtrs; }
@@ -55,6 +59,8 @@ ServerState::ServerState() : NetworkState(), m_server(nullptr)
 	m_soundScriptManager = std::make_unique<SoundScriptManager>();
 
 	m_modelManager = std::make_unique<pragma::asset::SModelManager>(*this);
+	m_roughModelCache = std::make_unique<pragma::networking::RoughModelCache>();
+	m_resourceHashCache = std::make_unique<pragma::networking::ResourceHashCache>();
 	engine->InitializeAssetManager(*m_modelManager);
 	pragma::asset::update_extension_cache(pragma::asset::Type::Model);
 
@@ -84,6 +90,8 @@ ServerState::~ServerState()
 
 void ServerState::InitializeGameServer(bool singlePlayerLocalGame)
 {
+	StopTrafficReplay();
+	StopLoadGenerator();
 	m_server = nullptr;
 	m_serverReg = nullptr;
 
@@ -94,10 +102,13 @@ void ServerState::InitializeGameServer(bool singlePlayerLocalGame)
 			return;
 		game->OnClientDropped(client, reason);
 	};
-	eventInterface.onClientConnected = [](pragma::networking::IServerClient &client) {
-
+	eventInterface.onClientConnected = [this](pragma::networking::IServerClient &client) {
+		// Resume right away, so the game is running at the full tick rate by the time the client has finished connecting
+		SetHibernating(false);
+		m_tEmptySince = {};
 	};
 	eventInterface.handlePacket = [this](pragma::networking::IServerClient &client, NetPacket &packet) { HandlePacket(client, packet); };
+	eventInterface.onQueuedMessageSent = [this](pragma::networking::IServerClient &client, NetPacket &packet) { m_sentMessageStats.Add(packet.GetMessageID(), packet->GetSize()); };
 
 	if(singlePlayerLocalGame == false) {
 		auto netLibName = GetConVarString("net_library");
@@ -187,7 +198,7 @@ void ServerState::OnClientAuthenticated(pragma::networking::IServerClient &sessi
 	NetPacket p;
 	unsigned int numResources = ResourceManager::GetResourceCount();
 	p->Write<unsigned int>(numResources);
-	SendPacket("start_resource_transfer", p, pragma::networking::Protocol::SlowReliable, session);
+	SendPacket<"start_resource_transfer">(p, pragma::networking::Protocol::SlowReliable, session);
 }
 bool ServerState::ConnectLocalHostPlayerClient()
 {
@@ -199,6 +210,8 @@ bool ServerState::ConnectLocalHostPlayerClient()
 }
 void ServerState::ResetGameServer()
 {
+	StopTrafficReplay();
+	StopLoadGenerator();
 	m_server = std::make_unique<pragma::networking::LocalServer>();
 	//if(m_localClient == nullptr)
 	//	m_localClient = std::make_shared<pragma::networking::LocalServerClient>();
@@ -253,12 +266,77 @@ void ServerState::Think()
 			if(m_server->PollEvents(err) == false)
 				Con::cwar << "Server polling failed: " << err.GetMessage() << Con::endl;
 		}
+		UpdateTrafficReplay();
+		UpdateLoadGenerator();
+		UpdateResourceHashes();
+		UpdateOutgoingQueues();
 		if(m_serverReg)
 			m_serverReg->UpdateServerData();
 	}
 }
 
-void ServerState::Tick() { NetworkState::Tick(); }
+void ServerState::Tick()
+{
+	UpdateHibernation();
+	if(m_loadGenerator == nullptr)
+		NetworkState::Tick();
+	else {
+		auto t = std::chrono::steady_clock::now();
+		NetworkState::Tick();
+		m_loadGenerator->OnServerTick(std::chrono::steady_clock::now() - t);
+	}
+	// Send the messages of this tick (most importantly the snapshot) right away
+	UpdateOutgoingQueues();
+}
+
+static auto cvHibernate = GetServerConVar("sv_hibernate");
+static auto cvHibernateTickRate = GetServerConVar("sv_hibernate_tickrate");
+static auto cvHibernateDelay = GetServerConVar("sv_hibernate_delay");
+bool ServerState::IsHibernating() const { return m_hibernating; }
+ServerState::HibernationMode ServerState::GetHibernationMode() const { return m_hibernating ? static_cast<HibernationMode>(cvHibernate->GetInt()) : HibernationMode::Disabled; }
+void ServerState::SetHibernationInhibited(const std::string &identifier, bool inhibited)
+{
+	if(inhibited) {
+		m_hibernationInhibitors.insert(identifier);
+		SetHibernating(false);
+		return;
+	}
+	m_hibernationInhibitors.erase(identifier);
+}
+void ServerState::SetHibernating(bool hibernating)
+{
+	if(hibernating == m_hibernating)
+		return;
+	m_hibernating = hibernating;
+	if(hibernating) {
+		Con::csv << "No clients connected, server is hibernating..." << Con::endl;
+		engine->SetTickRate(umath::min(static_cast<uint32_t>(umath::max(cvHibernateTickRate->GetInt(), 1)), engine->GetTickRate()));
+	}
+	else {
+		Con::csv << "Server is resuming from hibernation..." << Con::endl;
+		engine->SetTickRate(umath::max(GetConVarInt("sv_tickrate"), 1));
+	}
+	auto *game = GetGameState();
+	if(game) {
+		game->CallCallbacks<void, bool>("OnHibernationStateChanged", hibernating);
+		game->CallLuaCallbacks<void, bool>("OnHibernationStateChanged", hibernating);
+	}
+}
+void ServerState::UpdateHibernation()
+{
+	if(cvHibernate->GetInt() == umath::to_integral(HibernationMode::Disabled) || engine->IsServerOnly() == false || m_server == nullptr || IsGameActive() == false || m_server->GetClients().empty() == false || m_hibernationInhibitors.empty() == false) {
+		m_tEmptySince = {};
+		SetHibernating(false);
+		return;
+	}
+	if(m_hibernating)
+		return;
+	auto t = std::chrono::steady_clock::now();
+	if(m_tEmptySince.has_value() == false)
+		m_tEmptySince = t;
+	if(std::chrono::duration<float>(t - *m_tEmptySince).count() >= cvHibernateDelay->GetFloat())
+		SetHibernating(true);
+}
 
 void ServerState::implFindSimilarConVars(const std::string &input, std::vector<SimilarCmdInfo> &similarCmds) const
 {
@@ -373,7 +451,7 @@ ConVar *ServerState::SetConVar(std::string scmd, std::string value, bool bApplyI
 		NetPacket p;
 		p->WriteString(scmd);
 		p->WriteString(cvar->GetString());
-		SendPacket("cvar_set", p, pragma::networking::Protocol::SlowReliable);
+		SendPacket<"cvar_set">(p, pragma::networking::Protocol::SlowReliable);
 	}
 	return cvar;
 }
@@ -408,7 +486,7 @@ ConCommand *ServerState::CreateConCommand(const std::string &scmd, LuaFunction f
 	NetPacket packet;
 	packet->WriteString(scmd);
 	packet->Write<unsigned int>(cmd->GetID());
-	SendPacket("luacmd_reg", packet, pragma::networking::Protocol::SlowReliable);
+	SendPacket<"luacmd_reg">(packet, pragma::networking::Protocol::SlowReliable);
 	return cmd;
 }
 WMServerData &ServerState::GetServerData() { return m_serverData; }
@@ -458,6 +536,8 @@ ModelMesh *ServerState::CreateMesh() const { return new ModelMesh; }
 REGISTER_CONVAR_CALLBACK_SV(sv_tickrate, [](NetworkState *, const ConVar &, int, int val) {
 	if(val < 0)
 		val = 0;
+	if(server != nullptr && server->IsHibernating())
+		return; // Will be applied once the server resumes
 	engine->SetTickRate(val);
 });
 
@@ -0,0 +1,99 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#ifndef __NAV_QUERY_SERVICE_HPP__
+#define __NAV_QUERY_SERVICE_HPP__
+
+#include "pragma/networkdefinitions.h"
+#include "pragma/ai/navsystem.h"
+#include "pragma/util/util_task_scheduler.hpp"
+#include <mathutil/uvec.h>
+#include <unordered_map>
+
+namespace pragma::nav {
+	class QueryService;
+	class DLLNETWORK PathQuery {
+	  public:
+		PathQuery(const Vector3 &start, const Vector3 &end);
+		bool IsComplete() const;
+		bool IsCancelled() const;
+		// Only valid once the query is complete. nullptr if no path could be found or if the query was cancelled.
+		const std::shared_ptr<RcPathResult> &GetResult() const;
+		const Vector3 &GetStart() const;
+		const Vector3 &GetEnd() const;
+	  private:
+		friend QueryService;
+		Vector3 m_start;
+		Vector3 m_end;
+		std::shared_ptr<RcPathResult> m_result = nullptr;
+		std::atomic<bool> m_started = false;
+		std::atomic<bool> m_complete = false;
+		std::atomic<bool> m_cancelled = false;
+		// Number of requesters sharing this query (Guarded by QueryService::m_pendingQueryMutex)
+		uint32_t m_requesterCount = 1;
+	};
+
+	// Processes path queries on a set of worker threads. Every worker owns a dtNavMeshQuery object, which is
+	// re-used for all of its queries.
+	class DLLNETWORK QueryService {
+	  public:
+		struct DLLNETWORK Settings {
+			uint32_t workerCount = 2;
+			// Search extents for finding the nearest polygons to the start and goal positions
+			Vector3 extents {256.f, 256.f, 256.f};
+			// Maximum number of polygons in a path
+			uint32_t maxPathLength = 128;
+			uint32_t maxNodes = 2048;
+		};
+		struct DLLNETWORK Stats {
+			uint64_t numRequests = 0;
+			// Requests that were merged into an identical pending query
+			uint64_t numDeduplicated = 0;
+			uint64_t numCancelled = 0;
+			uint64_t numSucceeded = 0;
+			uint64_t numFailed = 0;
+		};
+
+		QueryService(const std::shared_ptr<Mesh> &navMesh, const Settings &settings);
+		~QueryService();
+		// If a query with the same start and goal positions is still pending, it will be shared with this request
+		std::shared_ptr<PathQuery> RequestPath(const Vector3 &start, const Vector3 &end, TaskPriority priority = TaskPriority::Normal);
+		// Shared queries are only cancelled once all of their requesters have cancelled them
+		void Cancel(PathQuery &query);
+
+		const Settings &GetSettings() const;
+		Stats GetStats() const;
+	  private:
+		struct QueryKey {
+			Vector3 start;
+			Vector3 end;
+			bool operator==(const QueryKey &other) const { return start == other.start && end == other.end; }
+		};
+		struct QueryKeyHash {
+			size_t operator()(const QueryKey &key) const;
+		};
+		void ProcessQuery(const std::shared_ptr<PathQuery> &query);
+		void RemovePendingQuery(const PathQuery &query);
+
+		std::weak_ptr<Mesh> m_navMesh;
+		Settings m_settings;
+		std::vector<std::shared_ptr<dtNavMeshQuery>> m_navQueries;
+
+		std::mutex m_pendingQueryMutex;
+		std::unordered_map<QueryKey, std::shared_ptr<PathQuery>, QueryKeyHash> m_pendingQueries;
+
+		std::atomic<uint64_t> m_numRequests = 0;
+		std::atomic<uint64_t> m_numDeduplicated = 0;
+		std::atomic<uint64_t> m_numCancelled = 0;
+		std::atomic<uint64_t> m_numSucceeded = 0;
+		std::atomic<uint64_t> m_numFailed = 0;
+
+		// Declared last, so that the workers are stopped before anything else is destroyed
+		std::unique_ptr<TaskScheduler> m_scheduler = nullptr;
+	};
+};
+
+#endif
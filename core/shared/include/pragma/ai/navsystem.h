@@ -8,8 +8,12 @@
 #define __NAVSYSTEM_H__
 
 #include "pragma/networkdefinitions.h"
+#include "pragma/util/util_task_scheduler.hpp"
 #include <udm_types.hpp>
 #include <mathutil/glmutil.h>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
 
 class Game;
 class rcContext;
@@ -22,6 +26,10 @@ typedef unsigned int dtPolyRef;
 class dtNavMesh;
 class dtNavMeshQuery;
 
+namespace pragma::nav {
+	struct InputGeometry;
+};
+
 class RcNavMesh;
 class DLLNETWORK RcPathResult {
   public:
@@ -38,14 +46,52 @@ class DLLNETWORK RcPathResult {
 
 class DLLNETWORK RcNavMesh {
   public:
+	struct DLLNETWORK TileGrid {
+		Vector3 min;
+		Vector3 max;
+		float tileWidth = 0.f;
+		// Number of tiles along the x- and z-axes
+		int32_t width = 0;
+		int32_t height = 0;
+	};
+	struct DLLNETWORK Tile {
+		int32_t x = 0;
+		int32_t y = 0;
+		// nullptr if the tile doesn't contain any polygons
+		std::shared_ptr<rcPolyMesh> polyMesh = nullptr;
+		std::shared_ptr<rcPolyMeshDetail> polyMeshDetail = nullptr;
+	};
 	RcNavMesh(const std::shared_ptr<rcPolyMesh> &polyMesh, const std::shared_ptr<rcPolyMeshDetail> &polyMeshDetail, const std::shared_ptr<dtNavMesh> &navMesh);
+	// Tiled navigation mesh; The tiles have to be added with SetTile
+	RcNavMesh(const std::shared_ptr<dtNavMesh> &navMesh, const TileGrid &tileGrid);
 	dtNavMesh &GetNavMesh();
+	// Only available for non-tiled navigation meshes
 	rcPolyMesh &GetPolyMesh();
 	rcPolyMeshDetail &GetPolyMeshDetail();
+
+	bool IsTiled() const;
+	const TileGrid &GetTileGrid() const;
+	const std::vector<Tile> &GetTiles() const;
+	const Tile *GetTile(int32_t x, int32_t y) const;
+	// Replaces the existing tile at the same coordinates. Ownership of the detour tile data (allocated with dtAlloc) is transferred to
+	// the navigation mesh. The data may be nullptr if the tile is empty.
+	bool SetTile(Tile &&tile, uint8_t *navData, int32_t navDataSize);
+
+	// Tiles may be rebuilt while path queries are running on other threads. Anything accessing the detour mesh
+	// outside of the main thread has to hold a shared lock on this mutex.
+	std::shared_mutex &GetTileMutex() const;
+
+	// Source geometry of tiled navigation meshes, used for rebuilding tiles
+	const std::shared_ptr<pragma::nav::InputGeometry> &GetInputGeometry() const;
+	void SetInputGeometry(const std::shared_ptr<pragma::nav::InputGeometry> &geometry);
   private:
 	std::shared_ptr<rcPolyMesh> m_polyMesh;
 	std::shared_ptr<rcPolyMeshDetail> m_polyMeshDetail;
 	std::shared_ptr<dtNavMesh> m_navMesh;
+	std::optional<TileGrid> m_tileGrid {};
+	std::vector<Tile> m_tiles;
+	std::shared_ptr<pragma::nav::InputGeometry> m_inputGeometry = nullptr;
+	mutable std::shared_mutex m_tileMutex;
 };
 
 namespace udm {
@@ -54,7 +100,7 @@ namespace udm {
 
 namespace pragma {
 	namespace nav {
-		static constexpr uint32_t PNAV_VERSION = 1;
+		static constexpr uint32_t PNAV_VERSION = 2;
 		static constexpr auto PNAV_IDENTIFIER = "PNAV";
 		static constexpr auto PNAV_EXTENSION_BINARY = "pnav_b";
 		static constexpr auto PNAV_EXTENSION_ASCII = "pnav";
@@ -72,6 +118,11 @@ namespace pragma {
 			std::vector<Vector3> verts;
 			uint8_t area = 0u;
 		};
+		struct DLLNETWORK InputGeometry {
+			std::vector<Vector3> verts;
+			std::vector<int32_t> indices;
+			std::vector<ConvexArea> areas;
+		};
 		struct DLLNETWORK Config {
 			enum class PartitionType : uint32_t { Watershed, Monotone, Layers };
 
@@ -92,6 +143,9 @@ namespace pragma {
 			float sampleDetailDist = 60.f;
 			float sampleDetailMaxError = 1.f;
 			PartitionType partitionType = PartitionType::Watershed;
+			// Width of a navigation mesh tile in cells. If 0, the navigation mesh will be generated as a single mesh, otherwise
+			// it is split into tiles, which are built in parallel and can be rebuilt individually at runtime.
+			int32_t tileSize = 0;
 		};
 		DLLNETWORK std::shared_ptr<RcNavMesh> generate(Game &game, const Config &config, std::string *err = nullptr);
 		DLLNETWORK std::shared_ptr<RcNavMesh> generate(Game &game, const Config &config, const BaseEntity &ent, std::string *err = nullptr);
@@ -106,8 +160,32 @@ namespace pragma {
 			static std::shared_ptr<Mesh> Create(const std::shared_ptr<RcNavMesh> &rcMesh, const Config &config);
 			static std::shared_ptr<Mesh> Load(Game &game, const std::string &fname);
 
+			static constexpr uint32_t DEFAULT_MAX_QUERY_NODES = 2048;
+			static constexpr uint32_t DEFAULT_MAX_PATH_LENGTH = 128;
+			static constexpr float DEFAULT_QUERY_EXTENT = 256.f;
+
+			std::shared_ptr<dtNavMeshQuery> CreateQuery(uint32_t maxNodes = DEFAULT_MAX_QUERY_NODES) const;
 			std::shared_ptr<RcPathResult> FindPath(const Vector3 &start, const Vector3 &end);
+			// Uses an existing query object instead of creating a new one. The query must not be used by another thread at the same time.
+			std::shared_ptr<RcPathResult> FindPath(const std::shared_ptr<dtNavMeshQuery> &query, const Vector3 &start, const Vector3 &end, const Vector3 &extents, uint32_t maxPathLength);
 			bool RayCast(const Vector3 &start, const Vector3 &end, Vector3 &hit);
+
+			// Schedules all tiles overlapping the specified bounds to be rebuilt from the input geometry. Only available for tiled navigation meshes.
+			// If the mesh has no input geometry (e.g. because it was loaded from a file), the geometry of the world will be used.
+			// The tiles are rebuilt in the background and replaced by UpdateTileRebuilds once they're complete.
+			bool RebuildTiles(Game &game, const Vector3 &min, const Vector3 &max, std::string *err = nullptr);
+			// Replaces the input geometry and rebuilds the tiles overlapping the specified bounds
+			bool UpdateGeometry(Game &game, const std::shared_ptr<InputGeometry> &geometry, const Vector3 &min, const Vector3 &max, std::string *err = nullptr);
+			// Dynamic obstacles mark their bounds as non-walkable. The affected tiles are rebuilt in the background.
+			std::optional<uint32_t> AddObstacle(Game &game, const Vector3 &min, const Vector3 &max);
+			bool RemoveObstacle(Game &game, uint32_t obstacleId);
+			// Replaces the tiles that have finished rebuilding and starts rebuilding the tiles that have been changed since.
+			// Has to be called from the main thread; The game calls this every tick for its navigation mesh.
+			void UpdateTileRebuilds(Game &game);
+			// Blocks until all scheduled tile rebuilds have been completed and applied
+			void FinishTileRebuilds(Game &game);
+			bool IsTileRebuildPending() const;
+
 			bool Save(Game &game, udm::AssetDataArg outData, std::string &outErr);
 			bool Save(Game &game, const std::string &fileName, std::string &outErr);
 
@@ -122,8 +200,24 @@ namespace pragma {
 			bool LoadFromAssetData(Game &game, const udm::AssetData &data, std::string &outErr);
 			bool FindNearestPoly(const Vector3 &pos, dtPolyRef &ref);
 		  private:
+			struct Obstacle {
+				Vector3 min;
+				Vector3 max;
+			};
+			struct TileRebuild;
+			void StartTileRebuild(Game &game);
 			std::shared_ptr<RcNavMesh> m_rcMesh;
 			Config m_config = {};
+			std::unordered_map<uint32_t, Obstacle> m_obstacles;
+			uint32_t m_nextObstacleId = 0;
+
+			// Tiles that have to be rebuilt, indexed by y *width +x
+			std::vector<bool> m_dirtyTiles;
+			uint32_t m_dirtyTileCount = 0;
+			// Created on demand and kept for subsequent rebuilds
+			std::unique_ptr<TaskScheduler> m_tileBuildScheduler = nullptr;
+			// Rebuild that is currently in progress, if any; Declared after the scheduler, so it is waited for before the workers are stopped
+			std::shared_ptr<TileRebuild> m_tileRebuild = nullptr;
 		};
 	};
 };
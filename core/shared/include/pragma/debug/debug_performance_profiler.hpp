@@ -9,6 +9,7 @@
 #define __DEBUG_PERFORMANCE_PROFILER_HPP__
 
 #include "pragma/definitions.h"
+#include "pragma/debug/debug_trace_recorder.hpp"
 #include <spdlog/spdlog.h>
 #include <mathutil/umath.h>
 #include <sharedutils/util_clock.hpp>
@@ -104,10 +105,15 @@ namespace pragma {
 			ProfilingStage *GetStage(ProfilingStage::StageId stage);
 			const std::vector<std::weak_ptr<ProfilingStage>> &GetStages() const;
 			void AddStage(ProfilingStage &stage);
+
+			// Captures the start and end times of all stages while recording
+			const TraceRecorder &GetTraceRecorder() const;
+			TraceRecorder &GetTraceRecorder();
 		  protected:
 			Profiler() = default;
 			std::shared_ptr<ProfilingStage> m_rootStage = nullptr;
 		  private:
+			TraceRecorder m_traceRecorder;
 			ProfilingStage::StageId m_nextStageId = 0u;
 			std::vector<std::weak_ptr<ProfilingStage>> m_stages = {};
 			friend std::shared_ptr<ProfilingStage> ProfilingStage::Create(Profiler &profiler, std::thread::id tid, const std::string &name);
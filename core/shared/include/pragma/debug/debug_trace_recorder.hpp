@@ -0,0 +1,101 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan
+ */
+
+#ifndef __DEBUG_TRACE_RECORDER_HPP__
+#define __DEBUG_TRACE_RECORDER_HPP__
+
+#include "pragma/definitions.h"
+#include <chrono>
+#include <atomic>
+#include <array>
+#include <mutex>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+#include <string>
+#include <ostream>
+#include <unordered_map>
+
+namespace pragma {
+	namespace debug {
+		// Records the start and end of profiling stages of all threads, which can then be exported
+		// in the Chrome Trace Event format (viewable in chrome://tracing or https://ui.perfetto.dev).
+		// Every thread writes into its own buffer, so recording an event does not require any locks.
+		class DLLNETWORK TraceRecorder {
+		  public:
+			enum class EventType : uint8_t { Begin = 0, End };
+			using Clock = std::chrono::steady_clock;
+			static constexpr uint32_t DEFAULT_MAX_EVENTS_PER_THREAD = 4'000'000;
+
+			TraceRecorder();
+			~TraceRecorder();
+			TraceRecorder(const TraceRecorder &) = delete;
+			TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+			// Discards all previously recorded events and starts a new capture. If frameCount is set, the
+			// capture will end automatically after the specified number of frames (see EndFrame).
+			void Start(std::optional<uint32_t> frameCount = {}, uint32_t maxEventsPerThread = DEFAULT_MAX_EVENTS_PER_THREAD);
+			void Stop();
+			bool IsRecording() const;
+
+			// May be called from any thread while recording. The name will be copied on first use.
+			void Record(const std::string &name, EventType type);
+			// Returns true if the frame limit has been reached and the capture has been stopped as a result
+			bool EndFrame();
+
+			uint32_t GetRecordedFrameCount() const;
+			uint64_t GetRecordedEventCount() const;
+			uint64_t GetDroppedEventCount() const;
+
+			// Must not be called while recording
+			void WriteChromeTrace(std::ostream &out) const;
+		  private:
+			struct Event {
+				Clock::time_point time;
+				uint32_t nameIndex;
+				EventType type;
+			};
+			struct EventChunk {
+				static constexpr uint32_t SIZE = 4'096;
+				std::array<Event, SIZE> events;
+				std::unique_ptr<EventChunk> next = nullptr;
+			};
+			struct ThreadBuffer {
+				std::thread::id threadId;
+				uint32_t index = 0;
+				std::unique_ptr<EventChunk> firstChunk = nullptr;
+				EventChunk *lastChunk = nullptr;
+				uint32_t lastChunkCount = 0;
+				std::atomic<uint32_t> eventCount = 0;
+				std::atomic<uint32_t> droppedEventCount = 0;
+				// Names are interned per thread, keyed by the address of the source string
+				std::vector<std::string> names;
+				std::unordered_map<const std::string *, uint32_t> nameIndices;
+				// Set while the owning thread is writing to this buffer
+				std::atomic<bool> busy = false;
+			};
+			ThreadBuffer &GetThreadBuffer();
+			uint32_t GetNameIndex(ThreadBuffer &buffer, const std::string &name);
+			void WaitForWriters() const;
+
+			// Used to identify the recorder in the thread-local buffer cache
+			uint64_t m_recorderId = 0;
+			std::atomic<bool> m_recording = false;
+			Clock::time_point m_startTime {};
+			std::optional<uint32_t> m_frameLimit {};
+			uint32_t m_frameCount = 0;
+			uint32_t m_maxEventsPerThread = DEFAULT_MAX_EVENTS_PER_THREAD;
+
+			// Buffers are re-used between captures and only released when the recorder is destroyed
+			mutable std::mutex m_bufferMutex;
+			std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+		};
+	};
+};
+
+#endif
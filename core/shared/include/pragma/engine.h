@@ -55,6 +55,9 @@ namespace util {
 namespace pragma::asset {
 	class AssetManager;
 };
+namespace pragma {
+	class FramePacer;
+};
 namespace pragma::debug {
 	class CPUProfiler;
 	template<class TProfilingStage>
@@ -161,6 +164,13 @@ class DLLNETWORK Engine : public CVarHandler, public CallbackHandler {
 	void SetProfilingEnabled(bool bEnabled);
 	bool StartProfilingStage(const char *stage);
 	bool StopProfilingStage();
+	// Records all profiling stages for the specified number of ticks (or until StopProfilingCapture is called)
+	// and writes them to a file in the Chrome Trace Event format. Enables profiling if it isn't enabled already.
+	void StartProfilingCapture(std::optional<uint32_t> tickCount, const std::string &fileName);
+	bool StopProfilingCapture();
+	bool IsProfilingCaptureActive() const;
+	// Paces the main loop of dedicated servers. Call Wake on the pacer to interrupt the wait for the next tick.
+	pragma::FramePacer &GetFramePacer();
 
 	upad::PackageManager *GetPADPackageManager() const;
 
@@ -340,6 +350,7 @@ class DLLNETWORK Engine : public CVarHandler, public CallbackHandler {
 	std::mutex m_parallelJobMutex = {};
 
 	std::shared_ptr<pragma::debug::CPUProfiler> m_cpuProfiler;
+	std::unique_ptr<pragma::FramePacer> m_framePacer;
 	std::vector<CallbackHandle> m_profileHandlers = {};
 
 	std::queue<std::function<void()>> m_tickEventQueue;
@@ -347,6 +358,7 @@ class DLLNETWORK Engine : public CVarHandler, public CallbackHandler {
 	StateFlags m_stateFlags;
 	mutable upad::PackageManager *m_padPackageManager = nullptr;
 	std::unique_ptr<pragma::debug::ProfilingStageManager<pragma::debug::ProfilingStage>> m_profilingStageManager;
+	std::string m_profilingCaptureFileName;
 
 	std::unordered_map<std::string, std::function<void(int, char *[])>> m_launchOptions;
 
@@ -9,6 +9,7 @@
 
 #include "pragma/entities/components/base_entity_component.hpp"
 #include "pragma/ai/navsystem.h"
+#include "pragma/ai/nav_query_service.hpp"
 #include "pragma/model/animation/activities.h"
 #include <pragma/math/orientation.h>
 #include <atomic>
@@ -24,23 +25,6 @@ namespace pragma {
 				std::array<std::unique_ptr<Vector3>, 2> splineNodes; // Antepenult and penultimate
 				uint32_t pathIdx;
 			};
-			struct PathQuery {
-				PathQuery(const Vector3 &start, const Vector3 &end);
-				std::atomic<bool> complete;
-				std::shared_ptr<PathInfo> pathInfo;
-				Vector3 start;
-				Vector3 end;
-				util::WeakHandle<BaseAIComponent> npc = {};
-			};
-			struct NavThread {
-				std::thread thread;
-				std::atomic<bool> running = true;
-				CallbackHandle releaseCallback = {};
-				std::queue<std::shared_ptr<PathQuery>> queryQueue {};
-
-				std::mutex pendingQueueMutex = {};
-				std::queue<std::shared_ptr<PathQuery>> pendingQueue {};
-			};
 		};
 	};
 
@@ -55,6 +39,7 @@ namespace pragma {
 		static const char *MoveResultToString(MoveResult result);
 		static void ReloadNavThread(Game &game);
 		static void ReleaseNavThread();
+		static nav::QueryService *GetNavQueryService();
 		struct DLLNETWORK MoveInfo {
 			MoveInfo() {}
 			MoveInfo(Activity act);
@@ -100,7 +85,7 @@ namespace pragma {
 		virtual void OnModelChanged(const std::shared_ptr<Model> &model);
 		virtual void OnEntityComponentAdded(BaseEntityComponent &component) override;
 		static std::atomic<uint32_t> s_npcCount;
-		static std::shared_ptr<ai::navigation::NavThread> s_navThread;
+		static std::unique_ptr<nav::QueryService> s_navQueryService;
 		//
 	  protected:
 		BaseAIComponent(BaseEntity &ent);
@@ -112,7 +97,7 @@ namespace pragma {
 
 		// Navigation Path
 		struct {
-			std::shared_ptr<ai::navigation::PathQuery> queuedPath;
+			std::shared_ptr<nav::PathQuery> queuedPath;
 			std::shared_ptr<ai::navigation::PathInfo> pathInfo;
 			Vector3 pathTarget;
 			bool bPathUpdateRequired = false;
@@ -55,6 +55,7 @@ namespace pragma {
 		virtual void UpdateViewAttachmentOffset(BaseEntity *ent, pragma::BaseCharacterComponent &pl, Vector3 &pos, Quat &rot, Bool bYawOnly = false) const;
 		virtual void OnEntitySpawn() override;
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 		std::optional<umath::Transform> GetParentPose() const;
 
 		StateFlags m_stateFlags = StateFlags::None;
@@ -149,6 +149,7 @@ namespace pragma {
 		void DetachFromGround(float duration = 0.1f);
 
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 
 		MovementComponent *GetMovementComponent();
 		const MovementComponent *GetMovementComponent() const { return const_cast<BaseCharacterComponent *>(this)->GetMovementComponent(); }
@@ -9,6 +9,7 @@
 
 #include "pragma/entities/components/base_entity_component_handle_wrapper.hpp"
 #include "pragma/entities/entity_component_event.hpp"
+#include "pragma/entities/entity_component_event_callbacks.hpp"
 #include "pragma/entities/entity_component_event_info.hpp"
 #include "pragma/entities/entity_component_info.hpp"
 #include "pragma/entities/baseentity_net_event_manager.hpp"
@@ -60,6 +61,7 @@ namespace pragma {
 	struct ComponentEvent;
 	class BaseEntityComponentSystem;
 	class EntityComponentManager;
+	class EntityTickScheduler;
 	struct ComponentMemberInfo;
 	using ComponentMemberIndex = uint32_t;
 
@@ -72,6 +74,16 @@ namespace pragma {
 		TickPolicy tickPolicy = TickPolicy::Never;
 		double lastTick = 0.0;
 		double nextTick = 0.0;
+		// Slot in the EntityTickScheduler, for internal use only
+		uint32_t tickSlot = std::numeric_limits<uint32_t>::max();
+		// Number of game ticks between two ticks of the component; 0 = Use the interval of the component type
+		uint32_t tickInterval = 0;
+		// Offset used to distribute components with the same tick interval over multiple game ticks
+		uint32_t tickPhase = 0;
+		// Game tick index of the last tick of the component, or of when it was added to the EntityTickScheduler
+		uint64_t lastTickIndex = 0;
+		// Delta time of the last tick of the component; 0 if the component isn't ticking
+		double lastTickDelta = 0.0;
 	};
 
 	template<typename... Args>
@@ -177,8 +189,11 @@ namespace pragma {
 		// Binds the specified function to an event specifically for this component. The function will be called
 		// whenever THIS component has triggered that event.
 		CallbackHandle AddEventCallback(ComponentEventId eventId, const std::function<util::EventReply(std::reference_wrapper<ComponentEvent>)> &fCallback);
-		CallbackHandle AddEventCallback(ComponentEventId eventId, const CallbackHandle &hCallback);
+		// If threadSafe is set, the callback must only access the entity it belongs to, as it may be invoked from a worker thread
+		CallbackHandle AddEventCallback(ComponentEventId eventId, const CallbackHandle &hCallback, bool threadSafe = false);
 		void RemoveEventCallback(ComponentEventId eventId, const CallbackHandle &hCallback);
+		bool HasEventCallbacks(ComponentEventId eventId) const;
+		bool HasThreadUnsafeEventCallbacks(ComponentEventId eventId) const;
 
 		// Invokes all registered event callbacks for this component.
 		// Only call this method directly if the event has been registered
@@ -200,10 +215,11 @@ namespace pragma {
 		util::EventReply InjectEvent(ComponentEventId eventId);
 
 		// Binds the specified function to an event. The function will be called, whenever the event was broadcasted (or injected)
-		CallbackHandle BindEvent(ComponentEventId eventId, const std::function<util::EventReply(std::reference_wrapper<ComponentEvent>)> &fCallback);
+		// See AddEventCallback for threadSafe.
+		CallbackHandle BindEvent(ComponentEventId eventId, const std::function<util::EventReply(std::reference_wrapper<ComponentEvent>)> &fCallback, bool threadSafe = false);
 
 		// Same as above, but assumes the callback never 'handles' the event. This is mostly to avoid cases where the return value is omitted by accident.
-		CallbackHandle BindEventUnhandled(ComponentEventId eventId, const std::function<void(std::reference_wrapper<ComponentEvent>)> &fCallback);
+		CallbackHandle BindEventUnhandled(ComponentEventId eventId, const std::function<void(std::reference_wrapper<ComponentEvent>)> &fCallback, bool threadSafe = false);
 
 		virtual void OnAttached(BaseEntity &ent);
 		virtual void OnDetached(BaseEntity &ent);
@@ -241,6 +257,10 @@ namespace pragma {
 		double LastTick() const;
 		double GetNextTick() const;
 		void SetNextTick(double t);
+		void SetTickInterval(uint32_t interval);
+		uint32_t GetTickInterval() const;
+		// Delta time of the last tick of this component, which is larger than the game's tick delta time if the component has a tick interval.
+		// If the component isn't ticking, the game's tick delta time is returned instead.
 		double DeltaTime() const;
 		bool Tick(double tDelta);
 		virtual void OnTick(double tDelta) {}
@@ -282,10 +302,15 @@ namespace pragma {
 	  protected:
 		friend EntityComponentManager;
 		friend BaseEntityComponentSystem;
+		friend EntityTickScheduler;
 		BaseEntityComponent(BaseEntity &ent);
 		void CleanUp();
 		void UpdateTickPolicy();
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData);
+		// Broadcasted events are only passed to HandleEvent if the component has listed them here.
+		// Every component that overwrites HandleEvent has to overwrite this function as well and add the ids of all
+		// events its HandleEvent implementation reacts to, after calling the base implementation.
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const;
 		virtual void OnActiveStateChanged(bool active);
 		virtual void Load(udm::LinkedPropertyWrapperArg udm, uint32_t version);
 		virtual std::optional<ComponentMemberIndex> DoGetMemberIndex(const std::string &name) const;
@@ -311,8 +336,8 @@ namespace pragma {
 		ComponentId m_componentId = std::numeric_limits<ComponentId>::max();
 
 		std::vector<CallbackInfo> &GetCallbackInfos() const;
-		std::unordered_map<ComponentEventId, std::vector<CallbackHandle>> &GetEventCallbacks() const;
-		std::unordered_map<ComponentEventId, std::vector<CallbackHandle>> &GetBoundEvents() const;
+		ComponentEventCallbacks &GetEventCallbacks() const;
+		std::unordered_map<ComponentEventId, std::vector<ComponentEventCallbacks::Callback>> &GetBoundEvents() const;
 	  protected:
 		void OnEntityComponentAdded(BaseEntityComponent &component, bool bSkipEventBinding);
 		BaseEntity &m_entity;
@@ -323,8 +348,8 @@ namespace pragma {
 		friend BaseEntityComponentSystem;
 
 		mutable std::unique_ptr<std::vector<CallbackInfo>> m_callbackInfos;
-		mutable std::unique_ptr<std::unordered_map<ComponentEventId, std::vector<CallbackHandle>>> m_eventCallbacks;
-		mutable std::unique_ptr<std::unordered_map<ComponentEventId, std::vector<CallbackHandle>>> m_boundEvents;
+		mutable std::unique_ptr<ComponentEventCallbacks> m_eventCallbacks;
+		mutable std::unique_ptr<std::unordered_map<ComponentEventId, std::vector<ComponentEventCallbacks::Callback>>> m_boundEvents;
 	};
 };
 REGISTER_BASIC_BITWISE_OPERATORS(pragma::BaseEntityComponent::StateFlags)
@@ -19,6 +19,7 @@ namespace pragma {
 		virtual ~BaseFlammableComponent() override;
 		virtual void Initialize() override;
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 
 		const util::PBoolProperty &GetOnFireProperty() const;
 		const util::PBoolProperty &GetIgnitableProperty() const;
@@ -100,6 +100,7 @@ namespace pragma {
 
 		virtual void ApplyViewRotationOffset(const EulerAngles &ang, float dur = 0.5f) = 0;
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 
 		ActionInputControllerComponent *GetActionInputController();
 		const ActionInputControllerComponent *GetActionInputController() const { return const_cast<BasePlayerComponent *>(this)->GetActionInputController(); }
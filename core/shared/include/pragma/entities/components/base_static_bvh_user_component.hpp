@@ -38,6 +38,7 @@ namespace pragma {
 		friend BaseStaticBvhCacheComponent;
 		void UpdateBvhStatus();
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 		CallbackHandle m_cbOnPoseChanged;
 		pragma::ComponentHandle<BaseStaticBvhCacheComponent> m_staticBvhComponent {};
 		BaseBvhComponent *m_bvhComponent = nullptr;
@@ -21,6 +21,7 @@ namespace pragma {
 		virtual void Initialize() override;
 
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 	  protected:
 		BaseBuoyancyComponent(BaseEntity &ent);
 		virtual void OnEndTouch(BaseEntity *ent, PhysObj *phys);
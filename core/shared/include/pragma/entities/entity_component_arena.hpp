@@ -0,0 +1,124 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#ifndef __ENTITY_COMPONENT_ARENA_HPP__
+#define __ENTITY_COMPONENT_ARENA_HPP__
+
+#include "pragma/networkdefinitions.h"
+#include <bit>
+#include <cinttypes>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace pragma {
+	// Pooled storage for all components of one type. Components are constructed in chunks of contiguous memory, so components
+	// of the same type are close to each other and can be iterated without chasing pointers across the heap.
+	// Freed slots are re-used by new components. Chunks are only released together with the arena, so the address of a component
+	// never changes during its lifetime.
+	// Note: Since chunks are never returned before the arena is destroyed (i.e. when the game ends), the memory of the peak number of
+	// components stays reserved, even if the peak was short-lived (e.g. a burst of projectiles or debris).
+	class DLLNETWORK ComponentArena {
+	  public:
+		// Slots per chunk; The first chunks are smaller, so component types with few instances don't waste memory
+		static constexpr uint32_t MIN_CHUNK_CAPACITY = 4;
+		static constexpr uint32_t MAX_CHUNK_CAPACITY = 64;
+		struct DLLNETWORK Stats {
+			size_t objectSize = 0;
+			size_t chunkCount = 0;
+			size_t capacity = 0;
+			size_t count = 0;
+			size_t peakCount = 0;
+			size_t allocationCount = 0;
+			size_t reservedBytes = 0;
+			size_t GetUsedBytes() const { return count * objectSize; }
+		};
+
+		ComponentArena(size_t objectSize, size_t objectAlignment);
+		~ComponentArena();
+		ComponentArena(const ComponentArena &) = delete;
+		ComponentArena &operator=(const ComponentArena &) = delete;
+
+		template<class T, typename... TArgs>
+		T *Create(TArgs &&...args);
+		template<class T>
+		void Destroy(T *object);
+
+		// Calls the function for every live object in memory order. Objects that are created by the function may or may not be included.
+		template<typename TFunc>
+		void ForEach(TFunc &&func) const;
+
+		size_t GetCount() const;
+		const Stats &GetStats() const;
+	  private:
+		struct Chunk {
+			std::byte *data = nullptr;
+			uint32_t capacity = 0;
+			// Slots that have been allocated
+			uint64_t usedMask = 0;
+			// Slots that contain a fully constructed object
+			uint64_t liveMask = 0;
+			bool inFreeList = false;
+			uint64_t GetFullMask() const { return (capacity == 64) ? ~uint64_t {0} : ((uint64_t {1} << capacity) - 1); }
+		};
+		void *Allocate();
+		void Free(void *ptr);
+		void SetLive(void *ptr, bool live);
+		// Returns the chunk index and slot of the object
+		std::pair<uint32_t, uint32_t> FindSlot(void *ptr) const;
+
+		size_t m_stride = 0;
+		size_t m_alignment = 0;
+		std::vector<std::unique_ptr<Chunk>> m_chunks;
+		// Chunk data addresses and the indices of their chunks, sorted by address
+		std::vector<std::pair<const std::byte *, uint32_t>> m_chunksByAddress;
+		// Indices of chunks that may have free slots; Full chunks are removed lazily
+		std::vector<uint32_t> m_freeChunks;
+		Stats m_stats {};
+	};
+};
+
+template<class T, typename... TArgs>
+T *pragma::ComponentArena::Create(TArgs &&...args)
+{
+	auto *ptr = Allocate();
+	T *object;
+	try {
+		object = new(ptr) T {std::forward<TArgs>(args)...};
+	}
+	catch(...) {
+		Free(ptr);
+		throw;
+	}
+	SetLive(ptr, true);
+	return object;
+}
+
+template<class T>
+void pragma::ComponentArena::Destroy(T *object)
+{
+	// Object is no longer visible to ForEach while it's being destroyed
+	SetLive(object, false);
+	object->~T();
+	Free(object);
+}
+
+template<typename TFunc>
+void pragma::ComponentArena::ForEach(TFunc &&func) const
+{
+	for(size_t i = 0; i < m_chunks.size(); ++i) {
+		auto &chunk = *m_chunks[i];
+		for(auto mask = chunk.liveMask; mask != 0;) {
+			auto slot = std::countr_zero(mask);
+			func(static_cast<void *>(chunk.data + slot * m_stride));
+			// The function may have destroyed other objects of this chunk
+			mask = chunk.liveMask & ((~uint64_t {0} << slot) << 1);
+		}
+	}
+}
+
+#endif
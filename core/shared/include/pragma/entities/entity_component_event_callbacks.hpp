@@ -0,0 +1,82 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#ifndef __ENTITY_COMPONENT_EVENT_CALLBACKS_HPP__
+#define __ENTITY_COMPONENT_EVENT_CALLBACKS_HPP__
+
+#include "pragma/networkdefinitions.h"
+#include "pragma/types.hpp"
+#include "pragma/util/util_handled.hpp"
+#include <sharedutils/functioncallback.h>
+#include <array>
+#include <optional>
+#include <vector>
+
+namespace pragma {
+	using ComponentEventId = uint32_t;
+	class BaseEntityComponent;
+	struct ComponentEvent;
+	// Event callbacks of a single component. Most components only have callbacks for a handful of events, with one or two
+	// callbacks each, so the callbacks are stored in a flat list that is searched linearly, with inline storage for the first callbacks.
+	// A bit mask over the event ids allows skipping the search for events that definitely have no callbacks.
+	// Callbacks may be added or removed while the callbacks are being invoked. Removed callbacks are invalidated and
+	// erased once the outermost invocation has completed.
+	class DLLNETWORK ComponentEventCallbacks {
+	  public:
+		struct DLLNETWORK Callback {
+			CallbackHandle hCallback;
+			// The callback only accesses the entity it belongs to and may be invoked from a worker thread
+			// (e.g. during the parallel skeletal animation update)
+			bool threadSafe = false;
+		};
+		class DLLNETWORK CallbackList {
+		  public:
+			static constexpr uint32_t INLINE_CAPACITY = 2;
+			size_t size() const { return m_inlineCount + m_overflow.size(); }
+			bool empty() const { return size() == 0; }
+			Callback &operator[](size_t i) { return (i < INLINE_CAPACITY) ? m_inline[i] : m_overflow[i - INLINE_CAPACITY]; }
+			const Callback &operator[](size_t i) const { return const_cast<CallbackList *>(this)->operator[](i); }
+			void push_back(const Callback &callback);
+			// Erases all invalid callbacks, preserving the order of the remaining ones
+			void Compact();
+		  private:
+			std::array<Callback, INLINE_CAPACITY> m_inline;
+			uint32_t m_inlineCount = 0;
+			std::vector<Callback> m_overflow;
+		};
+
+		CallbackHandle Add(ComponentEventId eventId, const CallbackHandle &hCallback, bool threadSafe = false);
+		void Remove(ComponentEventId eventId, const CallbackHandle &hCallback);
+		// Removes all callbacks
+		void Clear();
+
+		bool HasCallbacks(ComponentEventId eventId) const;
+		bool HasThreadUnsafeCallbacks(ComponentEventId eventId) const;
+		bool IsEmpty() const;
+		bool IsDispatching() const;
+		const CallbackList *FindCallbacks(ComponentEventId eventId) const;
+
+		// If the owner has been removed by one of the callbacks, this object has been destroyed as well and the
+		// function returns immediately
+		util::EventReply Invoke(ComponentEventId eventId, ComponentEvent &evData, const ComponentHandle<const BaseEntityComponent> &hOwner);
+	  private:
+		struct Entry {
+			ComponentEventId eventId;
+			CallbackList callbacks;
+		};
+		static uint64_t GetEventBit(ComponentEventId eventId) { return uint64_t {1} << (eventId % 64); }
+		std::optional<size_t> FindEntry(ComponentEventId eventId) const;
+		void Compact();
+
+		std::vector<Entry> m_entries;
+		// Bit (eventId % 64) is set if there may be callbacks for the event
+		uint64_t m_eventMask = 0;
+		uint32_t m_dispatchDepth = 0;
+		bool m_compactionRequired = false;
+	};
+};
+
+#endif
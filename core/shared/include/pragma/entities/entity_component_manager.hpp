@@ -14,6 +14,7 @@
 #include "pragma/entities/entity_component_info.hpp"
 #include "pragma/entities/entity_component_member_info.hpp"
 #include "pragma/entities/entity_component_event_info.hpp"
+#include "pragma/entities/entity_component_arena.hpp"
 #include "pragma/util/global_string_table.hpp"
 #include "pragma/types.hpp"
 #include <cinttypes>
@@ -154,6 +155,8 @@ namespace pragma {
 			std::queue<std::size_t> m_freeIndices = {};
 			std::size_t m_count = 0ull;
 			std::vector<BaseEntityComponent *> m_components = {};
+			// Only set for component types registered through RegisterComponentType<TComponent>
+			std::shared_ptr<ComponentArena> m_arena = nullptr;
 		};
 
 		const std::vector<ComponentContainerInfo> &GetComponents() const;
@@ -161,6 +164,13 @@ namespace pragma {
 		// Returns all currently active components of the specified type. Note that some items in the container may be NULL.
 		const std::vector<BaseEntityComponent *> &GetComponents(ComponentId componentId) const;
 		const std::vector<BaseEntityComponent *> &GetComponents(ComponentId componentId, std::size_t &count) const;
+		// Calls the function for all components of the specified type. If the component type has an arena, the components are
+		// iterated in memory order, otherwise in the order of GetComponents. Components created by the function may or may not be included.
+		// Either way, only components that have been registered with the manager and haven't been removed yet are included.
+		template<class TComponent, typename TFunc, typename = std::enable_if_t<std::is_final<TComponent>::value && std::is_base_of<BaseEntityComponent, TComponent>::value>>
+		void ForEachComponent(TFunc &&func) const;
+		// Returns nullptr if the components of this type are not allocated through an arena (e.g. Lua-based components)
+		const ComponentArena *GetComponentArena(ComponentId componentId) const;
 
 		// Automatically called when a component was removed; Don't call this manually!
 		void DeregisterComponent(BaseEntityComponent &component);
@@ -194,6 +204,9 @@ pragma::ComponentId pragma::EntityComponentManager::RegisterComponentType(const
 	if(std::is_base_of<pragma::BaseNetComponent, TComponent>::value)
 		flags |= ComponentFlags::Networked;
 	auto componentId = PreRegisterComponentType(name);
+	// The arena is kept alive by the deleters of its components, in case they outlive the component manager
+	auto arena = std::make_shared<ComponentArena>(sizeof(TComponent), alignof(TComponent));
+	m_components.at(componentId).m_arena = arena;
 	TComponent::RegisterEvents(*this, [this, componentId](const std::string &evName, ComponentEventInfo::Type type) {
 		auto id = RegisterEvent<TComponent>(evName, type);
 		auto it = m_componentEvents.find(id);
@@ -203,8 +216,8 @@ pragma::ComponentId pragma::EntityComponentManager::RegisterComponentType(const
 	});
 	RegisterComponentType(
 	  name,
-	  [](BaseEntity &ent) {
-		  return util::TSharedHandle<BaseEntityComponent> {new TComponent {ent}, [](pragma::BaseEntityComponent *c) { delete c; }};
+	  [arena](BaseEntity &ent) {
+		  return util::TSharedHandle<BaseEntityComponent> {arena->Create<TComponent>(ent), [arena](pragma::BaseEntityComponent *c) { arena->Destroy(static_cast<TComponent *>(c)); }};
 	  },
 	  regInfo, flags, std::type_index(typeid(TComponent)));
 	auto &componentInfo = *m_componentInfos[componentId];
@@ -212,6 +225,33 @@ pragma::ComponentId pragma::EntityComponentManager::RegisterComponentType(const
 	return componentId;
 }
 
+template<class TComponent, typename TFunc, typename>
+void pragma::EntityComponentManager::ForEachComponent(TFunc &&func) const
+{
+	ComponentId componentId;
+	if(GetComponentTypeId<TComponent>(componentId) == false)
+		return;
+	// The arena also contains components that are still being created (the id is assigned after construction) or that have been removed,
+	// but not released yet
+	auto isIncluded = [](const TComponent &component) { return component.GetComponentId() != INVALID_COMPONENT_ID && (component.GetStateFlags() & (TComponent::StateFlags::Removed | TComponent::StateFlags::CleanedUp)) == TComponent::StateFlags::None; };
+	auto *arena = GetComponentArena(componentId);
+	if(arena) {
+		arena->ForEach([&func, &isIncluded](void *ptr) {
+			auto &component = *static_cast<TComponent *>(ptr);
+			if(isIncluded(component))
+				func(component);
+		});
+		return;
+	}
+	std::size_t count;
+	auto &components = GetComponents(componentId, count);
+	for(auto i = decltype(count) {0u}; i < count; ++i) {
+		auto *component = components[i];
+		if(component && isIncluded(static_cast<TComponent &>(*component)))
+			func(static_cast<TComponent &>(*component));
+	}
+}
+
 template<class TComponent, typename>
 bool pragma::EntityComponentManager::GetComponentTypeId(ComponentId &outId) const
 {
@@ -33,6 +33,8 @@ namespace pragma {
 		virtual ~BaseEntityComponentSystem();
 		util::EventReply BroadcastEvent(ComponentEventId ev, ComponentEvent &evData, const BaseEntityComponent *src = nullptr) const;
 		util::EventReply BroadcastEvent(ComponentEventId ev) const;
+		// Returns true if any of the components handles the event (see BaseEntityComponent::GetHandledEvents)
+		bool HasEventHandlers(ComponentEventId ev) const;
 
 		ComponentHandle<pragma::BaseEntityComponent> AddComponent(const std::string &name, bool bForceCreateNew = false);
 		ComponentHandle<pragma::BaseEntityComponent> AddComponent(ComponentId componentId, bool bForceCreateNew = false);
@@ -66,6 +68,9 @@ namespace pragma {
 		virtual void OnRemove() = 0;
 
 		// For internal use only
+		void InvalidateEventDispatchTable();
+		// Builds the event dispatch table if it has been invalidated, so that it isn't built lazily by a later broadcast
+		void UpdateEventDispatchTable() const;
 		EntityComponentManager *GetComponentManager();
 		const EntityComponentManager *GetComponentManager() const;
 		static void Cleanup();
@@ -76,11 +81,18 @@ namespace pragma {
 		virtual void OnComponentAdded(BaseEntityComponent &component);
 		virtual void OnComponentRemoved(BaseEntityComponent &component);
 	  private:
+		// Components by the events they handle (see BaseEntityComponent::GetHandledEvents), in the order in which they were added
+		using EventDispatchTable = std::unordered_map<ComponentEventId, std::vector<ComponentHandle<BaseEntityComponent>>>;
+		const std::shared_ptr<EventDispatchTable> &GetEventDispatchTable() const;
+		void AddToEventDispatchTable(BaseEntityComponent &component) const;
+
 		std::unordered_map<ComponentId, ComponentHandle<BaseEntityComponent>> m_componentLookupTable; // Only contains one (the first) component per type; Used for fast lookups
 		std::vector<util::TSharedHandle<BaseEntityComponent>> m_components;
 		EntityComponentManager *m_componentManager;
 		BaseEntity *m_entity;
 		mutable StateFlags m_stateFlags = StateFlags::None;
+		// Built on demand; Held by every broadcast in progress, so it stays valid if it's rebuilt during a broadcast
+		mutable std::shared_ptr<EventDispatchTable> m_eventDispatchTable;
 	};
 };
 REGISTER_BASIC_BITWISE_OPERATORS(pragma::BaseEntityComponentSystem::StateFlags)
@@ -9,6 +9,7 @@
 
 #include "pragma/entities/entity_component_system.hpp"
 #include "pragma/entities/components/base_entity_component.hpp"
+#include "pragma/game/entity_tick_scheduler.hpp"
 
 template<class TComponent, typename>
 pragma::ComponentHandle<TComponent> pragma::BaseEntityComponentSystem::AddComponent(bool bForceCreateNew)
@@ -35,6 +36,8 @@ pragma::ComponentHandle<TComponent> pragma::BaseEntityComponentSystem::GetCompon
 	ComponentId componentId;
 	if(m_componentManager->GetComponentId(std::type_index(typeid(TComponent)), componentId) == false)
 		return pragma::ComponentHandle<TComponent> {};
+	if(EntityTickScheduler::IsValidatingTickAccess())
+		EntityTickScheduler::ValidateTickAccess(componentId, EntityTickScheduler::AccessType::Read);
 	auto it = m_componentLookupTable.find(componentId);
 	return (it != m_componentLookupTable.end()) ? const_cast<BaseEntityComponent *>(it->second.get())->GetHandle<TComponent>() : pragma::ComponentHandle<TComponent> {};
 }
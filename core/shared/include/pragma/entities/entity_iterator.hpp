@@ -24,6 +24,14 @@ struct DLLNETWORK IEntityIteratorFilter {
 	virtual bool ShouldPass(BaseEntity &ent, std::size_t index) = 0;
 };
 
+// Filters that only pass entities within a bounded region. When attached to an iterator, the entity spatial
+// index of the game is used to narrow down the entities that have to be tested.
+struct DLLNETWORK IEntityIteratorSpatialFilter : public IEntityIteratorFilter {
+	using IEntityIteratorFilter::IEntityIteratorFilter;
+	// World-space bounds that enclose all entities that can pass this filter
+	virtual void GetBounds(Vector3 &outMin, Vector3 &outMax) const = 0;
+};
+
 #pragma warning(push)
 #pragma warning(disable : 4251)
 struct BaseEntityContainer {
@@ -43,6 +51,14 @@ struct EntityContainer : public BaseEntityContainer {
   private:
 	std::vector<BaseEntity *> &ents;
 };
+// Entities found through the spatial index
+struct EntityCandidateContainer : public BaseEntityContainer {
+	EntityCandidateContainer(std::vector<BaseEntity *> &&candidates) : BaseEntityContainer(candidates.size()), ents {std::move(candidates)} {}
+	virtual std::size_t Size() const override;
+	virtual BaseEntity *At(std::size_t index) override;
+  private:
+	std::vector<BaseEntity *> ents;
+};
 struct EntityIteratorData {
 	EntityIteratorData(Game &game);
 	EntityIteratorData(Game &game, const std::vector<pragma::BaseEntityComponent *> &components, std::size_t count);
@@ -138,6 +154,7 @@ class DLLNETWORK EntityIterator {
 	void SetBaseComponentType(pragma::ComponentId componentId);
 	void SetBaseComponentType(std::type_index typeIndex);
 	void SetBaseComponentType(const std::string &componentName);
+	void ApplySpatialFilter(const IEntityIteratorSpatialFilter &filter);
 
 	std::shared_ptr<EntityIteratorData> m_iteratorData;
   private:
@@ -240,10 +257,11 @@ struct DLLNETWORK EntityIteratorFilterUser : public IEntityIteratorFilter {
 	std::function<bool(BaseEntity &, std::size_t)> m_fUserFilter = nullptr;
 };
 
-struct DLLNETWORK EntityIteratorFilterSphere : public IEntityIteratorFilter {
+struct DLLNETWORK EntityIteratorFilterSphere : public IEntityIteratorSpatialFilter {
 	EntityIteratorFilterSphere(Game &game, const Vector3 &origin, float radius);
 
 	virtual bool ShouldPass(BaseEntity &ent, std::size_t index) override;
+	virtual void GetBounds(Vector3 &outMin, Vector3 &outMax) const override;
   protected:
 	bool ShouldPass(BaseEntity &ent, std::size_t index, Vector3 &outClosestPointOnEntityBounds, float &outDistToEntity) const;
 
@@ -251,10 +269,11 @@ struct DLLNETWORK EntityIteratorFilterSphere : public IEntityIteratorFilter {
 	float m_radius = 0.f;
 };
 
-struct DLLNETWORK EntityIteratorFilterBox : public IEntityIteratorFilter {
+struct DLLNETWORK EntityIteratorFilterBox : public IEntityIteratorSpatialFilter {
 	EntityIteratorFilterBox(Game &game, const Vector3 &min, const Vector3 &max);
 
 	virtual bool ShouldPass(BaseEntity &ent, std::size_t index) override;
+	virtual void GetBounds(Vector3 &outMin, Vector3 &outMax) const override;
   private:
 	Vector3 m_min;
 	Vector3 m_max;
@@ -285,6 +304,14 @@ struct ComponentContainer : public BaseEntityContainer {
 	// For internal use only!
 	const std::vector<pragma::BaseEntityComponent *> &components;
 };
+// Components of the entities found through the spatial index. Derives from ComponentContainer, so component iterators
+// can use it interchangeably.
+struct ComponentCandidateContainer : public ComponentContainer {
+	// Note: 'components' is only bound here, it is initialized below
+	ComponentCandidateContainer(std::vector<pragma::BaseEntityComponent *> &&candidates) : ComponentContainer(ownedComponents, candidates.size()), ownedComponents {std::move(candidates)} {}
+  private:
+	std::vector<pragma::BaseEntityComponent *> ownedComponents;
+};
 
 template<class TComponent>
 class BaseEntityComponentIterator : public BaseEntityIterator {
@@ -388,6 +415,12 @@ void EntityIterator::AttachFilter(TARGS... args)
 			return;
 		}
 	}
+	if constexpr(std::is_base_of_v<IEntityIteratorSpatialFilter, TFilter>) {
+		auto filter = std::make_shared<TFilter>(m_iteratorData->game, std::forward<TARGS>(args)...);
+		ApplySpatialFilter(*filter);
+		m_iteratorData->filters.emplace_back(std::move(filter));
+		return;
+	}
 	m_iteratorData->filters.emplace_back(std::make_unique<TFilter>(m_iteratorData->game, std::forward<TARGS>(args)...));
 }
 
@@ -0,0 +1,77 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#ifndef __ENTITY_SPATIAL_INDEX_HPP__
+#define __ENTITY_SPATIAL_INDEX_HPP__
+
+#include "pragma/networkdefinitions.h"
+#include <mathutil/uvec.h>
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <mutex>
+
+class BaseEntity;
+namespace pragma {
+	// Hash grid of the world-space bounds of all entities with a transform component, used to find
+	// candidates for spatial entity queries without having to iterate all entities.
+	// Entities are marked as dirty whenever their pose or collision bounds change, and the grid is
+	// updated lazily on the next query.
+	class DLLNETWORK EntitySpatialIndex {
+	  public:
+		static constexpr float DEFAULT_CELL_SIZE = 512.f;
+		// Entities that overlap more cells than this are not inserted into the grid and are tested for every query instead
+		static constexpr uint32_t MAX_CELLS_PER_ENTITY = 64;
+
+		struct DLLNETWORK Stats {
+			uint32_t entityCount = 0;
+			uint32_t oversizedEntityCount = 0;
+			uint32_t cellCount = 0;
+		};
+
+		EntitySpatialIndex(float cellSize = DEFAULT_CELL_SIZE);
+		EntitySpatialIndex(const EntitySpatialIndex &) = delete;
+		EntitySpatialIndex &operator=(const EntitySpatialIndex &) = delete;
+
+		// May be called from any thread
+		void MarkDirty(BaseEntity &ent);
+		void Remove(const BaseEntity &ent);
+		void Clear();
+
+		// Returns all entities whose bounds intersect the specified box, sorted by entity index.
+		// The result may contain entities that are outside of the box (but never the other way around).
+		void FindCandidates(const Vector3 &min, const Vector3 &max, std::vector<BaseEntity *> &outEnts);
+		Stats GetStats();
+	  private:
+		using CellCoord = std::array<int32_t, 3>;
+		struct EntityRecord {
+			BaseEntity *entity = nullptr;
+			Vector3 min {};
+			Vector3 max {};
+			CellCoord cellMin {};
+			CellCoord cellMax {};
+			bool inserted = false;
+			bool oversized = false;
+			bool dirty = false;
+		};
+		void Update();
+		void UpdateEntity(uint32_t entIdx);
+		void InsertIntoCells(uint32_t entIdx, EntityRecord &record);
+		void RemoveFromCells(uint32_t entIdx, EntityRecord &record);
+		CellCoord GetCellCoord(const Vector3 &pos) const;
+		static uint64_t GetCellKey(int32_t x, int32_t y, int32_t z);
+
+		float m_cellSize = DEFAULT_CELL_SIZE;
+		std::mutex m_mutex;
+		std::vector<EntityRecord> m_entities;
+		std::vector<uint32_t> m_dirtyEntities;
+		std::vector<uint32_t> m_oversizedEntities;
+		std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells;
+		uint32_t m_entityCount = 0;
+	};
+};
+
+#endif
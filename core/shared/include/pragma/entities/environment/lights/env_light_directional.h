@@ -30,6 +30,7 @@ namespace pragma {
 	  protected:
 		virtual void Load(udm::LinkedPropertyWrapperArg udm, uint32_t version) override;
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 		util::PColorProperty m_ambientColor = nullptr;
 		Float m_maxExposure = 8.f;
 		pragma::NetEventId m_netEvSetAmbientColor = pragma::INVALID_NET_EVENT;
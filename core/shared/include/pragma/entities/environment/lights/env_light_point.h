@@ -24,6 +24,7 @@ namespace pragma {
 		float CalcDistanceFalloff(const Vector3 &point) const;
 	  protected:
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 	};
 };
 
@@ -51,6 +51,7 @@ namespace pragma {
 	  protected:
 		virtual void Load(udm::LinkedPropertyWrapperArg udm, uint32_t version) override;
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 		virtual void SetFieldAngleComponent(BaseFieldAngleComponent &c);
 		util::PFloatProperty m_blendFraction = nullptr;
 		util::PFloatProperty m_coneStartOffset = nullptr;
@@ -25,6 +25,7 @@ namespace pragma {
 		virtual void Initialize() override;
 		virtual void OnEntitySpawn() override;
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 		std::vector<util::TSharedHandle<physics::IConstraint>> &GetConstraints();
 		virtual void OnRemove();
 	  protected:
@@ -21,6 +21,7 @@ namespace pragma {
 		virtual void OnTick(double dt) override;
 	  protected:
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 		virtual void OnEntityComponentAdded(BaseEntityComponent &component) override;
 
 		Vector3 m_kvPushDir = {};
@@ -17,6 +17,7 @@ namespace pragma {
 		using BaseEntityComponent::BaseEntityComponent;
 		virtual void Initialize() override;
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 	  protected:
 		std::string m_target;
 		enum class SpawnFlags : uint32_t { FaceTargetDirectionOnTeleport = 512 };
@@ -70,6 +70,7 @@ namespace pragma {
 		virtual void OnStartTouch(BaseEntity &ent);
 		virtual void OnEndTouch(BaseEntity &ent);
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 
 		void SetTriggerFlags(TriggerFlags flags);
 		TriggerFlags GetTriggerFlags() const;
@@ -10,6 +10,8 @@
 #include "pragma/networkdefinitions.h"
 #include "pragma/util/util_thread_pool.hpp"
 #include "pragma/game/global_animation_channel_queue_processor.hpp"
+#include <functional>
+#include <unordered_map>
 
 class Game;
 namespace pragma {
@@ -28,7 +30,23 @@ namespace pragma {
 		const std::vector<AnimatedEntity> &GetAnimatedEntities() const;
 
 		void UpdateAnimations(double dt);
+
+		// If called from a worker thread during the parallel skeletal animation update, the function is queued and
+		// executed on the main thread once all parallel updates have completed. Otherwise it's executed immediately.
+		// Use this for thread-safe animation event callbacks with side effects that are not thread-safe (e.g. physics).
+		static void RunOnMainThread(const std::function<void()> &f);
 	  private:
+		// Skeletal animation groups with no parent/attachment or constraint dependency on each other.
+		// The members of a group are stored in topological order (dependencies before dependents) in m_skeletalUpdateOrder.
+		struct SkeletalAnimationGroup {
+			uint32_t offset = 0;
+			uint32_t count = 0;
+			// The group has listeners for events that aren't multi-thread safe and has to be evaluated on the main thread
+			bool requiresMainThread = false;
+		};
+		void UpdateSkeletalAnimationsParallel(double dt);
+		void UpdateMainThreadSkeletalAnimations(BaseAnimatedComponent &animC, double dt);
+		void BuildSkeletalAnimationGroups();
 		void UpdateEntityAnimationDrivers(double dt);
 		void UpdateConstraints(double dt);
 
@@ -37,8 +55,17 @@ namespace pragma {
 		pragma::ComponentId m_panimaComponentId = std::numeric_limits<pragma::ComponentId>::max();
 		pragma::ComponentId m_animationDriverComponentId = std::numeric_limits<pragma::ComponentId>::max();
 		pragma::ComponentId m_constraintManagerComponentId = std::numeric_limits<pragma::ComponentId>::max();
+		pragma::ComponentId m_constraintComponentId = std::numeric_limits<pragma::ComponentId>::max();
 		std::vector<AnimatedEntity> m_animatedEntities;
 		std::vector<BaseAnimatedComponent *> m_postAnimListenerQueue;
+
+		std::vector<BaseAnimatedComponent *> m_skeletalUpdateQueue;
+		std::vector<BaseAnimatedComponent *> m_skeletalUpdateOrder;
+		std::vector<SkeletalAnimationGroup> m_skeletalAnimationGroups;
+		// Group index and position in m_skeletalUpdateOrder of every queued component
+		std::unordered_map<const BaseAnimatedComponent *, std::pair<uint32_t, uint32_t>> m_skeletalUpdateIndices;
+		// Number of members of each main-thread group that have already been updated
+		std::vector<uint32_t> m_mainThreadGroupProgress;
 		GlobalAnimationChannelQueueProcessor m_channelQueueProcessor;
 	};
 };
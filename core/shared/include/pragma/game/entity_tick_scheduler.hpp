@@ -0,0 +1,123 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#ifndef __ENTITY_TICK_SCHEDULER_HPP__
+#define __ENTITY_TICK_SCHEDULER_HPP__
+
+#include "pragma/networkdefinitions.h"
+#include "pragma/types.hpp"
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <tuple>
+#include <vector>
+
+class Game;
+namespace BS {
+	class thread_pool;
+};
+namespace pragma {
+	class BaseEntityComponent;
+	// Keeps track of all components that have to be ticked, grouped into one bucket per component type.
+	// Every registered component has a stable slot in its bucket, which makes adding and removing components O(1):
+	// Outside of a tick the last component of the bucket is moved into the freed slot, during a tick the slot
+	// is left as a tombstone, which is reclaimed once the tick has completed.
+	// Components can tick at a lower frequency than the game (every N ticks), in which case they're distributed
+	// evenly over the N ticks. The delta time passed to a component is the time since its last tick.
+	class DLLNETWORK EntityTickScheduler {
+	  public:
+		static constexpr uint32_t INVALID_SLOT = std::numeric_limits<uint32_t>::max();
+		// Number of components of the same type that are ticked by one task in a parallel phase
+		static constexpr uint32_t PARALLEL_TICK_BATCH_SIZE = 32;
+		enum class AccessType : uint8_t {
+			Read = 0,
+			Write,
+			Structural // Adding or removing components, broadcasting events or changing the active state of components
+		};
+		// Component types which declare the component types they access during their tick are ticked in parallel phases.
+		// All component types of the same phase which don't write to a component type that the other reads or writes are ticked
+		// concurrently on the thread pool, before the remaining component types are ticked on the main thread.
+		// Components ticked in parallel must not add or remove entities or components, broadcast events or change the active
+		// state of components, and must only access components of other entities through the types they've declared. A component type implicitly reads and writes its own type.
+		// Lua-based component types are always ticked on the main thread.
+		struct DLLNETWORK TickAccess {
+			uint32_t phase = 0;
+			std::vector<ComponentId> read;
+			std::vector<ComponentId> write;
+		};
+
+		EntityTickScheduler(Game &game);
+		~EntityTickScheduler();
+		void Add(BaseEntityComponent &component);
+		void Remove(BaseEntityComponent &component);
+
+		// Interval (in ticks) for all components of the specified type, unless the component has its own interval
+		void SetTickInterval(ComponentId componentId, uint32_t interval);
+		uint32_t GetTickInterval(ComponentId componentId) const;
+
+		void SetTickAccess(ComponentId componentId, const TickAccess &access);
+		void ClearTickAccess(ComponentId componentId);
+		const TickAccess *GetTickAccess(ComponentId componentId) const;
+
+		// Tick policy updates requested from a worker thread during a parallel phase are deferred until the phase has completed.
+		// Returns true if the update has been deferred.
+		bool DeferTickPolicyUpdate(BaseEntityComponent &component);
+
+		void Tick(double tCur, double dt);
+		uint64_t GetTickIndex() const;
+		size_t GetComponentCount() const;
+
+		// Only set during a parallel phase with access validation enabled (debug_validate_component_tick_access)
+		static bool IsValidatingTickAccess() { return s_validateTickAccess.load(std::memory_order_relaxed); }
+		// Reports undeclared accesses of the component type that is being ticked on the calling thread
+		static void ValidateTickAccess(ComponentId componentId, AccessType type);
+	  private:
+		struct Bucket {
+			ComponentId componentId = std::numeric_limits<ComponentId>::max();
+			// nullptr = Tombstone
+			std::vector<BaseEntityComponent *> components;
+			uint32_t numTombstones = 0;
+			uint32_t tickInterval = 1;
+			uint32_t nextTickPhase = 0;
+
+			std::unique_ptr<TickAccess> access;
+			bool parallel = false;
+		};
+		Bucket &GetBucket(ComponentId componentId);
+		bool IsDue(const Bucket &bucket, const BaseEntityComponent &component, double tCur) const;
+		// Returns the time since the last tick of the component (or since it was added), which is at least one game tick
+		double ConsumeTickDelta(BaseEntityComponent &component, double dt) const;
+		void TickBucket(Bucket &bucket, double tCur, double dt);
+		void TickParallelPhases(double tCur, double dt);
+		void UpdateParallelBatches();
+		bool IsConflicting(const Bucket &a, const Bucket &b) const;
+		void ReportTickAccessViolation(const Bucket &bucket, ComponentId componentId, AccessType type);
+		void Compact(Bucket &bucket);
+
+		Game &m_game;
+		// Indexed by component id
+		std::vector<std::unique_ptr<Bucket>> m_buckets;
+		size_t m_componentCount = 0;
+		uint64_t m_tickIndex = 0;
+		bool m_ticking = false;
+
+		// Buckets that can be ticked concurrently, in the order in which they have to be ticked
+		std::vector<std::vector<Bucket *>> m_parallelBatches;
+		bool m_parallelBatchesDirty = false;
+		std::unique_ptr<BS::thread_pool> m_threadPool;
+		bool m_parallelPhaseActive = false;
+		std::vector<ComponentHandle<BaseEntityComponent>> m_deferredTickPolicyUpdates;
+		std::mutex m_deferredTickPolicyUpdateMutex;
+
+		std::set<std::tuple<ComponentId, ComponentId, AccessType>> m_reportedViolations;
+		std::mutex m_reportedViolationMutex;
+		static std::atomic<bool> s_validateTickAccess;
+	};
+};
+
+#endif
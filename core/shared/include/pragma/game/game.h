@@ -81,6 +81,8 @@ namespace pragma {
 	class BaseGamemodeComponent;
 	class BaseGameComponent;
 	struct AnimationUpdateManager;
+	class EntitySpatialIndex;
+	class EntityTickScheduler;
 	namespace nav {
 		class Mesh;
 	};
@@ -193,6 +195,7 @@ class DLLNETWORK Game : public CallbackHandler, public LuaCallbackHandler {
 	BaseEntity *FindEntityByUniqueId(const util::Uuid &uuid);
 	const std::unordered_map<size_t, BaseEntity *> &GetEntityUuidMap() const { return const_cast<Game *>(this)->GetEntityUuidMap(); }
 	std::unordered_map<size_t, BaseEntity *> &GetEntityUuidMap() { return m_uuidToEnt; }
+	pragma::EntitySpatialIndex &GetEntitySpatialIndex();
 	pragma::BaseWorldComponent *GetWorld();
 	const std::vector<util::TWeakSharedHandle<pragma::BaseWorldComponent>> &GetWorldComponents() const;
 	unsigned char GetPlayerCount();
@@ -210,6 +213,10 @@ class DLLNETWORK Game : public CallbackHandler, public LuaCallbackHandler {
 	TraceResult RayCast(const TraceData &data) const;
 	TraceResult Sweep(const TraceData &data) const;
 
+	void OverlapBatch(std::span<const TraceData> queries, std::span<TraceResult> outResults, pragma::physics::IEnvironment::BatchQueryFlags flags = pragma::physics::IEnvironment::BatchQueryFlags::None) const;
+	void RayCastBatch(std::span<const TraceData> queries, std::span<TraceResult> outResults, pragma::physics::IEnvironment::BatchQueryFlags flags = pragma::physics::IEnvironment::BatchQueryFlags::None) const;
+	void SweepBatch(std::span<const TraceData> queries, std::span<TraceResult> outResults, pragma::physics::IEnvironment::BatchQueryFlags flags = pragma::physics::IEnvironment::BatchQueryFlags::None) const;
+
 	virtual void CreateGiblet(const GibletCreateInfo &info) = 0;
 
 	const std::shared_ptr<pragma::nav::Mesh> &GetNavMesh() const;
@@ -359,7 +366,7 @@ class DLLNETWORK Game : public CallbackHandler, public LuaCallbackHandler {
 	virtual bool IsPhysicsSimulationEnabled() const = 0;
 
 	std::vector<pragma::ComponentHandle<pragma::BasePhysicsComponent>> &GetAwakePhysicsComponents();
-	std::vector<pragma::BaseEntityComponent *> &GetEntityTickComponents() { return m_entityTickComponents; }
+	pragma::EntityTickScheduler &GetEntityTickScheduler();
 	std::vector<pragma::BaseGamemodeComponent *> &GetGamemodeComponents() { return m_gamemodeComponents; }
 
 	// Debug
@@ -378,9 +385,10 @@ class DLLNETWORK Game : public CallbackHandler, public LuaCallbackHandler {
 	std::unique_ptr<pragma::AnimationUpdateManager> m_animUpdateManager;
 	std::vector<BaseEntity *> m_baseEnts;
 	std::unordered_map<size_t, BaseEntity *> m_uuidToEnt;
+	std::unique_ptr<pragma::EntitySpatialIndex> m_entitySpatialIndex;
 	std::queue<EntityHandle> m_entsScheduledForRemoval;
 	std::vector<pragma::ComponentHandle<pragma::BasePhysicsComponent>> m_awakePhysicsEntities;
-	std::vector<pragma::BaseEntityComponent *> m_entityTickComponents;
+	std::unique_ptr<pragma::EntityTickScheduler> m_entityTickScheduler;
 	std::vector<pragma::BaseGamemodeComponent *> m_gamemodeComponents;
 	std::shared_ptr<Lua::Interface> m_lua = nullptr;
 	std::unique_ptr<pragma::lua::ClassManager> m_luaClassManager;
@@ -436,7 +444,7 @@ class DLLNETWORK Game : public CallbackHandler, public LuaCallbackHandler {
 	virtual void RegisterLuaEntityComponent(luabind::class_<pragma::BaseEntityComponent> &classDef);
 	void LoadConfig();
 	void SaveConfig();
-	void UpdateTimers();
+	void UpdateTimers(bool persistentOnly = false);
 	virtual void InitializeLuaScriptWatcher();
 
 	// Map
@@ -21,9 +21,9 @@ namespace pragma::lua {
 		using ResultHandler = std::function<void(lua_State *)>;
 
 		LuaThreadPool(lua_State *l, uint32_t threadCount);
-		LuaThreadPool(lua_State *l, uint32_t threadCount, const std::string &name);
-		uint32_t AddTask(const std::function<ResultHandler()> &task);
-		uint32_t AddTask(const std::shared_ptr<LuaThreadTask> &task);
+		LuaThreadPool(lua_State *l, uint32_t threadCount, const std::string &name, Backend backend = Backend::Fifo);
+		uint32_t AddTask(const std::function<ResultHandler()> &task, TaskPriority priority = TaskPriority::Normal);
+		uint32_t AddTask(const std::shared_ptr<LuaThreadTask> &task, TaskPriority priority = TaskPriority::Normal);
 	  private:
 		lua_State *m_luaState = nullptr;
 	};
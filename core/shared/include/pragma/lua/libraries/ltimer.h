@@ -34,6 +34,7 @@ class DLLNETWORK Timer {
 	bool m_bRemove;
 	bool m_bRunning;
 	bool m_bIsValid;
+	bool m_bPersistent = false;
 	std::vector<std::shared_ptr<TimerHandle>> m_handles;
 
 	double GetCurTime(Game *game);
@@ -54,6 +55,9 @@ class DLLNETWORK Timer {
 	bool IsValid();
 	bool IsRunning();
 	bool IsPaused();
+	// Persistent timers keep running while the simulation is suspended (e.g. on a hibernating server)
+	void SetPersistent(bool persistent);
+	bool IsPersistent() const;
 	void InvalidateHandle(TimerHandle *hTimer);
 	float GetTimeLeft();
 	void SetTimeInterval(float time);
@@ -81,6 +85,8 @@ DLLNETWORK void Lua_Timer_GetRepetitionsLeft(lua_State *l, TimerHandle &timer);
 DLLNETWORK void Lua_Timer_SetRepetitions(lua_State *l, TimerHandle &timer, unsigned int reps);
 DLLNETWORK void Lua_Timer_IsRunning(lua_State *l, TimerHandle &timer);
 DLLNETWORK void Lua_Timer_IsPaused(lua_State *l, TimerHandle &timer);
+DLLNETWORK void Lua_Timer_SetPersistent(lua_State *l, TimerHandle &timer, bool persistent);
+DLLNETWORK void Lua_Timer_IsPersistent(lua_State *l, TimerHandle &timer);
 DLLNETWORK void Lua_Timer_Call(lua_State *l, TimerHandle &timer);
 DLLNETWORK void Lua_Timer_SetCall(lua_State *l, TimerHandle &timer, LuaFunctionObject o);
 
@@ -144,6 +144,12 @@ namespace pragma {
 			DefaultTransmit = Default | TransmitOnChange,
 			DefaultSnapshot = Default | SnapshotData
 		};
+		// Only applies to members with the TransmitOnChange flag
+		enum class TransmitPriority : uint8_t {
+			Low = 0,    // Changes are held back until another member of the entity is transmitted, or the low priority delay has passed
+			Normal,     // Changes are collected and transmitted at the end of the tick, together with all other changes of the entity
+			High        // Changes are transmitted immediately
+		};
 		struct MemberInfo {
 			struct TransformCompositeInfo {
 				pragma::ComponentMemberIndex posIdx = pragma::INVALID_COMPONENT_MEMBER_INDEX;
@@ -166,6 +172,8 @@ namespace pragma {
 			ents::EntityMemberType type;
 			std::any initialValue;
 			BaseLuaBaseEntityComponent::MemberFlags flags;
+			TransmitPriority transmitPriority = TransmitPriority::Normal;
+			float transmitInterval = 0.f; // Minimum amount of time (in seconds) between two transmissions of this member
 			mutable luabind::object onChange;
 			std::unique_ptr<TransformCompositeInfo> transformCompositeInfo;
 
@@ -195,6 +203,7 @@ namespace pragma {
 		virtual void OnMembersChanged() override { pragma::BaseEntityComponent::OnMembersChanged(); }
 		virtual const ComponentMemberInfo *GetMemberInfo(ComponentMemberIndex idx) const override;
 		virtual util::EventReply HandleEvent(ComponentEventId eventId, ComponentEvent &evData) override;
+		virtual void GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const override;
 
 		virtual void OnAttached(BaseEntity &ent) override;
 		virtual void OnDetached(BaseEntity &ent) override;
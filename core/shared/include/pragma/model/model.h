@@ -429,6 +429,8 @@ class DLLNETWORK Model : public std::enable_shared_from_this<Model> {
 	void CalculateRenderBounds();
 	void CalculateCollisionBounds();
 	virtual void Update(ModelUpdateFlags flags = ModelUpdateFlags::AllData);
+	// Incremented every time the model is updated, can be used to detect changes to the model data
+	uint32_t GetUpdateIndex() const;
 	void GetCollisionBounds(Vector3 &min, Vector3 &max) const;
 	void GetRenderBounds(Vector3 &min, Vector3 &max) const;
 	void SetCollisionBounds(const Vector3 &min, const Vector3 &max);
@@ -607,6 +609,7 @@ class DLLNETWORK Model : public std::enable_shared_from_this<Model> {
 	mutable MetaInfo m_metaInfo = {};
 	StateFlags m_stateFlags = StateFlags::None;
 	float m_mass = 0.f;
+	uint32_t m_updateIndex = 0u;
 	uint32_t m_meshCount = 0u;
 	uint32_t m_subMeshCount = 0u;
 	uint32_t m_vertexCount = 0u;
@@ -0,0 +1,47 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#ifndef __NET_MESSAGE_REGISTRY_HPP__
+#define __NET_MESSAGE_REGISTRY_HPP__
+
+#include "pragma/networkdefinitions.h"
+#include <algorithm>
+#include <cinttypes>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace pragma::networking {
+	// Name of a net message as a template argument, e.g. SendPacket<"snapshot">(packet, protocol).
+	// The message ID is resolved once per message name, instead of once per packet.
+	template<size_t N>
+	struct NetMessageName {
+		constexpr NetMessageName(const char (&str)[N]) { std::copy_n(str, N, value); }
+		char value[N];
+	};
+
+	struct DLLNETWORK NetMessageStats {
+		uint64_t packetCount = 0;
+		uint64_t byteCount = 0;
+	};
+
+	// Number of packets and bytes per net message ID
+	class DLLNETWORK NetMessageStatsTable {
+	  public:
+		void Add(uint32_t messageId, size_t numBytes, uint32_t numPackets = 1);
+		const NetMessageStats *Find(uint32_t messageId) const;
+		const std::vector<NetMessageStats> &GetStats() const;
+		NetMessageStats GetTotal() const;
+		void Reset();
+
+		// Prints the stats of all messages that have been used, sorted by the number of bytes
+		void Print(const std::unordered_map<std::string, uint32_t> &messageIds) const;
+	  private:
+		std::vector<NetMessageStats> m_stats;
+	};
+};
+
+#endif
@@ -0,0 +1,45 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan
+ */
+
+#ifndef __RESOURCE_TRANSFER_HPP__
+#define __RESOURCE_TRANSFER_HPP__
+
+#include "pragma/networkdefinitions.h"
+#include <mathutil/umath.h>
+#include <sharedutils/netpacket.hpp>
+#include <fsys/filesystem.h>
+#include <cinttypes>
+#include <string>
+#include <vector>
+
+namespace pragma::networking::resource_transfer {
+	// Identifies a file transfer to a single client. Multiple files can be transferred to the same client at once.
+	using TransferId = uint32_t;
+	static constexpr uint32_t DEFAULT_CHUNK_SIZE = 16'384;
+	static constexpr uint32_t MIN_CHUNK_SIZE = 1'024;
+	static constexpr uint32_t MAX_CHUNK_SIZE = 262'144;
+	// Extension of the file next to a partially downloaded file, which contains the content hash of the complete file.
+	// If the server announces the same hash again, the download will resume where it left off.
+	static constexpr const char *PARTIAL_HASH_FILE_EXTENSION = ".hash";
+	// Upper limit for the uncompressed size of the rough model data of a single model
+	static constexpr uint64_t MAX_ROUGH_MODEL_SIZE = 64 * 1'024 * 1'024;
+	// LZ4 can't compress data by more than this factor, so a larger uncompressed size than the compressed size allows for is invalid
+	static constexpr uint64_t MAX_LZ4_COMPRESSION_RATIO = 255;
+
+	enum class ChunkFlags : uint8_t { None = 0u, Compressed = 1u };
+
+	// Returns the MD5 hex digest of the contents of the file. The file will be read from the beginning in small blocks.
+	DLLNETWORK std::string compute_file_hash(VFilePtrInternal &f);
+
+	// Chunk layout: size (uint32), flags, [compressed size (uint32)], data
+	// The chunk will only be compressed if compress is true and the compressed data is actually smaller.
+	DLLNETWORK void write_chunk(NetPacket &packet, const uint8_t *data, uint32_t size, bool compress);
+	DLLNETWORK bool read_chunk(NetPacket &packet, std::vector<uint8_t> &outData);
+};
+REGISTER_BASIC_BITWISE_OPERATORS(pragma::networking::resource_transfer::ChunkFlags)
+
+#endif
@@ -0,0 +1,113 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan
+ */
+
+#ifndef __SNAPSHOT_CODEC_HPP__
+#define __SNAPSHOT_CODEC_HPP__
+
+#include "pragma/networkdefinitions.h"
+#include <mathutil/umath.h>
+#include <mathutil/uvec.h>
+#include <sharedutils/netpacket.hpp>
+#include <array>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+namespace pragma::networking {
+	enum class SnapshotEncoding : uint8_t {
+		Raw = 0,  // Full-precision floats, no delta compression
+		Quantized // Fixed-point / smallest-three quantization, delta-encoded against the last acknowledged snapshot
+	};
+
+	struct DLLNETWORK SnapshotQuantizationSettings {
+		// Size of a single fixed-point step in world units
+		float positionPrecision = 1.f / 64.f;
+		float velocityPrecision = 1.f / 16.f;
+		// Size of a single fixed-point step in radians per second
+		float angularVelocityPrecision = 1.f / 512.f;
+		// Number of bits for each of the three smallest quaternion components (Range [4,20])
+		uint8_t rotationBits = 12;
+
+		void Write(NetPacket &packet) const;
+		void Read(NetPacket &packet);
+		bool operator==(const SnapshotQuantizationSettings &other) const;
+		bool operator!=(const SnapshotQuantizationSettings &other) const { return !operator==(other); }
+	};
+
+	struct DLLNETWORK QuantizedEntityState {
+		enum class Field : uint8_t {
+			None = 0u,
+			Position = 1u,
+			Velocity = Position << 1u,
+			AngularVelocity = Velocity << 1u,
+			Rotation = AngularVelocity << 1u,
+			All = Position | Velocity | AngularVelocity | Rotation,
+
+			// Fields are encoded relative to the baseline state
+			Baseline = Rotation << 1u
+		};
+
+		static QuantizedEntityState Create(const SnapshotQuantizationSettings &settings, const Vector3 &pos, const Vector3 &vel, const Vector3 &angVel, const Quat &rot);
+		Vector3 GetPosition(const SnapshotQuantizationSettings &settings) const;
+		Vector3 GetVelocity(const SnapshotQuantizationSettings &settings) const;
+		Vector3 GetAngularVelocity(const SnapshotQuantizationSettings &settings) const;
+		Quat GetRotation(const SnapshotQuantizationSettings &settings) const;
+		Field GetChangedFields(const QuantizedEntityState &baseline) const;
+
+		std::array<int32_t, 3> position {};
+		std::array<int32_t, 3> velocity {};
+		std::array<int32_t, 3> angularVelocity {};
+		uint64_t rotation = 0;
+	};
+
+	using SnapshotStateTable = std::unordered_map<uint32_t, QuantizedEntityState>;
+
+	// Keeps the entity states of the most recent snapshots around, so they can be used as delta baselines.
+	// Snapshot ids are 8-bit and wrap around, which is why only a small window of snapshots is retained.
+	class DLLNETWORK SnapshotHistory {
+	  public:
+		static constexpr uint32_t MAX_BASELINE_AGE = 32;
+		void Store(uint8_t snapshotId, const SnapshotQuantizationSettings &settings, const std::shared_ptr<const SnapshotStateTable> &states);
+		// Returns the states of the specified snapshot, or nullptr if the snapshot is unknown or was encoded with different settings
+		const SnapshotStateTable *Find(uint8_t snapshotId, const SnapshotQuantizationSettings &settings) const;
+		void Clear();
+	  private:
+		struct Entry {
+			uint8_t snapshotId = 0;
+			SnapshotQuantizationSettings settings {};
+			std::shared_ptr<const SnapshotStateTable> states = nullptr;
+		};
+		std::array<Entry, MAX_BASELINE_AGE> m_entries {};
+	};
+
+	namespace snapshot {
+		DLLNETWORK void write_varint(NetPacket &packet, uint64_t value);
+		DLLNETWORK uint64_t read_varint(NetPacket &packet);
+		DLLNETWORK void write_signed_varint(NetPacket &packet, int64_t value);
+		DLLNETWORK int64_t read_signed_varint(NetPacket &packet);
+
+		DLLNETWORK int32_t quantize(float v, float precision);
+		DLLNETWORK float dequantize(int32_t v, float precision);
+		DLLNETWORK uint64_t encode_smallest_three(const Quat &rot, uint8_t bits);
+		DLLNETWORK Quat decode_smallest_three(uint64_t encoded, uint8_t bits);
+		DLLNETWORK uint32_t get_smallest_three_byte_count(uint8_t bits);
+
+		// Writes the fields of 'state' that differ from 'baseline'. If 'baseline' is nullptr, all fields are written.
+		DLLNETWORK void write_entity_state(NetPacket &packet, const QuantizedEntityState &state, const QuantizedEntityState *baseline, const SnapshotQuantizationSettings &settings);
+		// Returns an empty optional if the state was delta-encoded, but no baseline was specified. The data will be consumed either way.
+		DLLNETWORK std::optional<QuantizedEntityState> read_entity_state(NetPacket &packet, const QuantizedEntityState *baseline, const SnapshotQuantizationSettings &settings);
+
+		// Non-delta quantized transforms (Used for physics object data)
+		DLLNETWORK void write_quantized_vector(NetPacket &packet, const Vector3 &v, float precision);
+		DLLNETWORK Vector3 read_quantized_vector(NetPacket &packet, float precision);
+		DLLNETWORK void write_quantized_rotation(NetPacket &packet, const Quat &rot, uint8_t bits);
+		DLLNETWORK Quat read_quantized_rotation(NetPacket &packet, uint8_t bits);
+	};
+};
+REGISTER_BASIC_BITWISE_OPERATORS(pragma::networking::QuantizedEntityState::Field)
+
+#endif
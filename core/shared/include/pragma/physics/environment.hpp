@@ -18,6 +18,8 @@
 #include <pragma/math/vector/wvvector3.h>
 #include <vector>
 #include <unordered_map>
+#include <span>
+#include <mutex>
 #include <pragma/networkstate/networkstate.h>
 #if 0
 #include <BulletSoftBody/btSoftBody.h>
@@ -32,6 +34,9 @@ class TraceData;
 struct PhysSoftBodyInfo;
 enum class RayCastFlags : uint32_t;
 
+namespace pragma {
+	class TaskScheduler;
+};
 namespace pragma::physics {
 	class IBase;
 	class IShape;
@@ -87,6 +92,12 @@ namespace pragma::physics {
 	class DLLNETWORK IEnvironment {
 	  public:
 		enum class StateFlags : uint32_t { None = 0u, SurfacesDirty = 1u };
+		enum class BatchQueryFlags : uint32_t {
+			None = 0u,
+			// Distributes the queries across the query thread pool. The filters of all queries have to be thread-safe (i.e. no Lua callbacks).
+			// Ignored unless the physics module supports concurrent queries (see SupportsConcurrentQueries).
+			Parallel = 1u
+		};
 		enum class Event : uint32_t {
 			OnConstraintCreated = 0,
 			OnCollisionObjectCreated,
@@ -165,6 +176,16 @@ namespace pragma::physics {
 		virtual Bool RayCast(const TraceData &data, std::vector<TraceResult> *optOutResults = nullptr) const = 0;
 		virtual Bool Sweep(const TraceData &data, std::vector<TraceResult> *optOutResults = nullptr) const = 0;
 
+		// Batched queries. outResults[i] receives the first result of queries[i] (the closest hit for ray casts and sweeps),
+		// or a result with a hit type of RayCastHitType::None if there was no hit. outResults must be at least as large as queries.
+		// The default implementations issue the queries one by one, physics modules may override them with native batch queries.
+		// Must not be called while the simulation is being stepped.
+		virtual void OverlapBatch(std::span<const TraceData> queries, std::span<TraceResult> outResults, BatchQueryFlags flags = BatchQueryFlags::None) const;
+		virtual void RayCastBatch(std::span<const TraceData> queries, std::span<TraceResult> outResults, BatchQueryFlags flags = BatchQueryFlags::None) const;
+		virtual void SweepBatch(std::span<const TraceData> queries, std::span<TraceResult> outResults, BatchQueryFlags flags = BatchQueryFlags::None) const;
+		// Physics modules have to opt in if Overlap, RayCast and Sweep may be called from multiple threads at once
+		virtual bool SupportsConcurrentQueries() const;
+
 		const std::vector<util::TSharedHandle<IConstraint>> &GetConstraints() const;
 		std::vector<util::TSharedHandle<IConstraint>> &GetConstraints();
 		const std::vector<util::TSharedHandle<ICollisionObject>> &GetCollisionObjects() const;
@@ -219,6 +240,10 @@ namespace pragma::physics {
 		virtual RemainingDeltaTime DoStepSimulation(float timeStep, int maxSubSteps = 1, float fixedTimeStep = (1.f / 60.f)) = 0;
 		virtual void UpdateSurfaceTypes() = 0;
 
+		using QueryFunction = Bool (IEnvironment::*)(const TraceData &, std::vector<TraceResult> *) const;
+		void RunBatchQuery(QueryFunction query, std::span<const TraceData> queries, std::span<TraceResult> outResults, BatchQueryFlags flags) const;
+		TaskScheduler &GetQueryScheduler() const;
+
 		std::unique_ptr<pragma::physics::IVisualDebugger> m_visualDebugger;
 	  private:
 		NetworkState &m_nwState;
@@ -229,9 +254,14 @@ namespace pragma::physics {
 		std::unique_ptr<IEventCallback> m_eventCallback = nullptr;
 		SurfaceTypeManager m_surfTypeManager = {};
 		TireTypeManager m_tireTypeManager = {};
+
+		// Only created once a parallel batch query is issued
+		mutable std::once_flag m_querySchedulerInitFlag;
+		mutable std::unique_ptr<TaskScheduler> m_queryScheduler = nullptr;
 	};
 };
 REGISTER_BASIC_BITWISE_OPERATORS(pragma::physics::IEnvironment::StateFlags)
+REGISTER_BASIC_BITWISE_OPERATORS(pragma::physics::IEnvironment::BatchQueryFlags)
 
 template<class T, typename... TARGS>
 std::shared_ptr<T> pragma::physics::IEnvironment::CreateSharedPtr(TARGS &&...args)
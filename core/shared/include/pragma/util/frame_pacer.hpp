@@ -0,0 +1,66 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#ifndef __FRAME_PACER_HPP__
+#define __FRAME_PACER_HPP__
+
+#include "pragma/networkdefinitions.h"
+#include <condition_variable>
+#include <optional>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+
+namespace pragma {
+	// Puts the main loop to sleep until the next tick is due, instead of busy-waiting.
+	// The thread sleeps until shortly before the deadline and spins for the remaining time (the spin slack),
+	// since the operating system scheduler can't be relied upon to wake the thread up on time.
+	// The wait can be interrupted from any other thread (e.g. when a network packet has been received).
+	class DLLNETWORK FramePacer {
+	  public:
+		using Clock = std::chrono::steady_clock;
+		// Tick jitter is the amount of time by which a tick was started after its deadline
+		struct DLLNETWORK Stats {
+			uint64_t tickCount = 0;
+			uint64_t wakeCount = 0; // Number of times a wait was interrupted early
+			std::chrono::nanoseconds totalSleepTime {0};
+			std::chrono::nanoseconds totalSpinTime {0};
+			std::chrono::nanoseconds minJitter {0};
+			std::chrono::nanoseconds maxJitter {0};
+			double meanJitterUs = 0.0;
+			double jitterStdDevUs = 0.0;
+		};
+
+		FramePacer();
+		FramePacer(const FramePacer &) = delete;
+		FramePacer &operator=(const FramePacer &) = delete;
+
+		void SetSpinSlack(std::chrono::nanoseconds slack);
+		std::chrono::nanoseconds GetSpinSlack() const;
+
+		// Blocks until the deadline has been reached or Wake has been called. Returns false if the wait was interrupted.
+		bool WaitUntil(Clock::time_point deadline);
+		// May be called from any thread. Calls from the thread that owns the pacer are ignored, since that thread can't be waiting.
+		void Wake();
+
+		// Has to be called whenever a tick is started after a wait to update the jitter statistics
+		void OnTickStarted();
+		const Stats &GetStats() const;
+		void ResetStats();
+	  private:
+		std::thread::id m_ownerThreadId;
+		std::chrono::nanoseconds m_spinSlack;
+		std::mutex m_wakeMutex;
+		std::condition_variable m_wakeCondition;
+		std::atomic<bool> m_wakeRequested = false;
+		std::optional<Clock::time_point> m_tickDeadline {};
+		Stats m_stats {};
+		double m_jitterM2 = 0.0;
+	};
+};
+
+#endif
@@ -0,0 +1,111 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan
+ */
+
+#ifndef __UTIL_TASK_SCHEDULER_HPP__
+#define __UTIL_TASK_SCHEDULER_HPP__
+
+#include "pragma/networkdefinitions.h"
+#include <mathutil/umath.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pragma {
+	enum class TaskPriority : uint8_t {
+		Low = 0,
+		Normal,
+		High,
+
+		Count
+	};
+
+	// Work-stealing task scheduler. Every worker has its own set of deques (one per priority). Tasks submitted from a worker
+	// are pushed to that worker's deques and executed in LIFO order, idle workers steal the oldest tasks of other workers.
+	// Tasks submitted from outside of the scheduler are placed in a shared queue.
+	// Higher priority tasks are always picked up first, regardless of which queue they're in.
+	class DLLNETWORK TaskScheduler {
+	  public:
+		using Task = std::function<void()>;
+		struct DLLNETWORK WorkerStats {
+			uint64_t tasksExecuted = 0;
+			// Number of tasks this worker has taken from the deques of other workers
+			uint64_t tasksStolen = 0;
+			std::chrono::nanoseconds idleTime {0};
+		};
+
+		// Fork/join helper. Waiting for a group will execute other pending tasks in the meantime, so
+		// a task may spawn and wait for child tasks without blocking its worker.
+		class DLLNETWORK TaskGroup {
+		  public:
+			TaskGroup(TaskScheduler &scheduler, TaskPriority priority = TaskPriority::Normal);
+			TaskGroup(const TaskGroup &) = delete;
+			TaskGroup &operator=(const TaskGroup &) = delete;
+			~TaskGroup();
+			void Run(const Task &task);
+			void Wait();
+			bool IsComplete() const;
+		  private:
+			TaskScheduler &m_scheduler;
+			TaskPriority m_priority;
+			std::atomic<uint32_t> m_pendingTaskCount = 0;
+		};
+
+		TaskScheduler(uint32_t threadCount, const std::string &name = "");
+		~TaskScheduler();
+		void Submit(const Task &task, TaskPriority priority = TaskPriority::Normal);
+		// Executes a single pending task on the calling thread. Returns false if there was no task to execute.
+		bool RunPendingTask();
+		// Blocks until all submitted tasks have been completed
+		void WaitForIdle();
+		void Stop(bool execRemainingQueue = false);
+
+		uint32_t GetWorkerCount() const;
+		// Index of the worker of this scheduler the calling thread belongs to, if any
+		std::optional<uint32_t> GetCurrentWorkerIndex() const;
+		uint32_t GetPendingTaskCount() const;
+		std::vector<WorkerStats> GetWorkerStats() const;
+		void ResetWorkerStats();
+	  private:
+		using TaskQueues = std::array<std::deque<Task>, umath::to_integral(TaskPriority::Count)>;
+		struct Worker {
+			std::thread thread;
+			TaskQueues queues;
+			std::mutex queueMutex;
+			std::atomic<uint64_t> tasksExecuted = 0;
+			std::atomic<uint64_t> tasksStolen = 0;
+			std::atomic<uint64_t> idleTime = 0; // Nanoseconds
+		};
+		void RunWorker(uint32_t workerIdx);
+		bool FindTask(std::optional<uint32_t> workerIdx, Task &outTask, bool &outStolen);
+		void ExecuteTask(std::optional<uint32_t> workerIdx, Task &task, bool stolen);
+
+		std::vector<std::unique_ptr<Worker>> m_workers;
+		TaskQueues m_sharedQueues;
+		std::mutex m_sharedQueueMutex;
+
+		std::mutex m_wakeMutex;
+		std::condition_variable m_wakeCondition;
+		std::condition_variable m_idleCondition;
+		// Tasks which have been submitted, but not picked up by a worker yet
+		std::atomic<uint32_t> m_queuedTaskCount = 0;
+		// Tasks which have been submitted, but not completed yet
+		std::atomic<uint32_t> m_unfinishedTaskCount = 0;
+		std::atomic<bool> m_stop = false;
+		bool m_execRemainingQueue = true;
+	};
+};
+
+#endif
@@ -9,6 +9,7 @@
 #define __UTIL_THREAD_POOL_HPP__
 
 #include "pragma/networkdefinitions.h"
+#include "pragma/util/util_task_scheduler.hpp"
 #include <sharedutils/ctpl_stl.h>
 
 namespace pragma {
@@ -16,20 +17,32 @@ namespace pragma {
 	  public:
 		using ResultHandler = std::function<void()>;
 		static constexpr void (*NO_RESULT)() {nullptr};
+		enum class Backend : uint8_t {
+			Fifo = 0,    // Single shared FIFO queue (ctpl)
+			WorkStealing // Per-worker deques with priorities, see TaskScheduler
+		};
 
 		ThreadPool(uint32_t threadCount);
-		ThreadPool(uint32_t threadCount, const std::string &name, const std::string &baseName = "tp");
-		uint32_t AddTask(const std::function<ResultHandler()> &task);
+		ThreadPool(uint32_t threadCount, const std::string &name, const std::string &baseName = "tp", Backend backend = Backend::Fifo);
+		// The priority is ignored by the Fifo backend
+		uint32_t AddTask(const std::function<ResultHandler()> &task, TaskPriority priority = TaskPriority::Normal);
+		// With the WorkStealing backend, this will block until all previously added tasks have been completed
 		void AddBarrier();
 		bool IsComplete() const { return m_completedTaskCount == m_totalTaskCount; }
 		bool IsComplete(uint32_t taskId) const;
 		void Stop(bool execRemainingQueue = false);
 		void PushResults(uint32_t taskId);
-		void BatchProcess(uint32_t numJobs, uint32_t numItemsPerJob, const std::function<ResultHandler(uint32_t, uint32_t)> &f);
+		void BatchProcess(uint32_t numJobs, uint32_t numItemsPerJob, const std::function<ResultHandler(uint32_t, uint32_t)> &f, TaskPriority priority = TaskPriority::Normal);
 
+		// Only valid for the Fifo backend
 		ctpl::thread_pool *operator->() { return &m_pool; }
 		ctpl::thread_pool &operator*() { return m_pool; }
 
+		Backend GetBackend() const { return m_scheduler ? Backend::WorkStealing : Backend::Fifo; }
+		// Returns nullptr unless the WorkStealing backend is used
+		TaskScheduler *GetScheduler() { return m_scheduler.get(); }
+		std::vector<TaskScheduler::WorkerStats> GetWorkerStats() const;
+
 		void WaitForPendingCount(uint32_t count);
 		void WaitForCompletion();
 		uint32_t GetTotalTaskCount() const { return m_totalTaskCount; }
@@ -48,6 +61,9 @@ namespace pragma {
 
 		std::atomic<uint32_t> m_completedTaskCount = 0;
 		uint32_t m_totalTaskCount = 0;
+
+		// Declared last, so that the workers are stopped before the task states are destroyed
+		std::unique_ptr<TaskScheduler> m_scheduler = nullptr;
 	};
 };
 
@@ -54,13 +54,14 @@ void BaseAIComponent::UpdatePath()
 	if(CanMove() == false || m_moveInfo.moveOnPath == false)
 		return;
 	if(m_navInfo.queuedPath != nullptr) {
-		if(s_navThread == nullptr)
+		if(s_navQueryService == nullptr)
 			m_navInfo.queuedPath = nullptr;
 		else {
 			auto bPathChanged = false;
-			if(m_navInfo.queuedPath->complete == true) {
-				if(m_navInfo.queuedPath->pathInfo != nullptr) {
-					m_navInfo.pathInfo = m_navInfo.queuedPath->pathInfo;
+			if(m_navInfo.queuedPath->IsComplete() == true) {
+				auto &path = m_navInfo.queuedPath->GetResult();
+				if(path != nullptr) {
+					m_navInfo.pathInfo = std::make_shared<ai::navigation::PathInfo>(path);
 					m_navInfo.pathState = PathResult::Success;
 				}
 				else {
@@ -103,11 +104,13 @@ void BaseAIComponent::ResetPath()
 	m_navInfo.bPathUpdateRequired = true;
 	m_navInfo.bTargetReached = false;
 	m_navInfo.pathState = PathResult::Updating;
-	if(s_navThread != nullptr) {
-		m_navInfo.queuedPath = std::make_shared<ai::navigation::PathQuery>(pTrComponent->GetPosition(), GetMoveTarget());
-		s_navThread->pendingQueueMutex.lock();
-		s_navThread->pendingQueue.push(m_navInfo.queuedPath);
-		s_navThread->pendingQueueMutex.unlock();
+	if(s_navQueryService != nullptr) {
+		// The previous request is obsolete
+		if(m_navInfo.queuedPath != nullptr)
+			s_navQueryService->Cancel(*m_navInfo.queuedPath);
+		// NPCs without a path are stuck until the query has completed, so they take precedence over NPCs which are re-pathing
+		auto priority = (m_navInfo.pathInfo == nullptr) ? TaskPriority::High : TaskPriority::Normal;
+		m_navInfo.queuedPath = s_navQueryService->RequestPath(pTrComponent->GetPosition(), GetMoveTarget(), priority);
 	}
 }
 
@@ -0,0 +1,121 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan
+ */
+
+#include "stdafx_shared.h"
+#include "pragma/ai/nav_query_service.hpp"
+#include "DetourNavMeshQuery.h"
+#include <sharedutils/util_hash.hpp>
+
+pragma::nav::PathQuery::PathQuery(const Vector3 &start, const Vector3 &end) : m_start {start}, m_end {end} {}
+bool pragma::nav::PathQuery::IsComplete() const { return m_complete; }
+bool pragma::nav::PathQuery::IsCancelled() const { return m_cancelled; }
+const std::shared_ptr<RcPathResult> &pragma::nav::PathQuery::GetResult() const { return m_result; }
+const Vector3 &pragma::nav::PathQuery::GetStart() const { return m_start; }
+const Vector3 &pragma::nav::PathQuery::GetEnd() const { return m_end; }
+
+////////////
+
+size_t pragma::nav::QueryService::QueryKeyHash::operator()(const QueryKey &key) const
+{
+	size_t hash = 0;
+	for(auto *v : {&key.start, &key.end}) {
+		for(uint8_t i = 0; i < 3; ++i)
+			hash = util::hash_combine<float>(hash, (*v)[i]);
+	}
+	return hash;
+}
+
+pragma::nav::QueryService::QueryService(const std::shared_ptr<Mesh> &navMesh, const Settings &settings) : m_navMesh {navMesh}, m_settings {settings}
+{
+	m_settings.workerCount = umath::max(m_settings.workerCount, 1u);
+	m_navQueries.reserve(m_settings.workerCount);
+	for(auto i = decltype(m_settings.workerCount) {0u}; i < m_settings.workerCount; ++i)
+		m_navQueries.push_back(navMesh->CreateQuery(m_settings.maxNodes));
+	m_scheduler = std::make_unique<TaskScheduler>(m_settings.workerCount, "nav");
+}
+
+pragma::nav::QueryService::~QueryService()
+{
+	{
+		std::scoped_lock lock {m_pendingQueryMutex};
+		for(auto &[key, query] : m_pendingQueries)
+			query->m_cancelled = true;
+		m_pendingQueries.clear();
+	}
+	m_scheduler->Stop(true);
+}
+
+std::shared_ptr<pragma::nav::PathQuery> pragma::nav::QueryService::RequestPath(const Vector3 &start, const Vector3 &end, TaskPriority priority)
+{
+	++m_numRequests;
+	std::shared_ptr<PathQuery> query = nullptr;
+	{
+		std::scoped_lock lock {m_pendingQueryMutex};
+		auto it = m_pendingQueries.find({start, end});
+		if(it != m_pendingQueries.end()) {
+			++m_numDeduplicated;
+			++it->second->m_requesterCount;
+			query = it->second;
+		}
+		else {
+			query = std::make_shared<PathQuery>(start, end);
+			m_pendingQueries[{start, end}] = query;
+		}
+	}
+	// If the query is shared, it may already have been submitted with a lower priority. In that case it will be
+	// submitted again, and whichever task gets to it first will process it.
+	m_scheduler->Submit([this, query]() { ProcessQuery(query); }, priority);
+	return query;
+}
+
+void pragma::nav::QueryService::RemovePendingQuery(const PathQuery &query)
+{
+	auto it = m_pendingQueries.find({query.m_start, query.m_end});
+	if(it != m_pendingQueries.end() && it->second.get() == &query)
+		m_pendingQueries.erase(it);
+}
+
+void pragma::nav::QueryService::Cancel(PathQuery &query)
+{
+	std::scoped_lock lock {m_pendingQueryMutex};
+	if(query.m_complete || query.m_cancelled)
+		return;
+	if(query.m_requesterCount > 1) {
+		--query.m_requesterCount;
+		return;
+	}
+	query.m_cancelled = true;
+	RemovePendingQuery(query);
+	++m_numCancelled;
+}
+
+void pragma::nav::QueryService::ProcessQuery(const std::shared_ptr<PathQuery> &query)
+{
+	if(query->m_started.exchange(true))
+		return; // Already processed by a task with a different priority
+	{
+		// Identical requests made from now on will require a new query
+		std::scoped_lock lock {m_pendingQueryMutex};
+		RemovePendingQuery(*query);
+	}
+	if(query->m_cancelled) {
+		query->m_complete = true;
+		return;
+	}
+	auto navMesh = m_navMesh.lock();
+	auto workerIdx = m_scheduler->GetCurrentWorkerIndex();
+	if(navMesh && workerIdx && m_navQueries[*workerIdx])
+		query->m_result = navMesh->FindPath(m_navQueries[*workerIdx], query->m_start, query->m_end, m_settings.extents, m_settings.maxPathLength);
+	if(query->m_result)
+		++m_numSucceeded;
+	else
+		++m_numFailed;
+	query->m_complete = true;
+}
+
+const pragma::nav::QueryService::Settings &pragma::nav::QueryService::GetSettings() const { return m_settings; }
+pragma::nav::QueryService::Stats pragma::nav::QueryService::GetStats() const { return {m_numRequests, m_numDeduplicated, m_numCancelled, m_numSucceeded, m_numFailed}; }
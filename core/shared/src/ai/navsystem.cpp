@@ -17,6 +17,7 @@
 #include "DetourNavMesh.h"
 #include "DetourNavMeshBuilder.h"
 #include "DetourNavMeshQuery.h"
+#include "DetourCommon.h"
 #include <fsys/filesystem.h>
 #include <mathutil/umath.h>
 #include "pragma/model/modelmesh.h"
@@ -24,15 +25,68 @@
 #include "pragma/entities/components/base_model_component.hpp"
 #include "pragma/model/model.h"
 #include "pragma/util/util_game.hpp"
+#include "pragma/util/util_task_scheduler.hpp"
 #include <sharedutils/scope_guard.h>
 #include <udm.hpp>
+#include <thread>
 
 RcNavMesh::RcNavMesh(const std::shared_ptr<rcPolyMesh> &polyMesh, const std::shared_ptr<rcPolyMeshDetail> &polyMeshDetail, const std::shared_ptr<dtNavMesh> &navMesh) : m_polyMesh(polyMesh), m_polyMeshDetail(polyMeshDetail), m_navMesh(navMesh) {}
+RcNavMesh::RcNavMesh(const std::shared_ptr<dtNavMesh> &navMesh, const TileGrid &tileGrid) : m_navMesh(navMesh), m_tileGrid(tileGrid)
+{
+	m_tiles.resize(tileGrid.width * tileGrid.height);
+	for(auto y = decltype(tileGrid.height) {0}; y < tileGrid.height; ++y) {
+		for(auto x = decltype(tileGrid.width) {0}; x < tileGrid.width; ++x) {
+			auto &tile = m_tiles[y * tileGrid.width + x];
+			tile.x = x;
+			tile.y = y;
+		}
+	}
+}
 
 rcPolyMesh &RcNavMesh::GetPolyMesh() { return *m_polyMesh; }
 rcPolyMeshDetail &RcNavMesh::GetPolyMeshDetail() { return *m_polyMeshDetail; }
 dtNavMesh &RcNavMesh::GetNavMesh() { return *m_navMesh; }
 
+bool RcNavMesh::IsTiled() const { return m_tileGrid.has_value(); }
+const RcNavMesh::TileGrid &RcNavMesh::GetTileGrid() const { return *m_tileGrid; }
+const std::vector<RcNavMesh::Tile> &RcNavMesh::GetTiles() const { return m_tiles; }
+const RcNavMesh::Tile *RcNavMesh::GetTile(int32_t x, int32_t y) const
+{
+	if(!m_tileGrid || x < 0 || y < 0 || x >= m_tileGrid->width || y >= m_tileGrid->height)
+		return nullptr;
+	return &m_tiles[y * m_tileGrid->width + x];
+}
+bool RcNavMesh::SetTile(Tile &&tile, uint8_t *navData, int32_t navDataSize)
+{
+	if(GetTile(tile.x, tile.y) == nullptr) {
+		if(navData != nullptr)
+			dtFree(navData);
+		return false;
+	}
+	std::unique_lock lock {m_tileMutex};
+	auto ref = m_navMesh->getTileRefAt(tile.x, tile.y, 0);
+	if(ref != 0)
+		m_navMesh->removeTile(ref, nullptr, nullptr);
+	auto &dstTile = m_tiles[tile.y * m_tileGrid->width + tile.x];
+	dstTile = std::move(tile);
+	if(navData == nullptr) {
+		dstTile.polyMesh = nullptr;
+		dstTile.polyMeshDetail = nullptr;
+		return true;
+	}
+	auto status = m_navMesh->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, nullptr);
+	if(dtStatusFailed(status)) {
+		dtFree(navData);
+		dstTile.polyMesh = nullptr;
+		dstTile.polyMeshDetail = nullptr;
+		return false;
+	}
+	return true;
+}
+std::shared_mutex &RcNavMesh::GetTileMutex() const { return m_tileMutex; }
+const std::shared_ptr<pragma::nav::InputGeometry> &RcNavMesh::GetInputGeometry() const { return m_inputGeometry; }
+void RcNavMesh::SetInputGeometry(const std::shared_ptr<pragma::nav::InputGeometry> &geometry) { m_inputGeometry = geometry; }
+
 ////////////////////////////////
 
 pragma::nav::Config::Config(float walkableRadius, float characterHeight, float maxClimbHeight, float walkableSlopeAngle)
@@ -42,7 +96,7 @@ pragma::nav::Config::Config(float walkableRadius, float characterHeight, float m
 
 ////////////////////////////////
 
-static std::shared_ptr<dtNavMesh> initialize_detour_mesh(rcPolyMesh &polyMesh, rcPolyMeshDetail &polyMeshDetail, const pragma::nav::Config &config, std::string *err = nullptr)
+static bool create_detour_mesh_data(const rcPolyMesh &polyMesh, const rcPolyMeshDetail &polyMeshDetail, const pragma::nav::Config &config, int32_t tileX, int32_t tileY, uint8_t **outNavData, int32_t *outNavDataSize)
 {
 	dtNavMeshCreateParams params;
 	memset(&params, 0, sizeof(params));
@@ -59,6 +113,14 @@ static std::shared_ptr<dtNavMesh> initialize_detour_mesh(rcPolyMesh &polyMesh, r
 	params.detailTris = polyMeshDetail.tris;
 	params.detailTriCount = polyMeshDetail.ntris;
 
+	// TODO
+	/*params.offMeshConVerts = m_geom->getOffMeshConnectionVerts();
+	params.offMeshConRad = m_geom->getOffMeshConnectionRads();
+	params.offMeshConDir = m_geom->getOffMeshConnectionDirs();
+	params.offMeshConAreas = m_geom->getOffMeshConnectionAreas();
+	params.offMeshConFlags = m_geom->getOffMeshConnectionFlags();
+	params.offMeshConUserID = m_geom->getOffMeshConnectionId();
+	params.offMeshConCount = m_geom->getOffMeshConnectionCount();*/
 	params.offMeshConVerts = 0;
 	params.offMeshConRad = 0;
 	params.offMeshConDir = 0;
@@ -70,21 +132,28 @@ static std::shared_ptr<dtNavMesh> initialize_detour_mesh(rcPolyMesh &polyMesh, r
 	params.walkableHeight = config.characterHeight;
 	params.walkableRadius = config.walkableRadius;
 	params.walkableClimb = config.maxClimbHeight;
+	params.tileX = tileX;
+	params.tileY = tileY;
+	params.tileLayer = 0;
 	rcVcopy(params.bmin, polyMesh.bmin);
 	rcVcopy(params.bmax, polyMesh.bmax);
 	params.cs = polyMesh.cs;
 	params.ch = polyMesh.ch;
+	params.buildBvTree = true;
+	return dtCreateNavMeshData(&params, outNavData, outNavDataSize);
+}
 
+static std::shared_ptr<dtNavMesh> initialize_detour_mesh(rcPolyMesh &polyMesh, rcPolyMeshDetail &polyMeshDetail, const pragma::nav::Config &config, std::string *err = nullptr)
+{
 	uint8_t *navData;
 	int32_t navDataSize;
-	if(dtCreateNavMeshData(&params, &navData, &navDataSize) == false) {
+	if(create_detour_mesh_data(polyMesh, polyMeshDetail, config, 0, 0, &navData, &navDataSize) == false) {
 		if(err != nullptr)
 			*err = "Could not create detour navigation mesh!";
 		return nullptr;
 	}
 	util::ScopeGuard sg([navData]() { dtFree(navData); });
 	auto dtNav = std::shared_ptr<dtNavMesh>(dtAllocNavMesh(), [](dtNavMesh *dtNavMesh) { dtFreeNavMesh(dtNavMesh); });
-	;
 	if(dtNav == nullptr) {
 		if(err != nullptr)
 			*err = "Could not allocate detour navigation mesh!";
@@ -96,148 +165,97 @@ static std::shared_ptr<dtNavMesh> initialize_detour_mesh(rcPolyMesh &polyMesh, r
 			*err = "Could not initialize detour navigation mesh!";
 		return nullptr;
 	}
-	sg.dismiss(); // TODO: Is this okay?
+	sg.dismiss(); // Owned by the navigation mesh now
 	return dtNav;
 }
 
-std::shared_ptr<RcNavMesh> pragma::nav::generate(Game &game, const Config &config, const BaseEntity &ent, std::string *err)
+static std::shared_ptr<dtNavMesh> create_tiled_detour_mesh(const RcNavMesh::TileGrid &grid, std::string *err = nullptr)
 {
-	auto &hMdl = ent.GetModel();
-	if(hMdl == nullptr)
+	// Poly references are 32-bit; Split the available bits between tiles and polygons per tile
+	auto tileBits = umath::min(static_cast<int32_t>(dtIlog2(dtNextPow2(grid.width * grid.height))), 14);
+	auto polyBits = 22 - tileBits;
+	if(grid.width * grid.height > (1 << tileBits)) {
+		if(err != nullptr)
+			*err = "Too many navigation mesh tiles! Increase the tile size.";
 		return nullptr;
-	auto numTris = hMdl->GetTriangleCount();
-	std::vector<Vector3> vertices;
-	std::vector<int32_t> triangles;
-	vertices.reserve(hMdl->GetVertexCount());
-	triangles.reserve(numTris * 3u);
-	auto &colMeshes = hMdl->GetCollisionMeshes();
-	std::vector<ConvexArea> areas;
-	areas.reserve(colMeshes.size()); //numTris);
-	for(auto &colMesh : colMeshes) {
-		auto &meshVerts = colMesh->GetVertices();
-		auto &meshTris = colMesh->GetTriangles();
-		auto baseSurfMaterial = colMesh->GetSurfaceMaterial();
-		auto &surfMaterials = colMesh->GetSurfaceMaterials();
-		auto numMeshTris = meshTris.size() / 3;
-		auto idxOffset = vertices.size();
-		vertices.reserve(vertices.size() + meshVerts.size());
-		for(auto &v : meshVerts)
-			vertices.push_back(v);
-
-		triangles.reserve(triangles.size() + meshTris.size());
-		for(auto idx : meshTris)
-			triangles.push_back(idxOffset + idx);
-
-		Vector3 min, max;
-		colMesh->GetAABB(&min, &max);
-		areas.push_back({});
-		areas.back().verts.push_back(min);
-		areas.back().verts.push_back(max);
-		areas.back().area = baseSurfMaterial;
-		/*areas.reserve(areas.size() +meshTris.size() /3);
-		for(auto i=decltype(meshTris.size()){0u};i<meshTris.size();i+=3)
-		{
-			auto &v0 = meshVerts.at(meshTris.at(i));
-			auto &v1 = meshVerts.at(meshTris.at(i +1));
-			auto &v2 = meshVerts.at(meshTris.at(i +2));
-
-			areas.push_back({});
-			auto &area = areas.back();
-			area.verts = {v0,v2,v1};
-			area.area = baseSurfMaterial;
-		}*/
 	}
+	dtNavMeshParams params;
+	memset(&params, 0, sizeof(params));
+	rcVcopy(params.orig, &grid.min[0]);
+	params.tileWidth = grid.tileWidth;
+	params.tileHeight = grid.tileWidth;
+	params.maxTiles = 1 << tileBits;
+	params.maxPolys = 1 << polyBits;
 
-	return generate(game, config, vertices, triangles, &areas, err);
+	auto dtNav = std::shared_ptr<dtNavMesh>(dtAllocNavMesh(), [](dtNavMesh *dtNavMesh) { dtFreeNavMesh(dtNavMesh); });
+	if(dtNav == nullptr) {
+		if(err != nullptr)
+			*err = "Could not allocate detour navigation mesh!";
+		return nullptr;
+	}
+	auto status = dtNav->init(&params);
+	if(dtStatusFailed(status)) {
+		if(err != nullptr)
+			*err = "Could not initialize detour navigation mesh!";
+		return nullptr;
+	}
+	return dtNav;
 }
-std::shared_ptr<RcNavMesh> pragma::nav::generate(Game &game, const Config &config, const std::vector<Vector3> &verts, const std::vector<int32_t> &indices, const std::vector<ConvexArea> *areas, std::string *err)
-{
-	//
-	// Step 1. Initialize build config.
-	//
-
-	// See http://digestingduck.blogspot.com/2009/08/recast-settings-uncovered.html for more information
-	auto cellSize = config.cellSize;
-	auto cellHeight = config.cellHeight;
-	auto agentHeight = config.characterHeight;
-	auto agentRadius = config.walkableRadius;
-	auto regionMinSize = config.minRegionSize;
-	auto regionMergeSize = config.mergeRegionSize;
-	auto edgeMaxLen = config.maxEdgeLength;
-	auto edgeMaxError = config.maxSimplificationError;
-
-	auto vertsPerPoly = config.vertsPerPoly;
-	auto detailSampleDist = config.sampleDetailDist;
-	auto detailSampleMaxError = config.sampleDetailMaxError;
-	auto partitionType = config.partitionType;
-
-	auto ctx = std::make_shared<rcContext>();
-	auto keepInterResults = false;
 
-	Vector3 min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
-	Vector3 max(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+static void calc_geometry_bounds(const std::vector<Vector3> &verts, Vector3 &outMin, Vector3 &outMax)
+{
+	outMin = Vector3(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+	outMax = Vector3(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
 	for(auto &v : verts) {
-		uvec::min(&min, v);
-		uvec::max(&max, v);
+		uvec::min(&outMin, v);
+		uvec::max(&outMax, v);
 	}
 	for(auto i = 0; i < 3; ++i) {
-		min[i] -= 0.01f;
-		max[i] += 0.01f;
+		outMin[i] -= 0.01f;
+		outMax[i] += 0.01f;
 	}
-	const auto *bmin = reinterpret_cast<float *>(&min);
-	const auto *bmax = reinterpret_cast<float *>(&max);
-	const auto *fverts = reinterpret_cast<const float *>(verts.data());
-	const auto nverts = verts.size();
-	const auto *tris = indices.data();
-	const auto ntris = indices.size() / 3;
+}
 
-	// Init build configuration from GUI
+static rcConfig create_rc_config(const pragma::nav::Config &config)
+{
+	// See http://digestingduck.blogspot.com/2009/08/recast-settings-uncovered.html for more information
 	rcConfig cfg;
 	memset(&cfg, 0, sizeof(cfg));
-	cfg.cs = cellSize;
-	cfg.ch = cellHeight;
+	cfg.cs = config.cellSize;
+	cfg.ch = config.cellHeight;
 	cfg.walkableSlopeAngle = config.walkableSlopeAngle;
 	cfg.walkableHeight = static_cast<int32_t>(ceilf(config.characterHeight / cfg.ch));
 	cfg.walkableClimb = static_cast<int32_t>(floorf(config.maxClimbHeight / cfg.ch));
 	cfg.walkableRadius = static_cast<int32_t>(ceilf(config.walkableRadius / cfg.cs));
-	cfg.maxEdgeLen = static_cast<int32_t>(edgeMaxLen / cellSize);
-	cfg.maxSimplificationError = edgeMaxError;
-	cfg.minRegionArea = static_cast<int32_t>(rcSqr(regionMinSize));     // Note: area = size*size
-	cfg.mergeRegionArea = static_cast<int32_t>(rcSqr(regionMergeSize)); // Note: area = size*size
-	cfg.maxVertsPerPoly = static_cast<int32_t>(vertsPerPoly);
-	cfg.detailSampleDist = detailSampleDist < 0.9f ? 0 : cellSize * detailSampleDist;
-	cfg.detailSampleMaxError = cellHeight * detailSampleMaxError;
-
-	// Set the area where the navigation will be build.
-	// Here the bounds of the input mesh are used, but the
-	// area could be specified by an user defined box, etc.
-	rcVcopy(cfg.bmin, bmin);
-	rcVcopy(cfg.bmax, bmax);
-	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
-
-	// Reset build times gathering.
-	ctx->resetTimers();
-
-	// Start the build process.
-	ctx->startTimer(RC_TIMER_TOTAL);
-
-	ctx->log(RC_LOG_PROGRESS, "Building navigation:");
-	ctx->log(RC_LOG_PROGRESS, " - %d x %d cells", cfg.width, cfg.height);
-	ctx->log(RC_LOG_PROGRESS, " - %.1fK verts, %.1fK tris", nverts / 1000.0f, ntris / 1000.0f);
+	cfg.maxEdgeLen = static_cast<int32_t>(config.maxEdgeLength / config.cellSize);
+	cfg.maxSimplificationError = config.maxSimplificationError;
+	cfg.minRegionArea = static_cast<int32_t>(rcSqr(config.minRegionSize));     // Note: area = size*size
+	cfg.mergeRegionArea = static_cast<int32_t>(rcSqr(config.mergeRegionSize)); // Note: area = size*size
+	cfg.maxVertsPerPoly = static_cast<int32_t>(config.vertsPerPoly);
+	cfg.detailSampleDist = config.sampleDetailDist < 0.9f ? 0 : config.cellSize * config.sampleDetailDist;
+	cfg.detailSampleMaxError = config.cellHeight * config.sampleDetailMaxError;
+	return cfg;
+}
 
+using BoxList = std::vector<std::pair<Vector3, Vector3>>;
+// Rasterizes the input triangles and builds the Recast poly mesh for the area described by cfg (Steps 2 to 7).
+// Used for both single and tiled navigation meshes.
+static bool build_poly_mesh(Game &game, rcContext &ctx, const rcConfig &cfg, const float *fverts, int32_t nverts, const int32_t *tris, int32_t ntris, const pragma::nav::Config &config, const std::vector<pragma::nav::ConvexArea> *areas,
+  const BoxList *obstacles, std::shared_ptr<rcPolyMesh> &outPolyMesh, std::shared_ptr<rcPolyMeshDetail> &outPolyMeshDetail)
+{
 	//
 	// Step 2. Rasterize input polygon soup.
 	//
 
 	// Allocate voxel heightfield where we rasterize our input data to.
-	auto m_solid = std::shared_ptr<rcHeightfield>(rcAllocHeightfield(), [](rcHeightfield *heightfield) { rcFreeHeightField(heightfield); });
-	if(m_solid == nullptr) {
-		ctx->log(RC_LOG_ERROR, "buildNavigation: Out of memory 'solid'.");
-		return nullptr;
+	auto solid = std::shared_ptr<rcHeightfield>(rcAllocHeightfield(), [](rcHeightfield *heightfield) { rcFreeHeightField(heightfield); });
+	if(solid == nullptr) {
+		ctx.log(RC_LOG_ERROR, "buildNavigation: Out of memory 'solid'.");
+		return false;
 	}
-	if(rcCreateHeightfield(ctx.get(), *m_solid, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch) == false) {
-		ctx->log(RC_LOG_ERROR, "buildNavigation: Could not create solid heightfield.");
-		return nullptr;
+	if(rcCreateHeightfield(&ctx, *solid, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch) == false) {
+		ctx.log(RC_LOG_ERROR, "buildNavigation: Could not create solid heightfield.");
+		return false;
 	}
 
 	// Allocate array that can hold triangle area types.
@@ -248,11 +266,9 @@ std::shared_ptr<RcNavMesh> pragma::nav::generate(Game &game, const Config &confi
 	// Find triangles which are walkable based on their slope and rasterize them.
 	// If your input data is multiple meshes, you can transform them here, calculate
 	// the are type for each of the meshes and rasterize them.
-	rcMarkWalkableTriangles(ctx.get(), cfg.walkableSlopeAngle, fverts, nverts, tris, ntris, triAreas.data());
-	rcRasterizeTriangles(ctx.get(), fverts, nverts, tris, triAreas.data(), ntris, *m_solid, cfg.walkableClimb);
-
-	if(keepInterResults == false)
-		triAreas.clear();
+	rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, fverts, nverts, tris, ntris, triAreas.data());
+	rcRasterizeTriangles(&ctx, fverts, nverts, tris, triAreas.data(), ntris, *solid, cfg.walkableClimb);
+	triAreas.clear();
 
 	//
 	// Step 3. Filter walkables surfaces.
@@ -261,9 +277,9 @@ std::shared_ptr<RcNavMesh> pragma::nav::generate(Game &game, const Config &confi
 	// Once all geoemtry is rasterized, we do initial pass of filtering to
 	// remove unwanted overhangs caused by the conservative rasterization
 	// as well as filter spans where the character cannot possibly stand.
-	rcFilterLowHangingWalkableObstacles(ctx.get(), cfg.walkableClimb, *m_solid);
-	rcFilterLedgeSpans(ctx.get(), cfg.walkableHeight, cfg.walkableClimb, *m_solid);
-	rcFilterWalkableLowHeightSpans(ctx.get(), cfg.walkableHeight, *m_solid);
+	rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *solid);
+	rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *solid);
+	rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *solid);
 
 	//
 	// Step 4. Partition walkable surface to simple regions.
@@ -272,23 +288,21 @@ std::shared_ptr<RcNavMesh> pragma::nav::generate(Game &game, const Config &confi
 	// Compact the heightfield so that it is faster to handle from now on.
 	// This will result more cache coherent data as well as the neighbours
 	// between walkable cells will be calculated.
-	auto m_chf = std::shared_ptr<rcCompactHeightfield>(rcAllocCompactHeightfield(), [](rcCompactHeightfield *compactHeightfield) { rcFreeCompactHeightfield(compactHeightfield); });
-	if(m_chf == nullptr) {
-		ctx->log(RC_LOG_ERROR, "buildNavigation: Out of memory 'chf'.");
-		return nullptr;
+	auto chf = std::shared_ptr<rcCompactHeightfield>(rcAllocCompactHeightfield(), [](rcCompactHeightfield *compactHeightfield) { rcFreeCompactHeightfield(compactHeightfield); });
+	if(chf == nullptr) {
+		ctx.log(RC_LOG_ERROR, "buildNavigation: Out of memory 'chf'.");
+		return false;
 	}
-	if(rcBuildCompactHeightfield(ctx.get(), cfg.walkableHeight, cfg.walkableClimb, *m_solid, *m_chf) == false) {
-		ctx->log(RC_LOG_ERROR, "buildNavigation: Could not build compact data.");
-		return nullptr;
+	if(rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *solid, *chf) == false) {
+		ctx.log(RC_LOG_ERROR, "buildNavigation: Could not build compact data.");
+		return false;
 	}
-
-	if(keepInterResults == false)
-		m_solid = nullptr;
+	solid = nullptr;
 
 	// Erode the walkable area by agent radius.
-	if(rcErodeWalkableArea(ctx.get(), cfg.walkableRadius, *m_chf) == false) {
-		ctx->log(RC_LOG_ERROR, "buildNavigation: Could not erode.");
-		return nullptr;
+	if(rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf) == false) {
+		ctx.log(RC_LOG_ERROR, "buildNavigation: Could not erode.");
+		return false;
 	}
 
 	// (Optional) Mark areas.
@@ -296,28 +310,19 @@ std::shared_ptr<RcNavMesh> pragma::nav::generate(Game &game, const Config &confi
 		for(auto &convexArea : *areas) {
 			if(convexArea.verts.empty())
 				continue;
-			/*auto hMin = std::numeric_limits<float>::max();
-			auto hMax = std::numeric_limits<float>::lowest();
-			Vector3 min(std::numeric_limits<float>::max(),std::numeric_limits<float>::max(),std::numeric_limits<float>::max());
-			Vector3 max(std::numeric_limits<float>::lowest(),std::numeric_limits<float>::lowest(),std::numeric_limits<float>::lowest());
-			for(auto &v : convexArea.verts)
-			{
-				hMin = umath::min(hMin,v.y);
-				hMax = umath::max(hMax,v.y);
-
-				uvec::min(&min,v);
-				uvec::max(&max,v);
-			}
-			hMin = -10;//std::numeric_limits<float>::lowest();
-			hMax = 10;//std::numeric_limits<float>::max();
-			*/
 			auto min = convexArea.verts.at(0);
 			auto max = convexArea.verts.at(1);
-			//rcMarkConvexPolyArea(ctx.get(),reinterpret_cast<const float*>(convexArea.verts.data()),convexArea.verts.size(),hMin,hMax,convexArea.area,*m_chf);
-			rcMarkBoxArea(ctx.get(), reinterpret_cast<float *>(&min), reinterpret_cast<float *>(&max), convexArea.area, *m_chf);
+			//rcMarkConvexPolyArea(&ctx,reinterpret_cast<const float*>(convexArea.verts.data()),convexArea.verts.size(),hMin,hMax,convexArea.area,*chf);
+			rcMarkBoxArea(&ctx, reinterpret_cast<float *>(&min), reinterpret_cast<float *>(&max), convexArea.area, *chf);
 		}
 	}
 
+	// Dynamic obstacles
+	if(obstacles != nullptr) {
+		for(auto &[min, max] : *obstacles)
+			rcMarkBoxArea(&ctx, &min[0], &max[0], RC_NULL_AREA, *chf);
+	}
+
 	// Partition the heightfield so that we can use simple algorithm later to triangulate the walkable areas.
 	// There are 3 martitioning methods, each with some pros and cons:
 	// 1) Watershed partitioning
@@ -344,33 +349,33 @@ std::shared_ptr<RcNavMesh> pragma::nav::generate(Game &game, const Config &confi
 	//     if you have large open areas with small obstacles (not a problem if you use tiles)
 	//   * good choice to use for tiled navmesh with medium and small sized tiles
 
-	if(partitionType == Config::PartitionType::Watershed) {
+	if(config.partitionType == pragma::nav::Config::PartitionType::Watershed) {
 		// Prepare for region partitioning, by calculating distance field along the walkable surface.
-		if(rcBuildDistanceField(ctx.get(), *m_chf) == false) {
-			ctx->log(RC_LOG_ERROR, "buildNavigation: Could not build distance field.");
-			return nullptr;
+		if(rcBuildDistanceField(&ctx, *chf) == false) {
+			ctx.log(RC_LOG_ERROR, "buildNavigation: Could not build distance field.");
+			return false;
 		}
 
 		// Partition the walkable surface into simple regions without holes.
-		if(rcBuildRegions(ctx.get(), *m_chf, 0, cfg.minRegionArea, cfg.mergeRegionArea) == false) {
-			ctx->log(RC_LOG_ERROR, "buildNavigation: Could not build watershed regions.");
-			return nullptr;
+		if(rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea) == false) {
+			ctx.log(RC_LOG_ERROR, "buildNavigation: Could not build watershed regions.");
+			return false;
 		}
 	}
-	else if(partitionType == Config::PartitionType::Monotone) {
+	else if(config.partitionType == pragma::nav::Config::PartitionType::Monotone) {
 		// Partition the walkable surface into simple regions without holes.
 		// Monotone partitioning does not need distancefield.
-		if(rcBuildRegionsMonotone(ctx.get(), *m_chf, 0, cfg.minRegionArea, cfg.mergeRegionArea) == false) {
-			ctx->log(RC_LOG_ERROR, "buildNavigation: Could not build monotone regions.");
-			return nullptr;
+		if(rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea) == false) {
+			ctx.log(RC_LOG_ERROR, "buildNavigation: Could not build monotone regions.");
+			return false;
 		}
 	}
 	else // SAMPLE_PARTITION_LAYERS
 	{
 		// Partition the walkable surface into simple regions without holes.
-		if(rcBuildLayerRegions(ctx.get(), *m_chf, 0, cfg.minRegionArea) == false) {
-			ctx->log(RC_LOG_ERROR, "buildNavigation: Could not build layer regions.");
-			return nullptr;
+		if(rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea) == false) {
+			ctx.log(RC_LOG_ERROR, "buildNavigation: Could not build layer regions.");
+			return false;
 		}
 	}
 
@@ -379,14 +384,14 @@ std::shared_ptr<RcNavMesh> pragma::nav::generate(Game &game, const Config &confi
 	//
 
 	// Create contours.
-	auto m_cset = std::shared_ptr<rcContourSet>(rcAllocContourSet(), [](rcContourSet *contourSet) { rcFreeContourSet(contourSet); });
-	if(m_cset == nullptr) {
-		ctx->log(RC_LOG_ERROR, "buildNavigation: Out of memory 'cset'.");
-		return nullptr;
+	auto cset = std::shared_ptr<rcContourSet>(rcAllocContourSet(), [](rcContourSet *contourSet) { rcFreeContourSet(contourSet); });
+	if(cset == nullptr) {
+		ctx.log(RC_LOG_ERROR, "buildNavigation: Out of memory 'cset'.");
+		return false;
 	}
-	if(rcBuildContours(ctx.get(), *m_chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *m_cset) == false) {
-		ctx->log(RC_LOG_ERROR, "buildNavigation: Could not create contours.");
-		return nullptr;
+	if(rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset) == false) {
+		ctx.log(RC_LOG_ERROR, "buildNavigation: Could not create contours.");
+		return false;
 	}
 
 	//
@@ -394,36 +399,315 @@ std::shared_ptr<RcNavMesh> pragma::nav::generate(Game &game, const Config &confi
 	//
 
 	// Build polygon navmesh from the contours.
-	auto m_pmesh = std::unique_ptr<rcPolyMesh, void (*)(rcPolyMesh *)>(rcAllocPolyMesh(), [](rcPolyMesh *polyMesh) { rcFreePolyMesh(polyMesh); });
-	if(m_pmesh == nullptr) {
-		ctx->log(RC_LOG_ERROR, "buildNavigation: Out of memory 'pmesh'.");
-		return nullptr;
+	auto pmesh = std::shared_ptr<rcPolyMesh>(rcAllocPolyMesh(), [](rcPolyMesh *polyMesh) { rcFreePolyMesh(polyMesh); });
+	if(pmesh == nullptr) {
+		ctx.log(RC_LOG_ERROR, "buildNavigation: Out of memory 'pmesh'.");
+		return false;
 	}
-	if(rcBuildPolyMesh(ctx.get(), *m_cset, cfg.maxVertsPerPoly, *m_pmesh) == false) {
-		ctx->log(RC_LOG_ERROR, "buildNavigation: Could not triangulate contours.");
-		return nullptr;
+	if(rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *pmesh) == false) {
+		ctx.log(RC_LOG_ERROR, "buildNavigation: Could not triangulate contours.");
+		return false;
 	}
 
 	//
 	// Step 7. Create detail mesh which allows to access approximate height on each polygon.
 	//
 
-	auto m_dmesh = std::unique_ptr<rcPolyMeshDetail, void (*)(rcPolyMeshDetail *)>(rcAllocPolyMeshDetail(), [](rcPolyMeshDetail *polyMesh) { rcFreePolyMeshDetail(polyMesh); });
-	if(m_dmesh == nullptr) {
-		ctx->log(RC_LOG_ERROR, "buildNavigation: Out of memory 'pmdtl'.");
-		return nullptr;
+	auto dmesh = std::shared_ptr<rcPolyMeshDetail>(rcAllocPolyMeshDetail(), [](rcPolyMeshDetail *polyMesh) { rcFreePolyMeshDetail(polyMesh); });
+	if(dmesh == nullptr) {
+		ctx.log(RC_LOG_ERROR, "buildNavigation: Out of memory 'pmdtl'.");
+		return false;
+	}
+
+	if(rcBuildPolyMeshDetail(&ctx, *pmesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *dmesh) == false) {
+		ctx.log(RC_LOG_ERROR, "buildNavigation: Could not build detail mesh.");
+		return false;
+	}
+
+	// Update poly flags from areas.
+	for(auto i = decltype(pmesh->npolys) {0}; i < pmesh->npolys; ++i) {
+		auto &area = pmesh->areas[i];
+		if(area == RC_WALKABLE_AREA)
+			area = 0u;
+		auto *surfMat = game.GetSurfaceMaterial(area);
+		if(surfMat != nullptr)
+			pmesh->flags[i] = umath::to_integral(surfMat->GetNavigationFlags());
+	}
+
+	outPolyMesh = pmesh;
+	outPolyMeshDetail = dmesh;
+	return true;
+}
+
+static int32_t get_tile_border_size(const rcConfig &cfg) { return cfg.walkableRadius + 3; }
+static float get_tile_border_width(const pragma::nav::Config &config) { return get_tile_border_size(create_rc_config(config)) * config.cellSize; }
+
+// Returns the range of tiles overlapping the specified bounds. Returns false if there is no overlap with the tile grid.
+static bool get_tile_range(const RcNavMesh::TileGrid &grid, const Vector3 &min, const Vector3 &max, int32_t &outX0, int32_t &outY0, int32_t &outX1, int32_t &outY1)
+{
+	outX0 = static_cast<int32_t>(floorf((min.x - grid.min.x) / grid.tileWidth));
+	outY0 = static_cast<int32_t>(floorf((min.z - grid.min.z) / grid.tileWidth));
+	outX1 = static_cast<int32_t>(floorf((max.x - grid.min.x) / grid.tileWidth));
+	outY1 = static_cast<int32_t>(floorf((max.z - grid.min.z) / grid.tileWidth));
+	if(outX1 < 0 || outY1 < 0 || outX0 >= grid.width || outY0 >= grid.height)
+		return false;
+	outX0 = umath::clamp(outX0, 0, grid.width - 1);
+	outY0 = umath::clamp(outY0, 0, grid.height - 1);
+	outX1 = umath::clamp(outX1, 0, grid.width - 1);
+	outY1 = umath::clamp(outY1, 0, grid.height - 1);
+	return true;
+}
+
+// Collects the triangles (as vertex indices) for every tile in the specified range, including the triangles overlapping the tile border.
+static std::vector<std::vector<int32_t>> get_tile_triangles(const RcNavMesh::TileGrid &grid, float borderWidth, const pragma::nav::InputGeometry &geometry, int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+	auto w = x1 - x0 + 1;
+	auto h = y1 - y0 + 1;
+	std::vector<std::vector<int32_t>> tileTris(w * h);
+	auto &verts = geometry.verts;
+	auto &indices = geometry.indices;
+	for(size_t i = 0; i + 2 < indices.size(); i += 3) {
+		auto &v0 = verts[indices[i]];
+		auto &v1 = verts[indices[i + 1]];
+		auto &v2 = verts[indices[i + 2]];
+		Vector3 min {umath::min(umath::min(v0.x, v1.x), v2.x) - borderWidth, 0.f, umath::min(umath::min(v0.z, v1.z), v2.z) - borderWidth};
+		Vector3 max {umath::max(umath::max(v0.x, v1.x), v2.x) + borderWidth, 0.f, umath::max(umath::max(v0.z, v1.z), v2.z) + borderWidth};
+		int32_t tx0, ty0, tx1, ty1;
+		if(get_tile_range(grid, min, max, tx0, ty0, tx1, ty1) == false)
+			continue;
+		tx0 = umath::max(tx0, x0);
+		ty0 = umath::max(ty0, y0);
+		tx1 = umath::min(tx1, x1);
+		ty1 = umath::min(ty1, y1);
+		for(auto y = ty0; y <= ty1; ++y) {
+			for(auto x = tx0; x <= tx1; ++x) {
+				auto &tris = tileTris[(y - y0) * w + (x - x0)];
+				tris.push_back(indices[i]);
+				tris.push_back(indices[i + 1]);
+				tris.push_back(indices[i + 2]);
+			}
+		}
+	}
+	return tileTris;
+}
+
+struct TileBuildResult {
+	RcNavMesh::Tile tile {};
+	uint8_t *navData = nullptr;
+	int32_t navDataSize = 0;
+	bool success = false;
+};
+static TileBuildResult build_tile(Game &game, const pragma::nav::Config &config, const RcNavMesh::TileGrid &grid, const pragma::nav::InputGeometry &geometry, const std::vector<int32_t> &tris, const BoxList *obstacles, int32_t x, int32_t y)
+{
+	TileBuildResult result {};
+	result.tile.x = x;
+	result.tile.y = y;
+	if(tris.empty()) {
+		result.success = true;
+		return result;
+	}
+	auto cfg = create_rc_config(config);
+	cfg.tileSize = config.tileSize;
+	cfg.borderSize = get_tile_border_size(cfg);
+	cfg.width = cfg.tileSize + cfg.borderSize * 2;
+	cfg.height = cfg.tileSize + cfg.borderSize * 2;
+	auto borderWidth = cfg.borderSize * cfg.cs;
+	cfg.bmin[0] = grid.min.x + x * grid.tileWidth - borderWidth;
+	cfg.bmin[1] = grid.min.y;
+	cfg.bmin[2] = grid.min.z + y * grid.tileWidth - borderWidth;
+	cfg.bmax[0] = grid.min.x + (x + 1) * grid.tileWidth + borderWidth;
+	cfg.bmax[1] = grid.max.y;
+	cfg.bmax[2] = grid.min.z + (y + 1) * grid.tileWidth + borderWidth;
+
+	rcContext ctx {};
+	std::shared_ptr<rcPolyMesh> polyMesh;
+	std::shared_ptr<rcPolyMeshDetail> polyMeshDetail;
+	if(build_poly_mesh(game, ctx, cfg, reinterpret_cast<const float *>(geometry.verts.data()), geometry.verts.size(), tris.data(), tris.size() / 3, config, &geometry.areas, obstacles, polyMesh, polyMeshDetail) == false)
+		return result;
+	if(polyMesh->npolys == 0) {
+		result.success = true;
+		return result;
 	}
+	if(cfg.maxVertsPerPoly > DT_VERTS_PER_POLYGON || create_detour_mesh_data(*polyMesh, *polyMeshDetail, config, x, y, &result.navData, &result.navDataSize) == false)
+		return result;
+	result.tile.polyMesh = polyMesh;
+	result.tile.polyMeshDetail = polyMeshDetail;
+	result.success = true;
+	return result;
+}
 
-	if(rcBuildPolyMeshDetail(ctx.get(), *m_pmesh, *m_chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *m_dmesh) == false) {
-		ctx->log(RC_LOG_ERROR, "buildNavigation: Could not build detail mesh.");
+// Builds all tiles in the specified range in parallel
+static std::vector<TileBuildResult> build_tiles(Game &game, const pragma::nav::Config &config, const RcNavMesh::TileGrid &grid, const pragma::nav::InputGeometry &geometry, const BoxList *obstacles, int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+	auto w = x1 - x0 + 1;
+	auto tileTris = get_tile_triangles(grid, get_tile_border_width(config), geometry, x0, y0, x1, y1);
+	std::vector<TileBuildResult> results(tileTris.size());
+	auto buildTile = [&](size_t i) { results[i] = build_tile(game, config, grid, geometry, tileTris[i], obstacles, x0 + static_cast<int32_t>(i % w), y0 + static_cast<int32_t>(i / w)); };
+	auto numWorkers = umath::min(std::thread::hardware_concurrency(), static_cast<uint32_t>(results.size()));
+	if(numWorkers <= 1) {
+		for(auto i = decltype(results.size()) {0u}; i < results.size(); ++i)
+			buildTile(i);
+		return results;
+	}
+	// Only used for the initial generation, tile rebuilds use the scheduler of the navigation mesh
+	pragma::TaskScheduler scheduler {numWorkers, "navgen"};
+	pragma::TaskScheduler::TaskGroup group {scheduler};
+	for(auto i = decltype(results.size()) {0u}; i < results.size(); ++i)
+		group.Run([&buildTile, i]() { buildTile(i); });
+	group.Wait();
+	return results;
+}
+
+// Replaces the tiles of the navigation mesh with the build results. Tiles that could not be built are left untouched.
+static bool apply_tiles(RcNavMesh &navMesh, std::vector<TileBuildResult> &results, std::string *err)
+{
+	auto success = true;
+	for(auto &result : results) {
+		auto x = result.tile.x;
+		auto y = result.tile.y;
+		if(result.success == false || navMesh.SetTile(std::move(result.tile), result.navData, result.navDataSize) == false) {
+			if(err != nullptr)
+				*err = "Could not build navigation mesh tile (" + std::to_string(x) + "," + std::to_string(y) + ")!";
+			success = false;
+		}
+		result.navData = nullptr;
+	}
+	return success;
+}
+
+static std::shared_ptr<RcNavMesh> generate_tiled(Game &game, const pragma::nav::Config &config, const std::shared_ptr<pragma::nav::InputGeometry> &geometry, std::string *err)
+{
+	if(config.cellSize <= 0.f || config.cellHeight <= 0.f) {
+		if(err != nullptr)
+			*err = "Invalid cell size!";
 		return nullptr;
 	}
+	RcNavMesh::TileGrid grid {};
+	calc_geometry_bounds(geometry->verts, grid.min, grid.max);
+	int32_t gridWidth, gridHeight;
+	rcCalcGridSize(&grid.min[0], &grid.max[0], config.cellSize, &gridWidth, &gridHeight);
+	grid.width = (gridWidth + config.tileSize - 1) / config.tileSize;
+	grid.height = (gridHeight + config.tileSize - 1) / config.tileSize;
+	grid.tileWidth = config.tileSize * config.cellSize;
+
+	auto dtNav = create_tiled_detour_mesh(grid, err);
+	if(dtNav == nullptr)
+		return nullptr;
+	auto navMesh = std::make_shared<RcNavMesh>(dtNav, grid);
+	navMesh->SetInputGeometry(geometry);
+	auto results = build_tiles(game, config, grid, *geometry, nullptr, 0, 0, grid.width - 1, grid.height - 1);
+	if(apply_tiles(*navMesh, results, err) == false)
+		return nullptr;
+	return navMesh;
+}
+
+static bool collect_geometry(const BaseEntity &ent, pragma::nav::InputGeometry &outGeometry)
+{
+	auto &hMdl = ent.GetModel();
+	if(hMdl == nullptr)
+		return false;
+	auto numTris = hMdl->GetTriangleCount();
+	auto &vertices = outGeometry.verts;
+	auto &triangles = outGeometry.indices;
+	vertices.reserve(hMdl->GetVertexCount());
+	triangles.reserve(numTris * 3u);
+	auto &colMeshes = hMdl->GetCollisionMeshes();
+	auto &areas = outGeometry.areas;
+	areas.reserve(colMeshes.size()); //numTris);
+	for(auto &colMesh : colMeshes) {
+		auto &meshVerts = colMesh->GetVertices();
+		auto &meshTris = colMesh->GetTriangles();
+		auto baseSurfMaterial = colMesh->GetSurfaceMaterial();
+		auto &surfMaterials = colMesh->GetSurfaceMaterials();
+		auto numMeshTris = meshTris.size() / 3;
+		auto idxOffset = vertices.size();
+		vertices.reserve(vertices.size() + meshVerts.size());
+		for(auto &v : meshVerts)
+			vertices.push_back(v);
+
+		triangles.reserve(triangles.size() + meshTris.size());
+		for(auto idx : meshTris)
+			triangles.push_back(idxOffset + idx);
+
+		Vector3 min, max;
+		colMesh->GetAABB(&min, &max);
+		areas.push_back({});
+		areas.back().verts.push_back(min);
+		areas.back().verts.push_back(max);
+		areas.back().area = baseSurfMaterial;
+		/*areas.reserve(areas.size() +meshTris.size() /3);
+		for(auto i=decltype(meshTris.size()){0u};i<meshTris.size();i+=3)
+		{
+			auto &v0 = meshVerts.at(meshTris.at(i));
+			auto &v1 = meshVerts.at(meshTris.at(i +1));
+			auto &v2 = meshVerts.at(meshTris.at(i +2));
+
+			areas.push_back({});
+			auto &area = areas.back();
+			area.verts = {v0,v2,v1};
+			area.area = baseSurfMaterial;
+		}*/
+	}
+	return true;
+}
 
-	if(keepInterResults == false) {
-		m_chf = nullptr;
-		m_cset = nullptr;
+std::shared_ptr<RcNavMesh> pragma::nav::generate(Game &game, const Config &config, const BaseEntity &ent, std::string *err)
+{
+	auto geometry = std::make_shared<InputGeometry>();
+	if(collect_geometry(ent, *geometry) == false)
+		return nullptr;
+	if(config.tileSize > 0)
+		return generate_tiled(game, config, geometry, err);
+	return generate(game, config, geometry->verts, geometry->indices, &geometry->areas, err);
+}
+std::shared_ptr<RcNavMesh> pragma::nav::generate(Game &game, const Config &config, const std::vector<Vector3> &verts, const std::vector<int32_t> &indices, const std::vector<ConvexArea> *areas, std::string *err)
+{
+	if(config.tileSize > 0) {
+		auto geometry = std::make_shared<InputGeometry>();
+		geometry->verts = verts;
+		geometry->indices = indices;
+		if(areas != nullptr)
+			geometry->areas = *areas;
+		return generate_tiled(game, config, geometry, err);
 	}
 
+	//
+	// Step 1. Initialize build config.
+	//
+
+	auto ctx = std::make_shared<rcContext>();
+
+	Vector3 min, max;
+	calc_geometry_bounds(verts, min, max);
+	const auto *fverts = reinterpret_cast<const float *>(verts.data());
+	const auto nverts = verts.size();
+	const auto *tris = indices.data();
+	const auto ntris = indices.size() / 3;
+
+	auto cfg = create_rc_config(config);
+
+	// Set the area where the navigation will be build.
+	// Here the bounds of the input mesh are used, but the
+	// area could be specified by an user defined box, etc.
+	rcVcopy(cfg.bmin, &min[0]);
+	rcVcopy(cfg.bmax, &max[0]);
+	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
+
+	// Reset build times gathering.
+	ctx->resetTimers();
+
+	// Start the build process.
+	ctx->startTimer(RC_TIMER_TOTAL);
+
+	ctx->log(RC_LOG_PROGRESS, "Building navigation:");
+	ctx->log(RC_LOG_PROGRESS, " - %d x %d cells", cfg.width, cfg.height);
+	ctx->log(RC_LOG_PROGRESS, " - %.1fK verts, %.1fK tris", nverts / 1000.0f, ntris / 1000.0f);
+
+	std::shared_ptr<rcPolyMesh> m_pmesh;
+	std::shared_ptr<rcPolyMeshDetail> m_dmesh;
+	if(build_poly_mesh(game, *ctx, cfg, fverts, nverts, tris, ntris, config, areas, nullptr, m_pmesh, m_dmesh) == false)
+		return nullptr;
+
 	// At this point the navigation mesh data is ready, you can access it from m_pmesh.
 	// See duDebugDrawPolyMesh or dtCreateNavMeshData as examples how to access the data.
 
@@ -433,81 +717,13 @@ std::shared_ptr<RcNavMesh> pragma::nav::generate(Game &game, const Config &confi
 
 	// The GUI may allow more max points per polygon than Detour can handle.
 	// Only build the detour navmesh if we do not exceed the limit.
-	std::unique_ptr<dtNavMesh, void (*)(dtNavMesh *)> m_navMesh = std::unique_ptr<dtNavMesh, void (*)(dtNavMesh *)>(nullptr, [](dtNavMesh *) {});
+	std::shared_ptr<dtNavMesh> m_navMesh = nullptr;
 	if(cfg.maxVertsPerPoly <= DT_VERTS_PER_POLYGON) {
-		unsigned char *navData = 0;
-		int navDataSize = 0;
-
-		// Update poly flags from areas.
-		for(auto i = decltype(m_pmesh->npolys) {0}; i < m_pmesh->npolys; ++i) {
-			auto &area = m_pmesh->areas[i];
-			if(area == RC_WALKABLE_AREA)
-				area = 0u;
-			if(area != 0u)
-				std::cout << "";
-			auto *surfMat = game.GetSurfaceMaterial(area);
-			if(surfMat != nullptr)
-				m_pmesh->flags[i] = umath::to_integral(surfMat->GetNavigationFlags());
-		}
-
-		dtNavMeshCreateParams params;
-		memset(&params, 0, sizeof(params));
-		params.verts = m_pmesh->verts;
-		params.vertCount = m_pmesh->nverts;
-		params.polys = m_pmesh->polys;
-		params.polyAreas = m_pmesh->areas;
-		params.polyFlags = m_pmesh->flags;
-		params.polyCount = m_pmesh->npolys;
-		params.nvp = m_pmesh->nvp;
-		params.detailMeshes = m_dmesh->meshes;
-		params.detailVerts = m_dmesh->verts;
-		params.detailVertsCount = m_dmesh->nverts;
-		params.detailTris = m_dmesh->tris;
-		params.detailTriCount = m_dmesh->ntris;
-		// TODO
-		/*params.offMeshConVerts = m_geom->getOffMeshConnectionVerts();
-		params.offMeshConRad = m_geom->getOffMeshConnectionRads();
-		params.offMeshConDir = m_geom->getOffMeshConnectionDirs();
-		params.offMeshConAreas = m_geom->getOffMeshConnectionAreas();
-		params.offMeshConFlags = m_geom->getOffMeshConnectionFlags();
-		params.offMeshConUserID = m_geom->getOffMeshConnectionId();
-		params.offMeshConCount = m_geom->getOffMeshConnectionCount();*/
-		params.walkableHeight = agentHeight;
-		params.walkableRadius = agentRadius;
-		params.walkableClimb = config.maxClimbHeight;
-		rcVcopy(params.bmin, m_pmesh->bmin);
-		rcVcopy(params.bmax, m_pmesh->bmax);
-		params.cs = cfg.cs;
-		params.ch = cfg.ch;
-		params.buildBvTree = true;
-
-		if(dtCreateNavMeshData(&params, &navData, &navDataSize) == false) {
-			ctx->log(RC_LOG_ERROR, "Could not build Detour navmesh.");
-			return nullptr;
-		}
-
-		util::ScopeGuard sg([navData]() { dtFree(navData); });
-
-		m_navMesh = std::unique_ptr<dtNavMesh, void (*)(dtNavMesh *)>(dtAllocNavMesh(), [](dtNavMesh *navMesh) { dtFreeNavMesh(navMesh); });
+		m_navMesh = initialize_detour_mesh(*m_pmesh, *m_dmesh, config, err);
 		if(m_navMesh == nullptr) {
-			ctx->log(RC_LOG_ERROR, "Could not create Detour navmesh");
-			return nullptr;
-		}
-
-		dtStatus status;
-
-		status = m_navMesh->init(navData, navDataSize, DT_TILE_FREE_DATA);
-		if(dtStatusFailed(status)) {
-			ctx->log(RC_LOG_ERROR, "Could not init Detour navmesh");
+			ctx->log(RC_LOG_ERROR, "Could not build Detour navmesh.");
 			return nullptr;
 		}
-		sg.dismiss();
-		/*status = m_navQuery->init(m_navMesh, 2048);
-		if (dtStatusFailed(status))
-		{
-			m_ctx->log(RC_LOG_ERROR, "Could not init Detour navmesh query");
-			return nullptr;
-		}*/
 	}
 
 	ctx->stopTimer(RC_TIMER_TOTAL);
@@ -518,7 +734,7 @@ std::shared_ptr<RcNavMesh> pragma::nav::generate(Game &game, const Config &confi
 
 	auto m_totalBuildTimeMs = ctx->getAccumulatedTime(RC_TIMER_TOTAL) / 1000.f;
 
-	return std::make_shared<RcNavMesh>(std::move(m_pmesh), std::move(m_dmesh), std::move(m_navMesh));
+	return std::make_shared<RcNavMesh>(m_pmesh, m_dmesh, m_navMesh);
 
 	// Obsolete
 	/*for(unsigned int i=0;i<meshes->size();i++)
@@ -908,8 +1124,10 @@ static void read_poly_mesh(const udm::LinkedPropertyWrapper &udmPolyMesh, rcPoly
 	load_array_data(udmPolyMesh["areas"], n, &polyMesh.areas);
 	assert(n == polyMesh.maxpolys);
 
-	for(auto i = decltype(polyMesh.maxpolys) {0}; i < polyMesh.maxpolys; ++i)
-		polyMesh.areas[i] = (i < areaTranslationTable.size()) ? areaTranslationTable.at(i) : polyMesh.areas[i];
+	for(auto i = decltype(polyMesh.maxpolys) {0}; i < polyMesh.maxpolys; ++i) {
+		auto area = polyMesh.areas[i];
+		polyMesh.areas[i] = (area < areaTranslationTable.size()) ? areaTranslationTable.at(area) : area;
+	}
 }
 
 static void read_poly_mesh(const udm::LinkedPropertyWrapper &udmPolyMeshDetail, rcPolyMeshDetail &polyMeshDetail)
@@ -932,6 +1150,7 @@ bool pragma::nav::Mesh::Save(Game &game, udm::AssetDataArg outData, std::string
 {
 	if(m_rcMesh == nullptr)
 		return false;
+	FinishTileRebuilds(game);
 	auto &navMesh = *m_rcMesh;
 	outData.SetAssetType(PNAV_IDENTIFIER);
 	outData.SetAssetVersion(PNAV_VERSION);
@@ -950,26 +1169,65 @@ bool pragma::nav::Mesh::Save(Game &game, udm::AssetDataArg outData, std::string
 	udmConfig["vertsPerPoly"] = m_config.vertsPerPoly;
 	udmConfig["sampleDetailDist"] = m_config.sampleDetailDist;
 	udmConfig["partitionType"] = m_config.partitionType;
+	udmConfig["tileSize"] = m_config.tileSize;
 
 	std::vector<std::string> surfaceMaterialNames;
 	std::unordered_map<uint32_t, uint32_t> surfaceMaterialTable;
-	auto &polyMesh = navMesh.GetPolyMesh();
-	auto numAreas = polyMesh.maxpolys;
-	for(auto i = decltype(numAreas) {0}; i < numAreas; ++i) {
-		auto areaIdx = polyMesh.areas[i];
-		auto it = surfaceMaterialTable.find(areaIdx);
-		if(it != surfaceMaterialTable.end())
-			continue;
-		surfaceMaterialTable.insert(std::make_pair(areaIdx, surfaceMaterialNames.size()));
-		auto *surfMat = game.GetSurfaceMaterial(areaIdx);
-		if(surfMat != nullptr)
-			surfaceMaterialNames.push_back(surfMat->GetIdentifier());
-		else {
-			Con::cwar << "Nav mesh poly with unknown surface material index " << +areaIdx << "! Setting to 0..." << Con::endl;
-			surfaceMaterialNames.push_back("");
+	auto addSurfaceMaterials = [&game, &surfaceMaterialNames, &surfaceMaterialTable](const rcPolyMesh &polyMesh) {
+		auto numAreas = polyMesh.maxpolys;
+		for(auto i = decltype(numAreas) {0}; i < numAreas; ++i) {
+			auto areaIdx = polyMesh.areas[i];
+			auto it = surfaceMaterialTable.find(areaIdx);
+			if(it != surfaceMaterialTable.end())
+				continue;
+			surfaceMaterialTable.insert(std::make_pair(areaIdx, surfaceMaterialNames.size()));
+			auto *surfMat = game.GetSurfaceMaterial(areaIdx);
+			if(surfMat != nullptr)
+				surfaceMaterialNames.push_back(surfMat->GetIdentifier());
+			else {
+				Con::cwar << "Nav mesh poly with unknown surface material index " << +areaIdx << "! Setting to 0..." << Con::endl;
+				surfaceMaterialNames.push_back("");
+			}
+		}
+	};
+
+	if(navMesh.IsTiled()) {
+		auto &tiles = navMesh.GetTiles();
+		uint32_t numTiles = 0;
+		for(auto &tile : tiles) {
+			if(tile.polyMesh == nullptr)
+				continue;
+			addSurfaceMaterials(*tile.polyMesh);
+			++numTiles;
 		}
+		udm["surfaceMaterials"] = surfaceMaterialNames;
+
+		auto &grid = navMesh.GetTileGrid();
+		auto udmTileGrid = udm["tileGrid"];
+		udmTileGrid["bounds"]["min"] = grid.min;
+		udmTileGrid["bounds"]["max"] = grid.max;
+		udmTileGrid["tileWidth"] = grid.tileWidth;
+		udmTileGrid["width"] = grid.width;
+		udmTileGrid["height"] = grid.height;
+
+		// Empty tiles are not stored
+		auto udmTiles = udm.AddArray("tiles", numTiles);
+		uint32_t tileIdx = 0;
+		for(auto &tile : tiles) {
+			if(tile.polyMesh == nullptr)
+				continue;
+			auto udmTile = udmTiles[tileIdx++];
+			udmTile["x"] = tile.x;
+			udmTile["y"] = tile.y;
+			write_poly_mesh(udmTile["polyMesh"], *tile.polyMesh, surfaceMaterialTable);
+			write_poly_mesh(udmTile["polyMeshDetail"], *tile.polyMeshDetail);
+		}
+		return true;
 	}
 
+	auto &polyMesh = navMesh.GetPolyMesh();
+	addSurfaceMaterials(polyMesh);
+
 	// Write surface material names
 	udm["surfaceMaterials"] = surfaceMaterialNames;
 	write_poly_mesh(udm["polyMesh"], polyMesh, surfaceMaterialTable);
@@ -1007,6 +1265,7 @@ bool pragma::nav::Mesh::LoadFromAssetData(Game &game, const udm::AssetData &data
 	udmConfig["vertsPerPoly"](m_config.vertsPerPoly);
 	udmConfig["sampleDetailDist"](m_config.sampleDetailDist);
 	udmConfig["partitionType"](m_config.partitionType);
+	udmConfig["tileSize"](m_config.tileSize);
 
 	std::vector<std::string> surfaceMaterialNames;
 	udm["surfaceMaterials"](surfaceMaterialNames);
@@ -1020,6 +1279,46 @@ bool pragma::nav::Mesh::LoadFromAssetData(Game &game, const udm::AssetData &data
 			Con::cwar << "Nav mesh poly with unknown surface material '" << name << "'! Setting to 0..." << Con::endl;
 	}
 
+	auto udmTileGrid = udm["tileGrid"];
+	if(udmTileGrid) {
+		RcNavMesh::TileGrid grid {};
+		udmTileGrid["bounds"]["min"](grid.min);
+		udmTileGrid["bounds"]["max"](grid.max);
+		udmTileGrid["tileWidth"](grid.tileWidth);
+		udmTileGrid["width"](grid.width);
+		udmTileGrid["height"](grid.height);
+		auto dtMesh = create_tiled_detour_mesh(grid, &outErr);
+		if(dtMesh == nullptr)
+			return false;
+		auto navMesh = std::make_shared<RcNavMesh>(dtMesh, grid);
+
+		auto udmTiles = udm["tiles"];
+		auto numTiles = udmTiles.GetSize();
+		for(auto i = decltype(numTiles) {0u}; i < numTiles; ++i) {
+			auto udmTile = udmTiles[i];
+			RcNavMesh::Tile tile {};
+			udmTile["x"](tile.x);
+			udmTile["y"](tile.y);
+			tile.polyMesh = std::shared_ptr<rcPolyMesh>(rcAllocPolyMesh(), [](rcPolyMesh *polyMesh) { rcFreePolyMesh(polyMesh); });
+			tile.polyMeshDetail = std::shared_ptr<rcPolyMeshDetail>(rcAllocPolyMeshDetail(), [](rcPolyMeshDetail *polyMeshDetail) { rcFreePolyMeshDetail(polyMeshDetail); });
+			if(tile.polyMesh == nullptr || tile.polyMeshDetail == nullptr) {
+				outErr = "Unable to allocate rcPolyMesh!";
+				return false;
+			}
+			read_poly_mesh(udmTile["polyMesh"], *tile.polyMesh, surfaceMaterialTable);
+			read_poly_mesh(udmTile["polyMeshDetail"], *tile.polyMeshDetail);
+
+			uint8_t *navData;
+			int32_t navDataSize;
+			if(create_detour_mesh_data(*tile.polyMesh, *tile.polyMeshDetail, m_config, tile.x, tile.y, &navData, &navDataSize) == false || navMesh->SetTile(std::move(tile), navData, navDataSize) == false) {
+				outErr = "Unable to create navigation mesh tile!";
+				return false;
+			}
+		}
+		m_rcMesh = navMesh;
+		return true;
+	}
+
 	auto polyMesh = std::shared_ptr<rcPolyMesh>(rcAllocPolyMesh(), [](rcPolyMesh *polyMesh) { rcFreePolyMesh(polyMesh); });
 	if(polyMesh == nullptr) {
 		outErr = "Unable to allocate rcPolyMesh!";
@@ -1077,6 +1376,7 @@ bool pragma::nav::Mesh::FindNearestPoly(const Vector3 &pos, dtPolyRef &ref)
 	filter.setIncludeFlags(0xFFFF); // TODO
 	filter.setExcludeFlags(0);      // TODO
 	Vector3 nearestPoint {};
+	std::shared_lock lock {mesh.GetTileMutex()};
 	status = navQuery->findNearestPoly(&pos[0], &extents[0], &filter, &ref, &nearestPoint[0]);
 	if(dtStatusFailed(status))
 		return false;
@@ -1109,6 +1409,7 @@ bool pragma::nav::Mesh::RayCast(const Vector3 &start, const Vector3 &end, Vector
 		rayHit->path = hitRefs.data();
 	}
 
+	std::shared_lock lock {mesh.GetTileMutex()};
 	status = navQuery->raycast(startRef, &start[0], &end[0], &filter, 0, rayHit.get());
 	if(dtStatusFailed(status) || rayHit->t == 0.f)
 		return false;
@@ -1119,33 +1420,220 @@ bool pragma::nav::Mesh::RayCast(const Vector3 &start, const Vector3 &end, Vector
 	return true;
 }
 
-std::shared_ptr<RcPathResult> pragma::nav::Mesh::FindPath(const Vector3 &start, const Vector3 &end)
+// Snapshot of everything a tile rebuild needs, so the build doesn't depend on the state of the navigation mesh
+struct pragma::nav::Mesh::TileRebuild {
+	TileRebuild(TaskScheduler &scheduler) : group {scheduler} {}
+	~TileRebuild()
+	{
+		group.Wait();
+		// Results that have not been applied to the navigation mesh
+		for(auto &result : results) {
+			if(result.navData != nullptr)
+				dtFree(result.navData);
+		}
+	}
+	Config config;
+	RcNavMesh::TileGrid grid;
+	std::shared_ptr<InputGeometry> geometry;
+	BoxList obstacles;
+	// Bounds of the tiles that are being rebuilt
+	int32_t x0 = 0;
+	int32_t y0 = 0;
+	int32_t x1 = 0;
+	int32_t y1 = 0;
+	std::vector<std::vector<int32_t>> tileTris;
+	// Pre-allocated, one entry for each tile that is being rebuilt
+	std::vector<TileBuildResult> results;
+	TaskScheduler::TaskGroup group;
+};
+
+bool pragma::nav::Mesh::RebuildTiles(Game &game, const Vector3 &min, const Vector3 &max, std::string *err)
+{
+	if(m_rcMesh == nullptr || m_rcMesh->IsTiled() == false) {
+		if(err != nullptr)
+			*err = "Navigation mesh is not tiled!";
+		return false;
+	}
+	auto geometry = m_rcMesh->GetInputGeometry();
+	if(geometry == nullptr) {
+		auto *pWorld = game.GetWorld();
+		geometry = std::make_shared<InputGeometry>();
+		if(pWorld == nullptr || collect_geometry(pWorld->GetEntity(), *geometry) == false) {
+			if(err != nullptr)
+				*err = "No input geometry available!";
+			return false;
+		}
+		m_rcMesh->SetInputGeometry(geometry);
+	}
+	// Changes within the border of a tile affect that tile as well
+	auto borderWidth = get_tile_border_width(m_config);
+	auto &grid = m_rcMesh->GetTileGrid();
+	int32_t x0, y0, x1, y1;
+	if(get_tile_range(grid, min - Vector3 {borderWidth, 0.f, borderWidth}, max + Vector3 {borderWidth, 0.f, borderWidth}, x0, y0, x1, y1) == false)
+		return true;
+	m_dirtyTiles.resize(grid.width * grid.height, false);
+	for(auto y = y0; y <= y1; ++y) {
+		for(auto x = x0; x <= x1; ++x) {
+			auto idx = y * grid.width + x;
+			if(m_dirtyTiles[idx])
+				continue;
+			m_dirtyTiles[idx] = true;
+			++m_dirtyTileCount;
+		}
+	}
+	UpdateTileRebuilds(game);
+	return true;
+}
+
+void pragma::nav::Mesh::StartTileRebuild(Game &game)
+{
+	auto &grid = m_rcMesh->GetTileGrid();
+	if(m_tileBuildScheduler == nullptr)
+		m_tileBuildScheduler = std::make_unique<TaskScheduler>(umath::max(std::thread::hardware_concurrency(), 2u) - 1, "navgen");
+	auto rebuild = std::make_shared<TileRebuild>(*m_tileBuildScheduler);
+	rebuild->config = m_config;
+	rebuild->grid = grid;
+	rebuild->geometry = m_rcMesh->GetInputGeometry();
+	rebuild->obstacles.reserve(m_obstacles.size());
+	for(auto &[id, obstacle] : m_obstacles)
+		rebuild->obstacles.push_back({obstacle.min, obstacle.max});
+	rebuild->x0 = grid.width;
+	rebuild->y0 = grid.height;
+	rebuild->x1 = -1;
+	rebuild->y1 = -1;
+	rebuild->results.reserve(m_dirtyTileCount);
+	for(auto y = 0; y < grid.height; ++y) {
+		for(auto x = 0; x < grid.width; ++x) {
+			if(m_dirtyTiles[y * grid.width + x] == false)
+				continue;
+			rebuild->results.push_back({});
+			rebuild->results.back().tile.x = x;
+			rebuild->results.back().tile.y = y;
+			rebuild->x0 = umath::min(rebuild->x0, x);
+			rebuild->y0 = umath::min(rebuild->y0, y);
+			rebuild->x1 = umath::max(rebuild->x1, x);
+			rebuild->y1 = umath::max(rebuild->y1, y);
+		}
+	}
+	std::fill(m_dirtyTiles.begin(), m_dirtyTiles.end(), false);
+	m_dirtyTileCount = 0;
+	m_tileRebuild = rebuild;
+
+	// Collecting the triangles of the tiles requires a pass over the entire input geometry, so that is done on a worker as well
+	auto *r = rebuild.get();
+	r->group.Run([r, &game]() {
+		r->tileTris = get_tile_triangles(r->grid, get_tile_border_width(r->config), *r->geometry, r->x0, r->y0, r->x1, r->y1);
+		auto w = r->x1 - r->x0 + 1;
+		for(auto i = decltype(r->results.size()) {0u}; i < r->results.size(); ++i) {
+			r->group.Run([r, &game, w, i]() {
+				auto x = r->results[i].tile.x;
+				auto y = r->results[i].tile.y;
+				r->results[i] = build_tile(game, r->config, r->grid, *r->geometry, r->tileTris[(y - r->y0) * w + (x - r->x0)], &r->obstacles, x, y);
+			});
+		}
+	});
+}
+
+void pragma::nav::Mesh::UpdateTileRebuilds(Game &game)
+{
+	if(m_tileRebuild != nullptr) {
+		if(m_tileRebuild->group.IsComplete() == false)
+			return;
+		std::string err;
+		if(apply_tiles(*m_rcMesh, m_tileRebuild->results, &err) == false)
+			Con::cwar << "Unable to rebuild navigation mesh tiles: " << err << Con::endl;
+		m_tileRebuild = nullptr;
+	}
+	// Tiles that were changed while the previous rebuild was in progress
+	if(m_dirtyTileCount > 0 && m_rcMesh != nullptr)
+		StartTileRebuild(game);
+}
+
+void pragma::nav::Mesh::FinishTileRebuilds(Game &game)
+{
+	while(IsTileRebuildPending()) {
+		if(m_tileRebuild != nullptr)
+			m_tileRebuild->group.Wait();
+		UpdateTileRebuilds(game);
+	}
+}
+
+bool pragma::nav::Mesh::IsTileRebuildPending() const { return m_tileRebuild != nullptr || m_dirtyTileCount > 0; }
+
+bool pragma::nav::Mesh::UpdateGeometry(Game &game, const std::shared_ptr<InputGeometry> &geometry, const Vector3 &min, const Vector3 &max, std::string *err)
+{
+	if(m_rcMesh == nullptr || m_rcMesh->IsTiled() == false) {
+		if(err != nullptr)
+			*err = "Navigation mesh is not tiled!";
+		return false;
+	}
+	m_rcMesh->SetInputGeometry(geometry);
+	return RebuildTiles(game, min, max, err);
+}
+
+std::optional<uint32_t> pragma::nav::Mesh::AddObstacle(Game &game, const Vector3 &min, const Vector3 &max)
+{
+	if(m_rcMesh == nullptr || m_rcMesh->IsTiled() == false)
+		return {};
+	auto id = m_nextObstacleId++;
+	m_obstacles[id] = {min, max};
+	RebuildTiles(game, min, max);
+	return id;
+}
+
+bool pragma::nav::Mesh::RemoveObstacle(Game &game, uint32_t obstacleId)
+{
+	auto it = m_obstacles.find(obstacleId);
+	if(it == m_obstacles.end())
+		return false;
+	auto obstacle = it->second;
+	m_obstacles.erase(it);
+	RebuildTiles(game, obstacle.min, obstacle.max);
+	return true;
+}
+
+std::shared_ptr<dtNavMeshQuery> pragma::nav::Mesh::CreateQuery(uint32_t maxNodes) const
 {
 	if(m_rcMesh == nullptr)
 		return nullptr;
-	auto &mesh = *m_rcMesh;
 	auto navQuery = std::shared_ptr<dtNavMeshQuery>(dtAllocNavMeshQuery(), [](dtNavMeshQuery *navQuery) { dtFreeNavMeshQuery(navQuery); });
-	auto status = navQuery->init(&mesh.GetNavMesh(), 2048); // TODO
-	if(dtStatusFailed(status)) {
-		//Con::cerr<<"FAILED #1: "<<start.x<<","<<start.y<<","<<start.z<<" => "<<end.x<<","<<end.y<<","<<end.z<<Con::endl;
+	auto status = navQuery->init(&m_rcMesh->GetNavMesh(), maxNodes);
+	if(dtStatusFailed(status))
 		return nullptr;
-	}
-	const Vector3 extents(256.f, 256.f, 256.f); // TODO
+	return navQuery;
+}
+
+std::shared_ptr<RcPathResult> pragma::nav::Mesh::FindPath(const Vector3 &start, const Vector3 &end)
+{
+	auto navQuery = CreateQuery();
+	if(navQuery == nullptr)
+		return nullptr;
+	return FindPath(navQuery, start, end, Vector3 {DEFAULT_QUERY_EXTENT, DEFAULT_QUERY_EXTENT, DEFAULT_QUERY_EXTENT}, DEFAULT_MAX_PATH_LENGTH);
+}
+
+std::shared_ptr<RcPathResult> pragma::nav::Mesh::FindPath(const std::shared_ptr<dtNavMeshQuery> &navQuery, const Vector3 &start, const Vector3 &end, const Vector3 &extents, uint32_t maxPathLength)
+{
+	if(m_rcMesh == nullptr || maxPathLength == 0)
+		return nullptr;
+	auto &mesh = *m_rcMesh;
 	dtQueryFilter filter;
 	filter.setIncludeFlags(0xFFFF); // TODO
 	filter.setExcludeFlags(0);      // TODO
 	dtPolyRef startRef;
 	Vector3 startPoint;
+	std::shared_lock lock {mesh.GetTileMutex()};
 	auto statusStart = navQuery->findNearestPoly(&start[0], &extents[0], &filter, &startRef, &startPoint[0]);
 	if(dtStatusFailed(statusStart) == false && startRef != 0) {
 		dtPolyRef endRef;
 		Vector3 endPoint;
 		auto statusEnd = navQuery->findNearestPoly(&end[0], &extents[0], &filter, &endRef, &endPoint[0]);
 		if(!dtStatusFailed(statusEnd) && endRef != 0) {
-			int maxPath = 128;                                                                      // TODO
-			auto r = std::make_shared<RcPathResult>(mesh, navQuery, startPoint, endPoint, maxPath); // TODO
+			// Note: The result keeps a reference to the query for looking up the path nodes later on. This is safe even if the query
+			// is re-used for other searches in the meantime, since the lookup only accesses the navigation mesh. If a tile along the
+			// path is rebuilt, the lookup of its nodes will fail.
+			auto r = std::make_shared<RcPathResult>(mesh, navQuery, startPoint, endPoint, maxPathLength);
 			int32_t pathCount = 0;
-			auto findStatus = navQuery->findPath(startRef, endRef, &startPoint[0], &endPoint[0], &filter, &r->path[0], &pathCount, maxPath);
+			auto findStatus = navQuery->findPath(startRef, endRef, &startPoint[0], &endPoint[0], &filter, &r->path[0], &pathCount, static_cast<int32_t>(maxPathLength));
 			r->pathCount = pathCount + 2;
 			return r;
 		}
@@ -1170,6 +1658,7 @@ bool RcPathResult::GetNode(uint32_t nodeId, const Vector3 &closest, Vector3 &nod
 	if(nodeId >= pathCount)
 		return false;
 	--nodeId;
-	query->closestPointOnPolyBoundary(path[nodeId], &closest[0], &node[0]);
-	return true;
+	std::shared_lock lock {navMesh.GetTileMutex()};
+	auto status = query->closestPointOnPolyBoundary(path[nodeId], &closest[0], &node[0]);
+	return !dtStatusFailed(status);
 }
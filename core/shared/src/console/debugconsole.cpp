@@ -8,6 +8,7 @@
 #include "stdafx_shared.h"
 #include "pragma/console/debugconsole.h"
 #include "pragma/engine.h"
+#include "pragma/util/frame_pacer.hpp"
 #include <pragma/serverstate/serverstate.h>
 #include <sharedutils/util_string.h>
 #include <pragma/console/convars.h>
@@ -86,8 +87,11 @@ static void KeyboardInput()
 
 void Engine::ConsoleInput(const std::string_view &line) // TODO: Make sure input-thread and engine don't access m_consoleInput at the same time?
 {
-	std::unique_lock lock {m_consoleInputMutex};
-	m_consoleInput.push(std::string {line});
+	{
+		std::unique_lock lock {m_consoleInputMutex};
+		m_consoleInput.push(std::string {line});
+	}
+	m_framePacer->Wake();
 }
 
 void Engine::ToggleConsole()
@@ -10,6 +10,7 @@
 #include "pragma/entities/components/parent_component.hpp"
 #include "pragma/entities/components/base_child_component.hpp"
 #include "pragma/entities/entity_component_system_t.hpp"
+#include "pragma/entities/entity_component_manager.hpp"
 #include "pragma/debug/debug_performance_profiler.hpp"
 #include <pragma/engine.h>
 #include <pragma/console/convars.h>
@@ -19,10 +20,12 @@
 #include <pragma/game/game.h>
 #include <fsys/filesystem.h>
 #include <mathutil/uvec.h>
+#include <sharedutils/util.h>
 #include <sharedutils/util_string.h>
 #include <sharedutils/util_file.h>
 #include <pragma/engine_version.h>
 #include <pragma/asset/util_asset.hpp>
+#include "pragma/util/frame_pacer.hpp"
 #include <map>
 
 #define DLLSPEC_ISTEAMWORKS DLLNETWORK
@@ -51,10 +54,16 @@ REGISTER_ENGINE_CONVAR(cache_version, udm::Type::String, "", ConVarFlags::Archiv
 REGISTER_ENGINE_CONVAR(cache_version_target, udm::Type::UInt32, "16", ConVarFlags::None, "If cache_version does not match this value, the cache files will be cleared and it will be set to it.");
 REGISTER_ENGINE_CONVAR(debug_profiling_enabled, udm::Type::Boolean, "0", ConVarFlags::None, "Enables profiling timers.");
 REGISTER_ENGINE_CONVAR(debug_disable_animation_updates, udm::Type::Boolean, "0", ConVarFlags::None, "Disables animation updates.");
+REGISTER_ENGINE_CONVAR(sh_parallel_animation_updates, udm::Type::Boolean, "0", ConVarFlags::Archive, "If enabled, skeletal animations of entities that don't depend on each other will be updated in parallel.");
+REGISTER_ENGINE_CONVAR(sh_parallel_component_ticks, udm::Type::Boolean, "0", ConVarFlags::Archive, "If enabled, component types that have declared their tick access will be ticked in parallel with other non-conflicting component types. Experimental: Use debug_validate_component_tick_access to verify the declared access first.");
+REGISTER_ENGINE_CONVAR(debug_validate_component_tick_access, udm::Type::Boolean, "0", ConVarFlags::None, "If enabled, components that access undeclared component types during a parallel tick will be reported.");
 REGISTER_ENGINE_CONVAR(sh_mount_external_game_resources, udm::Type::Boolean, "1", ConVarFlags::Archive, "If set to 1, the game will attempt to load missing resources from external games.");
 REGISTER_ENGINE_CONVAR(sh_lua_remote_debugging, udm::Type::UInt8, "0", ConVarFlags::Archive,
   "0 = Remote debugging is disabled; 1 = Remote debugging is enabled serverside; 2 = Remote debugging is enabled clientside.\nCannot be changed during an active game. Also requires the \"-luaext\" launch parameter.\nRemote debugging cannot be enabled clientside and serverside at the same time.");
 REGISTER_ENGINE_CONVAR(lua_open_editor_on_error, udm::Type::Boolean, "1", ConVarFlags::Archive, "1 = Whenever there's a Lua error, the engine will attempt to automatically open a Lua IDE and open the file and line which caused the error.");
+REGISTER_ENGINE_CONVAR(sh_frame_pacing, udm::Type::Boolean, "1", ConVarFlags::Archive, "If enabled, dedicated servers will sleep between ticks instead of busy-waiting for the next tick.");
+REGISTER_ENGINE_CONVAR(sh_frame_pacing_spin_slack, udm::Type::Float, "1", ConVarFlags::Archive,
+  "Time in milliseconds before the next tick at which the dedicated server stops sleeping and spins until the tick is due. Higher values reduce tick jitter at the cost of CPU time.");
 REGISTER_ENGINE_CONVAR(steam_steamworks_enabled, udm::Type::Boolean, "1", ConVarFlags::Archive, "Enables or disables steamworks.");
 static void cvar_steam_steamworks_enabled(bool val)
 {
@@ -348,6 +357,81 @@ static void debug_profiling_print(NetworkState *, pragma::BasePlayerComponent *,
 }
 REGISTER_ENGINE_CONCOMMAND(debug_profiling_print, debug_profiling_print, ConVarFlags::None, "Prints the last profiled times.");
 
+static void debug_profiling_capture_start(NetworkState *, pragma::BasePlayerComponent *, std::vector<std::string> &argv)
+{
+	std::optional<uint32_t> tickCount {};
+	if(!argv.empty()) {
+		auto n = util::to_int(argv.front());
+		if(n > 0)
+			tickCount = static_cast<uint32_t>(n);
+	}
+	auto fileName = (argv.size() > 1) ? argv[1] : ("profiling/capture_" + util::get_date_time("%Y-%m-%d_%H-%M-%S") + ".json");
+	if(engine->IsProfilingCaptureActive())
+		engine->StopProfilingCapture();
+	engine->StartProfilingCapture(tickCount, fileName);
+	if(tickCount)
+		Con::cout << "Capturing profiling stages for " << *tickCount << " ticks..." << Con::endl;
+	else
+		Con::cout << "Capturing profiling stages until 'debug_profiling_capture_stop' is called..." << Con::endl;
+}
+REGISTER_ENGINE_CONCOMMAND(debug_profiling_capture_start, debug_profiling_capture_start, ConVarFlags::None,
+  "Records all profiling stages for the specified number of ticks and saves them as a Chrome trace file (viewable in chrome://tracing or Perfetto). Usage: debug_profiling_capture_start <tickCount> [fileName]. A tick count of 0 records until the capture is stopped manually.");
+
+static void debug_profiling_capture_stop(NetworkState *, pragma::BasePlayerComponent *, std::vector<std::string> &)
+{
+	if(engine->IsProfilingCaptureActive() == false) {
+		Con::cwar << "No profiling capture is active!" << Con::endl;
+		return;
+	}
+	engine->StopProfilingCapture();
+}
+REGISTER_ENGINE_CONCOMMAND(debug_profiling_capture_stop, debug_profiling_capture_stop, ConVarFlags::None, "Stops the active profiling capture and writes it to disk.");
+
+static void debug_frame_pacing_stats(NetworkState *, pragma::BasePlayerComponent *, std::vector<std::string> &argv)
+{
+	auto &pacer = engine->GetFramePacer();
+	auto &stats = pacer.GetStats();
+	auto toMs = [](std::chrono::nanoseconds t) { return t.count() / 1'000'000.0; };
+	Con::cout << "Frame pacing statistics:" << Con::endl;
+	Con::cout << "Paced ticks: " << stats.tickCount << Con::endl;
+	Con::cout << "Early wake-ups: " << stats.wakeCount << Con::endl;
+	Con::cout << "Time slept: " << toMs(stats.totalSleepTime) << " ms" << Con::endl;
+	Con::cout << "Time spun: " << toMs(stats.totalSpinTime) << " ms" << Con::endl;
+	Con::cout << "Tick jitter: min " << toMs(stats.minJitter) << " ms, max " << toMs(stats.maxJitter) << " ms, mean " << (stats.meanJitterUs / 1'000.0) << " ms, std. dev. " << (stats.jitterStdDevUs / 1'000.0) << " ms" << Con::endl;
+	if(argv.empty() == false && util::to_boolean(argv.front()))
+		pacer.ResetStats();
+}
+REGISTER_ENGINE_CONCOMMAND(debug_frame_pacing_stats, debug_frame_pacing_stats, ConVarFlags::None, "Prints the tick jitter statistics of the dedicated server frame pacer. Usage: debug_frame_pacing_stats [reset]");
+
+static void debug_component_memory_stats(NetworkState *state, pragma::BasePlayerComponent *, std::vector<std::string> &)
+{
+	auto *game = state->GetGameState();
+	if(game == nullptr) {
+		Con::cwar << "No active game!" << Con::endl;
+		return;
+	}
+	auto &componentManager = game->GetEntityComponentManager();
+	std::vector<std::pair<std::string, const pragma::ComponentArena::Stats *>> typeStats;
+	for(auto &componentInfo : componentManager.GetRegisteredComponentTypes()) {
+		auto *arena = componentInfo ? componentManager.GetComponentArena(componentInfo->id) : nullptr;
+		if(arena == nullptr || arena->GetStats().chunkCount == 0)
+			continue;
+		typeStats.push_back({componentInfo->name.c_str(), &arena->GetStats()});
+	}
+	std::sort(typeStats.begin(), typeStats.end(), [](const auto &a, const auto &b) { return a.second->reservedBytes > b.second->reservedBytes; });
+	size_t totalReserved = 0;
+	size_t totalUsed = 0;
+	Con::cout << "Component memory statistics:" << Con::endl;
+	for(auto &[name, stats] : typeStats) {
+		Con::cout << name << ": " << stats->count << " / " << stats->capacity << " components (peak " << stats->peakCount << ", " << stats->allocationCount << " allocations), " << stats->chunkCount << " chunks, " << util::get_pretty_bytes(stats->GetUsedBytes()) << " / "
+		          << util::get_pretty_bytes(stats->reservedBytes) << Con::endl;
+		totalReserved += stats->reservedBytes;
+		totalUsed += stats->GetUsedBytes();
+	}
+	Con::cout << "Total: " << util::get_pretty_bytes(totalUsed) << " / " << util::get_pretty_bytes(totalReserved) << Con::endl;
+}
+REGISTER_SHARED_CONCOMMAND(debug_component_memory_stats, debug_component_memory_stats, ConVarFlags::None, "Prints the memory usage of the component arenas of all component types.");
+
 static void debug_profiling_physics_start(NetworkState *nw, pragma::BasePlayerComponent *, std::vector<std::string> &)
 {
 	auto *game = nw->GetGameState();
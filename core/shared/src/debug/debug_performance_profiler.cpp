@@ -29,6 +29,8 @@ const ProfilingStage &Profiler::GetRootStage() const { return const_cast<Profile
 ProfilingStage &Profiler::GetRootStage() { return *m_rootStage; }
 const std::vector<std::weak_ptr<ProfilingStage>> &Profiler::GetStages() const { return m_stages; }
 void Profiler::AddStage(ProfilingStage &stage) { m_stages.push_back(stage.shared_from_this()); }
+const TraceRecorder &Profiler::GetTraceRecorder() const { return m_traceRecorder; }
+TraceRecorder &Profiler::GetTraceRecorder() { return m_traceRecorder; }
 ProfilingStage *Profiler::GetStage(ProfilingStage::StageId stage)
 {
 	if(stage >= m_stages.size())
@@ -107,9 +109,15 @@ bool ProfilingStage::Start()
 {
 	if(m_parent.expired() || m_parent.lock()->GetName() == "root")
 		ResetCounters();
+	m_profiler.GetTraceRecorder().Record(m_name, TraceRecorder::EventType::Begin);
 	return GetTimer().Start();
 }
-bool ProfilingStage::Stop() { return GetTimer().Stop(); }
+bool ProfilingStage::Stop()
+{
+	auto res = GetTimer().Stop();
+	m_profiler.GetTraceRecorder().Record(m_name, TraceRecorder::EventType::End);
+	return res;
+}
 void ProfilingStage::ResetCounters()
 {
 	m_timer->ResetCounters();
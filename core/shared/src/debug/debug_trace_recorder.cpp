@@ -0,0 +1,210 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan
+ */
+
+#include "stdafx_shared.h"
+#include "pragma/debug/debug_trace_recorder.hpp"
+#include <sstream>
+#include <iomanip>
+
+using namespace pragma::debug;
+
+static std::atomic<uint64_t> g_nextRecorderId = 0;
+
+TraceRecorder::TraceRecorder() : m_recorderId {++g_nextRecorderId} {}
+TraceRecorder::~TraceRecorder() { Stop(); }
+
+void TraceRecorder::Start(std::optional<uint32_t> frameCount, uint32_t maxEventsPerThread)
+{
+	Stop();
+	std::scoped_lock lock {m_bufferMutex};
+	for(auto &buffer : m_buffers) {
+		if(buffer->firstChunk)
+			buffer->firstChunk->next = nullptr;
+		buffer->lastChunk = buffer->firstChunk.get();
+		buffer->lastChunkCount = 0;
+		buffer->eventCount = 0;
+		buffer->droppedEventCount = 0;
+		buffer->names.clear();
+		buffer->nameIndices.clear();
+	}
+	m_frameLimit = frameCount;
+	m_frameCount = 0;
+	m_maxEventsPerThread = maxEventsPerThread;
+	m_startTime = Clock::now();
+	m_recording = true;
+}
+
+void TraceRecorder::Stop()
+{
+	if(m_recording.exchange(false) == false)
+		return;
+	WaitForWriters();
+}
+
+void TraceRecorder::WaitForWriters() const
+{
+	// A writer always flags its buffer as busy before checking whether we're still recording, so once
+	// m_recording has been cleared, no writer can touch a buffer that isn't flagged.
+	std::scoped_lock lock {m_bufferMutex};
+	for(auto &buffer : m_buffers) {
+		while(buffer->busy)
+			std::this_thread::yield();
+	}
+}
+
+bool TraceRecorder::IsRecording() const { return m_recording; }
+
+bool TraceRecorder::EndFrame()
+{
+	if(!m_recording)
+		return false;
+	++m_frameCount;
+	if(!m_frameLimit || m_frameCount < *m_frameLimit)
+		return false;
+	Stop();
+	return true;
+}
+
+uint32_t TraceRecorder::GetRecordedFrameCount() const { return m_frameCount; }
+uint64_t TraceRecorder::GetRecordedEventCount() const
+{
+	std::scoped_lock lock {m_bufferMutex};
+	uint64_t count = 0;
+	for(auto &buffer : m_buffers)
+		count += buffer->eventCount;
+	return count;
+}
+uint64_t TraceRecorder::GetDroppedEventCount() const
+{
+	std::scoped_lock lock {m_bufferMutex};
+	uint64_t count = 0;
+	for(auto &buffer : m_buffers)
+		count += buffer->droppedEventCount;
+	return count;
+}
+
+TraceRecorder::ThreadBuffer &TraceRecorder::GetThreadBuffer()
+{
+	static thread_local std::pair<uint64_t, ThreadBuffer *> cachedBuffer {0, nullptr};
+	if(cachedBuffer.first == m_recorderId)
+		return *cachedBuffer.second;
+	// First event of this thread (or another recorder was used on this thread in the meantime)
+	auto tid = std::this_thread::get_id();
+	std::scoped_lock lock {m_bufferMutex};
+	auto it = std::find_if(m_buffers.begin(), m_buffers.end(), [tid](const std::unique_ptr<ThreadBuffer> &buffer) { return buffer->threadId == tid; });
+	if(it == m_buffers.end()) {
+		auto buffer = std::make_unique<ThreadBuffer>();
+		buffer->threadId = tid;
+		buffer->index = m_buffers.size();
+		it = m_buffers.insert(m_buffers.end(), std::move(buffer));
+	}
+	cachedBuffer = {m_recorderId, it->get()};
+	return **it;
+}
+
+uint32_t TraceRecorder::GetNameIndex(ThreadBuffer &buffer, const std::string &name)
+{
+	auto it = buffer.nameIndices.find(&name);
+	// The source string may have been destroyed and another one may have been allocated at the same address
+	if(it != buffer.nameIndices.end() && buffer.names[it->second] == name)
+		return it->second;
+	auto idx = static_cast<uint32_t>(buffer.names.size());
+	buffer.names.push_back(name);
+	buffer.nameIndices[&name] = idx;
+	return idx;
+}
+
+void TraceRecorder::Record(const std::string &name, EventType type)
+{
+	if(!m_recording)
+		return;
+	auto t = Clock::now();
+	auto &buffer = GetThreadBuffer();
+	buffer.busy = true;
+	if(!m_recording) {
+		buffer.busy = false;
+		return;
+	}
+	if(buffer.eventCount >= m_maxEventsPerThread) {
+		++buffer.droppedEventCount;
+		buffer.busy = false;
+		return;
+	}
+	if(!buffer.lastChunk) {
+		buffer.firstChunk = std::make_unique<EventChunk>();
+		buffer.lastChunk = buffer.firstChunk.get();
+		buffer.lastChunkCount = 0;
+	}
+	else if(buffer.lastChunkCount == EventChunk::SIZE) {
+		buffer.lastChunk->next = std::make_unique<EventChunk>();
+		buffer.lastChunk = buffer.lastChunk->next.get();
+		buffer.lastChunkCount = 0;
+	}
+	buffer.lastChunk->events[buffer.lastChunkCount++] = {t, GetNameIndex(buffer, name), type};
+	++buffer.eventCount;
+	buffer.busy = false;
+}
+
+static void write_json_string(std::ostream &out, const std::string &str)
+{
+	out << '"';
+	for(auto c : str) {
+		switch(c) {
+		case '"':
+			out << "\\\"";
+			break;
+		case '\\':
+			out << "\\\\";
+			break;
+		default:
+			if(static_cast<unsigned char>(c) < 0x20)
+				out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<uint32_t>(c) << std::dec << std::setfill(' ');
+			else
+				out << c;
+			break;
+		}
+	}
+	out << '"';
+}
+
+void TraceRecorder::WriteChromeTrace(std::ostream &out) const
+{
+	std::scoped_lock lock {m_bufferMutex};
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	auto first = true;
+	auto beginEvent = [&out, &first]() {
+		if(!first)
+			out << ",\n";
+		first = false;
+	};
+	out << std::fixed << std::setprecision(3);
+	for(auto &buffer : m_buffers) {
+		if(buffer->eventCount == 0)
+			continue;
+		std::stringstream ssThreadName;
+		ssThreadName << "Thread " << buffer->threadId;
+		beginEvent();
+		out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->index << ",\"args\":{\"name\":";
+		write_json_string(out, ssThreadName.str());
+		out << "}}";
+
+		for(auto *chunk = buffer->firstChunk.get(); chunk; chunk = chunk->next.get()) {
+			auto count = (chunk == buffer->lastChunk) ? buffer->lastChunkCount : EventChunk::SIZE;
+			for(auto i = decltype(count) {0u}; i < count; ++i) {
+				auto &ev = chunk->events[i];
+				auto ts = std::chrono::duration_cast<std::chrono::nanoseconds>(ev.time - m_startTime).count() / 1'000.0;
+				beginEvent();
+				out << "{\"name\":";
+				write_json_string(out, buffer->names[ev.nameIndex]);
+				out << ",\"cat\":\"pragma\",\"ph\":\"" << ((ev.type == EventType::Begin) ? 'B' : 'E') << "\",\"ts\":" << ts << ",\"pid\":0,\"tid\":" << buffer->index << "}";
+			}
+			if(chunk == buffer->lastChunk)
+				break;
+		}
+	}
+	out << "]}\n";
+}
@@ -41,6 +41,7 @@
 #include <sharedutils/util_debug.h>
 #include <fsys/filesystem.h>
 #include <spdlog/pattern_formatter.h>
+#include "pragma/util/frame_pacer.hpp"
 
 #ifdef __linux__
 #include <pthread.h>
@@ -136,6 +137,8 @@ Engine::Engine(int, char *[]) : CVarHandler(), m_logFile(nullptr), m_tickRate(En
 
 	RegisterCallback<void>("Think");
 
+	m_framePacer = std::make_unique<pragma::FramePacer>();
+
 	m_cpuProfiler = pragma::debug::CPUProfiler::Create<pragma::debug::CPUProfiler>();
 	AddProfilingHandler([this](bool profilingEnabled) {
 		if(profilingEnabled == false) {
@@ -496,10 +499,46 @@ void Engine::SetMountExternalGameResources(bool b)
 bool Engine::ShouldMountExternalGameResources() const { return m_bMountExternalGameResources; }
 
 pragma::debug::CPUProfiler &Engine::GetProfiler() const { return *m_cpuProfiler; }
+pragma::FramePacer &Engine::GetFramePacer() { return *m_framePacer; }
 pragma::debug::ProfilingStageManager<pragma::debug::ProfilingStage> *Engine::GetProfilingStageManager() { return m_profilingStageManager.get(); }
 bool Engine::StartProfilingStage(const char *stage) { return m_profilingStageManager && m_profilingStageManager->StartProfilerStage(stage); }
 bool Engine::StopProfilingStage() { return m_profilingStageManager && m_profilingStageManager->StopProfilerStage(); }
 
+void Engine::StartProfilingCapture(std::optional<uint32_t> tickCount, const std::string &fileName)
+{
+	if(GetConVarBool("debug_profiling_enabled") == false) {
+		std::vector<std::string> argv {"1"};
+		RunConsoleCommand("debug_profiling_enabled", argv);
+	}
+	m_profilingCaptureFileName = fileName;
+	m_cpuProfiler->GetTraceRecorder().Start(tickCount);
+}
+bool Engine::IsProfilingCaptureActive() const { return m_cpuProfiler->GetTraceRecorder().IsRecording(); }
+bool Engine::StopProfilingCapture()
+{
+	auto &recorder = m_cpuProfiler->GetTraceRecorder();
+	recorder.Stop();
+	if(m_profilingCaptureFileName.empty())
+		return false;
+	auto fileName = std::move(m_profilingCaptureFileName);
+	m_profilingCaptureFileName.clear();
+	if(filemanager::create_path(ufile::get_path_from_filename(fileName)) == false) {
+		spdlog::error("Failed to create path for profiling capture '{}'.", fileName);
+		return false;
+	}
+	auto f = FileManager::OpenFile<VFilePtrReal>(fileName.c_str(), "w");
+	if(f == nullptr) {
+		spdlog::error("Failed to open profiling capture file '{}' for writing.", fileName);
+		return false;
+	}
+	std::stringstream ss;
+	recorder.WriteChromeTrace(ss);
+	auto str = ss.str();
+	f->Write(str.data(), str.size());
+	spdlog::info("Wrote profiling capture with {} events ({} dropped) over {} ticks to '{}'.", recorder.GetRecordedEventCount(), recorder.GetDroppedEventCount(), recorder.GetRecordedFrameCount(), fileName);
+	return true;
+}
+
 void Engine::RunTickEvents()
 {
 	m_tickEventQueueMutex.lock();
@@ -538,6 +577,9 @@ void Engine::Tick()
 	StopProfilingStage(); // ServerTick
 	StopProfilingStage(); // Tick
 
+	if(m_cpuProfiler->GetTraceRecorder().EndFrame())
+		StopProfilingCapture();
+
 	UpdateParallelJobs();
 }
 
@@ -884,6 +926,8 @@ int32_t Engine::GetRemoteDebugging() const { return cvRemoteDebugging->GetInt();
 extern std::string __lp_map;
 extern std::string __lp_gamemode;
 static auto cvMountExternalResources = GetConVar("sh_mount_external_game_resources");
+static auto cvFramePacing = GetConVar("sh_frame_pacing");
+static auto cvFramePacingSpinSlack = GetConVar("sh_frame_pacing_spin_slack");
 void Engine::Start()
 {
 	if(cvMountExternalResources->GetBool() == true)
@@ -915,6 +959,8 @@ void Engine::Start()
 		auto skipTicks = static_cast<long long>(1'000 / tickRate);
 
 		auto t = GetTickCount();
+		if(t > nextTick)
+			m_framePacer->OnTickStarted();
 		while(t > nextTick && loops < MAX_FRAMESKIP) {
 			Tick();
 
@@ -924,6 +970,16 @@ void Engine::Start()
 		}
 		if(t > nextTick)
 			nextTick = t; // This should only happen after loading times
+		else if(IsServerOnly() && cvFramePacing->GetBool()) {
+			// There's nothing to render, so we can sleep until the next tick is due (or until we receive network data).
+			// The tick count has a resolution of one millisecond, so we wait until just past the deadline.
+			UpdateTickCount();
+			auto remaining = nextTick - static_cast<long long>(GetTickCount());
+			if(remaining >= 0) {
+				m_framePacer->SetSpinSlack(std::chrono::microseconds {static_cast<int64_t>(cvFramePacingSpinSlack->GetFloat() * 1'000.f)});
+				m_framePacer->WaitUntil(pragma::FramePacer::Clock::now() + std::chrono::milliseconds {remaining + 1});
+			}
+		}
 	} while(IsRunning());
 	Close();
 }
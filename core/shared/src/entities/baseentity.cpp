@@ -23,6 +23,7 @@
 #include "pragma/entities/baseentity_events.hpp"
 #include "pragma/entities/entity_component_system_t.hpp"
 #include "pragma/util/global_string_table.hpp"
+#include "pragma/entities/entity_spatial_index.hpp"
 
 Game &BaseEntity::GetGame() const { return *GetNetworkState()->GetGameState(); }
 BaseEntity *BaseEntity::CreateChild(const std::string &className)
@@ -154,10 +155,12 @@ void BaseEntity::OnRemove()
 	ClearComponents();
 	pragma::BaseLuaHandle::InvalidateHandle();
 
-	auto &uuidMap = GetNetworkState()->GetGameState()->GetEntityUuidMap();
+	auto *game = GetNetworkState()->GetGameState();
+	auto &uuidMap = game->GetEntityUuidMap();
 	auto it = uuidMap.find(util::get_uuid_hash(m_uuid));
 	if(it != uuidMap.end())
 		uuidMap.erase(it);
+	game->GetEntitySpatialIndex().Remove(*this);
 }
 
 void BaseEntity::Construct(unsigned int idx)
@@ -369,6 +372,7 @@ void BaseEntity::DoSpawn()
 	// Flag has to be set before events are triggered, in case
 	// one of the events relies (directly or indirectly) on :IsSpawned
 	m_stateFlags |= StateFlags::Spawned;
+	GetNetworkState()->GetGameState()->GetEntitySpatialIndex().MarkDirty(*this);
 	BroadcastEvent(EVENT_ON_SPAWN);
 }
 
@@ -30,13 +30,16 @@ void BaseAttachmentComponent::Initialize()
 	BaseEntityComponent::Initialize();
 
 	GetEntity().AddComponent("child");
-	BindEvent(BaseAnimatedComponent::EVENT_SHOULD_UPDATE_BONES, [this](std::reference_wrapper<pragma::ComponentEvent> evData) -> util::EventReply {
-		if(m_attachment != nullptr && (m_attachment->flags & FAttachmentMode::BoneMerge) != FAttachmentMode::None) {
-			static_cast<CEShouldUpdateBones &>(evData.get()).shouldUpdate = true;
-			return util::EventReply::Handled;
-		}
-		return util::EventReply::Unhandled;
-	});
+	BindEvent(
+	  BaseAnimatedComponent::EVENT_SHOULD_UPDATE_BONES,
+	  [this](std::reference_wrapper<pragma::ComponentEvent> evData) -> util::EventReply {
+		  if(m_attachment != nullptr && (m_attachment->flags & FAttachmentMode::BoneMerge) != FAttachmentMode::None) {
+			  static_cast<CEShouldUpdateBones &>(evData.get()).shouldUpdate = true;
+			  return util::EventReply::Handled;
+		  }
+		  return util::EventReply::Unhandled;
+	  },
+	  true);
 }
 util::EventReply BaseAttachmentComponent::HandleEvent(ComponentEventId eventId, ComponentEvent &evData)
 {
@@ -65,6 +68,13 @@ util::EventReply BaseAttachmentComponent::HandleEvent(ComponentEventId eventId,
 	}
 	return BaseEntityComponent::HandleEvent(eventId, evData);
 }
+void BaseAttachmentComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseModelComponent::EVENT_ON_MODEL_CHANGED);
+	outEventIds.push_back(BaseChildComponent::EVENT_ON_PARENT_CHANGED);
+	outEventIds.push_back(BaseEntity::EVENT_HANDLE_KEY_VALUE);
+}
 void BaseAttachmentComponent::OnTick(double dt) { UpdateAttachmentOffset(); }
 void BaseAttachmentComponent::OnRemove()
 {
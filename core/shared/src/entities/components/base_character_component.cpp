@@ -295,6 +295,11 @@ util::EventReply BaseCharacterComponent::HandleEvent(ComponentEventId eventId, C
 	}
 	return util::EventReply::Unhandled;
 }
+void BaseCharacterComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseTransformComponent::EVENT_ON_TELEPORT);
+}
 
 Quat BaseCharacterComponent::GetOrientationAxesRotation() const
 {
@@ -8,6 +8,7 @@
 #include "stdafx_shared.h"
 #include "pragma/entities/components/base_entity_component.hpp"
 #include "pragma/entities/entity_component_manager.hpp"
+#include "pragma/game/entity_tick_scheduler.hpp"
 #include "pragma/entities/components/basetoggle.h"
 #include "pragma/entities/components/base_generic_component.hpp"
 #include "pragma/entities/components/panima_component.hpp"
@@ -553,28 +554,23 @@ void BaseEntityComponent::CleanUp()
 	umath::set_flag(m_stateFlags, StateFlags::CleanedUp);
 	OnDetached(GetEntity());
 	if(m_eventCallbacks) {
-		for(auto &pair : *m_eventCallbacks) {
-			for(auto &hCb : pair.second) {
-				if(hCb.IsValid() == false)
-					continue;
-				hCb.Remove();
-			}
-		}
-		m_eventCallbacks = nullptr;
+		m_eventCallbacks->Clear();
+		// If the callbacks are currently being invoked, they'll be released together with the component
+		if(m_eventCallbacks->IsDispatching() == false)
+			m_eventCallbacks = nullptr;
 	}
 	if(m_boundEvents) {
 		for(auto &pair : *m_boundEvents) {
-			for(auto &hCb : pair.second) {
-				if(hCb.IsValid() == false)
+			for(auto &callback : pair.second) {
+				if(callback.hCallback.IsValid() == false)
 					continue;
-				hCb.Remove();
+				callback.hCallback.Remove();
 			}
 		}
 		m_boundEvents = nullptr;
 	}
 	if(umath::is_flag_set(m_stateFlags, StateFlags::IsLogicEnabled)) {
-		auto &logicComponents = GetEntity().GetNetworkState()->GetGameState()->GetEntityTickComponents();
-		*std::find(logicComponents.begin(), logicComponents.end(), this) = nullptr;
+		GetEntity().GetNetworkState()->GetGameState()->GetEntityTickScheduler().Remove(*this);
 		umath::set_flag(m_stateFlags, StateFlags::IsLogicEnabled, false);
 	}
 }
@@ -609,23 +605,23 @@ std::vector<BaseEntityComponent::CallbackInfo> &BaseEntityComponent::GetCallback
 		m_callbackInfos = std::make_unique<std::vector<CallbackInfo>>();
 	return *m_callbackInfos;
 }
-std::unordered_map<ComponentEventId, std::vector<CallbackHandle>> &BaseEntityComponent::GetEventCallbacks() const
+ComponentEventCallbacks &BaseEntityComponent::GetEventCallbacks() const
 {
 	if(!m_eventCallbacks)
-		m_eventCallbacks = std::make_unique<std::unordered_map<ComponentEventId, std::vector<CallbackHandle>>>();
+		m_eventCallbacks = std::make_unique<ComponentEventCallbacks>();
 	return *m_eventCallbacks;
 }
-std::unordered_map<ComponentEventId, std::vector<CallbackHandle>> &BaseEntityComponent::GetBoundEvents() const
+std::unordered_map<ComponentEventId, std::vector<ComponentEventCallbacks::Callback>> &BaseEntityComponent::GetBoundEvents() const
 {
 	if(!m_boundEvents)
-		m_boundEvents = std::make_unique<std::unordered_map<ComponentEventId, std::vector<CallbackHandle>>>();
+		m_boundEvents = std::make_unique<std::unordered_map<ComponentEventId, std::vector<ComponentEventCallbacks::Callback>>>();
 	return *m_boundEvents;
 }
 CallbackHandle BaseEntityComponent::AddEventCallback(ComponentEventId eventId, const std::function<util::EventReply(std::reference_wrapper<ComponentEvent>)> &fCallback)
 {
 	return AddEventCallback(eventId, FunctionCallback<util::EventReply, std::reference_wrapper<ComponentEvent>>::Create(fCallback));
 }
-CallbackHandle BaseEntityComponent::AddEventCallback(ComponentEventId eventId, const CallbackHandle &hCallback)
+CallbackHandle BaseEntityComponent::AddEventCallback(ComponentEventId eventId, const CallbackHandle &hCallback, bool threadSafe)
 {
 	// Sanity check (to make sure the event type is actually associated with this component)
 	auto componentTypeIndex = std::type_index(typeid(*this));
@@ -636,55 +632,27 @@ CallbackHandle BaseEntityComponent::AddEventCallback(ComponentEventId eventId, c
 	if(it != events.end() && it->second.typeIndex.has_value() && componentTypeIndex != *it->second.typeIndex && baseTypeIndex != *it->second.typeIndex)
 		throw std::logic_error("Attempted to add callback for component event " + std::to_string(eventId) + " (" + it->second.name + ") to component " + std::string(typeid(*this).name()) + ", which this event does not belong to!");
 
-	auto &eventCallbacks = GetEventCallbacks();
-	auto itEv = eventCallbacks.find(eventId);
-	if(itEv == eventCallbacks.end())
-		itEv = eventCallbacks.insert(std::make_pair(eventId, std::vector<CallbackHandle> {})).first;
-	itEv->second.push_back(hCallback);
-	return itEv->second.back();
+	return GetEventCallbacks().Add(eventId, hCallback, threadSafe);
 }
 void BaseEntityComponent::RemoveEventCallback(ComponentEventId eventId, const CallbackHandle &hCallback)
 {
 	if(!m_eventCallbacks)
 		return;
-	auto &eventCallbacks = GetEventCallbacks();
-	auto itEv = eventCallbacks.find(eventId);
-	if(itEv == eventCallbacks.end())
-		return;
-	auto itCb = std::find(itEv->second.begin(), itEv->second.end(), hCallback);
-	if(itCb == itEv->second.end())
-		return;
-	itEv->second.erase(itCb);
-	if(itEv->second.empty())
-		eventCallbacks.erase(itEv);
+	m_eventCallbacks->Remove(eventId, hCallback);
 }
+bool BaseEntityComponent::HasEventCallbacks(ComponentEventId eventId) const { return m_eventCallbacks && m_eventCallbacks->HasCallbacks(eventId); }
+bool BaseEntityComponent::HasThreadUnsafeEventCallbacks(ComponentEventId eventId) const { return m_eventCallbacks && m_eventCallbacks->HasThreadUnsafeCallbacks(eventId); }
 util::EventReply BaseEntityComponent::InvokeEventCallbacks(ComponentEventId eventId, const ComponentEvent &evData) const
 {
 	return InvokeEventCallbacks(eventId, const_cast<ComponentEvent &>(evData)); // Hack: This assumes the argument was passed as temporary variable and changing it does not matter
 }
 util::EventReply BaseEntityComponent::InvokeEventCallbacks(ComponentEventId eventId, ComponentEvent &evData) const
 {
-	if(!m_eventCallbacks)
-		return util::EventReply::Unhandled;
-	auto &eventCallbacks = GetEventCallbacks();
-	auto itEv = eventCallbacks.find(eventId);
-	if(itEv == eventCallbacks.end())
+	if(EntityTickScheduler::IsValidatingTickAccess())
+		EntityTickScheduler::ValidateTickAccess(GetComponentId(), EntityTickScheduler::AccessType::Write);
+	if(!m_eventCallbacks || m_eventCallbacks->HasCallbacks(eventId) == false)
 		return util::EventReply::Unhandled;
-	auto hThis = GetHandle();
-	auto &evs = itEv->second;
-	for(auto i = decltype(evs.size()) {0u}; i < evs.size();) {
-		auto &hCb = evs[i];
-		if(hCb.IsValid() == false) {
-			itEv->second.erase(itEv->second.begin() + i);
-			continue;
-		}
-		if(hCb.Call<util::EventReply, std::reference_wrapper<ComponentEvent>>(std::reference_wrapper<ComponentEvent>(evData)) == util::EventReply::Handled)
-			return util::EventReply::Handled;
-		if(hThis.expired()) // This component has been removed directly or indirectly by the callback; Return immediately
-			return util::EventReply::Unhandled;
-		++i;
-	}
-	return util::EventReply::Unhandled;
+	return m_eventCallbacks->Invoke(eventId, evData, GetHandle());
 }
 util::EventReply BaseEntityComponent::InvokeEventCallbacks(ComponentEventId eventId) const
 {
@@ -714,14 +682,17 @@ util::EventReply BaseEntityComponent::InjectEvent(ComponentEventId eventId)
 	CEGenericComponentEvent ev {};
 	return BroadcastEvent(eventId, ev);
 }
-CallbackHandle BaseEntityComponent::BindEventUnhandled(ComponentEventId eventId, const std::function<void(std::reference_wrapper<ComponentEvent>)> &fCallback)
+CallbackHandle BaseEntityComponent::BindEventUnhandled(ComponentEventId eventId, const std::function<void(std::reference_wrapper<ComponentEvent>)> &fCallback, bool threadSafe)
 {
-	return BindEvent(eventId, [fCallback](std::reference_wrapper<ComponentEvent> evData) -> util::EventReply {
-		fCallback(evData);
-		return util::EventReply::Unhandled;
-	});
+	return BindEvent(
+	  eventId,
+	  [fCallback](std::reference_wrapper<ComponentEvent> evData) -> util::EventReply {
+		  fCallback(evData);
+		  return util::EventReply::Unhandled;
+	  },
+	  threadSafe);
 }
-CallbackHandle BaseEntityComponent::BindEvent(ComponentEventId eventId, const std::function<util::EventReply(std::reference_wrapper<ComponentEvent>)> &fCallback)
+CallbackHandle BaseEntityComponent::BindEvent(ComponentEventId eventId, const std::function<util::EventReply(std::reference_wrapper<ComponentEvent>)> &fCallback, bool threadSafe)
 {
 	auto hCallback = FunctionCallback<util::EventReply, std::reference_wrapper<ComponentEvent>>::Create(fCallback);
 	auto &ent = GetEntity();
@@ -738,7 +709,7 @@ CallbackHandle BaseEntityComponent::BindEvent(ComponentEventId eventId, const st
 				pComponent->GetBaseTypeIndex(baseTypeIndex);
 				if(componentTypeIndex != *info.typeIndex && baseTypeIndex != *info.typeIndex)
 					continue;
-				auto cb = pComponent->AddEventCallback(eventId, hCallback);
+				auto cb = pComponent->AddEventCallback(eventId, hCallback, threadSafe);
 				FlagCallbackForRemoval(cb, CallbackType::Component, pComponent.get());
 				return cb;
 			}
@@ -746,10 +717,12 @@ CallbackHandle BaseEntityComponent::BindEvent(ComponentEventId eventId, const st
 	}
 	auto &boundEvents = GetBoundEvents();
 	auto itEv = boundEvents.find(eventId);
-	if(itEv == boundEvents.end())
-		itEv = boundEvents.insert(std::make_pair(eventId, std::vector<CallbackHandle> {})).first;
-	itEv->second.push_back(hCallback);
-	return itEv->second.back();
+	if(itEv == boundEvents.end()) {
+		itEv = boundEvents.insert({eventId, {}}).first;
+		ent.InvalidateEventDispatchTable();
+	}
+	itEv->second.push_back({hCallback, threadSafe});
+	return itEv->second.back().hCallback;
 }
 util::EventReply BaseEntityComponent::HandleEvent(ComponentEventId eventId, ComponentEvent &evData)
 {
@@ -765,7 +738,7 @@ util::EventReply BaseEntityComponent::HandleEvent(ComponentEventId eventId, Comp
 	if(itEv == boundEvents.end())
 		return util::EventReply::Unhandled;
 	for(auto it = itEv->second.begin(); it != itEv->second.end();) {
-		auto &hCb = *it;
+		auto &hCb = it->hCallback;
 		if(hCb.IsValid() == false) {
 			it = itEv->second.erase(it);
 			continue;
@@ -776,6 +749,15 @@ util::EventReply BaseEntityComponent::HandleEvent(ComponentEventId eventId, Comp
 	}
 	return util::EventReply::Unhandled;
 }
+void BaseEntityComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	outEventIds.push_back(BaseEntity::EVENT_ON_SPAWN);
+	outEventIds.push_back(BaseEntity::EVENT_ON_POST_SPAWN);
+	if(!m_boundEvents)
+		return;
+	for(auto &pair : *m_boundEvents)
+		outEventIds.push_back(pair.first);
+}
 void BaseEntityComponent::GetBaseTypeIndex(std::type_index &outTypeIndex) const {}
 void BaseEntityComponent::OnEntityComponentAdded(BaseEntityComponent &component) {}
 void BaseEntityComponent::OnEntityComponentAdded(BaseEntityComponent &component, bool bSkipEventBinding)
@@ -793,8 +775,8 @@ void BaseEntityComponent::OnEntityComponentAdded(BaseEntityComponent &component,
 				component.GetBaseTypeIndex(baseTypeIndex);
 				if(componentTypeIndex != *info.typeIndex && baseTypeIndex != *info.typeIndex)
 					continue;
-				for(auto &hCb : pair.second)
-					component.AddEventCallback(evId, hCb);
+				for(auto &callback : pair.second)
+					component.AddEventCallback(evId, callback.hCallback, callback.threadSafe);
 			}
 		}
 	}
@@ -814,8 +796,8 @@ void BaseEntityComponent::OnEntityComponentRemoved(BaseEntityComponent &componen
 			component.GetBaseTypeIndex(baseTypeIndex);
 			if(componentTypeIndex != *info.typeIndex && baseTypeIndex != *info.typeIndex)
 				continue;
-			for(auto &hCb : pair.second)
-				component.RemoveEventCallback(evId, hCb);
+			for(auto &callback : pair.second)
+				component.RemoveEventCallback(evId, callback.hCallback);
 		}
 	}
 	if(m_callbackInfos) {
@@ -902,17 +884,21 @@ void BaseEntityComponent::UpdateTickPolicy()
 {
 	if(!GetEntity().IsSpawned())
 		return;
-	auto &logicComponents = GetEntity().GetNetworkState()->GetGameState()->GetEntityTickComponents();
+	if(umath::is_flag_set(m_stateFlags, StateFlags::IsThinking))
+		return; // Tick policy update will be handled by game
+	auto &tickScheduler = GetEntity().GetNetworkState()->GetGameState()->GetEntityTickScheduler();
+	if(tickScheduler.DeferTickPolicyUpdate(*this))
+		return;
 	if(ShouldThink()) {
 		if(umath::is_flag_set(m_stateFlags, StateFlags::IsLogicEnabled))
 			return;
-		logicComponents.push_back(this);
+		tickScheduler.Add(*this);
 		umath::set_flag(m_stateFlags, StateFlags::IsLogicEnabled);
 		return;
 	}
 	if(!umath::is_flag_set(m_stateFlags, StateFlags::IsLogicEnabled))
 		return;
-	logicComponents.erase(std::find(logicComponents.begin(), logicComponents.end(), this));
+	tickScheduler.Remove(*this);
 	umath::set_flag(m_stateFlags, StateFlags::IsLogicEnabled, false);
 }
 void BaseEntityComponent::SetTickPolicy(TickPolicy policy)
@@ -928,11 +914,15 @@ void BaseEntityComponent::SetTickPolicy(TickPolicy policy)
 
 double BaseEntityComponent::GetNextTick() const { return m_tickData.nextTick; }
 void BaseEntityComponent::SetNextTick(double t) { m_tickData.nextTick = t; }
+void BaseEntityComponent::SetTickInterval(uint32_t interval) { m_tickData.tickInterval = interval; }
+uint32_t BaseEntityComponent::GetTickInterval() const { return m_tickData.tickInterval; }
 
 double BaseEntityComponent::LastTick() const { return m_tickData.lastTick; }
 
 double BaseEntityComponent::DeltaTime() const
 {
+	if(m_tickData.lastTickDelta > 0.0)
+		return m_tickData.lastTickDelta;
 	Game *game = GetEntity().GetNetworkState()->GetGameState();
 	//auto r = game->CurTime() -m_lastThink; // This would be more accurate, but can be 0 if the engine had to catch up on the tick rate
 	auto r = game->DeltaTickTime();
@@ -943,6 +933,7 @@ double BaseEntityComponent::DeltaTime() const
 bool BaseEntityComponent::Tick(double tDelta)
 {
 	m_stateFlags |= pragma::BaseEntityComponent::StateFlags::IsThinking;
+	m_tickData.lastTickDelta = tDelta;
 
 	auto hThis = GetHandle();
 	auto &ent = GetEntity();
@@ -965,6 +956,8 @@ void BaseEntityComponent::SetActive(bool enabled)
 {
 	if(enabled == IsActive())
 		return;
+	if(EntityTickScheduler::IsValidatingTickAccess())
+		EntityTickScheduler::ValidateTickAccess(GetComponentId(), EntityTickScheduler::AccessType::Structural);
 	umath::set_flag(m_stateFlags, StateFlags::IsInactive, !enabled);
 	BroadcastEvent(EVENT_ON_ACTIVE_STATE_CHANGED);
 	OnActiveStateChanged(enabled);
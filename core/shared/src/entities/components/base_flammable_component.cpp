@@ -70,6 +70,11 @@ util::EventReply BaseFlammableComponent::HandleEvent(ComponentEventId eventId, C
 		Extinguish();
 	return util::EventReply::Unhandled;
 }
+void BaseFlammableComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(pragma::SubmergibleComponent::EVENT_ON_WATER_SUBMERGED);
+}
 void BaseFlammableComponent::Save(udm::LinkedPropertyWrapperArg udm)
 {
 	BaseEntityComponent::Save(udm);
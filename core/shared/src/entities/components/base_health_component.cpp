@@ -81,6 +81,11 @@ util::EventReply BaseHealthComponent::HandleEvent(ComponentEventId eventId, Comp
 		OnTakeDamage(static_cast<CEOnTakeDamage &>(evData).damageInfo);
 	return util::EventReply::Unhandled;
 }
+void BaseHealthComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(DamageableComponent::EVENT_ON_TAKE_DAMAGE);
+}
 
 void BaseHealthComponent::OnTakeDamage(DamageInfo &info)
 {
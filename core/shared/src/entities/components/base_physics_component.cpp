@@ -10,6 +10,7 @@
 #include "pragma/entities/components/base_transform_component.hpp"
 #include "pragma/entities/components/velocity_component.hpp"
 #include "pragma/game/game_limits.h"
+#include "pragma/entities/entity_spatial_index.hpp"
 #include "pragma/util/bulletinfo.h"
 #include "pragma/physics/environment.hpp"
 #include "pragma/model/brush/brushmesh.h"
@@ -17,6 +18,7 @@
 #include "pragma/entities/components/base_player_component.hpp"
 #include "pragma/entities/components/base_model_component.hpp"
 #include "pragma/entities/components/base_animated_component.hpp"
+#include "pragma/game/animation_update_manager.hpp"
 #include "pragma/entities/entity_component_system_t.hpp"
 #include "pragma/model/model.h"
 #include "pragma/physics/raytraces.h"
@@ -69,17 +71,28 @@ void BasePhysicsComponent::Initialize()
 	m_netEvSetCollisionsEnabled = SetupNetEvent("set_collisions_enabled");
 	m_netEvSetSimEnabled = SetupNetEvent("set_simulation_enabled");
 
-	BindEvent(BaseAnimatedComponent::EVENT_SHOULD_UPDATE_BONES, [this](std::reference_wrapper<pragma::ComponentEvent> evData) -> util::EventReply {
-		if(IsRagdoll()) {
-			static_cast<CEShouldUpdateBones &>(evData.get()).shouldUpdate = true;
-			return util::EventReply::Handled;
-		}
-		return util::EventReply::Unhandled;
-	});
-	BindEventUnhandled(BaseAnimatedComponent::EVENT_ON_BONE_TRANSFORM_CHANGED, [this](std::reference_wrapper<pragma::ComponentEvent> evData) {
-		auto &evDataTransform = static_cast<CEOnBoneTransformChanged &>(evData.get());
-		UpdateBoneCollisionObject(evDataTransform.boneId, evDataTransform.pos != nullptr, evDataTransform.rot != nullptr);
-	});
+	// The bone listeners are invoked during the skeletal animation update, which may run on a worker thread.
+	// The physics objects must only be touched on the main thread.
+	BindEvent(
+	  BaseAnimatedComponent::EVENT_SHOULD_UPDATE_BONES,
+	  [this](std::reference_wrapper<pragma::ComponentEvent> evData) -> util::EventReply {
+		  if(IsRagdoll()) {
+			  static_cast<CEShouldUpdateBones &>(evData.get()).shouldUpdate = true;
+			  return util::EventReply::Handled;
+		  }
+		  return util::EventReply::Unhandled;
+	  },
+	  true);
+	BindEventUnhandled(
+	  BaseAnimatedComponent::EVENT_ON_BONE_TRANSFORM_CHANGED,
+	  [this](std::reference_wrapper<pragma::ComponentEvent> evData) {
+		  auto &evDataTransform = static_cast<CEOnBoneTransformChanged &>(evData.get());
+		  auto boneId = evDataTransform.boneId;
+		  auto updatePos = evDataTransform.pos != nullptr;
+		  auto updateRot = evDataTransform.rot != nullptr;
+		  AnimationUpdateManager::RunOnMainThread([this, boneId, updatePos, updateRot]() { UpdateBoneCollisionObject(boneId, updatePos, updateRot); });
+	  },
+	  true);
 	BindEvent(BaseAnimatedComponent::EVENT_MAINTAIN_ANIMATIONS, [this](std::reference_wrapper<pragma::ComponentEvent> evData) -> util::EventReply {
 		return IsRagdoll() ? util::EventReply::Handled : util::EventReply::Unhandled; // Don't process animations if we're in ragdoll mode
 	});
@@ -459,8 +472,11 @@ void BasePhysicsComponent::GetCollisionBounds(Vector3 *min, Vector3 *max) const
 
 void BasePhysicsComponent::SetCollisionBounds(const Vector3 &min, const Vector3 &max)
 {
-	if(min.x != m_colMin.x || min.y != m_colMin.y || min.z != m_colMin.z || max.x != m_colMax.x || max.y != m_colMax.y || max.z != m_colMax.z)
-		GetEntity().SetStateFlag(BaseEntity::StateFlags::CollisionBoundsChanged);
+	if(min.x != m_colMin.x || min.y != m_colMin.y || min.z != m_colMin.z || max.x != m_colMax.x || max.y != m_colMax.y || max.z != m_colMax.z) {
+		auto &ent = GetEntity();
+		ent.SetStateFlag(BaseEntity::StateFlags::CollisionBoundsChanged);
+		ent.GetNetworkState()->GetGameState()->GetEntitySpatialIndex().MarkDirty(ent);
+	}
 	m_colMin = min;
 	m_colMax = max;
 	auto extents = (max - min) * 0.5f;
@@ -99,6 +99,13 @@ util::EventReply BasePlayerComponent::HandleEvent(ComponentEventId eventId, Comp
 	}
 	return util::EventReply::Unhandled;
 }
+void BasePlayerComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseCharacterComponent::EVENT_ON_KILLED);
+	outEventIds.push_back(BaseCharacterComponent::EVENT_ON_RESPAWN);
+	outEventIds.push_back(BaseHealthComponent::EVENT_ON_TAKEN_DAMAGE);
+}
 bool BasePlayerComponent::CanUnCrouch() const
 {
 	if(m_shapeStand == nullptr)
@@ -80,3 +80,8 @@ util::EventReply BaseSoftBodyComponent::HandleEvent(ComponentEventId eventId, Co
 		ReleaseSoftBodyData();
 	return util::EventReply::Unhandled;
 }
+void BaseSoftBodyComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(pragma::BasePhysicsComponent::EVENT_ON_PHYSICS_DESTROYED);
+}
@@ -105,6 +105,12 @@ util::EventReply BaseStaticBvhUserComponent::HandleEvent(ComponentEventId eventI
 		UpdateBvhStatus();
 	return BaseEntityComponent::HandleEvent(eventId, evData);
 }
+void BaseStaticBvhUserComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BasePhysicsComponent::EVENT_ON_PHYSICS_INITIALIZED);
+	outEventIds.push_back(BasePhysicsComponent::EVENT_ON_PHYSICS_DESTROYED);
+}
 void BaseStaticBvhUserComponent::OnRemove()
 {
 	BaseEntityComponent::OnRemove();
@@ -21,6 +21,7 @@
 #include <sharedutils/datastream.h>
 #include "pragma/physics/raytraces.h"
 #include "pragma/entities/baseentity_trace.hpp"
+#include "pragma/entities/entity_spatial_index.hpp"
 #include <udm.hpp>
 
 using namespace pragma;
@@ -126,7 +127,9 @@ void BaseTransformComponent::OnPoseChanged(TransformChangeFlags changeFlags, boo
 		ent.SetStateFlag(BaseEntity::StateFlags::PositionChanged);
 	if(umath::is_flag_set(changeFlags, TransformChangeFlags::RotationChanged))
 		ent.SetStateFlag(BaseEntity::StateFlags::RotationChanged);
-	m_tLastMoved = ent.GetNetworkState()->GetGameState()->CurTime();
+	auto *game = ent.GetNetworkState()->GetGameState();
+	m_tLastMoved = game->CurTime();
+	game->GetEntitySpatialIndex().MarkDirty(ent);
 	if(updatePhysics) {
 		auto pPhysComponent = ent.GetPhysicsComponent();
 		auto *pPhys = pPhysComponent ? pPhysComponent->GetPhysicsObject() : nullptr;
@@ -90,6 +90,11 @@ util::EventReply ConstraintChildOfComponent::HandleEvent(ComponentEventId eventI
 		SetPropertyInfosDirty();
 	return util::EventReply::Unhandled;
 }
+void ConstraintChildOfComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(ConstraintComponent::EVENT_ON_PARTICIPANTS_FLAGGED_DIRTY);
+}
 void ConstraintChildOfComponent::SetLocationAxisEnabled(pragma::Axis axis, bool enabled)
 {
 	m_locationEnabled[umath::to_integral(axis)] = enabled;
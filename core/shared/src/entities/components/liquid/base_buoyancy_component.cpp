@@ -82,6 +82,11 @@ util::EventReply BaseBuoyancyComponent::HandleEvent(ComponentEventId eventId, Co
 	}
 	return util::EventReply::Unhandled;
 }
+void BaseBuoyancyComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseTouchComponent::EVENT_CAN_TRIGGER);
+}
 
 void BaseBuoyancyComponent::OnEndTouch(BaseEntity *ent, PhysObj *phys)
 {
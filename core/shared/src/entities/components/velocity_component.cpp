@@ -53,6 +53,12 @@ util::EventReply VelocityComponent::HandleEvent(ComponentEventId eventId, Compon
 	}
 	return util::EventReply::Unhandled;
 }
+void VelocityComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(DamageableComponent::EVENT_ON_TAKE_DAMAGE);
+	outEventIds.push_back(BaseTransformComponent::EVENT_ON_TELEPORT);
+}
 
 void VelocityComponent::SetVelocity(const Vector3 &vel)
 {
@@ -0,0 +1,99 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#include "stdafx_shared.h"
+#include "pragma/entities/entity_component_arena.hpp"
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+using namespace pragma;
+
+ComponentArena::ComponentArena(size_t objectSize, size_t objectAlignment) : m_alignment {objectAlignment}
+{
+	m_stride = ((objectSize + objectAlignment - 1) / objectAlignment) * objectAlignment;
+	m_stats.objectSize = m_stride;
+}
+ComponentArena::~ComponentArena()
+{
+	// Note: The arena is kept alive by the deleters of its objects, so there should be no live objects left at this point
+	assert(m_stats.count == 0);
+	for(auto &chunk : m_chunks)
+		::operator delete(chunk->data, std::align_val_t {m_alignment});
+}
+
+void *ComponentArena::Allocate()
+{
+	while(m_freeChunks.empty() == false) {
+		auto &chunk = *m_chunks[m_freeChunks.back()];
+		if(chunk.usedMask != chunk.GetFullMask())
+			break;
+		chunk.inFreeList = false;
+		m_freeChunks.pop_back();
+	}
+	if(m_freeChunks.empty()) {
+		auto capacity = std::min(MIN_CHUNK_CAPACITY << std::min<size_t>(m_chunks.size(), 4), MAX_CHUNK_CAPACITY);
+		auto chunk = std::make_unique<Chunk>();
+		chunk->data = static_cast<std::byte *>(::operator new(capacity * m_stride, std::align_val_t {m_alignment}));
+		chunk->capacity = capacity;
+		chunk->inFreeList = true;
+		auto chunkIndex = static_cast<uint32_t>(m_chunks.size());
+		auto it = std::upper_bound(m_chunksByAddress.begin(), m_chunksByAddress.end(), chunk->data, [](const std::byte *data, const std::pair<const std::byte *, uint32_t> &pair) { return data < pair.first; });
+		m_chunksByAddress.insert(it, {chunk->data, chunkIndex});
+		m_chunks.push_back(std::move(chunk));
+		m_freeChunks.push_back(chunkIndex);
+
+		++m_stats.chunkCount;
+		m_stats.capacity += capacity;
+		m_stats.reservedBytes += capacity * m_stride;
+	}
+	auto &chunk = *m_chunks[m_freeChunks.back()];
+	auto slot = std::countr_zero(~chunk.usedMask & chunk.GetFullMask());
+	chunk.usedMask |= uint64_t {1} << slot;
+
+	++m_stats.count;
+	++m_stats.allocationCount;
+	m_stats.peakCount = std::max(m_stats.peakCount, m_stats.count);
+	return chunk.data + slot * m_stride;
+}
+
+std::pair<uint32_t, uint32_t> ComponentArena::FindSlot(void *ptr) const
+{
+	auto *data = static_cast<const std::byte *>(ptr);
+	auto it = std::upper_bound(m_chunksByAddress.begin(), m_chunksByAddress.end(), data, [](const std::byte *data, const std::pair<const std::byte *, uint32_t> &pair) { return data < pair.first; });
+	assert(it != m_chunksByAddress.begin());
+	--it;
+	auto &chunk = *m_chunks[it->second];
+	auto slot = static_cast<uint32_t>((data - chunk.data) / m_stride);
+	assert(slot < chunk.capacity);
+	return {it->second, slot};
+}
+
+void ComponentArena::Free(void *ptr)
+{
+	auto [chunkIndex, slot] = FindSlot(ptr);
+	auto *chunk = m_chunks[chunkIndex].get();
+	if(chunk->inFreeList == false) {
+		chunk->inFreeList = true;
+		m_freeChunks.push_back(chunkIndex);
+	}
+	chunk->usedMask &= ~(uint64_t {1} << slot);
+	chunk->liveMask &= ~(uint64_t {1} << slot);
+	--m_stats.count;
+}
+
+void ComponentArena::SetLive(void *ptr, bool live)
+{
+	auto [chunkIndex, slot] = FindSlot(ptr);
+	auto *chunk = m_chunks[chunkIndex].get();
+	if(live)
+		chunk->liveMask |= uint64_t {1} << slot;
+	else
+		chunk->liveMask &= ~(uint64_t {1} << slot);
+}
+
+size_t ComponentArena::GetCount() const { return m_stats.count; }
+const ComponentArena::Stats &ComponentArena::GetStats() const { return m_stats; }
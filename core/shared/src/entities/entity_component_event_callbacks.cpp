@@ -0,0 +1,165 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#include "stdafx_shared.h"
+#include "pragma/entities/entity_component_event_callbacks.hpp"
+#include "pragma/entities/entity_component_event.hpp"
+#include "pragma/entities/components/base_entity_component.hpp"
+#include <algorithm>
+
+using namespace pragma;
+
+void ComponentEventCallbacks::CallbackList::push_back(const Callback &callback)
+{
+	if(m_inlineCount < INLINE_CAPACITY) {
+		m_inline[m_inlineCount++] = callback;
+		return;
+	}
+	m_overflow.push_back(callback);
+}
+void ComponentEventCallbacks::CallbackList::Compact()
+{
+	size_t n = 0;
+	auto count = size();
+	for(size_t i = 0; i < count; ++i) {
+		auto &callback = operator[](i);
+		if(callback.hCallback.IsValid() == false)
+			continue;
+		if(i != n)
+			operator[](n) = std::move(callback);
+		++n;
+	}
+	for(auto i = n; i < umath::min(count, static_cast<size_t>(INLINE_CAPACITY)); ++i)
+		m_inline[i] = Callback {};
+	m_inlineCount = umath::min(n, static_cast<size_t>(INLINE_CAPACITY));
+	m_overflow.resize((n > INLINE_CAPACITY) ? (n - INLINE_CAPACITY) : 0);
+}
+
+std::optional<size_t> ComponentEventCallbacks::FindEntry(ComponentEventId eventId) const
+{
+	if((m_eventMask & GetEventBit(eventId)) == 0)
+		return {};
+	auto it = std::find_if(m_entries.begin(), m_entries.end(), [eventId](const Entry &entry) { return entry.eventId == eventId; });
+	if(it == m_entries.end())
+		return {};
+	return it - m_entries.begin();
+}
+const ComponentEventCallbacks::CallbackList *ComponentEventCallbacks::FindCallbacks(ComponentEventId eventId) const
+{
+	auto idx = FindEntry(eventId);
+	return idx ? &m_entries[*idx].callbacks : nullptr;
+}
+bool ComponentEventCallbacks::HasCallbacks(ComponentEventId eventId) const
+{
+	auto *callbacks = FindCallbacks(eventId);
+	return callbacks && !callbacks->empty();
+}
+bool ComponentEventCallbacks::HasThreadUnsafeCallbacks(ComponentEventId eventId) const
+{
+	auto *callbacks = FindCallbacks(eventId);
+	if(!callbacks)
+		return false;
+	for(size_t i = 0; i < callbacks->size(); ++i) {
+		auto &callback = (*callbacks)[i];
+		if(callback.threadSafe == false && callback.hCallback.IsValid())
+			return true;
+	}
+	return false;
+}
+bool ComponentEventCallbacks::IsEmpty() const { return m_entries.empty(); }
+bool ComponentEventCallbacks::IsDispatching() const { return m_dispatchDepth > 0; }
+
+CallbackHandle ComponentEventCallbacks::Add(ComponentEventId eventId, const CallbackHandle &hCallback, bool threadSafe)
+{
+	auto idx = FindEntry(eventId);
+	if(!idx) {
+		// Note: If this happens during an invocation, the entries may be re-allocated, so they must only be accessed by index
+		idx = m_entries.size();
+		m_entries.push_back({eventId});
+		m_eventMask |= GetEventBit(eventId);
+	}
+	auto &callbacks = m_entries[*idx].callbacks;
+	callbacks.push_back({hCallback, threadSafe});
+	return hCallback;
+}
+void ComponentEventCallbacks::Remove(ComponentEventId eventId, const CallbackHandle &hCallback)
+{
+	auto idx = FindEntry(eventId);
+	if(!idx)
+		return;
+	auto &callbacks = m_entries[*idx].callbacks;
+	for(size_t i = 0; i < callbacks.size(); ++i) {
+		if(callbacks[i].hCallback == hCallback) {
+			callbacks[i] = Callback {};
+			break;
+		}
+	}
+	if(IsDispatching()) {
+		m_compactionRequired = true;
+		return;
+	}
+	Compact();
+}
+void ComponentEventCallbacks::Clear()
+{
+	for(auto &entry : m_entries) {
+		auto &callbacks = entry.callbacks;
+		for(size_t i = 0; i < callbacks.size(); ++i) {
+			auto &hCb = callbacks[i].hCallback;
+			if(hCb.IsValid())
+				hCb.Remove();
+		}
+	}
+	if(IsDispatching()) {
+		m_compactionRequired = true;
+		return;
+	}
+	m_entries.clear();
+	m_eventMask = 0;
+}
+
+void ComponentEventCallbacks::Compact()
+{
+	m_compactionRequired = false;
+	m_eventMask = 0;
+	for(auto it = m_entries.begin(); it != m_entries.end();) {
+		it->callbacks.Compact();
+		if(it->callbacks.empty()) {
+			it = m_entries.erase(it);
+			continue;
+		}
+		m_eventMask |= GetEventBit(it->eventId);
+		++it;
+	}
+}
+
+util::EventReply ComponentEventCallbacks::Invoke(ComponentEventId eventId, ComponentEvent &evData, const ComponentHandle<const BaseEntityComponent> &hOwner)
+{
+	auto idx = FindEntry(eventId);
+	if(!idx)
+		return util::EventReply::Unhandled;
+	++m_dispatchDepth;
+	auto reply = util::EventReply::Unhandled;
+	// Note: Callbacks which are added during the loop will be invoked as well
+	for(size_t i = 0; i < m_entries[*idx].callbacks.size(); ++i) {
+		// Copy of the handle, since the callback list may be re-allocated by the callback
+		auto hCb = m_entries[*idx].callbacks[i].hCallback;
+		if(hCb.IsValid() == false) {
+			m_compactionRequired = true;
+			continue;
+		}
+		auto r = hCb.Call<util::EventReply, std::reference_wrapper<ComponentEvent>>(std::reference_wrapper<ComponentEvent>(evData));
+		if(hOwner.expired()) // The owner has been removed directly or indirectly by the callback; Return immediately
+			return r;
+		if(r == util::EventReply::Handled) {
+			reply = r;
+			break;
+		}
+	}
+	if(--m_dispatchDepth == 0 && m_compactionRequired)
+		Compact();
+	return reply;
+}
@@ -524,6 +524,12 @@ const std::vector<BaseEntityComponent *> &EntityComponentManager::GetComponents(
 	count = info.GetCount();
 	return info.GetComponents();
 }
+const ComponentArena *EntityComponentManager::GetComponentArena(ComponentId componentId) const
+{
+	if(componentId >= m_components.size())
+		return nullptr;
+	return m_components[componentId].m_arena.get();
+}
 void EntityComponentManager::DeregisterComponent(BaseEntityComponent &component) { m_components.at(component.GetComponentId()).Pop(component); }
 
 ////////////////////
@@ -11,7 +11,9 @@
 #include "pragma/entities/entity_component_system.hpp"
 #include "pragma/entities/components/base_generic_component.hpp"
 #include "pragma/entities/components/base_entity_component_member_register.hpp"
+#include "pragma/game/entity_tick_scheduler.hpp"
 #include <unordered_set>
+#include <algorithm>
 
 using namespace pragma;
 static std::vector<BaseEntityComponentSystem *> g_systemsScheduledForCleanup; // TODO: It would be cleaner to have one instance of this per game state
@@ -56,29 +58,53 @@ void BaseEntityComponentSystem::ClearComponents()
 	}
 	m_components.clear();
 }
+void BaseEntityComponentSystem::InvalidateEventDispatchTable() { m_eventDispatchTable = nullptr; }
+void BaseEntityComponentSystem::UpdateEventDispatchTable() const { GetEventDispatchTable(); }
+void BaseEntityComponentSystem::AddToEventDispatchTable(BaseEntityComponent &component) const
+{
+	std::vector<ComponentEventId> eventIds;
+	component.GetHandledEvents(eventIds);
+	std::sort(eventIds.begin(), eventIds.end());
+	eventIds.erase(std::unique(eventIds.begin(), eventIds.end()), eventIds.end());
+	auto &dispatchTable = *m_eventDispatchTable;
+	for(auto eventId : eventIds)
+		dispatchTable[eventId].push_back(component.GetHandle());
+}
+const std::shared_ptr<BaseEntityComponentSystem::EventDispatchTable> &BaseEntityComponentSystem::GetEventDispatchTable() const
+{
+	if(m_eventDispatchTable)
+		return m_eventDispatchTable;
+	m_eventDispatchTable = std::make_shared<EventDispatchTable>();
+	for(auto &component : m_components) {
+		if(component.valid())
+			AddToEventDispatchTable(*component);
+	}
+	return m_eventDispatchTable;
+}
 util::EventReply BaseEntityComponentSystem::BroadcastEvent(ComponentEventId ev, ComponentEvent &evData, const BaseEntityComponent *src) const
 {
 	// Note: This function must only be called from one thread at a time.
 	// For this reason multi-threaded events should never be broadcasted, and should
 	// always use InvokeEventCallbacks instead.
-	auto &components = const_cast<BaseEntityComponentSystem *>(this)->m_components;
+	if(EntityTickScheduler::IsValidatingTickAccess())
+		EntityTickScheduler::ValidateTickAccess(src ? src->GetComponentId() : INVALID_COMPONENT_ID, EntityTickScheduler::AccessType::Structural);
 
-	// During the loop, an event callback may create other components, which would invalidate our iterator.
-	// We'll track how many components we have to catch events like that.
-	auto numInitialComponents = components.size();
-	auto numComponents = numInitialComponents;
-	for(auto it = components.begin(); it != components.begin() + numInitialComponents; ++it) {
-		auto &component = *it;
-		if(component == nullptr || component.get() == src)
+	// Event callbacks may add or remove components, which will cause the dispatch table to be re-built.
+	// We'll keep a reference to the current table, which only contains the components that existed when the broadcast started.
+	auto dispatchTable = GetEventDispatchTable();
+	auto it = dispatchTable->find(ev);
+	if(it == dispatchTable->end())
+		return util::EventReply::Unhandled;
+	for(auto &hComponent : it->second) {
+		if(hComponent.expired())
 			continue;
-		auto idx = (it - components.begin());
+		auto *component = hComponent.get();
+		if(component == src)
+			continue;
+		if(EntityTickScheduler::IsValidatingTickAccess())
+			EntityTickScheduler::ValidateTickAccess(component->GetComponentId(), EntityTickScheduler::AccessType::Write);
 		if(component->HandleEvent(ev, evData) == util::EventReply::Handled)
 			return util::EventReply::Handled;
-		if(components.size() != numComponents) {
-			// Iterator has been invalidated. This can happen because a new component has been added.
-			it = components.begin() + idx;
-			numComponents = components.size();
-		}
 	}
 	return util::EventReply::Unhandled;
 }
@@ -87,8 +113,16 @@ util::EventReply BaseEntityComponentSystem::BroadcastEvent(ComponentEventId even
 	CEGenericComponentEvent ev {};
 	return BroadcastEvent(eventId, ev);
 }
+bool BaseEntityComponentSystem::HasEventHandlers(ComponentEventId ev) const
+{
+	auto &dispatchTable = GetEventDispatchTable();
+	auto it = dispatchTable->find(ev);
+	return it != dispatchTable->end() && it->second.empty() == false;
+}
 pragma::ComponentHandle<pragma::BaseEntityComponent> BaseEntityComponentSystem::AddComponent(ComponentId componentId, bool bForceCreateNew)
 {
+	if(EntityTickScheduler::IsValidatingTickAccess())
+		EntityTickScheduler::ValidateTickAccess(componentId, EntityTickScheduler::AccessType::Structural);
 	if(bForceCreateNew == false) {
 		auto it = std::find_if(m_components.begin(), m_components.end(), [componentId](const util::TSharedHandle<pragma::BaseEntityComponent> &ptrComponent) { return ptrComponent.valid() && ptrComponent->GetComponentId() == componentId; });
 		if(it != m_components.end())
@@ -102,6 +136,13 @@ pragma::ComponentHandle<pragma::BaseEntityComponent> BaseEntityComponentSystem::
 	if(m_components.size() == m_components.capacity())
 		m_components.reserve(m_components.size() + 5u);
 	m_components.push_back(ptrComponent);
+	if(m_eventDispatchTable) {
+		// The table can only be extended in-place if no broadcast is in progress
+		if(m_eventDispatchTable.use_count() == 1)
+			AddToEventDispatchTable(*ptrComponent);
+		else
+			InvalidateEventDispatchTable();
+	}
 	auto it = m_componentLookupTable.find(componentId);
 	if(it == m_componentLookupTable.end())
 		m_componentLookupTable.insert(std::make_pair(componentId, ptrComponent));
@@ -167,6 +208,8 @@ void BaseEntityComponentSystem::RemoveComponent(pragma::BaseEntityComponent &com
 {
 	if(umath::is_flag_set(component.m_stateFlags, BaseEntityComponent::StateFlags::Removed))
 		return;
+	if(EntityTickScheduler::IsValidatingTickAccess())
+		EntityTickScheduler::ValidateTickAccess(component.GetComponentId(), EntityTickScheduler::AccessType::Structural);
 	if(umath::is_flag_set(component.m_stateFlags, BaseEntityComponent::StateFlags::IsInitializing))
 		throw std::runtime_error {"Attempted to remove component of type " + std::to_string(component.GetComponentId()) + " while it is being initialized. This is not allowed!"};
 	umath::set_flag(component.m_stateFlags, BaseEntityComponent::StateFlags::Removed);
@@ -210,6 +253,7 @@ void BaseEntityComponentSystem::RemoveComponent(pragma::BaseEntityComponent &com
 	// Clear the component. We can't erase it from m_components safely, so we just invalidate it
 	// for now. m_components will get cleaned up at a later date
 	*it = util::TSharedHandle<BaseEntityComponent> {};
+	InvalidateEventDispatchTable();
 	if(!umath::is_flag_set(m_stateFlags, StateFlags::ComponentCleanupRequired)) {
 		if(!umath::is_flag_set(m_stateFlags, StateFlags::IsBeingRemoved)) { // No point for cleanup if we're already being removed
 			umath::set_flag(m_stateFlags, StateFlags::ComponentCleanupRequired, true);
@@ -271,6 +315,8 @@ std::vector<util::TSharedHandle<BaseEntityComponent>> &BaseEntityComponentSystem
 
 pragma::ComponentHandle<BaseEntityComponent> BaseEntityComponentSystem::FindComponent(ComponentId componentId) const
 {
+	if(EntityTickScheduler::IsValidatingTickAccess())
+		EntityTickScheduler::ValidateTickAccess(componentId, EntityTickScheduler::AccessType::Read);
 	auto it = m_componentLookupTable.find(componentId);
 	if(it == m_componentLookupTable.end())
 		return {};
@@ -8,10 +8,14 @@
 #include "stdafx_shared.h"
 #include "pragma/entities/entity_iterator.hpp"
 #include "pragma/entities/entity_component_manager.hpp"
+#include "pragma/entities/entity_spatial_index.hpp"
 
 std::size_t EntityContainer::Size() const { return ents.size(); }
 BaseEntity *EntityContainer::At(std::size_t index) { return ents.at(index); }
 
+std::size_t EntityCandidateContainer::Size() const { return ents.size(); }
+BaseEntity *EntityCandidateContainer::At(std::size_t index) { return ents.at(index); }
+
 std::size_t ComponentContainer::Size() const { return components.size(); }
 BaseEntity *ComponentContainer::At(std::size_t index)
 {
@@ -141,3 +145,38 @@ void EntityIterator::SetBaseComponentType(const std::string &componentName)
 	componentManager.GetComponentTypeId(componentName, componentId);
 	SetBaseComponentType(componentId);
 }
+void EntityIterator::ApplySpatialFilter(const IEntityIteratorSpatialFilter &filter)
+{
+	if(!m_iteratorData)
+		return;
+	// Only the base containers are narrowed down. If another spatial filter has already been applied,
+	// the candidates of this filter will be tested by its ShouldPass instead.
+	auto &container = *m_iteratorData->entities;
+	auto isEntityContainer = (typeid(container) == typeid(EntityContainer));
+	auto isComponentContainer = (typeid(container) == typeid(ComponentContainer));
+	if(!isEntityContainer && !isComponentContainer)
+		return;
+	Vector3 min, max;
+	filter.GetBounds(min, max);
+	std::vector<BaseEntity *> candidates;
+	m_iteratorData->game.GetEntitySpatialIndex().FindCandidates(min, max, candidates);
+	if(isEntityContainer) {
+		m_iteratorData->entities = std::make_unique<EntityCandidateContainer>(std::move(candidates));
+		return;
+	}
+	auto &components = static_cast<ComponentContainer &>(container).components;
+	auto it = std::find_if(components.begin(), components.end(), [](const pragma::BaseEntityComponent *c) { return c != nullptr; });
+	if(it == components.end())
+		return;
+	if(candidates.size() >= container.Count())
+		return; // Iterating the components directly is cheaper
+	auto componentId = (*it)->GetComponentId();
+	std::vector<pragma::BaseEntityComponent *> candidateComponents;
+	candidateComponents.reserve(candidates.size());
+	for(auto *ent : candidates) {
+		auto *c = ent->FindComponent(componentId).get();
+		if(c != nullptr)
+			candidateComponents.push_back(c);
+	}
+	m_iteratorData->entities = std::make_unique<ComponentCandidateContainer>(std::move(candidateComponents));
+}
@@ -196,6 +196,13 @@ bool EntityIteratorFilterSphere::ShouldPass(BaseEntity &ent, std::size_t index)
 	return ShouldPass(ent, index, r, d);
 }
 
+void EntityIteratorFilterSphere::GetBounds(Vector3 &outMin, Vector3 &outMax) const
+{
+	Vector3 extents {m_radius, m_radius, m_radius};
+	outMin = m_origin - extents;
+	outMax = m_origin + extents;
+}
+
 /////////////////
 
 EntityIteratorFilterBox::EntityIteratorFilterBox(Game &game, const Vector3 &min, const Vector3 &max) : m_min(min), m_max(max) {}
@@ -210,9 +217,18 @@ bool EntityIteratorFilterBox::ShouldPass(BaseEntity &ent, std::size_t index)
 	Vector3 entMax {};
 	if(pPhysComponent != nullptr)
 		pPhysComponent->GetCollisionBounds(&entMin, &entMax);
+	auto &pos = pTrComponent->GetPosition();
+	entMin += pos;
+	entMax += pos;
 	return umath::intersection::aabb_aabb(m_min, m_max, entMin, entMax) != umath::intersection::Intersect::Outside;
 }
 
+void EntityIteratorFilterBox::GetBounds(Vector3 &outMin, Vector3 &outMax) const
+{
+	outMin = m_min;
+	outMax = m_max;
+}
+
 /////////////////
 
 EntityIteratorFilterCone::EntityIteratorFilterCone(Game &game, const Vector3 &origin, const Vector3 &dir, float radius, float angle) : EntityIteratorFilterSphere(game, origin, radius), m_direction(dir), m_angle(static_cast<float>(umath::cos(static_cast<float>(umath::deg_to_rad(angle)))))
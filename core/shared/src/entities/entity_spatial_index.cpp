@@ -0,0 +1,219 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan
+ */
+
+#include "stdafx_shared.h"
+#include "pragma/entities/entity_spatial_index.hpp"
+#include "pragma/entities/components/base_physics_component.hpp"
+#include "pragma/entities/components/base_transform_component.hpp"
+#include <pragma/math/intersection.h>
+
+using namespace pragma;
+
+EntitySpatialIndex::EntitySpatialIndex(float cellSize) : m_cellSize {umath::max(cellSize, 1.f)} {}
+
+uint64_t EntitySpatialIndex::GetCellKey(int32_t x, int32_t y, int32_t z)
+{
+	// 21 bits per axis, which is more than enough for any realistic map size
+	constexpr uint64_t mask = (1ull << 21) - 1;
+	return ((static_cast<uint64_t>(x) & mask) << 42) | ((static_cast<uint64_t>(y) & mask) << 21) | (static_cast<uint64_t>(z) & mask);
+}
+
+EntitySpatialIndex::CellCoord EntitySpatialIndex::GetCellCoord(const Vector3 &pos) const
+{
+	return {static_cast<int32_t>(umath::floor(pos.x / m_cellSize)), static_cast<int32_t>(umath::floor(pos.y / m_cellSize)), static_cast<int32_t>(umath::floor(pos.z / m_cellSize))};
+}
+
+void EntitySpatialIndex::MarkDirty(BaseEntity &ent)
+{
+	auto idx = ent.GetIndex();
+	std::scoped_lock lock {m_mutex};
+	if(idx >= m_entities.size())
+		m_entities.resize(idx + 1);
+	auto &record = m_entities[idx];
+	record.entity = &ent;
+	if(record.dirty)
+		return;
+	record.dirty = true;
+	m_dirtyEntities.push_back(idx);
+}
+
+void EntitySpatialIndex::Remove(const BaseEntity &ent)
+{
+	auto idx = ent.GetIndex();
+	std::scoped_lock lock {m_mutex};
+	if(idx >= m_entities.size() || m_entities[idx].entity != &ent)
+		return;
+	auto &record = m_entities[idx];
+	RemoveFromCells(idx, record);
+	// If the entity is still in the dirty list, it will be skipped during the next update
+	record.entity = nullptr;
+}
+
+void EntitySpatialIndex::Clear()
+{
+	std::scoped_lock lock {m_mutex};
+	m_entities.clear();
+	m_dirtyEntities.clear();
+	m_oversizedEntities.clear();
+	m_cells.clear();
+	m_entityCount = 0;
+}
+
+void EntitySpatialIndex::InsertIntoCells(uint32_t entIdx, EntityRecord &record)
+{
+	auto &cMin = record.cellMin;
+	auto &cMax = record.cellMax;
+	auto numCells = static_cast<uint64_t>(cMax[0] - cMin[0] + 1) * static_cast<uint64_t>(cMax[1] - cMin[1] + 1) * static_cast<uint64_t>(cMax[2] - cMin[2] + 1);
+	record.inserted = true;
+	++m_entityCount;
+	if(numCells > MAX_CELLS_PER_ENTITY) {
+		record.oversized = true;
+		m_oversizedEntities.push_back(entIdx);
+		return;
+	}
+	record.oversized = false;
+	for(auto x = cMin[0]; x <= cMax[0]; ++x) {
+		for(auto y = cMin[1]; y <= cMax[1]; ++y) {
+			for(auto z = cMin[2]; z <= cMax[2]; ++z)
+				m_cells[GetCellKey(x, y, z)].push_back(entIdx);
+		}
+	}
+}
+
+void EntitySpatialIndex::RemoveFromCells(uint32_t entIdx, EntityRecord &record)
+{
+	if(record.inserted == false)
+		return;
+	record.inserted = false;
+	--m_entityCount;
+	auto fRemove = [entIdx](std::vector<uint32_t> &indices) {
+		auto it = std::find(indices.begin(), indices.end(), entIdx);
+		if(it == indices.end())
+			return;
+		*it = indices.back();
+		indices.pop_back();
+	};
+	if(record.oversized) {
+		fRemove(m_oversizedEntities);
+		return;
+	}
+	auto &cMin = record.cellMin;
+	auto &cMax = record.cellMax;
+	for(auto x = cMin[0]; x <= cMax[0]; ++x) {
+		for(auto y = cMin[1]; y <= cMax[1]; ++y) {
+			for(auto z = cMin[2]; z <= cMax[2]; ++z) {
+				auto it = m_cells.find(GetCellKey(x, y, z));
+				if(it == m_cells.end())
+					continue;
+				fRemove(it->second);
+				if(it->second.empty())
+					m_cells.erase(it);
+			}
+		}
+	}
+}
+
+void EntitySpatialIndex::UpdateEntity(uint32_t entIdx)
+{
+	auto &record = m_entities[entIdx];
+	record.dirty = false;
+	if(record.entity == nullptr)
+		return;
+	auto &ent = *record.entity;
+	auto pTrComponent = ent.GetTransformComponent();
+	if(!pTrComponent) {
+		RemoveFromCells(entIdx, record);
+		return;
+	}
+	// The bounds have to enclose both the collision sphere and the collision bounds of the entity,
+	// since both are used by the spatial iterator filters
+	auto &pos = pTrComponent->GetPosition();
+	auto min = pos;
+	auto max = pos;
+	auto pPhysComponent = ent.GetPhysicsComponent();
+	if(pPhysComponent) {
+		Vector3 colCenter;
+		auto colRadius = pPhysComponent->GetCollisionRadius(&colCenter);
+		colCenter += pos;
+		Vector3 colMin, colMax;
+		pPhysComponent->GetCollisionBounds(&colMin, &colMax);
+		Vector3 extents {colRadius, colRadius, colRadius};
+		uvec::min(&min, colCenter - extents);
+		uvec::max(&max, colCenter + extents);
+		uvec::min(&min, pos + colMin);
+		uvec::max(&max, pos + colMax);
+	}
+	record.min = min;
+	record.max = max;
+	auto cellMin = GetCellCoord(min);
+	auto cellMax = GetCellCoord(max);
+	if(record.inserted && cellMin == record.cellMin && cellMax == record.cellMax)
+		return; // Entity is still in the same cells
+	RemoveFromCells(entIdx, record);
+	record.cellMin = cellMin;
+	record.cellMax = cellMax;
+	InsertIntoCells(entIdx, record);
+}
+
+void EntitySpatialIndex::Update()
+{
+	for(auto idx : m_dirtyEntities)
+		UpdateEntity(idx);
+	m_dirtyEntities.clear();
+}
+
+void EntitySpatialIndex::FindCandidates(const Vector3 &min, const Vector3 &max, std::vector<BaseEntity *> &outEnts)
+{
+	std::scoped_lock lock {m_mutex};
+	Update();
+
+	std::vector<uint32_t> indices;
+	auto fTest = [this, &min, &max, &indices](uint32_t idx) {
+		auto &record = m_entities[idx];
+		if(umath::intersection::aabb_aabb(min, max, record.min, record.max) != umath::intersection::Intersect::Outside)
+			indices.push_back(idx);
+	};
+	auto cMin = GetCellCoord(min);
+	auto cMax = GetCellCoord(max);
+	auto numCells = static_cast<uint64_t>(cMax[0] - cMin[0] + 1) * static_cast<uint64_t>(cMax[1] - cMin[1] + 1) * static_cast<uint64_t>(cMax[2] - cMin[2] + 1);
+	if(numCells > m_cells.size()) {
+		// Query volume is larger than the populated area, it's cheaper to test all entities directly
+		for(auto i = decltype(m_entities.size()) {0u}; i < m_entities.size(); ++i) {
+			if(m_entities[i].inserted)
+				fTest(i);
+		}
+	}
+	else {
+		for(auto x = cMin[0]; x <= cMax[0]; ++x) {
+			for(auto y = cMin[1]; y <= cMax[1]; ++y) {
+				for(auto z = cMin[2]; z <= cMax[2]; ++z) {
+					auto it = m_cells.find(GetCellKey(x, y, z));
+					if(it == m_cells.end())
+						continue;
+					for(auto idx : it->second)
+						fTest(idx);
+				}
+			}
+		}
+		for(auto idx : m_oversizedEntities)
+			fTest(idx);
+		// Entities that span multiple cells may have been found more than once
+		std::sort(indices.begin(), indices.end());
+		indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+	}
+
+	outEnts.reserve(outEnts.size() + indices.size());
+	for(auto idx : indices)
+		outEnts.push_back(m_entities[idx].entity);
+}
+
+EntitySpatialIndex::Stats EntitySpatialIndex::GetStats()
+{
+	std::scoped_lock lock {m_mutex};
+	Update();
+	return {m_entityCount, static_cast<uint32_t>(m_oversizedEntities.size()), static_cast<uint32_t>(m_cells.size())};
+}
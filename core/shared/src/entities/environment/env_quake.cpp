@@ -80,6 +80,12 @@ util::EventReply BaseEnvQuakeComponent::HandleEvent(ComponentEventId eventId, Co
 		StopShake();
 	return util::EventReply::Unhandled;
 }
+void BaseEnvQuakeComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_ON);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_OFF);
+}
 
 Bool BaseEnvQuakeComponent::IsGlobal() const { return (m_quakeFlags & SF_QUAKE_GLOBAL_SHAKE) != 0; }
 Bool BaseEnvQuakeComponent::InAir() const { return (m_quakeFlags & SF_QUAKE_IN_AIR) != 0; }
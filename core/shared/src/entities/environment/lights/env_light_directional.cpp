@@ -74,6 +74,12 @@ util::EventReply BaseEnvLightDirectionalComponent::HandleEvent(ComponentEventId
 	}
 	return BaseEntityComponent::HandleEvent(eventId, evData);
 }
+void BaseEnvLightDirectionalComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseEnvLightComponent::EVENT_CALC_LIGHT_DIRECTION_TO_POINT);
+	outEventIds.push_back(BaseEnvLightComponent::EVENT_CALC_LIGHT_INTENSITY_AT_POINT);
+}
 
 void BaseEnvLightDirectionalComponent::SetAmbientColor(const Color &color) { *m_ambientColor = color; }
 const Color &BaseEnvLightDirectionalComponent::GetAmbientColor() const { return *m_ambientColor; }
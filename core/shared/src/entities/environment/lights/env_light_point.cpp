@@ -42,6 +42,12 @@ util::EventReply BaseEnvLightPointComponent::HandleEvent(ComponentEventId eventI
 	}
 	return BaseEntityComponent::HandleEvent(eventId, evData);
 }
+void BaseEnvLightPointComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseEnvLightComponent::EVENT_CALC_LIGHT_DIRECTION_TO_POINT);
+	outEventIds.push_back(BaseEnvLightComponent::EVENT_CALC_LIGHT_INTENSITY_AT_POINT);
+}
 float BaseEnvLightPointComponent::CalcDistanceFalloff(const Vector3 &point) const
 {
 	auto *radiusC = dynamic_cast<pragma::BaseRadiusComponent *>(GetEntity().FindComponent("radius").get());
@@ -123,6 +123,12 @@ util::EventReply BaseEnvLightSpotComponent::HandleEvent(ComponentEventId eventId
 	}
 	return BaseEntityComponent::HandleEvent(eventId, evData);
 }
+void BaseEnvLightSpotComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseEnvLightComponent::EVENT_CALC_LIGHT_DIRECTION_TO_POINT);
+	outEventIds.push_back(BaseEnvLightComponent::EVENT_CALC_LIGHT_INTENSITY_AT_POINT);
+}
 
 void BaseEnvLightSpotComponent::Save(udm::LinkedPropertyWrapperArg udm)
 {
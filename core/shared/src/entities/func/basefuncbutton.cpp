@@ -61,6 +61,11 @@ util::EventReply BaseFuncButtonComponent::HandleEvent(ComponentEventId eventId,
 	}
 	return util::EventReply::Unhandled;
 }
+void BaseFuncButtonComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(UsableComponent::EVENT_ON_USE);
+}
 
 void BaseFuncButtonComponent::OnEntitySpawn()
 {
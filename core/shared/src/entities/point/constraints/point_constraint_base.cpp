@@ -65,6 +65,12 @@ util::EventReply BasePointConstraintComponent::HandleEvent(ComponentEventId even
 		OnTurnOff();
 	return util::EventReply::Unhandled;
 }
+void BasePointConstraintComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_ON);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_OFF);
+}
 
 void BasePointConstraintComponent::OnTurnOn()
 {
@@ -120,3 +120,8 @@ util::EventReply BaseTriggerPushComponent::HandleEvent(ComponentEventId eventId,
 	}
 	return util::EventReply::Unhandled;
 }
+void BaseTriggerPushComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseTouchComponent::EVENT_ON_START_TOUCH);
+}
@@ -62,3 +62,8 @@ util::EventReply BaseTriggerTeleportComponent::HandleEvent(ComponentEventId even
 	}
 	return util::EventReply::Unhandled;
 }
+void BaseTriggerTeleportComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseTouchComponent::EVENT_ON_START_TOUCH);
+}
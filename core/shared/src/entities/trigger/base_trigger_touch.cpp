@@ -143,6 +143,12 @@ util::EventReply BaseTouchComponent::HandleEvent(ComponentEventId eventId, Compo
 	}
 	return util::EventReply::Unhandled;
 }
+void BaseTouchComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_OFF);
+	outEventIds.push_back(BaseToggleComponent::EVENT_ON_TURN_ON);
+}
 void BaseTouchComponent::EndAllTouch()
 {
 	while(m_touching.empty() == false) {
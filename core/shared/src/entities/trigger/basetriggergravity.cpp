@@ -91,3 +91,9 @@ util::EventReply BaseEntityTriggerGravityComponent::HandleEvent(ComponentEventId
 	}
 	return util::EventReply::Unhandled;
 }
+void BaseEntityTriggerGravityComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(BaseTouchComponent::EVENT_ON_START_TOUCH);
+	outEventIds.push_back(BaseTouchComponent::EVENT_ON_END_TOUCH);
+}
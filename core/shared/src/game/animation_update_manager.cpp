@@ -11,10 +11,12 @@
 #include "pragma/entities/components/animation_driver_component.hpp"
 #include "pragma/entities/components/panima_component.hpp"
 #include "pragma/entities/components/constraints/constraint_manager_component.hpp"
+#include "pragma/entities/components/constraints/constraint_component.hpp"
 #include "pragma/entities/entity_iterator.hpp"
 #include "pragma/entities/entity_component_system_t.hpp"
 #include "pragma/console/cvar.h"
 #include "pragma/debug/intel_vtune.hpp"
+#include <numeric>
 
 pragma::AnimationUpdateManager::AnimationUpdateManager(Game &game) : game {game}
 {
@@ -23,6 +25,7 @@ pragma::AnimationUpdateManager::AnimationUpdateManager(Game &game) : game {game}
 	r = r && componentManager.GetComponentTypeId("panima", m_panimaComponentId);
 	r = r && componentManager.GetComponentTypeId("animation_driver", m_animationDriverComponentId);
 	r = r && componentManager.GetComponentTypeId("constraint_manager", m_constraintManagerComponentId);
+	r = r && componentManager.GetComponentTypeId("constraint", m_constraintComponentId);
 	assert(r);
 	if(!r) {
 		Con::crit << "Unable to determine animated component ids!" << Con::endl;
@@ -61,7 +64,210 @@ void pragma::AnimationUpdateManager::UpdateEntityAnimationDrivers(double dt)
 }
 void pragma::AnimationUpdateManager::UpdateConstraints(double dt) { pragma::ConstraintManagerComponent::ApplyConstraints(*game.GetNetworkState()); }
 
+
+// Returns true if the component has listeners for events that are invoked during the skeletal animation update,
+// but aren't flagged as multi-thread safe (i.e. Lua callbacks or C++ callbacks that may access other entities).
+static bool has_main_thread_animation_listeners(const pragma::BaseAnimatedComponent &animC)
+{
+	return animC.HasThreadUnsafeEventCallbacks(pragma::BaseAnimatedComponent::EVENT_SHOULD_UPDATE_BONES) || animC.HasThreadUnsafeEventCallbacks(pragma::BaseAnimatedComponent::EVENT_ON_BONE_TRANSFORM_CHANGED);
+}
+
+// Only set on worker threads during the parallel skeletal animation update
+static thread_local std::vector<std::function<void()>> *g_mainThreadTasks = nullptr;
+void pragma::AnimationUpdateManager::RunOnMainThread(const std::function<void()> &f)
+{
+	if(g_mainThreadTasks) {
+		g_mainThreadTasks->push_back(f);
+		return;
+	}
+	f();
+}
+
+void pragma::AnimationUpdateManager::BuildSkeletalAnimationGroups()
+{
+	auto &queue = m_skeletalUpdateQueue;
+	auto n = queue.size();
+	std::unordered_map<const BaseEntity *, size_t> entityToIndex;
+	entityToIndex.reserve(n);
+	for(auto i = decltype(n) {0u}; i < n; ++i)
+		entityToIndex[&queue[i]->GetEntity()] = i;
+	auto findIndex = [&entityToIndex](const BaseEntity *ent) -> std::optional<size_t> {
+		auto it = entityToIndex.find(ent);
+		return (it != entityToIndex.end()) ? it->second : std::optional<size_t> {};
+	};
+
+	// Collect the dependencies between the queued entities as (dependency, dependent) pairs
+	std::vector<std::pair<size_t, size_t>> dependencies;
+	for(auto i = decltype(n) {0u}; i < n; ++i) {
+		// Attachments are parented to their target entity as well, so walking up the parent chain covers both cases.
+		// Non-animated entities in-between are skipped.
+		for(auto *parent = queue[i]->GetEntity().GetParent(); parent != nullptr; parent = parent->GetParent()) {
+			auto idx = findIndex(parent);
+			if(!idx)
+				continue;
+			dependencies.push_back({*idx, i});
+			break;
+		}
+	}
+	for(auto *ent : EntityIterator {game, m_constraintComponentId}) {
+		auto constraintC = ent->GetComponent<ConstraintComponent>();
+		auto &participants = constraintC->GetConstraintParticipants();
+		if(!participants || participants->driverC.expired() || participants->drivenObjectC.expired())
+			continue;
+		auto driverIdx = findIndex(&participants->driverC->GetEntity());
+		auto drivenIdx = findIndex(&participants->drivenObjectC->GetEntity());
+		if(driverIdx && drivenIdx && *driverIdx != *drivenIdx)
+			dependencies.push_back({*driverIdx, *drivenIdx});
+	}
+
+	// Merge dependent entities into the same group
+	std::vector<size_t> roots(n);
+	std::iota(roots.begin(), roots.end(), 0);
+	auto findRoot = [&roots](size_t i) {
+		while(roots[i] != i) {
+			roots[i] = roots[roots[i]];
+			i = roots[i];
+		}
+		return i;
+	};
+	for(auto &[dependency, dependent] : dependencies)
+		roots[findRoot(dependent)] = findRoot(dependency);
+
+	// Sort topologically, so that parents and constraint drivers are evaluated before their dependents
+	std::sort(dependencies.begin(), dependencies.end());
+	std::vector<size_t> edgeOffsets(n + 1, 0);
+	std::vector<uint32_t> inDegree(n, 0);
+	for(auto &[dependency, dependent] : dependencies) {
+		++edgeOffsets[dependency + 1];
+		++inDegree[dependent];
+	}
+	for(auto i = decltype(n) {0u}; i < n; ++i)
+		edgeOffsets[i + 1] += edgeOffsets[i];
+	std::vector<size_t> order;
+	order.reserve(n);
+	for(auto i = decltype(n) {0u}; i < n; ++i) {
+		if(inDegree[i] == 0)
+			order.push_back(i);
+	}
+	for(auto i = decltype(order.size()) {0u}; i < order.size(); ++i) {
+		auto idx = order[i];
+		for(auto j = edgeOffsets[idx]; j < edgeOffsets[idx + 1]; ++j) {
+			auto dependent = dependencies[j].second;
+			if(--inDegree[dependent] == 0)
+				order.push_back(dependent);
+		}
+	}
+	if(order.size() < n) {
+		// Circular dependency; The remaining entities are evaluated in their original order
+		for(auto i = decltype(n) {0u}; i < n; ++i) {
+			if(inDegree[i] > 0)
+				order.push_back(i);
+		}
+	}
+
+	// Assign the entities to their groups, preserving the topological order within each group
+	constexpr auto invalidGroup = std::numeric_limits<size_t>::max();
+	std::vector<size_t> rootToGroup(n, invalidGroup);
+	std::vector<size_t> entityGroups(n);
+	m_skeletalAnimationGroups.clear();
+	for(auto idx : order) {
+		auto &groupIdx = rootToGroup[findRoot(idx)];
+		if(groupIdx == invalidGroup) {
+			groupIdx = m_skeletalAnimationGroups.size();
+			m_skeletalAnimationGroups.push_back({});
+		}
+		auto &group = m_skeletalAnimationGroups[groupIdx];
+		++group.count;
+		if(!group.requiresMainThread && has_main_thread_animation_listeners(*queue[idx]))
+			group.requiresMainThread = true;
+		entityGroups[idx] = groupIdx;
+	}
+	uint32_t offset = 0;
+	for(auto &group : m_skeletalAnimationGroups) {
+		group.offset = offset;
+		offset += group.count;
+		group.count = 0;
+	}
+	m_skeletalUpdateOrder.resize(n);
+	m_skeletalUpdateIndices.clear();
+	m_skeletalUpdateIndices.reserve(n);
+	for(auto idx : order) {
+		auto &group = m_skeletalAnimationGroups[entityGroups[idx]];
+		auto pos = group.offset + group.count++;
+		m_skeletalUpdateOrder[pos] = queue[idx];
+		m_skeletalUpdateIndices[queue[idx]] = {static_cast<uint32_t>(entityGroups[idx]), pos};
+	}
+	m_mainThreadGroupProgress.clear();
+	m_mainThreadGroupProgress.resize(m_skeletalAnimationGroups.size(), 0);
+}
+
+void pragma::AnimationUpdateManager::UpdateSkeletalAnimationsParallel(double dt)
+{
+	m_skeletalUpdateQueue.clear();
+	m_skeletalUpdateIndices.clear();
+	m_mainThreadGroupProgress.clear();
+	for(auto &entInfo : m_animatedEntities) {
+		if(entInfo.animatedC && entInfo.animatedC->PreMaintainAnimations(dt))
+			m_skeletalUpdateQueue.push_back(entInfo.animatedC);
+	}
+	if(m_skeletalUpdateQueue.empty())
+		return;
+	BuildSkeletalAnimationGroups();
+
+	std::vector<const SkeletalAnimationGroup *> parallelGroups;
+	parallelGroups.reserve(m_skeletalAnimationGroups.size());
+	for(auto &group : m_skeletalAnimationGroups) {
+		if(!group.requiresMainThread)
+			parallelGroups.push_back(&group);
+	}
+	auto updateGroup = [this, dt](const SkeletalAnimationGroup &group) {
+		for(auto i = group.offset; i < group.offset + group.count; ++i)
+			m_skeletalUpdateOrder[i]->UpdateAnimations(dt);
+	};
+	if(parallelGroups.size() > 1) {
+		// Animation events are queued by the components and dispatched on the main thread in HandleAnimationEvents.
+		// Work that thread-safe listeners defer through RunOnMainThread is executed afterwards in group order.
+		std::vector<std::vector<std::function<void()>>> mainThreadTasks(parallelGroups.size());
+		m_channelQueueProcessor.GetThreadPool()
+		  .submit_blocks<size_t>(0, parallelGroups.size(),
+		    [&parallelGroups, &updateGroup, &mainThreadTasks](size_t start, size_t indexAfterLast) {
+			    for(auto i = start; i < indexAfterLast; ++i) {
+				    g_mainThreadTasks = &mainThreadTasks[i];
+				    updateGroup(*parallelGroups[i]);
+				    g_mainThreadTasks = nullptr;
+			    }
+		    })
+		  .wait();
+		for(auto &tasks : mainThreadTasks) {
+			for(auto &task : tasks)
+				task();
+		}
+	}
+	else {
+		for(auto *group : parallelGroups)
+			updateGroup(*group);
+	}
+	// Groups with listeners that aren't thread-safe are updated on the main thread in UpdateMainThreadSkeletalAnimations,
+	// interleaved with the panima updates in entity order
+}
+
+void pragma::AnimationUpdateManager::UpdateMainThreadSkeletalAnimations(BaseAnimatedComponent &animC, double dt)
+{
+	auto it = m_skeletalUpdateIndices.find(&animC);
+	if(it == m_skeletalUpdateIndices.end())
+		return;
+	auto [groupIdx, pos] = it->second;
+	auto &group = m_skeletalAnimationGroups[groupIdx];
+	if(!group.requiresMainThread)
+		return;
+	// Members of the group that the component depends on have to be updated first
+	auto &progress = m_mainThreadGroupProgress[groupIdx];
+	while(group.offset + progress <= pos)
+		m_skeletalUpdateOrder[group.offset + progress++]->UpdateAnimations(dt);
+}
+
 static auto cvDisableAnimUpdates = GetConVar("debug_disable_animation_updates");
+static auto cvParallelAnimUpdates = GetConVar("sh_parallel_animation_updates");
 void pragma::AnimationUpdateManager::UpdateAnimations(double dt)
 {
 	m_channelQueueProcessor.Reset();
@@ -70,11 +276,23 @@ void pragma::AnimationUpdateManager::UpdateAnimations(double dt)
 		return;
 	auto t = std::chrono::steady_clock::now();
 	game.StartProfilingStage("UpdateAnimations");
+	auto parallel = cvParallelAnimUpdates->GetBool();
+	if(parallel) {
+		game.StartProfilingStage("UpdateSkeletalAnimation");
+		UpdateSkeletalAnimationsParallel(dt);
+		game.StopProfilingStage();
+	}
 	for(auto &entInfo : m_animatedEntities) {
 		game.StartProfilingStage("UpdateSkeletalAnimation");
-		auto maintainAnimations = entInfo.animatedC ? entInfo.animatedC->PreMaintainAnimations(dt) : false;
-		if(maintainAnimations)
-			entInfo.animatedC->UpdateAnimations(dt);
+		if(parallel) {
+			if(entInfo.animatedC)
+				UpdateMainThreadSkeletalAnimations(*entInfo.animatedC, dt);
+		}
+		else {
+			auto maintainAnimations = entInfo.animatedC ? entInfo.animatedC->PreMaintainAnimations(dt) : false;
+			if(maintainAnimations)
+				entInfo.animatedC->UpdateAnimations(dt);
+		}
 		game.StopProfilingStage();
 
 		if(entInfo.panimaC) {
@@ -0,0 +1,367 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#include "stdafx_shared.h"
+#include "pragma/game/entity_tick_scheduler.hpp"
+#include "pragma/game/game.h"
+#include "pragma/entities/components/base_entity_component.hpp"
+#include "pragma/entities/entity_component_manager.hpp"
+#include "pragma/console/cvar.h"
+#include "pragma/logging.hpp"
+#include <sharedutils/BS_thread_pool.hpp>
+#include <algorithm>
+
+using namespace pragma;
+
+std::atomic<bool> EntityTickScheduler::s_validateTickAccess = false;
+// Component type that is being ticked by the calling thread in a parallel phase
+static thread_local EntityTickScheduler *g_tickAccessScheduler = nullptr;
+static thread_local ComponentId g_tickAccessComponentId = std::numeric_limits<ComponentId>::max();
+
+EntityTickScheduler::EntityTickScheduler(Game &game) : m_game {game} {}
+EntityTickScheduler::~EntityTickScheduler() {}
+
+EntityTickScheduler::Bucket &EntityTickScheduler::GetBucket(ComponentId componentId)
+{
+	if(componentId >= m_buckets.size())
+		m_buckets.resize(componentId + 1);
+	auto &bucket = m_buckets[componentId];
+	if(bucket == nullptr) {
+		bucket = std::make_unique<Bucket>();
+		bucket->componentId = componentId;
+	}
+	return *bucket;
+}
+
+void EntityTickScheduler::Add(BaseEntityComponent &component)
+{
+	auto &tickData = component.m_tickData;
+	if(tickData.tickSlot != INVALID_SLOT)
+		return;
+	auto &bucket = GetBucket(component.GetComponentId());
+	tickData.tickSlot = bucket.components.size();
+	tickData.tickPhase = bucket.nextTickPhase++;
+	tickData.lastTickIndex = m_tickIndex;
+	bucket.components.push_back(&component);
+	++m_componentCount;
+}
+
+void EntityTickScheduler::Remove(BaseEntityComponent &component)
+{
+	auto &tickData = component.m_tickData;
+	auto slot = tickData.tickSlot;
+	if(slot == INVALID_SLOT)
+		return;
+	tickData.tickSlot = INVALID_SLOT;
+	tickData.lastTickDelta = 0.0;
+	--m_componentCount;
+	auto &bucket = *m_buckets[component.GetComponentId()];
+	if(m_ticking) {
+		// Moving components around would invalidate the tick loop, the slot will be reclaimed once the tick is complete
+		bucket.components[slot] = nullptr;
+		++bucket.numTombstones;
+		return;
+	}
+	auto *last = bucket.components.back();
+	bucket.components[slot] = last;
+	last->m_tickData.tickSlot = slot;
+	bucket.components.pop_back();
+}
+
+void EntityTickScheduler::SetTickInterval(ComponentId componentId, uint32_t interval) { GetBucket(componentId).tickInterval = umath::max(interval, static_cast<uint32_t>(1)); }
+uint32_t EntityTickScheduler::GetTickInterval(ComponentId componentId) const
+{
+	if(componentId >= m_buckets.size() || m_buckets[componentId] == nullptr)
+		return 1;
+	return m_buckets[componentId]->tickInterval;
+}
+
+void EntityTickScheduler::SetTickAccess(ComponentId componentId, const TickAccess &access)
+{
+	GetBucket(componentId).access = std::make_unique<TickAccess>(access);
+	m_parallelBatchesDirty = true;
+}
+void EntityTickScheduler::ClearTickAccess(ComponentId componentId)
+{
+	if(componentId >= m_buckets.size() || m_buckets[componentId] == nullptr)
+		return;
+	m_buckets[componentId]->access = nullptr;
+	m_parallelBatchesDirty = true;
+}
+const EntityTickScheduler::TickAccess *EntityTickScheduler::GetTickAccess(ComponentId componentId) const
+{
+	if(componentId >= m_buckets.size() || m_buckets[componentId] == nullptr)
+		return nullptr;
+	return m_buckets[componentId]->access.get();
+}
+
+bool EntityTickScheduler::IsDue(const Bucket &bucket, const BaseEntityComponent &component, double tCur) const
+{
+	auto &tickData = component.m_tickData;
+	auto interval = (tickData.tickInterval > 0) ? tickData.tickInterval : bucket.tickInterval;
+	if(interval > 1 && (m_tickIndex + tickData.tickPhase) % interval != 0)
+		return false;
+	return tCur >= tickData.nextTick;
+}
+
+double EntityTickScheduler::ConsumeTickDelta(BaseEntityComponent &component, double dt) const
+{
+	// Components with an interval may have been added fewer than 'interval' ticks ago, or may have skipped ticks due to their next tick time
+	auto &tickData = component.m_tickData;
+	auto numTicks = umath::max(m_tickIndex - tickData.lastTickIndex, static_cast<uint64_t>(1));
+	tickData.lastTickIndex = m_tickIndex;
+	return dt * numTicks;
+}
+
+void EntityTickScheduler::TickBucket(Bucket &bucket, double tCur, double dt)
+{
+	auto shouldProfile = (m_game.GetProfilingStageManager() != nullptr);
+	auto isProfiling = false;
+	// Note: Components may be added to the bucket during the loop, so the vector may be re-allocated
+	for(size_t i = 0; i < bucket.components.size(); ++i) {
+		auto *c = bucket.components[i];
+		if(c == nullptr)
+			continue;
+		if(IsDue(bucket, *c, tCur) == false)
+			continue;
+		if(shouldProfile && !isProfiling) {
+			auto *cInfo = m_game.GetEntityComponentManager().GetComponentInfo(bucket.componentId);
+			m_game.StartProfilingStage(cInfo ? cInfo->name.str : "Unknown");
+			isProfiling = true;
+		}
+		if(c->Tick(ConsumeTickDelta(*c, dt)) == false)
+			Remove(*c);
+	}
+	if(isProfiling)
+		m_game.StopProfilingStage();
+}
+
+static bool contains(const std::vector<ComponentId> &ids, ComponentId id) { return std::find(ids.begin(), ids.end(), id) != ids.end(); }
+bool EntityTickScheduler::IsConflicting(const Bucket &a, const Bucket &b) const
+{
+	auto writes = [](const Bucket &bucket, ComponentId id) { return id == bucket.componentId || contains(bucket.access->write, id); };
+	auto accesses = [&writes](const Bucket &bucket, ComponentId id) { return writes(bucket, id) || contains(bucket.access->read, id); };
+	auto writesAccessedType = [&writes, &accesses](const Bucket &writer, const Bucket &other) {
+		if(accesses(other, writer.componentId))
+			return true;
+		return std::any_of(writer.access->write.begin(), writer.access->write.end(), [&other, &accesses](ComponentId id) { return accesses(other, id); });
+	};
+	return writesAccessedType(a, b) || writesAccessedType(b, a);
+}
+
+void EntityTickScheduler::UpdateParallelBatches()
+{
+	m_parallelBatches.clear();
+	m_parallelBatchesDirty = false;
+	auto &componentManager = m_game.GetEntityComponentManager();
+	std::vector<Bucket *> candidates;
+	for(auto &bucket : m_buckets) {
+		if(bucket == nullptr)
+			continue;
+		bucket->parallel = false;
+		if(bucket->access == nullptr)
+			continue;
+		auto *cInfo = componentManager.GetComponentInfo(bucket->componentId);
+		if(cInfo == nullptr || umath::is_flag_set(cInfo->flags, ComponentFlags::LuaBased))
+			continue;
+		candidates.push_back(bucket.get());
+	}
+	// Phases are ticked in ascending order, component types within the same phase in the order of their ids
+	std::stable_sort(candidates.begin(), candidates.end(), [](const Bucket *a, const Bucket *b) { return a->access->phase < b->access->phase; });
+	size_t phaseStart = 0;
+	for(auto i = decltype(candidates.size()) {0u}; i < candidates.size(); ++i) {
+		auto *bucket = candidates[i];
+		if(i > 0 && bucket->access->phase != candidates[i - 1]->access->phase)
+			phaseStart = m_parallelBatches.size();
+		// The bucket has to be ticked after all previous buckets of the same phase it conflicts with
+		auto batchIdx = phaseStart;
+		for(auto j = m_parallelBatches.size(); j > phaseStart; --j) {
+			auto &batch = m_parallelBatches[j - 1];
+			if(std::any_of(batch.begin(), batch.end(), [this, bucket](const Bucket *other) { return IsConflicting(*bucket, *other); })) {
+				batchIdx = j;
+				break;
+			}
+		}
+		if(batchIdx == m_parallelBatches.size())
+			m_parallelBatches.push_back({});
+		m_parallelBatches[batchIdx].push_back(bucket);
+		bucket->parallel = true;
+	}
+}
+
+static auto cvParallelTicks = GetConVar("sh_parallel_component_ticks");
+static auto cvValidateTickAccess = GetConVar("debug_validate_component_tick_access");
+void EntityTickScheduler::TickParallelPhases(double tCur, double dt)
+{
+	if(m_parallelBatchesDirty)
+		UpdateParallelBatches();
+	if(m_parallelBatches.empty())
+		return;
+	if(m_threadPool == nullptr)
+		m_threadPool = std::make_unique<BS::thread_pool>();
+	auto validate = cvValidateTickAccess->GetBool();
+	struct Task {
+		Bucket *bucket;
+		size_t start;
+		size_t indexAfterLast;
+		// Components which have to be removed from the scheduler once the batch is complete
+		std::vector<BaseEntityComponent *> expired;
+	};
+	std::vector<Task> tasks;
+	for(auto &batch : m_parallelBatches) {
+		tasks.clear();
+		for(auto *bucket : batch) {
+			auto n = bucket->components.size();
+			for(size_t i = 0; i < n; i += PARALLEL_TICK_BATCH_SIZE)
+				tasks.push_back({bucket, i, umath::min(i + PARALLEL_TICK_BATCH_SIZE, n)});
+		}
+		if(tasks.empty())
+			continue;
+		// Broadcasting an event builds the event dispatch table of the entity if it has been invalidated, which must not happen
+		// concurrently for two components of the same entity
+		for(auto *bucket : batch) {
+			for(auto *c : bucket->components) {
+				if(c != nullptr)
+					c->GetEntity().UpdateEventDispatchTable();
+			}
+		}
+		s_validateTickAccess = validate;
+		m_parallelPhaseActive = true;
+		m_threadPool
+		  ->submit_blocks<size_t>(0, tasks.size(),
+		    [this, &tasks, tCur, dt, validate](size_t start, size_t indexAfterLast) {
+			    for(auto i = start; i < indexAfterLast; ++i) {
+				    auto &task = tasks[i];
+				    if(validate) {
+					    g_tickAccessScheduler = this;
+					    g_tickAccessComponentId = task.bucket->componentId;
+				    }
+				    for(auto j = task.start; j < task.indexAfterLast; ++j) {
+					    auto *c = task.bucket->components[j];
+					    if(c == nullptr)
+						    continue;
+					    if(IsDue(*task.bucket, *c, tCur) == false)
+						    continue;
+					    if(c->Tick(ConsumeTickDelta(*c, dt)) == false)
+						    task.expired.push_back(c);
+				    }
+				    g_tickAccessScheduler = nullptr;
+			    }
+		    })
+		  .wait();
+		s_validateTickAccess = false;
+		m_parallelPhaseActive = false;
+		for(auto &task : tasks) {
+			for(auto *c : task.expired)
+				Remove(*c);
+		}
+		for(auto &hComponent : m_deferredTickPolicyUpdates) {
+			if(hComponent.valid())
+				hComponent->UpdateTickPolicy();
+		}
+		m_deferredTickPolicyUpdates.clear();
+	}
+}
+
+bool EntityTickScheduler::DeferTickPolicyUpdate(BaseEntityComponent &component)
+{
+	if(!m_parallelPhaseActive)
+		return false;
+	std::scoped_lock lock {m_deferredTickPolicyUpdateMutex};
+	m_deferredTickPolicyUpdates.push_back(component.GetHandle());
+	return true;
+}
+
+void EntityTickScheduler::ValidateTickAccess(ComponentId componentId, AccessType type)
+{
+	auto *scheduler = g_tickAccessScheduler;
+	if(scheduler == nullptr)
+		return;
+	auto &bucket = *scheduler->m_buckets[g_tickAccessComponentId];
+	auto &access = *bucket.access;
+	switch(type) {
+	case AccessType::Read:
+		if(componentId == bucket.componentId || contains(access.read, componentId) || contains(access.write, componentId))
+			return;
+		break;
+	case AccessType::Write:
+		if(componentId == bucket.componentId || contains(access.write, componentId))
+			return;
+		break;
+	case AccessType::Structural:
+		break;
+	}
+	scheduler->ReportTickAccessViolation(bucket, componentId, type);
+}
+
+void EntityTickScheduler::ReportTickAccessViolation(const Bucket &bucket, ComponentId componentId, AccessType type)
+{
+	{
+		std::scoped_lock lock {m_reportedViolationMutex};
+		if(m_reportedViolations.insert({bucket.componentId, componentId, type}).second == false)
+			return;
+	}
+	auto &componentManager = m_game.GetEntityComponentManager();
+	auto getName = [&componentManager](ComponentId id) -> std::string {
+		if(id == INVALID_COMPONENT_ID)
+			return "unknown";
+		auto *cInfo = componentManager.GetComponentInfo(id);
+		return cInfo ? std::string {cInfo->name.str} : std::to_string(id);
+	};
+	switch(type) {
+	case AccessType::Read:
+		spdlog::error("Component type '{}' has accessed undeclared component type '{}' during a parallel tick!", getName(bucket.componentId), getName(componentId));
+		break;
+	case AccessType::Write:
+		spdlog::error("Component type '{}' has written to undeclared component type '{}' during a parallel tick!", getName(bucket.componentId), getName(componentId));
+		break;
+	case AccessType::Structural:
+		spdlog::error("Component type '{}' has added or removed a component, broadcast an event or changed the active state of a component (type '{}') during a parallel tick, which is not allowed!", getName(bucket.componentId), getName(componentId));
+		break;
+	}
+}
+
+void EntityTickScheduler::Compact(Bucket &bucket)
+{
+	auto &components = bucket.components;
+	size_t n = 0;
+	for(auto *c : components) {
+		if(c == nullptr)
+			continue;
+		c->m_tickData.tickSlot = n;
+		components[n++] = c;
+	}
+	components.resize(n);
+	bucket.numTombstones = 0;
+}
+
+void EntityTickScheduler::Tick(double tCur, double dt)
+{
+	m_ticking = true;
+	auto parallel = cvParallelTicks->GetBool();
+	if(parallel) {
+		m_game.StartProfilingStage("ParallelComponentTicks");
+		TickParallelPhases(tCur, dt);
+		m_game.StopProfilingStage();
+	}
+	// Note: New buckets may be created during the loop
+	for(size_t i = 0; i < m_buckets.size(); ++i) {
+		auto *bucket = m_buckets[i].get();
+		if(bucket == nullptr || bucket->components.empty() || (parallel && bucket->parallel))
+			continue;
+		TickBucket(*bucket, tCur, dt);
+	}
+	m_ticking = false;
+
+	for(auto &bucket : m_buckets) {
+		if(bucket && bucket->numTombstones > 0)
+			Compact(*bucket);
+	}
+	++m_tickIndex;
+}
+
+uint64_t EntityTickScheduler::GetTickIndex() const { return m_tickIndex; }
+size_t EntityTickScheduler::GetComponentCount() const { return m_componentCount; }
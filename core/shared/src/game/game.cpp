@@ -53,6 +53,8 @@
 #include "pragma/lua/class_manager.hpp"
 #include "pragma/util/util_bsp_tree.hpp"
 #include "pragma/entities/entity_iterator.hpp"
+#include "pragma/entities/entity_spatial_index.hpp"
+#include "pragma/game/entity_tick_scheduler.hpp"
 #include "pragma/asset_types/world.hpp"
 #include "pragma/model/model.h"
 #include "pragma/model/modelmanager.h"
@@ -201,6 +203,8 @@ Game::Game(NetworkState *state)
 	m_luaNetMessageIndex.push_back("invalid");
 	m_luaEnts = std::make_unique<LuaEntityManager>();
 	m_ammoTypes = std::make_unique<AmmoTypeManager>();
+	m_entitySpatialIndex = std::make_unique<pragma::EntitySpatialIndex>();
+	m_entityTickScheduler = std::make_unique<pragma::EntityTickScheduler>(*this);
 
 	RegisterCallback<void>("Tick");
 	RegisterCallback<void>("Think");
@@ -324,6 +328,8 @@ unsigned char Game::GetPlayerCount() { return m_numPlayers; }
 LuaEntityManager &Game::GetLuaEntityManager() { return *m_luaEnts.get(); }
 
 pragma::AnimationUpdateManager &Game::GetAnimationUpdateManager() { return *m_animUpdateManager; }
+pragma::EntitySpatialIndex &Game::GetEntitySpatialIndex() { return *m_entitySpatialIndex; }
+pragma::EntityTickScheduler &Game::GetEntityTickScheduler() { return *m_entityTickScheduler; }
 
 const GameModeInfo *Game::GetGameMode() const { return const_cast<Game *>(this)->GetGameMode(); }
 GameModeInfo *Game::GetGameMode() { return m_gameMode; }
@@ -695,38 +701,16 @@ void Game::Tick()
 		m_entsScheduledForRemoval.pop();
 	}
 
+	// Navigation mesh tiles that have been rebuilt in the background since the last tick
+	if(m_navMesh != nullptr)
+		m_navMesh->UpdateTileRebuilds(*this);
+
 	StartProfilingStage("GameObjectLogic");
 
 	// Perform some cleanup
 	pragma::BaseEntityComponentSystem::Cleanup();
 
-	auto &logicComponents = GetEntityTickComponents();
-	// Note: During the loop, new items may be appended to the end of logicComponents, but no elements
-	// may be erased from outside sources. If an element is removed, it's set to nullptr.
-	auto shouldProfile = (m_profilingStageManager != nullptr);
-	for(auto i = decltype(logicComponents.size()) {0u}; i < logicComponents.size();) {
-		auto *c = logicComponents[i];
-		if(c == nullptr) {
-			logicComponents.erase(logicComponents.begin() + i);
-			continue;
-		}
-		if(m_tCur < c->GetNextTick()) {
-			++i;
-			continue;
-		}
-		if(shouldProfile) {
-			auto *cInfo = c->GetComponentInfo();
-			StartProfilingStage(cInfo->name.str);
-		}
-		auto res = c->Tick(m_tDeltaTick);
-		if(shouldProfile)
-			StopProfilingStage();
-		if(res == false) {
-			logicComponents.erase(logicComponents.begin() + i);
-			continue;
-		}
-		++i;
-	}
+	m_entityTickScheduler->Tick(m_tCur, m_tDeltaTick);
 
 	StopProfilingStage(); // GameObjectLogic
 
@@ -800,6 +800,8 @@ void pragma::lua::register_entity_component_classes(lua_State *l, luabind::modul
 	entityComponentDef.def("GetTickPolicy", &pragma::BaseEntityComponent::GetTickPolicy);
 	entityComponentDef.def("GetNextTick", &pragma::BaseEntityComponent::GetNextTick);
 	entityComponentDef.def("SetNextTick", &pragma::BaseEntityComponent::SetNextTick);
+	entityComponentDef.def("SetTickInterval", &pragma::BaseEntityComponent::SetTickInterval);
+	entityComponentDef.def("GetTickInterval", &pragma::BaseEntityComponent::GetTickInterval);
 	entityComponentDef.def("SetActive", &pragma::BaseEntityComponent::SetActive);
 	entityComponentDef.def("IsActive", &pragma::BaseEntityComponent::IsActive);
 	entityComponentDef.def("Activate", &pragma::BaseEntityComponent::Activate);
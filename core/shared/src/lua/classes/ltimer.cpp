@@ -138,6 +138,9 @@ bool Timer::IsRunning() { return m_bRunning; }
 
 bool Timer::IsPaused() { return (!m_bRunning && m_next != 0.f) ? true : false; }
 
+void Timer::SetPersistent(bool persistent) { m_bPersistent = persistent; }
+bool Timer::IsPersistent() const { return m_bPersistent; }
+
 std::shared_ptr<TimerHandle> Timer::CreateHandle()
 {
 	std::shared_ptr<TimerHandle> pTimer(new TimerHandle(this));
@@ -204,7 +207,7 @@ Timer *Game::CreateTimer(float delay, int reps, const CallbackHandle &hCallback,
 
 void Game::ClearTimers() { m_timers.clear(); }
 
-void Game::UpdateTimers()
+void Game::UpdateTimers(bool persistentOnly)
 {
 	for(auto i = decltype(m_timers.size()) {0u}; i < m_timers.size(); ++i) {
 		auto &timer = *m_timers.at(i);
@@ -212,6 +215,8 @@ void Game::UpdateTimers()
 			m_timers.erase(m_timers.begin() + i);
 			continue;
 		}
+		if(persistentOnly && timer.IsPersistent() == false)
+			continue;
 		timer.Update(this);
 	}
 }
@@ -288,6 +293,18 @@ DLLNETWORK void Lua_Timer_IsPaused(lua_State *l, TimerHandle &timer)
 	lua_pushboolean(l, timer.GetTimer()->IsPaused());
 }
 
+DLLNETWORK void Lua_Timer_SetPersistent(lua_State *l, TimerHandle &timer, bool persistent)
+{
+	lua_checktimer(l, timer);
+	timer.GetTimer()->SetPersistent(persistent);
+}
+
+DLLNETWORK void Lua_Timer_IsPersistent(lua_State *l, TimerHandle &timer)
+{
+	lua_checktimer(l, timer);
+	lua_pushboolean(l, timer.GetTimer()->IsPersistent());
+}
+
 DLLNETWORK void Lua_Timer_Call(lua_State *l, TimerHandle &timer)
 {
 	NetworkState *state = engine->GetNetworkState(l);
@@ -10,23 +10,27 @@
 #include "pragma/lua/classes/thread_pool.hpp"
 
 pragma::lua::LuaThreadPool::LuaThreadPool(lua_State *l, uint32_t threadCount) : LuaThreadPool {l, threadCount, ""} {}
-pragma::lua::LuaThreadPool::LuaThreadPool(lua_State *l, uint32_t threadCount, const std::string &name) : m_luaState {l}, ThreadPool {threadCount, name, "lua"} {}
+pragma::lua::LuaThreadPool::LuaThreadPool(lua_State *l, uint32_t threadCount, const std::string &name, Backend backend) : m_luaState {l}, ThreadPool {threadCount, name, "lua", backend} {}
 
-uint32_t pragma::lua::LuaThreadPool::AddTask(const std::function<ResultHandler()> &task)
+uint32_t pragma::lua::LuaThreadPool::AddTask(const std::function<ResultHandler()> &task, TaskPriority priority)
 {
-	return ThreadPool::AddTask([this, task]() -> ThreadPool::ResultHandler {
-		auto resHandler = task();
-		return [this, resHandler]() { return resHandler(m_luaState); };
-	});
+	return ThreadPool::AddTask(
+	  [this, task]() -> ThreadPool::ResultHandler {
+		  auto resHandler = task();
+		  return [this, resHandler]() { return resHandler(m_luaState); };
+	  },
+	  priority);
 }
 
-uint32_t pragma::lua::LuaThreadPool::AddTask(const std::shared_ptr<LuaThreadTask> &task)
+uint32_t pragma::lua::LuaThreadPool::AddTask(const std::shared_ptr<LuaThreadTask> &task, TaskPriority priority)
 {
-	return AddTask([task]() -> ResultHandler {
-		for(auto &st : task->subTasks)
-			st();
-		return {};
-	});
+	return AddTask(
+	  [task]() -> ResultHandler {
+		  for(auto &st : task->subTasks)
+			  st();
+		  return {};
+	  },
+	  priority);
 }
 
 namespace pragma::lua {
@@ -40,17 +44,40 @@ namespace pragma::lua {
 		                      .def("AddBarrier", &LuaThreadPool::AddBarrier)
 		                      .def(
 		                        "AddTask", +[](LuaThreadPool &pool, std::shared_ptr<LuaThreadTask> &threadTask) { return pool.AddTask(threadTask); })
+		                      .def(
+		                        "AddTask", +[](LuaThreadPool &pool, std::shared_ptr<LuaThreadTask> &threadTask, TaskPriority priority) { return pool.AddTask(threadTask, priority); })
 		                      .def("Stop", &LuaThreadPool::Stop)
 		                      .def("PushResults", &LuaThreadPool::PushResults)
 		                      .def("WaitForPendingCount", &LuaThreadPool::WaitForPendingCount)
 		                      .def("WaitForCompletion", &LuaThreadPool::WaitForCompletion)
 		                      .def("GetTaskCount", &LuaThreadPool::GetTotalTaskCount)
 		                      .def("GetPendingTaskCount", &LuaThreadPool::GetPendingTaskCount)
-		                      .def("GetCompletedTaskCount", &LuaThreadPool::GetCompletedTaskCount);
+		                      .def("GetCompletedTaskCount", &LuaThreadPool::GetCompletedTaskCount)
+		                      .def("GetBackend", &LuaThreadPool::GetBackend)
+		                      .def("GetWorkerStats", +[](lua_State *l, LuaThreadPool &pool) -> luabind::tableT<void> {
+			                      auto t = luabind::newtable(l);
+			                      uint32_t idx = 1;
+			                      for(auto &stats : pool.GetWorkerStats()) {
+				                      auto tStats = luabind::newtable(l);
+				                      tStats["tasksExecuted"] = stats.tasksExecuted;
+				                      tStats["tasksStolen"] = stats.tasksStolen;
+				                      tStats["idleTime"] = std::chrono::duration<double>(stats.idleTime).count();
+				                      t[idx++] = tStats;
+			                      }
+			                      return t;
+		                      });
+		classDefPool.add_static_constant("BACKEND_FIFO", umath::to_integral(LuaThreadPool::Backend::Fifo));
+		classDefPool.add_static_constant("BACKEND_WORK_STEALING", umath::to_integral(LuaThreadPool::Backend::WorkStealing));
+		classDefPool.add_static_constant("TASK_PRIORITY_LOW", umath::to_integral(TaskPriority::Low));
+		classDefPool.add_static_constant("TASK_PRIORITY_NORMAL", umath::to_integral(TaskPriority::Normal));
+		classDefPool.add_static_constant("TASK_PRIORITY_HIGH", umath::to_integral(TaskPriority::High));
 		classDefPool.scope[classDefTask];
 		modUtil[classDefPool];
 		pragma::lua::define_custom_constructor<LuaThreadPool, [](lua_State *l, uint32_t threadCount) -> std::shared_ptr<LuaThreadPool> { return std::make_shared<LuaThreadPool>(l, threadCount); }, lua_State *, uint32_t>(l);
 		pragma::lua::define_custom_constructor<LuaThreadPool, [](lua_State *l, uint32_t threadCount, const std::string &name) -> std::shared_ptr<LuaThreadPool> { return std::make_shared<LuaThreadPool>(l, threadCount, name); }, lua_State *, uint32_t, const std::string &>(l);
+		pragma::lua::define_custom_constructor<LuaThreadPool,
+		  [](lua_State *l, uint32_t threadCount, const std::string &name, LuaThreadPool::Backend backend) -> std::shared_ptr<LuaThreadPool> { return std::make_shared<LuaThreadPool>(l, threadCount, name, backend); }, lua_State *, uint32_t, const std::string &,
+		  LuaThreadPool::Backend>(l);
 		pragma::lua::define_custom_constructor<LuaThreadTask, []() -> std::shared_ptr<LuaThreadTask> { return std::make_shared<LuaThreadTask>(); }>(l);
 	}
 };
@@ -1592,6 +1592,8 @@ void Game::RegisterLuaLibraries()
 	classDefTimer.def("SetRepetitions", &Lua_Timer_SetRepetitions);
 	classDefTimer.def("IsRunning", &Lua_Timer_IsRunning);
 	classDefTimer.def("IsPaused", &Lua_Timer_IsPaused);
+	classDefTimer.def("SetPersistent", &Lua_Timer_SetPersistent);
+	classDefTimer.def("IsPersistent", &Lua_Timer_IsPersistent);
 	classDefTimer.def("Call", &Lua_Timer_Call);
 	classDefTimer.def("SetCall", &Lua_Timer_SetCall);
 	timeMod[classDefTimer];
@@ -508,6 +508,13 @@ BaseLuaBaseEntityComponent::MemberIndex BaseLuaBaseEntityComponent::RegisterMemb
 		if(componentMemberInfo.has_value()) {
 			(*it)->memberDeclarations.push_back({functionName, memberName, get_component_member_name_hash(memberName), memberVarName, memberType, initialValue, memberFlags, std::move(onChange), std::move(componentMemberInfo)});
 			itMember = (*it)->memberDeclarations.end() - 1;
+
+			auto oTransmitPriority = attributes["transmitPriority"];
+			if(oTransmitPriority)
+				itMember->transmitPriority = static_cast<TransmitPriority>(umath::min(luabind::object_cast<uint32_t>(oTransmitPriority), umath::to_integral(TransmitPriority::High)));
+			auto oTransmitInterval = attributes["transmitInterval"];
+			if(oTransmitInterval)
+				itMember->transmitInterval = umath::max(luabind::object_cast<float>(oTransmitInterval), 0.f);
 		}
 	}
 	auto idx = itMember - (*it)->memberDeclarations.begin();
@@ -1003,6 +1010,11 @@ util::EventReply BaseLuaBaseEntityComponent::HandleEvent(ComponentEventId eventI
 	}*/
 	return util::EventReply::Unhandled;
 }
+void BaseLuaBaseEntityComponent::GetHandledEvents(std::vector<ComponentEventId> &outEventIds) const
+{
+	BaseEntityComponent::GetHandledEvents(outEventIds);
+	outEventIds.push_back(pragma::BaseEntityComponent::EVENT_ON_ENTITY_COMPONENT_ADDED);
+}
 
 void BaseLuaBaseEntityComponent::OnAttached(BaseEntity &ent)
 {
@@ -1673,6 +1685,10 @@ void Lua::register_base_entity_component(luabind::module_ &modEnts)
 	classDef.add_static_constant("MEMBER_FLAG_DEFAULT_TRANSMIT", umath::to_integral(pragma::BaseLuaBaseEntityComponent::MemberFlags::DefaultTransmit));
 	classDef.add_static_constant("MEMBER_FLAG_DEFAULT_SNAPSHOT", umath::to_integral(pragma::BaseLuaBaseEntityComponent::MemberFlags::DefaultSnapshot));
 
+	classDef.add_static_constant("MEMBER_TRANSMIT_PRIORITY_LOW", umath::to_integral(pragma::BaseLuaBaseEntityComponent::TransmitPriority::Low));
+	classDef.add_static_constant("MEMBER_TRANSMIT_PRIORITY_NORMAL", umath::to_integral(pragma::BaseLuaBaseEntityComponent::TransmitPriority::Normal));
+	classDef.add_static_constant("MEMBER_TRANSMIT_PRIORITY_HIGH", umath::to_integral(pragma::BaseLuaBaseEntityComponent::TransmitPriority::High));
+
 	classDef.def("Initialize", &pragma::BaseLuaBaseEntityComponent::Lua_Initialize, &pragma::BaseLuaBaseEntityComponent::default_Lua_Initialize);
 	classDef.def("OnTick", &pragma::BaseLuaBaseEntityComponent::Lua_OnTick, &pragma::BaseLuaBaseEntityComponent::default_Lua_OnTick);
 	classDef.def("OnRemove", &pragma::BaseLuaBaseEntityComponent::Lua_OnRemove, &pragma::BaseLuaBaseEntityComponent::default_Lua_OnRemove);
@@ -1697,14 +1713,14 @@ BaseLuaBaseEntityComponent::MemberInfo::MemberInfo(const std::string &functionNa
 }
 
 BaseLuaBaseEntityComponent::MemberInfo::MemberInfo(const MemberInfo &other)
-    : functionName(other.functionName), memberName(other.memberName), memberNameHash(other.memberNameHash), memberVariableName(other.memberVariableName), type(other.type), initialValue(other.initialValue), flags(other.flags), onChange(other.onChange),
-      transformCompositeInfo(other.transformCompositeInfo ? std::make_unique<TransformCompositeInfo>(*other.transformCompositeInfo) : nullptr), componentMemberInfo(other.componentMemberInfo)
+    : functionName(other.functionName), memberName(other.memberName), memberNameHash(other.memberNameHash), memberVariableName(other.memberVariableName), type(other.type), initialValue(other.initialValue), flags(other.flags),
+      transmitPriority(other.transmitPriority), transmitInterval(other.transmitInterval), onChange(other.onChange), transformCompositeInfo(other.transformCompositeInfo ? std::make_unique<TransformCompositeInfo>(*other.transformCompositeInfo) : nullptr), componentMemberInfo(other.componentMemberInfo)
 {
 }
 
 BaseLuaBaseEntityComponent::MemberInfo::MemberInfo(MemberInfo &&other)
     : functionName(std::move(other.functionName)), memberName(std::move(other.memberName)), memberNameHash(std::move(other.memberNameHash)), memberVariableName(std::move(other.memberVariableName)), type(std::move(other.type)), initialValue(std::move(other.initialValue)),
-      flags(std::move(other.flags)), onChange(std::move(other.onChange)), transformCompositeInfo(std::move(other.transformCompositeInfo)), componentMemberInfo(std::move(other.componentMemberInfo))
+      flags(std::move(other.flags)), transmitPriority(other.transmitPriority), transmitInterval(other.transmitInterval), onChange(std::move(other.onChange)), transformCompositeInfo(std::move(other.transformCompositeInfo)), componentMemberInfo(std::move(other.componentMemberInfo))
 {
 	other.transformCompositeInfo = nullptr;
 }
@@ -1718,6 +1734,8 @@ BaseLuaBaseEntityComponent::MemberInfo &BaseLuaBaseEntityComponent::MemberInfo::
 	type = other.type;
 	initialValue = other.initialValue;
 	flags = other.flags;
+	transmitPriority = other.transmitPriority;
+	transmitInterval = other.transmitInterval;
 	onChange = other.onChange;
 	transformCompositeInfo = other.transformCompositeInfo ? std::make_unique<TransformCompositeInfo>(*other.transformCompositeInfo) : nullptr;
 	componentMemberInfo = other.componentMemberInfo;
@@ -1733,6 +1751,8 @@ BaseLuaBaseEntityComponent::MemberInfo &BaseLuaBaseEntityComponent::MemberInfo::
 	type = std::move(other.type);
 	initialValue = std::move(other.initialValue);
 	flags = std::move(other.flags);
+	transmitPriority = other.transmitPriority;
+	transmitInterval = other.transmitInterval;
 	onChange = std::move(other.onChange);
 	transformCompositeInfo = std::move(other.transformCompositeInfo);
 	componentMemberInfo = std::move(other.componentMemberInfo);
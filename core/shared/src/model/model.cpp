@@ -1384,8 +1384,10 @@ void Model::CalculateCollisionBounds()
 	m_collisionMax = max;
 }
 
+uint32_t Model::GetUpdateIndex() const { return m_updateIndex; }
 void Model::Update(ModelUpdateFlags flags)
 {
+	++m_updateIndex;
 	if((flags & ModelUpdateFlags::UpdateChildren) != ModelUpdateFlags::None) {
 		for(auto &group : m_meshGroups) {
 			auto &meshes = group->GetMeshes();
@@ -0,0 +1,51 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan */
+
+#include "stdafx_shared.h"
+#include "pragma/networking/net_message_registry.hpp"
+#include <sharedutils/util.h>
+
+using namespace pragma::networking;
+
+void NetMessageStatsTable::Add(uint32_t messageId, size_t numBytes, uint32_t numPackets)
+{
+	if(numPackets == 0)
+		return;
+	if(messageId >= m_stats.size())
+		m_stats.resize(messageId + 1);
+	auto &stats = m_stats[messageId];
+	stats.packetCount += numPackets;
+	stats.byteCount += static_cast<uint64_t>(numBytes) * numPackets;
+}
+const NetMessageStats *NetMessageStatsTable::Find(uint32_t messageId) const { return (messageId < m_stats.size()) ? &m_stats[messageId] : nullptr; }
+const std::vector<NetMessageStats> &NetMessageStatsTable::GetStats() const { return m_stats; }
+NetMessageStats NetMessageStatsTable::GetTotal() const
+{
+	NetMessageStats total {};
+	for(auto &stats : m_stats) {
+		total.packetCount += stats.packetCount;
+		total.byteCount += stats.byteCount;
+	}
+	return total;
+}
+void NetMessageStatsTable::Reset() { m_stats.clear(); }
+
+void NetMessageStatsTable::Print(const std::unordered_map<std::string, uint32_t> &messageIds) const
+{
+	std::vector<std::pair<std::string, const NetMessageStats *>> sortedStats;
+	sortedStats.reserve(messageIds.size());
+	for(auto &pair : messageIds) {
+		auto *stats = Find(pair.second);
+		if(stats == nullptr || stats->packetCount == 0)
+			continue;
+		sortedStats.push_back({pair.first, stats});
+	}
+	std::sort(sortedStats.begin(), sortedStats.end(), [](const std::pair<std::string, const NetMessageStats *> &a, const std::pair<std::string, const NetMessageStats *> &b) { return a.second->byteCount > b.second->byteCount; });
+	for(auto &pair : sortedStats)
+		Con::cout << pair.first << ": " << pair.second->packetCount << " packets, " << util::get_pretty_bytes(pair.second->byteCount) << Con::endl;
+	auto total = GetTotal();
+	Con::cout << "Total: " << total.packetCount << " packets, " << util::get_pretty_bytes(total.byteCount) << Con::endl;
+}
@@ -0,0 +1,68 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan
+ */
+
+#include "stdafx_shared.h"
+#include "pragma/networking/resource_transfer.hpp"
+#include "pragma/encryption/md5.h"
+#include <udm.hpp>
+#include <array>
+
+std::string pragma::networking::resource_transfer::compute_file_hash(VFilePtrInternal &f)
+{
+	MD5 md5 {};
+	std::array<uint8_t, 65'536> buf;
+	f.Seek(0);
+	for(;;) {
+		auto read = f.Read(buf.data(), buf.size());
+		if(read == 0)
+			break;
+		md5.update(buf.data(), static_cast<MD5::size_type>(read));
+		if(read < buf.size())
+			break;
+	}
+	f.Seek(0);
+	return md5.finalize().hexdigest();
+}
+
+void pragma::networking::resource_transfer::write_chunk(NetPacket &packet, const uint8_t *data, uint32_t size, bool compress)
+{
+	packet->Write<uint32_t>(size);
+	if(compress && size > 0) {
+		auto blob = ::udm::compress_lz4_blob(data, size);
+		if(blob.compressedData.size() < size) {
+			packet->Write<ChunkFlags>(ChunkFlags::Compressed);
+			packet->Write<uint32_t>(static_cast<uint32_t>(blob.compressedData.size()));
+			packet->Write(blob.compressedData.data(), blob.compressedData.size());
+			return;
+		}
+	}
+	packet->Write<ChunkFlags>(ChunkFlags::None);
+	packet->Write(data, size);
+}
+
+bool pragma::networking::resource_transfer::read_chunk(NetPacket &packet, std::vector<uint8_t> &outData)
+{
+	auto size = packet->Read<uint32_t>();
+	auto flags = packet->Read<ChunkFlags>();
+	if(size > MAX_CHUNK_SIZE)
+		return false;
+	if(umath::is_flag_set(flags, ChunkFlags::Compressed) == false) {
+		outData.resize(size);
+		packet->Read(outData.data(), size);
+		return true;
+	}
+	auto compressedSize = packet->Read<uint32_t>();
+	if(compressedSize > packet->GetDataSize() - packet->GetOffset())
+		return false;
+	std::vector<uint8_t> compressedData(compressedSize);
+	packet->Read(compressedData.data(), compressedSize);
+	auto blob = ::udm::decompress_lz4_blob(compressedData.data(), compressedData.size(), size);
+	if(blob.data.size() != size)
+		return false;
+	outData = std::move(blob.data);
+	return true;
+}
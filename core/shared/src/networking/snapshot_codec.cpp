@@ -0,0 +1,252 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan
+ */
+
+#include "stdafx_shared.h"
+#include "pragma/networking/snapshot_codec.hpp"
+
+static constexpr float SMALLEST_THREE_RANGE = 0.70710678118f; // 1 /sqrt(2)
+
+void pragma::networking::SnapshotQuantizationSettings::Write(NetPacket &packet) const
+{
+	packet->Write<float>(positionPrecision);
+	packet->Write<float>(velocityPrecision);
+	packet->Write<float>(angularVelocityPrecision);
+	packet->Write<uint8_t>(rotationBits);
+}
+void pragma::networking::SnapshotQuantizationSettings::Read(NetPacket &packet)
+{
+	positionPrecision = packet->Read<float>();
+	velocityPrecision = packet->Read<float>();
+	angularVelocityPrecision = packet->Read<float>();
+	rotationBits = umath::clamp<uint8_t>(packet->Read<uint8_t>(), 4, 20);
+}
+bool pragma::networking::SnapshotQuantizationSettings::operator==(const SnapshotQuantizationSettings &other) const
+{
+	return positionPrecision == other.positionPrecision && velocityPrecision == other.velocityPrecision && angularVelocityPrecision == other.angularVelocityPrecision && rotationBits == other.rotationBits;
+}
+
+////////////
+
+static std::array<int32_t, 3> quantize_vector(const Vector3 &v, float precision) { return {pragma::networking::snapshot::quantize(v.x, precision), pragma::networking::snapshot::quantize(v.y, precision), pragma::networking::snapshot::quantize(v.z, precision)}; }
+static Vector3 dequantize_vector(const std::array<int32_t, 3> &v, float precision)
+{
+	return {pragma::networking::snapshot::dequantize(v[0], precision), pragma::networking::snapshot::dequantize(v[1], precision), pragma::networking::snapshot::dequantize(v[2], precision)};
+}
+
+pragma::networking::QuantizedEntityState pragma::networking::QuantizedEntityState::Create(const SnapshotQuantizationSettings &settings, const Vector3 &pos, const Vector3 &vel, const Vector3 &angVel, const Quat &rot)
+{
+	QuantizedEntityState state {};
+	state.position = quantize_vector(pos, settings.positionPrecision);
+	state.velocity = quantize_vector(vel, settings.velocityPrecision);
+	state.angularVelocity = quantize_vector(angVel, settings.angularVelocityPrecision);
+	state.rotation = snapshot::encode_smallest_three(rot, settings.rotationBits);
+	return state;
+}
+Vector3 pragma::networking::QuantizedEntityState::GetPosition(const SnapshotQuantizationSettings &settings) const { return dequantize_vector(position, settings.positionPrecision); }
+Vector3 pragma::networking::QuantizedEntityState::GetVelocity(const SnapshotQuantizationSettings &settings) const { return dequantize_vector(velocity, settings.velocityPrecision); }
+Vector3 pragma::networking::QuantizedEntityState::GetAngularVelocity(const SnapshotQuantizationSettings &settings) const { return dequantize_vector(angularVelocity, settings.angularVelocityPrecision); }
+Quat pragma::networking::QuantizedEntityState::GetRotation(const SnapshotQuantizationSettings &settings) const { return snapshot::decode_smallest_three(rotation, settings.rotationBits); }
+pragma::networking::QuantizedEntityState::Field pragma::networking::QuantizedEntityState::GetChangedFields(const QuantizedEntityState &baseline) const
+{
+	auto fields = Field::None;
+	if(position != baseline.position)
+		fields |= Field::Position;
+	if(velocity != baseline.velocity)
+		fields |= Field::Velocity;
+	if(angularVelocity != baseline.angularVelocity)
+		fields |= Field::AngularVelocity;
+	if(rotation != baseline.rotation)
+		fields |= Field::Rotation;
+	return fields;
+}
+
+////////////
+
+void pragma::networking::SnapshotHistory::Store(uint8_t snapshotId, const SnapshotQuantizationSettings &settings, const std::shared_ptr<const SnapshotStateTable> &states)
+{
+	auto &entry = m_entries[snapshotId % m_entries.size()];
+	entry.snapshotId = snapshotId;
+	entry.settings = settings;
+	entry.states = states;
+}
+const pragma::networking::SnapshotStateTable *pragma::networking::SnapshotHistory::Find(uint8_t snapshotId, const SnapshotQuantizationSettings &settings) const
+{
+	auto &entry = m_entries[snapshotId % m_entries.size()];
+	if(entry.states == nullptr || entry.snapshotId != snapshotId || entry.settings != settings)
+		return nullptr;
+	return entry.states.get();
+}
+void pragma::networking::SnapshotHistory::Clear()
+{
+	for(auto &entry : m_entries)
+		entry = {};
+}
+
+////////////
+
+void pragma::networking::snapshot::write_varint(NetPacket &packet, uint64_t value)
+{
+	while(value >= 0x80) {
+		packet->Write<uint8_t>(static_cast<uint8_t>(value) | 0x80);
+		value >>= 7;
+	}
+	packet->Write<uint8_t>(static_cast<uint8_t>(value));
+}
+uint64_t pragma::networking::snapshot::read_varint(NetPacket &packet)
+{
+	uint64_t value = 0;
+	for(uint32_t shift = 0; shift < 64; shift += 7) {
+		auto b = packet->Read<uint8_t>();
+		value |= static_cast<uint64_t>(b & 0x7F) << shift;
+		if((b & 0x80) == 0)
+			break;
+	}
+	return value;
+}
+void pragma::networking::snapshot::write_signed_varint(NetPacket &packet, int64_t value)
+{
+	// Zig-zag encoding, so that small negative values also result in few bytes
+	write_varint(packet, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+int64_t pragma::networking::snapshot::read_signed_varint(NetPacket &packet)
+{
+	auto v = read_varint(packet);
+	return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+int32_t pragma::networking::snapshot::quantize(float v, float precision)
+{
+	auto q = std::round(static_cast<double>(v) / static_cast<double>(precision));
+	return static_cast<int32_t>(umath::clamp<double>(q, std::numeric_limits<int32_t>::lowest(), std::numeric_limits<int32_t>::max()));
+}
+float pragma::networking::snapshot::dequantize(int32_t v, float precision) { return static_cast<float>(static_cast<double>(v) * static_cast<double>(precision)); }
+
+uint32_t pragma::networking::snapshot::get_smallest_three_byte_count(uint8_t bits) { return (2 + bits * 3 + 7) / 8; }
+uint64_t pragma::networking::snapshot::encode_smallest_three(const Quat &rot, uint8_t bits)
+{
+	std::array<float, 4> components {rot.w, rot.x, rot.y, rot.z};
+	auto len = std::sqrt(components[0] * components[0] + components[1] * components[1] + components[2] * components[2] + components[3] * components[3]);
+	if(len > 0.f) {
+		for(auto &c : components)
+			c /= len;
+	}
+	else
+		components = {1.f, 0.f, 0.f, 0.f};
+	uint32_t largestIdx = 0;
+	for(uint32_t i = 1; i < components.size(); ++i) {
+		if(std::abs(components[i]) > std::abs(components[largestIdx]))
+			largestIdx = i;
+	}
+	// q and -q describe the same rotation, so we can always make the dropped component positive
+	auto sign = (components[largestIdx] < 0.f) ? -1.f : 1.f;
+
+	auto maxValue = (1ull << bits) - 1;
+	uint64_t encoded = largestIdx;
+	auto shift = 2u;
+	for(uint32_t i = 0; i < components.size(); ++i) {
+		if(i == largestIdx)
+			continue;
+		auto normalized = (umath::clamp(components[i] * sign, -SMALLEST_THREE_RANGE, SMALLEST_THREE_RANGE) + SMALLEST_THREE_RANGE) / (SMALLEST_THREE_RANGE * 2.f);
+		auto q = static_cast<uint64_t>(std::round(normalized * static_cast<float>(maxValue)));
+		encoded |= umath::min(q, maxValue) << shift;
+		shift += bits;
+	}
+	return encoded;
+}
+Quat pragma::networking::snapshot::decode_smallest_three(uint64_t encoded, uint8_t bits)
+{
+	auto maxValue = (1ull << bits) - 1;
+	auto largestIdx = static_cast<uint32_t>(encoded & 3u);
+	std::array<float, 4> components {};
+	auto shift = 2u;
+	auto sumSqr = 0.f;
+	for(uint32_t i = 0; i < components.size(); ++i) {
+		if(i == largestIdx)
+			continue;
+		auto q = (encoded >> shift) & maxValue;
+		shift += bits;
+		auto c = (static_cast<float>(q) / static_cast<float>(maxValue)) * (SMALLEST_THREE_RANGE * 2.f) - SMALLEST_THREE_RANGE;
+		components[i] = c;
+		sumSqr += c * c;
+	}
+	components[largestIdx] = std::sqrt(umath::max(1.f - sumSqr, 0.f));
+	return Quat {components[0], components[1], components[2], components[3]};
+}
+
+void pragma::networking::snapshot::write_quantized_vector(NetPacket &packet, const Vector3 &v, float precision)
+{
+	for(auto c : quantize_vector(v, precision))
+		write_signed_varint(packet, c);
+}
+Vector3 pragma::networking::snapshot::read_quantized_vector(NetPacket &packet, float precision)
+{
+	std::array<int32_t, 3> q;
+	for(auto &c : q)
+		c = static_cast<int32_t>(read_signed_varint(packet));
+	return dequantize_vector(q, precision);
+}
+static void write_encoded_rotation(NetPacket &packet, uint64_t encoded, uint8_t bits)
+{
+	auto numBytes = pragma::networking::snapshot::get_smallest_three_byte_count(bits);
+	for(auto i = decltype(numBytes) {0u}; i < numBytes; ++i)
+		packet->Write<uint8_t>(static_cast<uint8_t>(encoded >> (i * 8)));
+}
+static uint64_t read_encoded_rotation(NetPacket &packet, uint8_t bits)
+{
+	uint64_t encoded = 0;
+	auto numBytes = pragma::networking::snapshot::get_smallest_three_byte_count(bits);
+	for(auto i = decltype(numBytes) {0u}; i < numBytes; ++i)
+		encoded |= static_cast<uint64_t>(packet->Read<uint8_t>()) << (i * 8);
+	return encoded;
+}
+void pragma::networking::snapshot::write_quantized_rotation(NetPacket &packet, const Quat &rot, uint8_t bits) { write_encoded_rotation(packet, encode_smallest_three(rot, bits), bits); }
+Quat pragma::networking::snapshot::read_quantized_rotation(NetPacket &packet, uint8_t bits) { return decode_smallest_three(read_encoded_rotation(packet, bits), bits); }
+
+static void write_delta(NetPacket &packet, const std::array<int32_t, 3> &v, const std::array<int32_t, 3> *baseline)
+{
+	for(auto i = 0u; i < v.size(); ++i)
+		pragma::networking::snapshot::write_signed_varint(packet, static_cast<int64_t>(v[i]) - (baseline ? (*baseline)[i] : 0));
+}
+static void read_delta(NetPacket &packet, std::array<int32_t, 3> &v, const std::array<int32_t, 3> *baseline)
+{
+	for(auto i = 0u; i < v.size(); ++i)
+		v[i] = static_cast<int32_t>(pragma::networking::snapshot::read_signed_varint(packet) + (baseline ? (*baseline)[i] : 0));
+}
+void pragma::networking::snapshot::write_entity_state(NetPacket &packet, const QuantizedEntityState &state, const QuantizedEntityState *baseline, const SnapshotQuantizationSettings &settings)
+{
+	auto fields = baseline ? (state.GetChangedFields(*baseline) | QuantizedEntityState::Field::Baseline) : QuantizedEntityState::Field::All;
+	packet->Write<QuantizedEntityState::Field>(fields);
+	if(umath::is_flag_set(fields, QuantizedEntityState::Field::Position))
+		write_delta(packet, state.position, baseline ? &baseline->position : nullptr);
+	if(umath::is_flag_set(fields, QuantizedEntityState::Field::Velocity))
+		write_delta(packet, state.velocity, baseline ? &baseline->velocity : nullptr);
+	if(umath::is_flag_set(fields, QuantizedEntityState::Field::AngularVelocity))
+		write_delta(packet, state.angularVelocity, baseline ? &baseline->angularVelocity : nullptr);
+	if(umath::is_flag_set(fields, QuantizedEntityState::Field::Rotation))
+		write_encoded_rotation(packet, state.rotation, settings.rotationBits);
+}
+std::optional<pragma::networking::QuantizedEntityState> pragma::networking::snapshot::read_entity_state(NetPacket &packet, const QuantizedEntityState *baseline, const SnapshotQuantizationSettings &settings)
+{
+	auto fields = packet->Read<QuantizedEntityState::Field>();
+	auto valid = true;
+	if(umath::is_flag_set(fields, QuantizedEntityState::Field::Baseline) == false)
+		baseline = nullptr;
+	else if(baseline == nullptr)
+		valid = false;
+	auto state = baseline ? *baseline : QuantizedEntityState {};
+	if(umath::is_flag_set(fields, QuantizedEntityState::Field::Position))
+		read_delta(packet, state.position, baseline ? &baseline->position : nullptr);
+	if(umath::is_flag_set(fields, QuantizedEntityState::Field::Velocity))
+		read_delta(packet, state.velocity, baseline ? &baseline->velocity : nullptr);
+	if(umath::is_flag_set(fields, QuantizedEntityState::Field::AngularVelocity))
+		read_delta(packet, state.angularVelocity, baseline ? &baseline->angularVelocity : nullptr);
+	if(umath::is_flag_set(fields, QuantizedEntityState::Field::Rotation))
+		state.rotation = read_encoded_rotation(packet, settings.rotationBits);
+	if(valid == false)
+		return {};
+	return state;
+}
@@ -25,6 +25,7 @@
 #include "pragma/physics/physsoftbodyinfo.hpp"
 #include "pragma/entities/components/base_physics_component.hpp"
 #include "pragma/entities/trigger/base_trigger_touch.hpp"
+#include "pragma/util/util_task_scheduler.hpp"
 
 std::vector<std::string> pragma::physics::IEnvironment::GetAvailablePhysicsEngines()
 {
@@ -272,3 +273,51 @@ bool PhysSoftBodyInfo::operator==(const PhysSoftBodyInfo &other) const
 
 	  bendingConstraintsDistance == other.bendingConstraintsDistance && clusterCount == other.clusterCount && maxClusterIterations == other.maxClusterIterations && materialStiffnessCoefficient == other.materialStiffnessCoefficient;
 }
+
+void pragma::physics::IEnvironment::OverlapBatch(std::span<const TraceData> queries, std::span<TraceResult> outResults, BatchQueryFlags flags) const { RunBatchQuery(&IEnvironment::Overlap, queries, outResults, flags); }
+void pragma::physics::IEnvironment::RayCastBatch(std::span<const TraceData> queries, std::span<TraceResult> outResults, BatchQueryFlags flags) const { RunBatchQuery(&IEnvironment::RayCast, queries, outResults, flags); }
+void pragma::physics::IEnvironment::SweepBatch(std::span<const TraceData> queries, std::span<TraceResult> outResults, BatchQueryFlags flags) const { RunBatchQuery(&IEnvironment::Sweep, queries, outResults, flags); }
+
+pragma::TaskScheduler &pragma::physics::IEnvironment::GetQueryScheduler() const
+{
+	std::call_once(m_querySchedulerInitFlag, [this]() {
+		// The thread issuing the batch helps out as well
+		auto numWorkers = umath::max(std::thread::hardware_concurrency(), 2u) - 1;
+		m_queryScheduler = std::make_unique<TaskScheduler>(numWorkers, "phys_query");
+	});
+	return *m_queryScheduler;
+}
+
+bool pragma::physics::IEnvironment::SupportsConcurrentQueries() const { return false; }
+
+void pragma::physics::IEnvironment::RunBatchQuery(QueryFunction query, std::span<const TraceData> queries, std::span<TraceResult> outResults, BatchQueryFlags flags) const
+{
+	assert(outResults.size() >= queries.size());
+	auto numQueries = umath::min(queries.size(), outResults.size());
+	auto runQueries = [this, query, &queries, &outResults](size_t start, size_t end) {
+		std::vector<TraceResult> results {};
+		for(auto i = start; i < end; ++i) {
+			results.clear();
+			if((this->*query)(queries[i], &results) == false || results.empty()) {
+				outResults[i] = {};
+				continue;
+			}
+			outResults[i] = std::move(results.front());
+		}
+	};
+	// Small batches aren't worth the overhead of dispatching them to other threads
+	constexpr size_t MIN_QUERIES_PER_TASK = 16;
+	if(umath::is_flag_set(flags, BatchQueryFlags::Parallel) == false || numQueries < MIN_QUERIES_PER_TASK * 2 || SupportsConcurrentQueries() == false) {
+		runQueries(0, numQueries);
+		return;
+	}
+	auto &scheduler = GetQueryScheduler();
+	auto numTasks = umath::min(static_cast<size_t>(scheduler.GetWorkerCount() + 1), numQueries / MIN_QUERIES_PER_TASK);
+	auto queriesPerTask = (numQueries + numTasks - 1) / numTasks;
+	TaskScheduler::TaskGroup group {scheduler, TaskPriority::High};
+	for(size_t start = 0; start < numQueries; start += queriesPerTask) {
+		auto end = umath::min(start + queriesPerTask, numQueries);
+		group.Run([&runQueries, start, end]() { runQueries(start, end); });
+	}
+	group.Wait();
+}
@@ -0,0 +1,88 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan
+ */
+
+#include "stdafx_shared.h"
+#include "pragma/util/frame_pacer.hpp"
+#include <cmath>
+
+using namespace pragma;
+
+FramePacer::FramePacer() : m_ownerThreadId {std::this_thread::get_id()}, m_spinSlack {std::chrono::milliseconds {1}} {}
+
+void FramePacer::SetSpinSlack(std::chrono::nanoseconds slack) { m_spinSlack = std::max(slack, std::chrono::nanoseconds {0}); }
+std::chrono::nanoseconds FramePacer::GetSpinSlack() const { return m_spinSlack; }
+
+bool FramePacer::WaitUntil(Clock::time_point deadline)
+{
+	m_tickDeadline = deadline;
+	auto interrupted = false;
+	auto tSleepStart = Clock::now();
+	auto tSleepEnd = deadline - m_spinSlack;
+	if(tSleepStart < tSleepEnd) {
+		std::unique_lock lock {m_wakeMutex};
+		interrupted = m_wakeCondition.wait_until(lock, tSleepEnd, [this]() { return m_wakeRequested.load(); });
+	}
+	auto tSpinStart = Clock::now();
+	m_stats.totalSleepTime += tSpinStart - tSleepStart;
+	if(interrupted == false) {
+		while(Clock::now() < deadline) {
+			if(m_wakeRequested) {
+				interrupted = true;
+				break;
+			}
+			std::this_thread::yield();
+		}
+		m_stats.totalSpinTime += Clock::now() - tSpinStart;
+	}
+	m_wakeRequested = false;
+	if(interrupted)
+		++m_stats.wakeCount;
+	return !interrupted;
+}
+
+void FramePacer::Wake()
+{
+	if(std::this_thread::get_id() == m_ownerThreadId)
+		return;
+	{
+		std::scoped_lock lock {m_wakeMutex};
+		m_wakeRequested = true;
+	}
+	m_wakeCondition.notify_one();
+}
+
+void FramePacer::OnTickStarted()
+{
+	if(m_tickDeadline.has_value() == false)
+		return;
+	auto jitter = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - *m_tickDeadline);
+	m_tickDeadline = {};
+
+	auto &stats = m_stats;
+	if(stats.tickCount == 0) {
+		stats.minJitter = jitter;
+		stats.maxJitter = jitter;
+	}
+	else {
+		stats.minJitter = std::min(stats.minJitter, jitter);
+		stats.maxJitter = std::max(stats.maxJitter, jitter);
+	}
+	// Welford's online algorithm
+	++stats.tickCount;
+	auto jitterUs = jitter.count() / 1'000.0;
+	auto delta = jitterUs - stats.meanJitterUs;
+	stats.meanJitterUs += delta / static_cast<double>(stats.tickCount);
+	m_jitterM2 += delta * (jitterUs - stats.meanJitterUs);
+	stats.jitterStdDevUs = (stats.tickCount > 1) ? std::sqrt(m_jitterM2 / static_cast<double>(stats.tickCount - 1)) : 0.0;
+}
+
+const FramePacer::Stats &FramePacer::GetStats() const { return m_stats; }
+void FramePacer::ResetStats()
+{
+	m_stats = {};
+	m_jitterM2 = 0.0;
+}
@@ -202,3 +202,30 @@ TraceResult Game::Sweep(const TraceData &data) const
 	}
 	return results.front();
 }
+void Game::OverlapBatch(std::span<const TraceData> queries, std::span<TraceResult> outResults, pragma::physics::IEnvironment::BatchQueryFlags flags) const
+{
+	auto *physEnv = GetPhysicsEnvironment();
+	if(physEnv == nullptr) {
+		std::fill(outResults.begin(), outResults.end(), TraceResult {});
+		return;
+	}
+	physEnv->OverlapBatch(queries, outResults, flags);
+}
+void Game::RayCastBatch(std::span<const TraceData> queries, std::span<TraceResult> outResults, pragma::physics::IEnvironment::BatchQueryFlags flags) const
+{
+	auto *physEnv = GetPhysicsEnvironment();
+	if(physEnv == nullptr) {
+		std::fill(outResults.begin(), outResults.end(), TraceResult {});
+		return;
+	}
+	physEnv->RayCastBatch(queries, outResults, flags);
+}
+void Game::SweepBatch(std::span<const TraceData> queries, std::span<TraceResult> outResults, pragma::physics::IEnvironment::BatchQueryFlags flags) const
+{
+	auto *physEnv = GetPhysicsEnvironment();
+	if(physEnv == nullptr) {
+		std::fill(outResults.begin(), outResults.end(), TraceResult {});
+		return;
+	}
+	physEnv->SweepBatch(queries, outResults, flags);
+}
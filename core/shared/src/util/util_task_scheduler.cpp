@@ -0,0 +1,228 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2021 Silverlan
+ */
+
+#include "stdafx_shared.h"
+#include "pragma/util/util_task_scheduler.hpp"
+#include <sharedutils/util.h>
+
+static thread_local const pragma::TaskScheduler *g_currentScheduler = nullptr;
+static thread_local uint32_t g_currentWorkerIndex = 0;
+
+pragma::TaskScheduler::TaskGroup::TaskGroup(TaskScheduler &scheduler, TaskPriority priority) : m_scheduler {scheduler}, m_priority {priority} {}
+pragma::TaskScheduler::TaskGroup::~TaskGroup() { Wait(); }
+void pragma::TaskScheduler::TaskGroup::Run(const Task &task)
+{
+	++m_pendingTaskCount;
+	m_scheduler.Submit(
+	  [this, task]() {
+		  task();
+		  --m_pendingTaskCount;
+	  },
+	  m_priority);
+}
+void pragma::TaskScheduler::TaskGroup::Wait()
+{
+	while(m_pendingTaskCount > 0) {
+		// Help out with pending tasks (which may include our own) instead of blocking
+		if(!m_scheduler.RunPendingTask())
+			std::this_thread::yield();
+	}
+}
+bool pragma::TaskScheduler::TaskGroup::IsComplete() const { return m_pendingTaskCount == 0; }
+
+////////////
+
+pragma::TaskScheduler::TaskScheduler(uint32_t threadCount, const std::string &name)
+{
+	m_workers.reserve(threadCount);
+	for(auto i = decltype(threadCount) {0u}; i < threadCount; ++i)
+		m_workers.push_back(std::make_unique<Worker>());
+	std::string fullName = "ts";
+	if(!name.empty())
+		fullName += '_' + name;
+	for(auto i = decltype(threadCount) {0u}; i < threadCount; ++i) {
+		auto &worker = *m_workers[i];
+		worker.thread = std::thread {[this, i]() { RunWorker(i); }};
+		util::set_thread_name(worker.thread, fullName);
+	}
+}
+pragma::TaskScheduler::~TaskScheduler() { Stop(true); }
+
+void pragma::TaskScheduler::Submit(const Task &task, TaskPriority priority)
+{
+	// Tasks spawned by a worker go to its own deque, everything else to the shared queue
+	auto workerIdx = GetCurrentWorkerIndex();
+	auto &queues = workerIdx ? m_workers[*workerIdx]->queues : m_sharedQueues;
+	auto &mutex = workerIdx ? m_workers[*workerIdx]->queueMutex : m_sharedQueueMutex;
+	++m_unfinishedTaskCount;
+	{
+		std::scoped_lock lock {mutex};
+		queues[umath::to_integral(priority)].push_back(task);
+		++m_queuedTaskCount;
+	}
+	{
+		std::scoped_lock lock {m_wakeMutex};
+	}
+	m_wakeCondition.notify_one();
+}
+
+bool pragma::TaskScheduler::FindTask(std::optional<uint32_t> workerIdx, Task &outTask, bool &outStolen)
+{
+	if(m_queuedTaskCount == 0)
+		return false;
+	auto pop = [this, &outTask](std::deque<Task> &queue, std::mutex &mutex, bool back) -> bool {
+		std::scoped_lock lock {mutex};
+		if(queue.empty())
+			return false;
+		if(back) {
+			outTask = std::move(queue.back());
+			queue.pop_back();
+		}
+		else {
+			outTask = std::move(queue.front());
+			queue.pop_front();
+		}
+		--m_queuedTaskCount;
+		return true;
+	};
+	auto numWorkers = static_cast<uint32_t>(m_workers.size());
+	for(auto p = umath::to_integral(TaskPriority::Count); p-- > 0;) {
+		outStolen = false;
+		// Newest task of our own deque first (cache-friendly for fork/join), then the shared queue
+		if(workerIdx) {
+			auto &worker = *m_workers[*workerIdx];
+			if(pop(worker.queues[p], worker.queueMutex, true))
+				return true;
+		}
+		if(pop(m_sharedQueues[p], m_sharedQueueMutex, false))
+			return true;
+		// Steal the oldest task from one of the other workers
+		outStolen = true;
+		auto offset = workerIdx ? (*workerIdx + 1) : 0u;
+		for(auto i = decltype(numWorkers) {0u}; i < numWorkers; ++i) {
+			auto victimIdx = (offset + i) % numWorkers;
+			if(workerIdx && victimIdx == *workerIdx)
+				continue;
+			auto &victim = *m_workers[victimIdx];
+			if(pop(victim.queues[p], victim.queueMutex, false))
+				return true;
+		}
+	}
+	return false;
+}
+
+void pragma::TaskScheduler::ExecuteTask(std::optional<uint32_t> workerIdx, Task &task, bool stolen)
+{
+	task();
+	if(workerIdx) {
+		auto &worker = *m_workers[*workerIdx];
+		++worker.tasksExecuted;
+		if(stolen)
+			++worker.tasksStolen;
+	}
+	if(--m_unfinishedTaskCount == 0) {
+		{
+			std::scoped_lock lock {m_wakeMutex};
+		}
+		m_idleCondition.notify_all();
+	}
+}
+
+void pragma::TaskScheduler::RunWorker(uint32_t workerIdx)
+{
+	g_currentScheduler = this;
+	g_currentWorkerIndex = workerIdx;
+	auto &worker = *m_workers[workerIdx];
+	for(;;) {
+		if(m_stop && !m_execRemainingQueue)
+			break;
+		Task task;
+		auto stolen = false;
+		if(FindTask(workerIdx, task, stolen)) {
+			ExecuteTask(workerIdx, task, stolen);
+			continue;
+		}
+		if(m_stop)
+			break;
+		auto tStart = std::chrono::steady_clock::now();
+		{
+			std::unique_lock ul {m_wakeMutex};
+			m_wakeCondition.wait(ul, [this]() { return m_stop || m_queuedTaskCount > 0; });
+		}
+		worker.idleTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart).count();
+	}
+}
+
+bool pragma::TaskScheduler::RunPendingTask()
+{
+	auto workerIdx = GetCurrentWorkerIndex();
+	Task task;
+	auto stolen = false;
+	if(!FindTask(workerIdx, task, stolen))
+		return false;
+	ExecuteTask(workerIdx, task, stolen);
+	return true;
+}
+
+void pragma::TaskScheduler::WaitForIdle()
+{
+	// Note: This must not be called from within a task of this scheduler, use a TaskGroup instead
+	std::unique_lock ul {m_wakeMutex};
+	m_idleCondition.wait(ul, [this]() { return m_unfinishedTaskCount == 0; });
+}
+
+void pragma::TaskScheduler::Stop(bool execRemainingQueue)
+{
+	if(m_stop)
+		return;
+	{
+		std::scoped_lock lock {m_wakeMutex};
+		m_execRemainingQueue = execRemainingQueue;
+		m_stop = true;
+	}
+	m_wakeCondition.notify_all();
+	for(auto &worker : m_workers) {
+		if(worker->thread.joinable())
+			worker->thread.join();
+	}
+	if(execRemainingQueue)
+		return;
+	// Discard the tasks that haven't been started
+	uint32_t numDiscarded = 0;
+	auto clearQueues = [&numDiscarded](TaskQueues &queues) {
+		for(auto &queue : queues) {
+			numDiscarded += queue.size();
+			queue.clear();
+		}
+	};
+	clearQueues(m_sharedQueues);
+	for(auto &worker : m_workers)
+		clearQueues(worker->queues);
+	m_queuedTaskCount = 0;
+	m_unfinishedTaskCount -= numDiscarded;
+	m_idleCondition.notify_all();
+}
+
+uint32_t pragma::TaskScheduler::GetWorkerCount() const { return m_workers.size(); }
+std::optional<uint32_t> pragma::TaskScheduler::GetCurrentWorkerIndex() const { return (g_currentScheduler == this) ? g_currentWorkerIndex : std::optional<uint32_t> {}; }
+uint32_t pragma::TaskScheduler::GetPendingTaskCount() const { return m_unfinishedTaskCount; }
+std::vector<pragma::TaskScheduler::WorkerStats> pragma::TaskScheduler::GetWorkerStats() const
+{
+	std::vector<WorkerStats> stats;
+	stats.reserve(m_workers.size());
+	for(auto &worker : m_workers)
+		stats.push_back({worker->tasksExecuted, worker->tasksStolen, std::chrono::nanoseconds {worker->idleTime}});
+	return stats;
+}
+void pragma::TaskScheduler::ResetWorkerStats()
+{
+	for(auto &worker : m_workers) {
+		worker->tasksExecuted = 0;
+		worker->tasksStolen = 0;
+		worker->idleTime = 0;
+	}
+}
@@ -11,17 +11,28 @@
 
 
 pragma::ThreadPool::ThreadPool(uint32_t threadCount) : ThreadPool {threadCount, ""} {}
-pragma::ThreadPool::ThreadPool(uint32_t threadCount, const std::string &name, const std::string &baseName) : m_pool {static_cast<int>(threadCount)}
+pragma::ThreadPool::ThreadPool(uint32_t threadCount, const std::string &name, const std::string &baseName, Backend backend) : m_pool {static_cast<int>((backend == Backend::Fifo) ? threadCount : 0u)}
 {
-	auto n = m_pool.size();
 	std::string fullName = baseName;
 	if(!name.empty())
 		fullName += '_' + name;
+	if(backend == Backend::WorkStealing) {
+		m_scheduler = std::make_unique<TaskScheduler>(threadCount, fullName);
+		return;
+	}
+	auto n = m_pool.size();
 	for(auto i = decltype(n) {0u}; i < n; ++i)
 		util::set_thread_name(m_pool.get_thread(i), fullName);
 }
 
-void pragma::ThreadPool::Stop(bool execRemainingQueue) { m_pool.stop(execRemainingQueue); }
+void pragma::ThreadPool::Stop(bool execRemainingQueue)
+{
+	if(m_scheduler)
+		m_scheduler->Stop(execRemainingQueue);
+	m_pool.stop(execRemainingQueue);
+}
+
+std::vector<pragma::TaskScheduler::WorkerStats> pragma::ThreadPool::GetWorkerStats() const { return m_scheduler ? m_scheduler->GetWorkerStats() : std::vector<TaskScheduler::WorkerStats> {}; }
 
 void pragma::ThreadPool::PushResults(uint32_t taskId)
 {
@@ -31,7 +42,7 @@ void pragma::ThreadPool::PushResults(uint32_t taskId)
 	m_taskCompleted[taskId].resultHandler();
 }
 
-void pragma::ThreadPool::BatchProcess(uint32_t numJobs, uint32_t numItemsPerJob, const std::function<ResultHandler(uint32_t, uint32_t)> &f)
+void pragma::ThreadPool::BatchProcess(uint32_t numJobs, uint32_t numItemsPerJob, const std::function<ResultHandler(uint32_t, uint32_t)> &f, TaskPriority priority)
 {
 	auto numBatches = numJobs / numItemsPerJob;
 	if((numJobs % numItemsPerJob) > 0)
@@ -39,7 +50,7 @@ void pragma::ThreadPool::BatchProcess(uint32_t numJobs, uint32_t numItemsPerJob,
 	for(auto i = decltype(numBatches) {0u}; i < numBatches; ++i) {
 		auto offset = i * numItemsPerJob;
 		auto end = umath::min(offset + numItemsPerJob, numJobs);
-		AddTask([f, offset, end]() -> ResultHandler { return f(offset, end); });
+		AddTask([f, offset, end]() -> ResultHandler { return f(offset, end); }, priority);
 	}
 }
 
@@ -59,16 +70,23 @@ bool pragma::ThreadPool::IsComplete(uint32_t taskId) const
 	return (taskId < m_taskCompleted.size()) ? m_taskCompleted[taskId].isComplete : false;
 }
 
-void pragma::ThreadPool::AddBarrier() { m_pool.barrier(); }
+void pragma::ThreadPool::AddBarrier()
+{
+	if(m_scheduler) {
+		WaitForCompletion();
+		return;
+	}
+	m_pool.barrier();
+}
 
-uint32_t pragma::ThreadPool::AddTask(const std::function<ResultHandler()> &task)
+uint32_t pragma::ThreadPool::AddTask(const std::function<ResultHandler()> &task, TaskPriority priority)
 {
 	auto taskId = m_totalTaskCount++;
 	if(m_totalTaskCount >= m_taskCompleted.size()) {
 		std::scoped_lock slock {m_taskCompletedMutex};
 		m_taskCompleted.resize(m_totalTaskCount);
 	}
-	m_pool.push([this, task, taskId](int id) {
+	auto runTask = [this, task, taskId]() {
 		auto resultHandler = task ? task() : nullptr;
 		++m_completedTaskCount;
 
@@ -76,6 +94,10 @@ uint32_t pragma::ThreadPool::AddTask(const std::function<ResultHandler()> &task)
 		m_taskCompleted[taskId].resultHandler = std::move(resultHandler);
 		m_taskCompleted[taskId].isComplete = true;
 		m_taskCompleteCondition.notify_one();
-	});
+	};
+	if(m_scheduler)
+		m_scheduler->Submit(runTask, priority);
+	else
+		m_pool.push([runTask](int id) { runTask(); });
 	return taskId;
 }